@@ -34,32 +34,81 @@ std::shared_ptr<Query> Analyze::do_analyze(std::shared_ptr<ast::TreeNode> parse)
             throw TableNotFoundError(y);
         }
         }
-        // 处理target list，再target list中添加上表名，例如 a.id
-        for (auto &sv_sel_col : x->cols) {
-            TabCol sel_col = {.tab_name = sv_sel_col->tab_name, .col_name = sv_sel_col->col_name};
-            query->cols.push_back(sel_col);
-        }
-
-        
         std::vector<ColMeta> all_cols;
 
         get_all_cols(query->tables, all_cols);
+        // 处理target list，再target list中添加上表名，例如 a.id；聚合函数以表名为空、字段名为其输出字段名加入
+        for (auto &sv_sel_col : x->cols) {
+            if (auto sv_agg = std::dynamic_pointer_cast<ast::AggCol>(sv_sel_col)) {
+                auto agg = convert_sv_agg(sv_agg, all_cols);
+                auto same = [&](const AggExpr &other) { return other.name == agg.name; };
+                if (std::none_of(query->aggs.begin(), query->aggs.end(), same)) {
+                    query->aggs.push_back(agg);
+                }
+                query->cols.push_back({.tab_name = "", .col_name = agg.name});
+                continue;
+            }
+            TabCol sel_col = {.tab_name = sv_sel_col->tab_name, .col_name = sv_sel_col->col_name};
+            query->cols.push_back(check_column(all_cols, sel_col));  // 列元数据校验
+        }
         if (query->cols.empty()) {
             // select all columns
             for (auto &col : all_cols) {
                 TabCol sel_col = {.tab_name = col.tab_name, .col_name = col.name};
                 query->cols.push_back(sel_col);
             }
-        } else {
-            // infer table name from column name
-            for (auto &sel_col : query->cols) {
-                sel_col = check_column(all_cols, sel_col);  // 列元数据校验
-            }
         }
 
         //处理where条件
         get_clause(x->conds, query->conds);
         check_clause(query->tables, query->conds);
+
+        // 处理order by，未写表名的排序字段在多个表中都存在时取最后一个表中的
+        for (auto &order : x->orders) {
+            TabCol sort_col = {.tab_name = order->cols->tab_name, .col_name = order->cols->col_name};
+            if (sort_col.tab_name.empty()) {
+                for (auto &col : all_cols) {
+                    if (col.name == sort_col.col_name) {
+                        sort_col.tab_name = col.tab_name;
+                    }
+                }
+            }
+            sort_col = check_column(all_cols, sort_col);
+            query->sort_keys.push_back({sort_col, order->orderby_dir == ast::OrderBy_DESC});
+        }
+
+        // 处理group by，聚合后只剩分组字段和聚合函数，投影和排序的字段都必须是分组字段
+        for (auto &sv_group_col : x->group_by) {
+            TabCol group_col = {.tab_name = sv_group_col->tab_name, .col_name = sv_group_col->col_name};
+            query->group_cols.push_back(check_column(all_cols, group_col));
+        }
+        if (!query->aggs.empty() || !query->group_cols.empty()) {
+            auto check_grouped = [&](const TabCol &col) {
+                bool grouped = std::any_of(query->group_cols.begin(), query->group_cols.end(), [&](const TabCol &group_col) {
+                    return group_col.tab_name == col.tab_name && group_col.col_name == col.col_name;
+                });
+                if (!grouped) {
+                    throw GroupByError(col.tab_name + '.' + col.col_name);
+                }
+            };
+            for (auto &sel_col : query->cols) {
+                if (!sel_col.tab_name.empty()) {
+                    check_grouped(sel_col);
+                }
+            }
+            for (auto &key : query->sort_keys) {
+                check_grouped(key.col);
+            }
+        }
+
+        // 处理limit和offset
+        if (x->limit != nullptr) {
+            if (x->limit->limit < 0 || x->limit->offset < 0) {
+                throw InvalidLimitError(x->limit->limit < 0 ? x->limit->limit : x->limit->offset);
+            }
+            query->limit = x->limit->limit;
+            query->offset = x->limit->offset;
+        }
             // outfile.open("output.txt",std::ios::out | std::ios::app);
             //         outfile << "ka1\n";
             //         outfile.close();
@@ -214,6 +263,35 @@ Value Analyze::convert_sv_value(const std::shared_ptr<ast::Value> &sv_val) {
     return val;
 }
 
+/**
+ * @brief 解析选择列表中的聚合函数，SUM和AVG只能用于数值字段
+ */
+AggExpr Analyze::convert_sv_agg(const std::shared_ptr<ast::AggCol> &sv_agg, const std::vector<ColMeta> &all_cols) {
+    std::map<ast::SvAggFunc, std::pair<AggFunc, std::string>> m = {
+        {ast::SV_AGG_COUNT, {AGG_COUNT, "COUNT"}}, {ast::SV_AGG_SUM, {AGG_SUM, "SUM"}},
+        {ast::SV_AGG_MIN, {AGG_MIN, "MIN"}},       {ast::SV_AGG_MAX, {AGG_MAX, "MAX"}},
+        {ast::SV_AGG_AVG, {AGG_AVG, "AVG"}},
+    };
+    AggExpr agg;
+    agg.func = m.at(sv_agg->func).first;
+    if (sv_agg->col_name.empty()) {
+        agg.name = m.at(sv_agg->func).second + "(*)";
+        return agg;
+    }
+    std::string arg = sv_agg->tab_name.empty() ? sv_agg->col_name : sv_agg->tab_name + '.' + sv_agg->col_name;
+    agg.name = m.at(sv_agg->func).second + '(' + arg + ')';
+    agg.col = check_column(all_cols, {.tab_name = sv_agg->tab_name, .col_name = sv_agg->col_name});
+    if (agg.func == AGG_SUM || agg.func == AGG_AVG) {
+        auto col = std::find_if(all_cols.begin(), all_cols.end(), [&](const ColMeta &col) {
+            return col.tab_name == agg.col.tab_name && col.name == agg.col.col_name;
+        });
+        if (col->type == TYPE_STRING) {
+            throw IncompatibleTypeError(coltype2str(col->type), agg.name);
+        }
+    }
+    return agg;
+}
+
 CompOp Analyze::convert_sv_comp_op(ast::SvCompOp op) {
     std::map<ast::SvCompOp, CompOp> m = {
         {ast::SV_OP_EQ, OP_EQ}, {ast::SV_OP_NE, OP_NE}, {ast::SV_OP_LT, OP_LT},
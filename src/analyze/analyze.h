@@ -34,6 +34,15 @@ class Query{
     std::vector<SetClause> set_clauses;
     //insert 的values值
     std::vector<Value> values;
+    // GROUP BY的分组字段
+    std::vector<TabCol> group_cols;
+    // 选择列表中的聚合函数，在cols中以表名为空、字段名为聚合函数的输出字段名出现
+    std::vector<AggExpr> aggs;
+    // ORDER BY的排序键
+    std::vector<SortKey> sort_keys;
+    // LIMIT的行数和OFFSET，limit为-1时不限制
+    int limit = -1;
+    int offset = 0;
 
     Query(){}
     bool check_table_existence(const std::string& table_name) {
@@ -64,6 +73,7 @@ private:
     void get_clause(const std::vector<std::shared_ptr<ast::BinaryExpr>> &sv_conds, std::vector<Condition> &conds);
     void check_clause(const std::vector<std::string> &tab_names, std::vector<Condition> &conds);
     Value convert_sv_value(const std::shared_ptr<ast::Value> &sv_val);
+    AggExpr convert_sv_agg(const std::shared_ptr<ast::AggCol> &sv_agg, const std::vector<ColMeta> &all_cols);
     CompOp convert_sv_comp_op(ast::SvCompOp op);
 };
 
@@ -0,0 +1,163 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define RMDB_BLOOM_AVX2 1
+#endif
+
+#include "defs.h"
+
+constexpr int BLOOM_BITS_PER_KEY = 16;      // 每个key占用的位数，分块后假阳性率约0.1%
+constexpr size_t BLOOM_MIN_KEYS = 1024;     // 过滤器至少按这么多个key分配空间
+
+/**
+ * @brief 分块的Bloom过滤器，只存在于内存中
+ * 每个块256位，由8个32位的字组成，按32字节对齐，一个块不会跨越cache line；
+ * 一个key只落在一个块中，在8个字中各置一位，查询时只访问一个块，支持AVX2时用一条向量指令完成；
+ * 不支持删除，删除key后过滤器仍可能返回true；插入的key数超过capacity后假阳性率上升，由使用者重建
+ */
+class BloomFilter {
+   private:
+    struct alignas(32) Block {
+        uint32_t words[8];
+    };
+
+    static constexpr uint32_t SALTS[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                          0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    std::vector<Block> blocks_;
+    size_t capacity_ = 0;       // 按这么多个key分配的空间
+    size_t num_keys_ = 0;       // 插入过的key数（包括重复的key）
+
+   public:
+    BloomFilter() = default;
+
+    explicit BloomFilter(size_t capacity) { reset(capacity); }
+
+    /* 清空并按capacity个key重新分配空间 */
+    void reset(size_t capacity) {
+        capacity_ = std::max(capacity, BLOOM_MIN_KEYS);
+        size_t num_blocks = (capacity_ * BLOOM_BITS_PER_KEY + 255) / 256;
+        blocks_.assign(num_blocks, Block{});
+        num_keys_ = 0;
+    }
+
+    void clear() {
+        blocks_.clear();
+        capacity_ = 0;
+        num_keys_ = 0;
+    }
+
+    bool empty() const { return blocks_.empty(); }
+
+    size_t capacity() const { return capacity_; }
+
+    size_t num_keys() const { return num_keys_; }
+
+    size_t memory_bytes() const { return blocks_.size() * sizeof(Block); }
+
+    void insert(uint64_t hash) {
+        assert(!empty());
+        Block &block = blocks_[block_index(hash)];
+        uint32_t masks[8];
+        make_masks(static_cast<uint32_t>(hash), masks);
+        for (int i = 0; i < 8; i++) {
+            block.words[i] |= masks[i];
+        }
+        num_keys_++;
+    }
+
+    /* hash对应的key是否可能插入过，返回false时一定没有插入过；没有分配空间时总是返回true */
+    bool may_contain(uint64_t hash) const {
+        if (empty()) {
+            return true;
+        }
+        const Block &block = blocks_[block_index(hash)];
+#ifdef RMDB_BLOOM_AVX2
+        if (has_avx2()) {
+            return may_contain_avx2(&block, static_cast<uint32_t>(hash));
+        }
+#endif
+        uint32_t masks[8];
+        make_masks(static_cast<uint32_t>(hash), masks);
+        for (int i = 0; i < 8; i++) {
+            if ((block.words[i] & masks[i]) != masks[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 计算由若干字段依次拼接成的key的哈希值
+     * 比较时相等的值哈希值也相同：字符串只取第一个'\0'之前的部分，浮点数的-0.0按0.0计算
+     */
+    static uint64_t hash_key(const char *key, const std::vector<ColType> &col_types, const std::vector<int> &col_lens) {
+        uint64_t hash = 0;
+        for (size_t i = 0; i < col_types.size(); i++) {
+            hash = hash * 0x9e3779b97f4a7c15ULL + hash_value(key, col_types[i], col_lens[i]);
+            key += col_lens[i];
+        }
+        return hash;
+    }
+
+    static uint64_t hash_value(const char *val, ColType type, int len) {
+        if (type == TYPE_STRING) {
+            return std::hash<std::string_view>()(std::string_view(val, strnlen(val, len)));
+        }
+        if (type == TYPE_FLOAT) {
+            float f;
+            memcpy(&f, val, sizeof(float));
+            if (f == 0) {
+                f = 0;
+            }
+            return std::hash<std::string_view>()(std::string_view(reinterpret_cast<const char *>(&f), sizeof(float)));
+        }
+        return std::hash<std::string_view>()(std::string_view(val, len));
+    }
+
+   private:
+    size_t block_index(uint64_t hash) const {
+        return static_cast<size_t>(((hash >> 32) * blocks_.size()) >> 32);
+    }
+
+    static void make_masks(uint32_t key, uint32_t *masks) {
+        for (int i = 0; i < 8; i++) {
+            masks[i] = 1U << ((key * SALTS[i]) >> 27);
+        }
+    }
+
+#ifdef RMDB_BLOOM_AVX2
+    static bool has_avx2() {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    __attribute__((target("avx2"))) static bool may_contain_avx2(const Block *block, uint32_t key) {
+        const __m256i salts = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(SALTS));
+        __m256i bits = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(key), salts), 27);
+        __m256i masks = _mm256_sllv_epi32(_mm256_set1_epi32(1), bits);
+        __m256i words = _mm256_load_si256(reinterpret_cast<const __m256i *>(block->words));
+        // masks中的每一位在words中都已置位
+        return _mm256_testc_si256(words, masks);
+    }
+#endif
+};
@@ -28,6 +28,21 @@ struct TabCol {
     }
 };
 
+// ORDER BY中的一个排序键
+struct SortKey {
+    TabCol col;
+    bool is_desc;
+};
+
+enum AggFunc { AGG_COUNT, AGG_SUM, AGG_MIN, AGG_MAX, AGG_AVG };
+
+// 选择列表中的一个聚合函数，COUNT(*)的col为空
+struct AggExpr {
+    AggFunc func;
+    TabCol col;
+    std::string name;   // 输出字段名，如COUNT(*)、SUM(t.b)
+};
+
 struct Value {
     ColType type;  // type of value
     union {
@@ -82,6 +82,11 @@ class IndexEntryNotFoundError : public RMDBError {
     IndexEntryNotFoundError() : RMDBError("Index entry not found") {}
 };
 
+class IndexEntryExistsError : public RMDBError {
+   public:
+    IndexEntryExistsError() : RMDBError("Index entry already exists") {}
+};
+
 // SM errors
 class DatabaseNotFoundError : public RMDBError {
    public:
@@ -132,6 +137,19 @@ class IndexExistsError : public RMDBError {
     }
 };
 
+class IndexOperationNotSupportedError : public RMDBError {
+   public:
+    IndexOperationNotSupportedError(const std::string &op, const std::string &tab_name,
+                                    const std::vector<std::string> &col_names) {
+        _msg += op + " is not supported on index: " + tab_name + ".(";
+        for(size_t i = 0; i < col_names.size(); ++i) {
+            if(i > 0) _msg += ", ";
+            _msg += col_names[i];
+        }
+        _msg += ")";
+    }
+};
+
 // QL errors
 class InvalidValueCountError : public RMDBError {
    public:
@@ -154,6 +172,22 @@ class AmbiguousColumnError : public RMDBError {
     AmbiguousColumnError(const std::string &col_name) : RMDBError("Ambiguous column: " + col_name) {}
 };
 
+class GroupByError : public RMDBError {
+   public:
+    GroupByError(const std::string &col_name)
+        : RMDBError("Column must appear in GROUP BY or be used in an aggregate function: " + col_name) {}
+};
+
+class InvalidLimitError : public RMDBError {
+   public:
+    InvalidLimitError(int value) : RMDBError("Invalid LIMIT/OFFSET value: " + std::to_string(value)) {}
+};
+
+class AggregateOverflowError : public RMDBError {
+   public:
+    AggregateOverflowError(const std::string &agg_name) : RMDBError("Integer overflow in aggregate: " + agg_name) {}
+};
+
 class PageNotExistError : public RMDBError {
    public:
     PageNotExistError(const std::string &table_name, int page_no)
@@ -10,5 +10,37 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
+#include "common/common.h"
 #include "defs.h"
 #include "errors.h"
+#include "system/sm_meta.h"
+
+/* 在cols中查找target字段，没有时返回nullptr */
+inline const ColMeta *find_col(const std::vector<ColMeta> &cols, const TabCol &target) {
+    auto pos = std::find_if(cols.begin(), cols.end(), [&](const ColMeta &col) {
+        return col.tab_name == target.tab_name && col.name == target.col_name;
+    });
+    return pos == cols.end() ? nullptr : &*pos;
+}
+
+/* cond为两侧字段分属左右子节点、类型相同的等值条件时，返回它在左右子节点中的字段 */
+inline bool get_join_key(const std::vector<ColMeta> &left_cols, const std::vector<ColMeta> &right_cols,
+                         const Condition &cond, const ColMeta **left_key, const ColMeta **right_key) {
+    if (cond.is_rhs_val || cond.op != OP_EQ) {
+        return false;
+    }
+    auto lhs = find_col(left_cols, cond.lhs_col), rhs = find_col(right_cols, cond.rhs_col);
+    if (lhs == nullptr || rhs == nullptr) {
+        lhs = find_col(left_cols, cond.rhs_col);
+        rhs = find_col(right_cols, cond.lhs_col);
+    }
+    if (lhs == nullptr || rhs == nullptr || lhs->type != rhs->type) {
+        return false;
+    }
+    *left_key = lhs;
+    *right_key = rhs;
+    return true;
+}
@@ -13,7 +13,6 @@ See the Mulan PSL v2 for more details. */
 #include "executor_delete.h"
 #include "executor_index_scan.h"
 #include "executor_insert.h"
-#include "executor_nestedloop_join.h"
 #include "executor_projection.h"
 #include "executor_seq_scan.h"
 #include "executor_update.h"
@@ -25,8 +24,11 @@ const char *help_info = "Supported SQL syntax:\n"
                    "command:\n"
                    "  CREATE TABLE table_name (column_name type [, column_name type ...])\n"
                    "  DROP TABLE table_name\n"
-                   "  CREATE INDEX table_name (column_name)\n"
+                   "  CREATE INDEX table_name (column_name) [USING {HASH | BTREE}]\n"
+                   "  CREATE NONUNIQUE INDEX table_name (column_name)\n"
                    "  DROP INDEX table_name (column_name)\n"
+                   "  OPTIMIZE INDEX table_name (column_name)\n"
+                   "  REINDEX table_name (column_name)\n"
                    "  INSERT INTO table_name VALUES (value [, value ...])\n"
                    "  DELETE FROM table_name [WHERE where_clause]\n"
                    "  UPDATE table_name SET column_name = value [, column_name = value ...] [WHERE where_clause]\n"
@@ -60,7 +62,7 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context){
             }
             case T_CreateIndex:
             {
-                sm_manager_->create_index(x->tab_name_, x->tab_col_names_, context);
+                sm_manager_->create_index(x->tab_name_, x->tab_col_names_, x->index_type_, x->unique_, context);
                 break;
             }
             case T_DropIndex:
@@ -68,6 +70,11 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context){
                 sm_manager_->drop_index(x->tab_name_, x->tab_col_names_, context);
                 break;
             }
+            case T_OptimizeIndex:
+            {
+                sm_manager_->optimize_index(x->tab_name_, x->tab_col_names_, context);
+                break;
+            }
             default:
                 throw InternalError("Unexpected field type");
                 break;  
@@ -156,32 +163,35 @@ void QlManager::select_from(std::unique_ptr<AbstractExecutor> executorTreeRoot,
 
     // Print records
     size_t num_rec = 0;
-    // 执行query_plan
-    for (executorTreeRoot->beginTuple(); !executorTreeRoot->is_end(); executorTreeRoot->nextTuple()) {
-        auto Tuple = executorTreeRoot->Next();
-        std::vector<std::string> columns;
-        for (auto &col : executorTreeRoot->cols()) {
-            std::string col_str;
-            char *rec_buf = Tuple->data + col.offset;
-            if (col.type == TYPE_INT) {
-                col_str = std::to_string(*(int *)rec_buf);
-            } else if (col.type == TYPE_FLOAT) {
-                col_str = std::to_string(*(float *)rec_buf);
-            } else if (col.type == TYPE_STRING) {
-                col_str = std::string((char *)rec_buf, col.len);
-                col_str.resize(strlen(col_str.c_str()));
+    // 执行query_plan，按批取出结果
+    TupleBatch batch;
+    executorTreeRoot->beginBatch();
+    while (executorTreeRoot->NextBatch(batch)) {
+        for (int row = 0; row < batch.size(); row++) {
+            std::vector<std::string> columns;
+            for (auto &col : executorTreeRoot->cols()) {
+                std::string col_str;
+                const char *rec_buf = batch.row(row) + col.offset;
+                if (col.type == TYPE_INT) {
+                    col_str = std::to_string(*(const int *)rec_buf);
+                } else if (col.type == TYPE_FLOAT) {
+                    col_str = std::to_string(*(const float *)rec_buf);
+                } else if (col.type == TYPE_STRING) {
+                    col_str = std::string(rec_buf, col.len);
+                    col_str.resize(strlen(col_str.c_str()));
+                }
+                columns.push_back(col_str);
             }
-            columns.push_back(col_str);
-        }
-        // print record into buffer
-        rec_printer.print_record(columns, context);
-        // print record into file
-        outfile << "|";
-        for(int i = 0; i < columns.size(); ++i) {
-            outfile << " " << columns[i] << " |";
+            // print record into buffer
+            rec_printer.print_record(columns, context);
+            // print record into file
+            outfile << "|";
+            for(int i = 0; i < columns.size(); ++i) {
+                outfile << " " << columns[i] << " |";
+            }
+            outfile << "\n";
+            num_rec++;
         }
-        outfile << "\n";
-        num_rec++;
     }
     outfile.close();
     // Print footer into buffer
@@ -13,37 +13,334 @@ See the Mulan PSL v2 for more details. */
 #include "execution_manager.h"
 #include "executor_abstract.h"
 #include "index/ix.h"
+#include "spill_file.h"
 #include "system/sm.h"
 
+constexpr size_t SORT_WORK_MEM = 16 << 20;  // 排序在内存中生成一个有序段最多使用的内存
+
+/**
+ * @brief 按一组排序键比较两条定长记录，每个键可以单独指定升序或降序
+ */
+class SortKeyComparator {
+   private:
+    struct Key {
+        int offset;
+        int len;
+        ColType type;
+        bool is_desc;
+    };
+    std::vector<Key> keys_;
+
+   public:
+    void add_key(const ColMeta &col, bool is_desc) { keys_.push_back({col.offset, col.len, col.type, is_desc}); }
+
+    /* a排在b之前时返回负数，排在之后时返回正数，所有键都相等时返回0 */
+    int compare(const char *a, const char *b) const {
+        for (auto &key : keys_) {
+            int cmp = ix_compare(a + key.offset, b + key.offset, key.type, key.len);
+            if (cmp != 0) {
+                return key.is_desc ? -cmp : cmp;
+            }
+        }
+        return 0;
+    }
+};
+
+/**
+ * @brief 用败者树对k个已排好序的临时文件做多路归并
+ * 每个文件读入一批记录作为缓冲；tree_[0]为当前最小记录所在的文件，tree_[1..k-1]为各内部节点上的败者，
+ * 取出最小记录后只需沿它所在文件的叶子到根重新比较一次，每条记录的比较次数为log k
+ */
+class RunMerger {
+   private:
+    struct Run {
+        SpillFile *file;
+        TupleBatch buffer;
+        int idx;
+        bool done;
+    };
+    const SortKeyComparator *cmp_;
+    std::vector<Run> runs_;
+    std::vector<int> tree_;
+
+   public:
+    RunMerger(const SortKeyComparator *cmp, const std::vector<SpillFile *> &files) : cmp_(cmp) {
+        runs_.resize(files.size());
+        for (size_t i = 0; i < files.size(); i++) {
+            runs_[i].file = files[i];
+            runs_[i].file->rewind();
+            runs_[i].buffer.reset(files[i]->row_len());
+            runs_[i].idx = 0;
+            runs_[i].done = false;
+            fill(runs_[i]);
+        }
+        int k = runs_.size();
+        tree_.assign(std::max(k, 1), 0);
+        if (k > 1) {
+            tree_[0] = build(1);
+        }
+    }
+
+    /* 当前最小的记录，所有文件都读完时返回nullptr */
+    const char *top() const {
+        if (runs_.empty()) {
+            return nullptr;
+        }
+        auto &run = runs_[tree_[0]];
+        return run.done ? nullptr : run.buffer.row(run.idx);
+    }
+
+    /* 取出当前最小的记录，由它所在的文件的下一条记录参与比较 */
+    void pop() {
+        int winner = tree_[0];
+        auto &run = runs_[winner];
+        if (++run.idx >= run.buffer.size()) {
+            fill(run);
+        }
+        int k = runs_.size();
+        for (int node = (winner + k) / 2; node >= 1; node /= 2) {
+            if (less(tree_[node], winner)) {
+                std::swap(tree_[node], winner);
+            }
+        }
+        tree_[0] = winner;
+    }
+
+   private:
+    void fill(Run &run) {
+        run.buffer.reset(run.file->row_len());
+        run.buffer.commit(run.file->read(run.buffer.free_space(), run.buffer.free_rows()));
+        run.idx = 0;
+        run.done = run.buffer.size() == 0;
+    }
+
+    /* 叶子按堆的方式编号为k..2k-1，第i个文件对应叶子k+i；返回子树中的胜者，败者留在内部节点上 */
+    int build(int node) {
+        int k = runs_.size();
+        if (node >= k) {
+            return node - k;
+        }
+        int l = build(node * 2);
+        int r = build(node * 2 + 1);
+        if (less(r, l)) {
+            tree_[node] = l;
+            return r;
+        }
+        tree_[node] = r;
+        return l;
+    }
+
+    /* 读完的文件视为无穷大，键相等时编号小的文件在前 */
+    bool less(int a, int b) const {
+        if (runs_[a].done || runs_[b].done) {
+            return !runs_[a].done;
+        }
+        int cmp = cmp_->compare(runs_[a].buffer.row(runs_[a].idx), runs_[b].buffer.row(runs_[b].idx));
+        return cmp < 0 || (cmp == 0 && a < b);
+    }
+};
+
+/**
+ * @brief 外部归并排序：子节点的记录依次复制到一段连续的内存中，占用的内存达到work_mem时对记录指针排序，
+ * 把这一有序段写入临时文件；子节点读完后，没有写出过有序段时直接按内存中的顺序输出，
+ * 否则把最后一段也写出，用败者树多路归并所有有序段。有序段多于归并路数（每路一批记录的缓冲放得进work_mem）时，
+ * 先把有序段分组归并为更长的有序段，直到一趟能够归并完。
+ * 排序键可以有多个，每个键单独指定升序或降序；NextBatch直接把记录从内存或归并的缓冲复制到batch中。
+ * 指定limit时只输出排在最前面的limit行：limit行放得进work_mem时用一个大小为limit的堆保留当前最前的limit行，
+ * 堆顶为其中排在最后的一行，新记录排在堆顶之前时替换堆顶，不再保存和写出其余的记录
+ */
 class SortExecutor : public AbstractExecutor {
    private:
     std::unique_ptr<AbstractExecutor> prev_;
-    ColMeta cols_;                              // 框架中只支持一个键排序，需要自行修改数据结构支持多个键排序
-    size_t tuple_num;
-    bool is_desc_;
-    std::vector<size_t> used_tuple;
-    std::unique_ptr<RmRecord> current_tuple;
+    std::vector<SortKey> sort_keys_;            // 排序键，按优先级排列
+    SortKeyComparator cmp_;
+    size_t len_;
+    size_t work_mem_;
+    int limit_;                                 // 最多输出的行数，-1时输出全部
+    size_t num_output_ = 0;                     // 已经输出的行数
+
+    // 内存中的有序段：rows_中依次存放记录，order_为排好序的记录指针，下一条输出的是order_[pos_]
+    std::vector<char> rows_;
+    std::vector<char *> order_;
+    size_t pos_ = 0;
+
+    std::vector<std::unique_ptr<SpillFile>> runs_;  // 写入临时文件的有序段
+    std::unique_ptr<RunMerger> merger_;
+    size_t num_runs_ = 0;                       // 生成过的有序段数，不含多趟归并中间生成的
+    const char *current_ = nullptr;             // 当前记录，为nullptr时已经输出完
 
    public:
-    SortExecutor(std::unique_ptr<AbstractExecutor> prev, TabCol sel_cols, bool is_desc) {
+    SortExecutor(std::unique_ptr<AbstractExecutor> prev, std::vector<SortKey> sort_keys,
+                 size_t work_mem = SORT_WORK_MEM, int limit = -1) {
         prev_ = std::move(prev);
-        cols_ = prev_->get_col_offset(sel_cols);
-        is_desc_ = is_desc;
-        tuple_num = 0;
-        used_tuple.clear();
+        sort_keys_ = std::move(sort_keys);
+        len_ = prev_->tupleLen();
+        work_mem_ = work_mem;
+        limit_ = limit;
+        for (auto &key : sort_keys_) {
+            cmp_.add_key(*get_col(prev_->cols(), key.col), key.is_desc);
+        }
     }
 
-    void beginTuple() override { 
-        
+    std::string getType() override { return "Sort"; }
+
+    size_t tupleLen() const override { return len_; }
+
+    const std::vector<ColMeta> &cols() const override { return prev_->cols(); }
+
+    void beginTuple() override {
+        sort();
+        current_ = fetch();
     }
 
     void nextTuple() override {
-        
+        assert(!is_end());
+        advance();
+        current_ = fetch();
     }
 
+    bool is_end() const override { return current_ == nullptr; }
+
     std::unique_ptr<RmRecord> Next() override {
-        return nullptr;
+        assert(!is_end());
+        return std::make_unique<RmRecord>(len_, const_cast<char *>(current_));
+    }
+
+    bool NextBatch(TupleBatch &batch) override {
+        batch.reset(len_);
+        for (; !is_end() && !batch.full(); nextTuple()) {
+            batch.append(current_);
+        }
+        return batch.num_rows() > 0;
     }
 
     Rid &rid() override { return _abstract_rid; }
-};
\ No newline at end of file
+
+    size_t get_num_runs() const { return num_runs_; }
+
+   private:
+    /* 读入子节点的所有记录，生成有序段；有写出的有序段时归并到只剩一趟 */
+    void sort() {
+        rows_.clear();
+        order_.clear();
+        pos_ = 0;
+        runs_.clear();
+        merger_.reset();
+        num_runs_ = 0;
+        num_output_ = 0;
+        size_t max_rows = std::max<size_t>(work_mem_ / (len_ + sizeof(char *)), 1);
+        if (limit_ >= 0 && (size_t)limit_ <= max_rows) {
+            top_n();
+            return;
+        }
+        rows_.reserve(std::min<size_t>(max_rows, TUPLE_BATCH_SIZE) * len_);
+
+        TupleBatch batch;
+        prev_->beginBatch();
+        while (prev_->NextBatch(batch)) {
+            for (int i = 0; i < batch.size(); i++) {
+                if (rows_.size() / len_ == max_rows) {
+                    spill_run();
+                }
+                const char *row = batch.row(i);
+                rows_.insert(rows_.end(), row, row + len_);
+            }
+        }
+        if (runs_.empty()) {
+            sort_rows();
+            return;
+        }
+        spill_run();
+        merge_runs();
+    }
+
+    /* 用大小为limit_的堆选出排在最前面的limit_行，最后按顺序排列堆中的记录 */
+    void top_n() {
+        rows_.resize((size_t)limit_ * len_);
+        auto less = [&](const char *a, const char *b) { return cmp_.compare(a, b) < 0; };
+        TupleBatch batch;
+        prev_->beginBatch();
+        while (limit_ > 0 && prev_->NextBatch(batch)) {
+            for (int i = 0; i < batch.size(); i++) {
+                const char *row = batch.row(i);
+                if (order_.size() < (size_t)limit_) {
+                    order_.push_back(rows_.data() + order_.size() * len_);
+                } else if (cmp_.compare(row, order_.front()) < 0) {
+                    std::pop_heap(order_.begin(), order_.end(), less);
+                } else {
+                    continue;
+                }
+                memcpy(order_.back(), row, len_);
+                std::push_heap(order_.begin(), order_.end(), less);
+            }
+        }
+        std::sort_heap(order_.begin(), order_.end(), less);
+        pos_ = 0;
+    }
+
+    /* rows_的地址已经固定后，对记录指针排序 */
+    void sort_rows() {
+        order_.clear();
+        for (size_t offset = 0; offset < rows_.size(); offset += len_) {
+            order_.push_back(rows_.data() + offset);
+        }
+        std::stable_sort(order_.begin(), order_.end(),
+                         [&](const char *a, const char *b) { return cmp_.compare(a, b) < 0; });
+        pos_ = 0;
+    }
+
+    /* 把内存中的记录排序后写入一个新的临时文件 */
+    void spill_run() {
+        sort_rows();
+        auto run = std::make_unique<SpillFile>(len_);
+        for (auto row : order_) {
+            run->append(row);
+        }
+        runs_.push_back(std::move(run));
+        num_runs_++;
+        rows_.clear();
+        order_.clear();
+    }
+
+    /* 有序段多于一趟能归并的路数时，按顺序每fan_in段归并为一段，最后留下的有序段由merger_归并输出 */
+    void merge_runs() {
+        size_t fan_in = std::max<size_t>(work_mem_ / (len_ * TUPLE_BATCH_SIZE), 2);
+        while (runs_.size() > fan_in) {
+            std::vector<SpillFile *> files;
+            for (size_t i = 0; i < fan_in; i++) {
+                files.push_back(runs_[i].get());
+            }
+            auto merged = std::make_unique<SpillFile>(len_);
+            RunMerger merger(&cmp_, files);
+            for (const char *row; (row = merger.top()) != nullptr; merger.pop()) {
+                merged->append(row);
+            }
+            runs_.erase(runs_.begin(), runs_.begin() + fan_in);
+            runs_.push_back(std::move(merged));
+        }
+        std::vector<SpillFile *> files;
+        for (auto &run : runs_) {
+            files.push_back(run.get());
+        }
+        merger_ = std::make_unique<RunMerger>(&cmp_, files);
+    }
+
+    const char *fetch() const {
+        if (limit_ >= 0 && num_output_ >= (size_t)limit_) {
+            return nullptr;
+        }
+        if (merger_ != nullptr) {
+            return merger_->top();
+        }
+        return pos_ < order_.size() ? order_[pos_] : nullptr;
+    }
+
+    void advance() {
+        num_output_++;
+        if (merger_ != nullptr) {
+            merger_->pop();
+        } else {
+            pos_++;
+        }
+    }
+};
@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/common.h"
 #include "index/ix.h"
 #include "system/sm.h"
+#include "tuple_batch.h"
 
 class AbstractExecutor {
    public:
@@ -43,6 +44,21 @@ class AbstractExecutor {
 
     virtual std::unique_ptr<RmRecord> Next() = 0;
 
+    /* 开始批量读取，与beginTuple相同，之后用NextBatch读取 */
+    virtual void beginBatch() { beginTuple(); }
+
+    /**
+     * @brief 读取下一批记录到batch中，返回false时已经读完
+     * 返回true时batch中可能没有有效行；默认逐条调用Next，逐条执行的算子由此接入批量执行的算子树
+     */
+    virtual bool NextBatch(TupleBatch &batch) {
+        batch.reset(tupleLen());
+        for (; !is_end() && !batch.full(); nextTuple()) {
+            batch.append(Next()->data);
+        }
+        return batch.num_rows() > 0;
+    }
+
     virtual ColMeta get_col_offset(const TabCol &target) { return ColMeta();};
 
     std::vector<ColMeta>::const_iterator get_col(const std::vector<ColMeta> &rec_cols, const TabCol &target) {
@@ -58,6 +74,21 @@ class AbstractExecutor {
     }
     virtual void feed(const std::map<TabCol, Value> &feed_dict){};
 
+    /**
+     * @brief 输出中是否可能有col字段等于val的记录，返回false时一定没有；用于连接时跳过不可能有匹配的外层记录
+     * @param val 长度为len的值，类型与col相同
+     */
+    virtual bool may_contain(const TabCol &col, const char *val, int len) { return true; }
+
+    /* 连接结果是左右两边记录的子集，col属于哪一边就在哪一边检查 */
+    static bool join_may_contain(AbstractExecutor *left, AbstractExecutor *right, const TabCol &col, const char *val,
+                                 int len) {
+        if (find_col(left->cols(), col) != nullptr) {
+            return left->may_contain(col, val, len);
+        }
+        return right->may_contain(col, val, len);
+    }
+
     std::map<TabCol, Value> rec2dict(const std::vector<ColMeta> &cols, const RmRecord *rec) {
         std::map<TabCol, Value> rec_dict;
         for (auto &col : cols) {
@@ -0,0 +1,638 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+#include "execution_defs.h"
+#include "executor_abstract.h"
+#include "index/ix.h"
+#include "spill_file.h"
+
+constexpr size_t AGG_MEM_BUDGET = 64 << 20;  // 各线程的分组哈希表合计最多占用的内存
+constexpr int AGG_PARTITION_BITS = 4;        // 溢出时每层按哈希值的4位分成16个分区
+constexpr int AGG_MAX_LEVEL = 3;             // 分区最多划分的层数，之后即使超出预算也在内存中聚合
+constexpr int AGG_NUM_THREADS = 4;           // 预聚合的线程数上限
+
+/* 默认的预聚合线程数，不超过CPU核数 */
+inline int agg_default_threads() {
+    return std::clamp<int>(std::thread::hardware_concurrency(), 1, AGG_NUM_THREADS);
+}
+
+/**
+ * @brief 分组哈希表：每个分组为定长的一项，依次存放分组key和聚合状态，新分组的聚合状态全为0；
+ * 开放寻址，槽号取哈希值的低位，线性探测
+ */
+class AggHashTable {
+   private:
+    size_t key_len_;
+    size_t entry_len_;
+    std::vector<char> entries_;
+    std::vector<uint64_t> hashes_;
+    std::vector<int> slots_;                    // 槽中为分组的下标，-1表示空槽
+    size_t slot_mask_ = 0;
+
+   public:
+    AggHashTable(size_t key_len, size_t entry_len) : key_len_(key_len), entry_len_(entry_len) {}
+
+    size_t size() const { return hashes_.size(); }
+
+    char *entry(size_t i) { return entries_.data() + i * entry_len_; }
+
+    uint64_t hash(size_t i) const { return hashes_[i]; }
+
+    /* 分组、哈希值和槽占用的内存 */
+    size_t bytes() const { return entries_.size() + hashes_.size() * sizeof(uint64_t) + slots_.size() * sizeof(int); }
+
+    void clear() {
+        entries_.clear();
+        hashes_.clear();
+        slots_.clear();
+        slot_mask_ = 0;
+    }
+
+    /* 查找key所在的分组，没有时加入新分组；返回分组的地址，在下一次插入前有效 */
+    char *find_or_insert(const char *key, uint64_t hash) {
+        if ((hashes_.size() + 1) * 2 > slots_.size()) {
+            grow();
+        }
+        size_t slot = hash & slot_mask_;
+        for (; slots_[slot] != -1; slot = (slot + 1) & slot_mask_) {
+            int i = slots_[slot];
+            if (hashes_[i] == hash && memcmp(entry(i), key, key_len_) == 0) {
+                return entry(i);
+            }
+        }
+        slots_[slot] = hashes_.size();
+        hashes_.push_back(hash);
+        entries_.resize(entries_.size() + entry_len_);
+        char *new_entry = entry(hashes_.size() - 1);
+        memcpy(new_entry, key, key_len_);
+        return new_entry;
+    }
+
+   private:
+    /* 槽数翻倍，保持槽数不小于分组数的两倍 */
+    void grow() {
+        size_t num_slots = std::max<size_t>(slots_.size() * 2, 16);
+        slots_.assign(num_slots, -1);
+        slot_mask_ = num_slots - 1;
+        for (size_t i = 0; i < hashes_.size(); i++) {
+            size_t slot = hashes_[i] & slot_mask_;
+            while (slots_[slot] != -1) {
+                slot = (slot + 1) & slot_mask_;
+            }
+            slots_[slot] = i;
+        }
+    }
+};
+
+/**
+ * @brief 哈希聚合：按分组字段把子节点的记录聚合为每组一行，支持COUNT/SUM/MIN/MAX/AVG。
+ * 当前线程按批读取子节点，每批交给一个预聚合线程，各线程聚合到自己的分组哈希表中，读完后再把各线程的哈希表合并。
+ * 某个线程的哈希表超出它的内存预算时，把其中的部分聚合结果按分组key的哈希值写入该线程的分区临时文件并清空哈希表；
+ * 有分区写出过时，各线程剩余的分组也写入分区，再逐个分区合并同一分区的部分聚合结果，分区仍然过大时继续按哈希值的其他位划分。
+ * 没有分组字段时不建哈希表，在当前线程中逐批累加到一个聚合状态上，只占用固定的内存，输入为空时也输出一行。
+ * 输出记录依次为各分组字段和各聚合函数的结果，聚合函数的输出字段表名为空、字段名为其名字。
+ * INT的SUM在聚合时累加为int64_t，输出时超出INT的范围则抛出AggregateOverflowError
+ */
+class AggregateExecutor : public AbstractExecutor {
+   private:
+    // 一个聚合函数：参数字段、在聚合状态中的偏移和输出字段
+    struct AggSpec {
+        AggFunc func;
+        ColMeta arg;                                // COUNT(*)时不使用
+        int state_offset;
+        ColMeta out;
+    };
+
+    // 一个预聚合线程的分组哈希表，以及哈希表超出预算时写出的部分聚合结果
+    struct Worker {
+        std::unique_ptr<AggHashTable> table;
+        std::vector<std::unique_ptr<SpillFile>> parts;
+    };
+
+    struct Partition {
+        std::vector<std::unique_ptr<SpillFile>> files;  // 写入同一分区的各个临时文件
+        int level;                                  // 划分的层数，决定下一次划分使用哈希值的哪几位
+    };
+
+    std::unique_ptr<AbstractExecutor> prev_;
+    std::vector<TabCol> group_cols_;
+    std::vector<AggExpr> aggs_;
+    std::vector<ColMeta> key_cols_;                 // 分组字段在子节点记录中的位置
+    std::vector<AggSpec> specs_;
+    std::vector<ColMeta> cols_;                     // 输出记录的字段
+    size_t len_ = 0;                                // 输出记录的长度，前key_len_字节与分组key相同
+    size_t key_len_ = 0;
+    size_t state_len_ = 0;
+    size_t mem_budget_;
+    int num_threads_;
+
+    AggHashTable table_;                            // 待输出的分组，下一个输出的是第out_idx_个
+    size_t out_idx_ = 0;
+    std::vector<Partition> partitions_;             // 尚未聚合的分区
+    size_t num_partitions_ = 0;                     // 聚合过的分区数，没有溢出时为0
+    bool end_ = true;
+    std::unique_ptr<RmRecord> record_;              // 当前的输出记录
+
+   public:
+    AggregateExecutor(std::unique_ptr<AbstractExecutor> prev, std::vector<TabCol> group_cols, std::vector<AggExpr> aggs,
+                      size_t mem_budget = AGG_MEM_BUDGET, int num_threads = agg_default_threads())
+        : table_(0, 0) {
+        prev_ = std::move(prev);
+        group_cols_ = std::move(group_cols);
+        aggs_ = std::move(aggs);
+        mem_budget_ = mem_budget;
+        num_threads_ = std::max(num_threads, 1);
+
+        for (auto &group_col : group_cols_) {
+            auto col = *get_col(prev_->cols(), group_col);
+            key_cols_.push_back(col);
+            col.offset = len_;
+            cols_.push_back(col);
+            len_ += col.len;
+        }
+        key_len_ = len_;
+        for (auto &agg : aggs_) {
+            AggSpec spec;
+            spec.func = agg.func;
+            spec.state_offset = state_len_;
+            spec.out = {"", agg.name, TYPE_INT, sizeof(int), (int)len_, false};
+            if (!agg.col.col_name.empty()) {
+                spec.arg = *get_col(prev_->cols(), agg.col);
+            }
+            switch (agg.func) {
+                case AGG_COUNT:
+                    state_len_ += sizeof(int64_t);
+                    break;
+                case AGG_SUM:
+                case AGG_AVG:
+                    // 整数的和为int64_t，浮点数的和为double，之后为记录数
+                    spec.out.type = agg.func == AGG_AVG ? TYPE_FLOAT : spec.arg.type;
+                    state_len_ += sizeof(int64_t) + sizeof(int64_t);
+                    break;
+                case AGG_MIN:
+                case AGG_MAX:
+                    // 是否已有值，之后为当前的最小或最大值
+                    spec.out.type = spec.arg.type;
+                    spec.out.len = spec.arg.len;
+                    state_len_ += 1 + spec.arg.len;
+                    break;
+            }
+            len_ += spec.out.len;
+            cols_.push_back(spec.out);
+            specs_.push_back(spec);
+        }
+        table_ = AggHashTable(key_len_, key_len_ + state_len_);
+        record_ = std::make_unique<RmRecord>(len_);
+    }
+
+    std::string getType() override { return "Aggregate"; }
+
+    size_t tupleLen() const override { return len_; }
+
+    const std::vector<ColMeta> &cols() const override { return cols_; }
+
+    void beginTuple() override {
+        open();
+        end_ = !next_group(record_->data);
+    }
+
+    void nextTuple() override {
+        assert(!is_end());
+        end_ = !next_group(record_->data);
+    }
+
+    bool is_end() const override { return end_; }
+
+    std::unique_ptr<RmRecord> Next() override {
+        assert(!is_end());
+        return std::make_unique<RmRecord>(*record_);
+    }
+
+    void beginBatch() override { open(); }
+
+    bool NextBatch(TupleBatch &batch) override {
+        batch.reset(len_);
+        while (!batch.full()) {
+            if (!next_group(batch.append())) {
+                batch.pop_back();
+                break;
+            }
+        }
+        return batch.num_rows() > 0;
+    }
+
+    /* 分组字段的值都来自子节点，聚合函数的结果无法判断 */
+    bool may_contain(const TabCol &col, const char *val, int len) override {
+        if (col.tab_name.empty()) {
+            return true;
+        }
+        return prev_->may_contain(col, val, len);
+    }
+
+    Rid &rid() override { return _abstract_rid; }
+
+    size_t get_num_partitions() const { return num_partitions_; }
+
+   private:
+    /* 读入子节点的所有记录完成聚合，溢出时只完成划分，各分区在输出时再聚合 */
+    void open() {
+        table_.clear();
+        out_idx_ = 0;
+        partitions_.clear();
+        num_partitions_ = 0;
+        if (group_cols_.empty()) {
+            aggregate_all();
+            return;
+        }
+
+        auto workers = run_workers();
+        bool spilled = std::any_of(workers.begin(), workers.end(), [](const Worker &w) { return !w.parts.empty(); });
+        if (!spilled) {
+            for (auto &w : workers) {
+                for (size_t i = 0; i < w.table->size(); i++) {
+                    merge_entry(table_, w.table->entry(i), w.table->hash(i));
+                }
+            }
+            return;
+        }
+        for (auto &w : workers) {
+            flush(w);
+        }
+        for (size_t p = 0; p < (1 << AGG_PARTITION_BITS); p++) {
+            Partition part;
+            part.level = 0;
+            for (auto &w : workers) {
+                if (!w.parts.empty() && w.parts[p]->num_rows() > 0) {
+                    part.files.push_back(std::move(w.parts[p]));
+                }
+            }
+            if (!part.files.empty()) {
+                partitions_.push_back(std::move(part));
+            }
+        }
+    }
+
+    /* 没有分组字段时逐批累加到一个聚合状态上 */
+    void aggregate_all() {
+        std::vector<char> state(state_len_);
+        TupleBatch batch;
+        prev_->beginBatch();
+        while (prev_->NextBatch(batch)) {
+            for (int i = 0; i < batch.size(); i++) {
+                update(state.data(), batch.row(i));
+            }
+        }
+        memcpy(table_.find_or_insert(state.data(), 0), state.data(), state_len_);
+    }
+
+    /**
+     * @brief 当前线程读取子节点，每批记录放入一个有界队列，由各预聚合线程取出后聚合到各自的哈希表中；
+     * 只有一个线程时直接在当前线程中聚合。任一线程出错时停止读取，等待所有线程结束后抛出
+     */
+    std::vector<Worker> run_workers() {
+        std::vector<Worker> workers(num_threads_);
+        for (auto &w : workers) {
+            w.table = std::make_unique<AggHashTable>(key_len_, key_len_ + state_len_);
+        }
+        size_t budget = mem_budget_ / num_threads_;
+        prev_->beginBatch();
+        if (num_threads_ == 1) {
+            TupleBatch batch;
+            while (prev_->NextBatch(batch)) {
+                consume(workers[0], batch, budget);
+            }
+            return workers;
+        }
+
+        std::mutex mutex;
+        std::condition_variable not_empty, not_full;
+        std::deque<TupleBatch> queue;
+        bool done = false;
+        std::exception_ptr error;
+        auto work = [&](Worker &w) {
+            while (true) {
+                TupleBatch batch;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    not_empty.wait(lock, [&] { return !queue.empty() || done; });
+                    if (queue.empty()) {
+                        return;
+                    }
+                    batch = std::move(queue.front());
+                    queue.pop_front();
+                }
+                not_full.notify_one();
+                try {
+                    consume(w, batch, budget);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (error == nullptr) {
+                        error = std::current_exception();
+                    }
+                    not_full.notify_all();
+                    return;
+                }
+            }
+        };
+        std::vector<std::thread> threads;
+        for (auto &w : workers) {
+            threads.emplace_back(work, std::ref(w));
+        }
+        auto finish = [&] {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                done = true;
+            }
+            not_empty.notify_all();
+            for (auto &thread : threads) {
+                thread.join();
+            }
+        };
+        try {
+            TupleBatch batch;
+            while (prev_->NextBatch(batch)) {
+                if (batch.size() == 0) {
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(mutex);
+                not_full.wait(lock, [&] { return queue.size() < workers.size() * 2 || error != nullptr; });
+                if (error != nullptr) {
+                    break;
+                }
+                queue.push_back(std::move(batch));
+                lock.unlock();
+                not_empty.notify_one();
+                batch = TupleBatch();
+            }
+        } catch (...) {
+            finish();
+            throw;
+        }
+        finish();
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+        return workers;
+    }
+
+    /* 把一批记录聚合到线程w的哈希表中，哈希表超出预算时写出 */
+    void consume(Worker &w, const TupleBatch &batch, size_t budget) const {
+        std::vector<char> key(key_len_);
+        for (int i = 0; i < batch.size(); i++) {
+            const char *row = batch.row(i);
+            uint64_t hash = make_key(row, key.data());
+            update(w.table->find_or_insert(key.data(), hash) + key_len_, row);
+            if (w.table->bytes() > budget) {
+                flush(w);
+            }
+        }
+    }
+
+    /* 把线程w哈希表中的部分聚合结果按哈希值写入各分区，然后清空哈希表 */
+    void flush(Worker &w) const {
+        if (w.parts.empty()) {
+            w.parts = make_parts();
+        }
+        for (size_t i = 0; i < w.table->size(); i++) {
+            w.parts[partition_of(w.table->hash(i), 0)]->append(w.table->entry(i));
+        }
+        w.table->clear();
+    }
+
+    /* 输出table_中的下一个分组，table_输出完时聚合下一个分区；没有剩余的分组时返回false */
+    bool next_group(char *out) {
+        while (out_idx_ >= table_.size()) {
+            if (!next_partition()) {
+                return false;
+            }
+        }
+        finalize(table_.entry(out_idx_++), out);
+        return true;
+    }
+
+    /* 取出下一个分区，把其中的部分聚合结果合并到table_中，分区中的分组过多时继续划分；没有剩余分区时返回false */
+    bool next_partition() {
+        while (!partitions_.empty()) {
+            Partition part = std::move(partitions_.back());
+            partitions_.pop_back();
+            table_.clear();
+            out_idx_ = 0;
+            std::vector<std::unique_ptr<SpillFile>> sub_parts;
+            TupleBatch batch;
+            for (auto &file : part.files) {
+                file->rewind();
+                while (read_file(file.get(), batch)) {
+                    for (int i = 0; i < batch.size(); i++) {
+                        const char *entry = batch.row(i);
+                        uint64_t hash = hash_key(entry);
+                        if (!sub_parts.empty()) {
+                            sub_parts[partition_of(hash, part.level + 1)]->append(entry);
+                            continue;
+                        }
+                        merge_entry(table_, entry, hash);
+                        if (table_.bytes() > mem_budget_ && part.level + 1 < AGG_MAX_LEVEL) {
+                            // 已合并的分组连同分区的其余部分按哈希值的下一层位继续划分
+                            sub_parts = make_parts();
+                            for (size_t j = 0; j < table_.size(); j++) {
+                                sub_parts[partition_of(table_.hash(j), part.level + 1)]->append(table_.entry(j));
+                            }
+                            table_.clear();
+                        }
+                    }
+                }
+            }
+            if (!sub_parts.empty()) {
+                for (auto &sub_part : sub_parts) {
+                    if (sub_part->num_rows() > 0) {
+                        Partition next;
+                        next.files.push_back(std::move(sub_part));
+                        next.level = part.level + 1;
+                        partitions_.push_back(std::move(next));
+                    }
+                }
+                continue;
+            }
+            num_partitions_++;
+            return true;
+        }
+        return false;
+    }
+
+    /* 把一项部分聚合结果合并到table中key相同的分组上 */
+    void merge_entry(AggHashTable &table, const char *entry, uint64_t hash) const {
+        combine(table.find_or_insert(entry, hash) + key_len_, entry + key_len_);
+    }
+
+    /* 把记录row累加到聚合状态state上 */
+    void update(char *state, const char *row) const {
+        for (auto &spec : specs_) {
+            char *s = state + spec.state_offset;
+            const char *val = row + spec.arg.offset;
+            switch (spec.func) {
+                case AGG_COUNT:
+                    store<int64_t>(s, load<int64_t>(s) + 1);
+                    break;
+                case AGG_SUM:
+                case AGG_AVG:
+                    if (spec.arg.type == TYPE_INT) {
+                        store<int64_t>(s, load<int64_t>(s) + load<int>(val));
+                    } else {
+                        store<double>(s, load<double>(s) + load<float>(val));
+                    }
+                    store<int64_t>(s + sizeof(int64_t), load<int64_t>(s + sizeof(int64_t)) + 1);
+                    break;
+                case AGG_MIN:
+                case AGG_MAX:
+                    if (s[0] == 0 || better(spec, val, s + 1)) {
+                        s[0] = 1;
+                        memcpy(s + 1, val, spec.arg.len);
+                    }
+                    break;
+            }
+        }
+    }
+
+    /* 把聚合状态src合并到dst上 */
+    void combine(char *dst, const char *src) const {
+        for (auto &spec : specs_) {
+            char *d = dst + spec.state_offset;
+            const char *s = src + spec.state_offset;
+            switch (spec.func) {
+                case AGG_COUNT:
+                    store<int64_t>(d, load<int64_t>(d) + load<int64_t>(s));
+                    break;
+                case AGG_SUM:
+                case AGG_AVG:
+                    if (spec.arg.type == TYPE_INT) {
+                        store<int64_t>(d, load<int64_t>(d) + load<int64_t>(s));
+                    } else {
+                        store<double>(d, load<double>(d) + load<double>(s));
+                    }
+                    store<int64_t>(d + sizeof(int64_t), load<int64_t>(d + sizeof(int64_t)) + load<int64_t>(s + sizeof(int64_t)));
+                    break;
+                case AGG_MIN:
+                case AGG_MAX:
+                    if (s[0] != 0 && (d[0] == 0 || better(spec, s + 1, d + 1))) {
+                        memcpy(d, s, 1 + spec.arg.len);
+                    }
+                    break;
+            }
+        }
+    }
+
+    /* 把int64_t的聚合结果写为INT字段，超出INT的范围时报错，不回绕 */
+    static void store_int(char *dest, int64_t val, const AggSpec &spec) {
+        if (val < std::numeric_limits<int>::min() || val > std::numeric_limits<int>::max()) {
+            throw AggregateOverflowError(spec.out.name);
+        }
+        store<int>(dest, (int)val);
+    }
+
+    /* 由分组的key和聚合状态生成输出记录 */
+    void finalize(const char *entry, char *out) const {
+        memcpy(out, entry, key_len_);
+        const char *state = entry + key_len_;
+        for (auto &spec : specs_) {
+            const char *s = state + spec.state_offset;
+            char *dest = out + spec.out.offset;
+            switch (spec.func) {
+                case AGG_COUNT:
+                    store_int(dest, load<int64_t>(s), spec);
+                    break;
+                case AGG_SUM:
+                    if (spec.arg.type == TYPE_INT) {
+                        store_int(dest, load<int64_t>(s), spec);
+                    } else {
+                        store<float>(dest, load<double>(s));
+                    }
+                    break;
+                case AGG_AVG: {
+                    int64_t count = load<int64_t>(s + sizeof(int64_t));
+                    double sum = spec.arg.type == TYPE_INT ? load<int64_t>(s) : load<double>(s);
+                    store<float>(dest, count == 0 ? 0 : sum / count);
+                    break;
+                }
+                case AGG_MIN:
+                case AGG_MAX:
+                    memcpy(dest, s + 1, spec.arg.len);
+                    break;
+            }
+        }
+    }
+
+    /* val是否应取代当前的最小（MIN）或最大（MAX）值curr */
+    static bool better(const AggSpec &spec, const char *val, const char *curr) {
+        int cmp = ix_compare(val, curr, spec.arg.type, spec.arg.len);
+        return spec.func == AGG_MIN ? cmp < 0 : cmp > 0;
+    }
+
+    /* 把记录row中各分组字段的值依次拼接成key，返回key的哈希值；字符串结尾之后补0，浮点数的-0.0按0.0存放 */
+    uint64_t make_key(const char *row, char *key) const {
+        char *dest = key;
+        for (auto &col : key_cols_) {
+            const char *val = row + col.offset;
+            if (col.type == TYPE_STRING) {
+                size_t n = strnlen(val, col.len);
+                memcpy(dest, val, n);
+                memset(dest + n, 0, col.len - n);
+            } else if (col.type == TYPE_FLOAT) {
+                float f = load<float>(val);
+                store<float>(dest, f == 0 ? 0 : f);
+            } else {
+                memcpy(dest, val, col.len);
+            }
+            dest += col.len;
+        }
+        return hash_key(key);
+    }
+
+    uint64_t hash_key(const char *key) const { return std::hash<std::string_view>()(std::string_view(key, key_len_)); }
+
+    std::vector<std::unique_ptr<SpillFile>> make_parts() const {
+        std::vector<std::unique_ptr<SpillFile>> parts(1 << AGG_PARTITION_BITS);
+        for (auto &part : parts) {
+            part = std::make_unique<SpillFile>(key_len_ + state_len_);
+        }
+        return parts;
+    }
+
+    /* 第level层的分区号取哈希值从高位开始的第level组位，槽号取低位，两者互不相关 */
+    static size_t partition_of(uint64_t hash, int level) {
+        return (hash >> (64 - AGG_PARTITION_BITS * (level + 1))) & ((1 << AGG_PARTITION_BITS) - 1);
+    }
+
+    static bool read_file(SpillFile *file, TupleBatch &batch) {
+        batch.reset(file->row_len());
+        batch.commit(file->read(batch.free_space(), batch.free_rows()));
+        return batch.num_rows() > 0;
+    }
+
+    template <typename T>
+    static T load(const char *src) {
+        T val;
+        memcpy(&val, src, sizeof(T));
+        return val;
+    }
+
+    template <typename T>
+    static void store(char *dest, T val) {
+        memcpy(dest, &val, sizeof(T));
+    }
+};
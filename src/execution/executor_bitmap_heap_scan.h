@@ -0,0 +1,150 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "executor_index_scan.h"
+
+constexpr int BITMAP_HEAP_SCAN_BATCH = 4096;  // 每批从索引中收集的rid个数
+
+/**
+ * @brief 按rid顺序回表的索引范围扫描
+ * 只用一个索引时，从IxScan中每次收集一批rid，按(page_no, slot_no)排序后依次读取记录，每个数据页在一批中只pin一次；
+ * 有多个索引时，先把每个索引扫描范围内的rid收集为RidBitmap并求交，再按RidBitmap中的顺序分批回表；
+ * 输出顺序是rid顺序而不是索引顺序，适合范围内记录较多、逐条回表会反复访问同一数据页的情况
+ */
+class BitmapHeapScanExecutor : public IndexScanExecutor {
+    std::vector<std::pair<IndexMeta, IxIndexHandle *>> and_indexes_;    // 与ih_求交的其他索引
+    std::unique_ptr<RidBitmap> bitmap_;                                 // 多个索引求交的结果
+    std::unique_ptr<RidBitmap::Iterator> bitmap_iter_;
+
+    std::vector<Rid> rids_;         // 当前批次排序后的rid
+    size_t pos_ = 0;
+    int page_no_ = RM_NO_PAGE;      // 当前pin住的数据页
+    Page *page_ = nullptr;
+    char *slots_ = nullptr;         // 当前数据页的记录区
+    RmRecord rec_;                  // 当前记录的副本
+
+   public:
+    BitmapHeapScanExecutor(SmManager *sm_manager, std::string tab_name, std::vector<Condition> conds,
+                           std::vector<std::string> index_col_names,
+                           const std::vector<std::vector<std::string>> &and_index_col_names, Context *context)
+        : IndexScanExecutor(sm_manager, std::move(tab_name), std::move(conds), std::move(index_col_names), context),
+          rec_(fh_->get_file_hdr().record_size) {
+        for (auto &col_names : and_index_col_names) {
+            and_indexes_.emplace_back(
+                *tab_.get_index_meta(col_names),
+                sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, col_names)).get());
+        }
+    }
+
+    ~BitmapHeapScanExecutor() override { release_page(); }
+
+    bool is_end() const override { return pos_ == rids_.size(); }
+
+    std::string getType() override { return "BitmapHeapScan"; }
+
+    void beginTuple() override {
+        check_runtime_conds();
+        pred_.compile(cols_, fed_conds_);
+        release_page();
+        Iid lower, upper;
+        get_scan_range(&lower, &upper);
+        scan_ = std::make_unique<IxScan>(ih_, lower, upper, sm_manager_->get_bpm());
+        if (!and_indexes_.empty()) {
+            bitmap_ = scan_bitmap(scan_.get());
+            for (auto &[index_meta, ih] : and_indexes_) {
+                if (bitmap_->empty()) {
+                    break;
+                }
+                get_scan_range(ih, index_meta, fed_conds_, &lower, &upper);
+                IxScan scan(ih, lower, upper, sm_manager_->get_bpm());
+                bitmap_->intersect_with(*scan_bitmap(&scan));
+            }
+            bitmap_iter_ = std::make_unique<RidBitmap::Iterator>(bitmap_->iterator());
+        }
+        rids_.clear();
+        pos_ = 0;
+        seek();
+    }
+
+    void nextTuple() override {
+        check_runtime_conds();
+        assert(!is_end());
+        pos_++;
+        seek();
+    }
+
+    std::unique_ptr<RmRecord> Next() override {
+        assert(!is_end());
+        return std::make_unique<RmRecord>(rec_);
+    }
+
+   private:
+    /* 从pos_开始找到第一条满足fed_conds_的记录，当前批次用完时收集下一批 */
+    void seek() {
+        while (true) {
+            if (pos_ == rids_.size() && !next_batch()) {
+                release_page();
+                return;
+            }
+            const Rid &rid = rids_[pos_];
+            if (rid.page_no != page_no_) {
+                release_page();
+                RmPageHandle ph = fh_->fetch_page_handle(rid.page_no);
+                page_ = ph.page;
+                slots_ = ph.slots;
+                page_no_ = rid.page_no;
+            }
+            memcpy(rec_.data, slots_ + rid.slot_no * rec_.size, rec_.size);
+            if (pred_.eval(rec_.data)) {
+                rid_ = rid;
+                return;
+            }
+            pos_++;
+        }
+    }
+
+    std::unique_ptr<RidBitmap> scan_bitmap(IxScan *scan) {
+        auto bitmap = std::make_unique<RidBitmap>(fh_->get_file_hdr().num_records_per_page);
+        for (; !scan->is_end(); scan->next()) {
+            bitmap->add(scan->rid());
+        }
+        return bitmap;
+    }
+
+    bool next_batch() {
+        rids_.clear();
+        pos_ = 0;
+        if (bitmap_iter_ != nullptr) {
+            Rid rid;
+            while (rids_.size() < BITMAP_HEAP_SCAN_BATCH && bitmap_iter_->next(&rid)) {
+                rids_.push_back(rid);
+            }
+            return !rids_.empty();
+        }
+        for (; !scan_->is_end() && rids_.size() < BITMAP_HEAP_SCAN_BATCH; scan_->next()) {
+            rids_.push_back(scan_->rid());
+        }
+        std::sort(rids_.begin(), rids_.end(), [](const Rid &a, const Rid &b) {
+            return a.page_no != b.page_no ? a.page_no < b.page_no : a.slot_no < b.slot_no;
+        });
+        return !rids_.empty();
+    }
+
+    void release_page() {
+        if (page_ != nullptr) {
+            sm_manager_->get_bpm()->unpin_page(page_->get_page_id(), false);
+            page_ = nullptr;
+            slots_ = nullptr;
+            page_no_ = RM_NO_PAGE;
+        }
+    }
+};
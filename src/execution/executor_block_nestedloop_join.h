@@ -0,0 +1,189 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "execution_defs.h"
+#include "executor_abstract.h"
+#include "predicate.h"
+
+constexpr size_t BLOCK_NLJ_MEM_BUDGET = 4 << 20;  // 一块外侧记录最多占用的内存
+
+/**
+ * @brief 块嵌套循环连接：把左子节点（外侧）的记录按内存预算分块读入一段连续的缓冲区，
+ * 每块只扫描一遍右子节点（内侧），每条右记录与块中的所有左记录比较，内侧的扫描次数从外侧记录数降为块数。
+ * 连接条件编译为谓词程序，直接对左右两条记录求值，只有满足条件的一对记录才写出连接结果。
+ * 用于没有可用等值条件的连接；输出记录为左记录接右记录，不保持左侧的顺序
+ */
+class BlockNestedLoopJoinExecutor : public AbstractExecutor {
+   private:
+    std::unique_ptr<AbstractExecutor> left_;    // 左儿子节点（外侧）
+    std::unique_ptr<AbstractExecutor> right_;   // 右儿子节点（内侧）
+    size_t len_;                                // join后获得的每条记录的长度
+    std::vector<ColMeta> cols_;                 // join后获得的记录的字段
+    std::vector<Condition> fed_conds_;          // join条件
+    Predicate pred_;                            // 由fed_conds_编译出的谓词程序
+    size_t block_rows_max_;                     // 一块最多容纳的左记录数
+
+    // 当前块：block_中依次存放block_rows_条左记录；下一对待比较的是第block_idx_条左记录与right_batch_中第right_idx_个有效行
+    std::vector<char> block_;
+    size_t block_rows_ = 0;
+    size_t block_idx_ = 0;
+    TupleBatch right_batch_;
+    int right_idx_ = 0;
+    size_t num_blocks_ = 0;                     // 读入过的块数，即扫描右子节点的次数
+
+    // 左子节点中尚未放入块的记录为left_batch_中第left_idx_个有效行之后的行
+    TupleBatch left_batch_;
+    int left_idx_ = 0;
+    bool left_done_ = false;
+    bool end_ = true;
+    std::unique_ptr<RmRecord> record_;          // 当前的连接结果
+
+   public:
+    BlockNestedLoopJoinExecutor(std::unique_ptr<AbstractExecutor> left, std::unique_ptr<AbstractExecutor> right,
+                                std::vector<Condition> conds, size_t mem_budget = BLOCK_NLJ_MEM_BUDGET) {
+        left_ = std::move(left);
+        right_ = std::move(right);
+        len_ = left_->tupleLen() + right_->tupleLen();
+        cols_ = left_->cols();
+        auto right_cols = right_->cols();
+        for (auto &col : right_cols) {
+            col.offset += left_->tupleLen();
+        }
+        cols_.insert(cols_.end(), right_cols.begin(), right_cols.end());
+        fed_conds_ = std::move(conds);
+        block_rows_max_ = std::max<size_t>(mem_budget / left_->tupleLen(), 1);
+        record_ = std::make_unique<RmRecord>(len_);
+    }
+
+    std::string getType() override { return "BlockNestedLoopJoin"; }
+
+    size_t tupleLen() const override { return len_; }
+
+    const std::vector<ColMeta> &cols() const override { return cols_; }
+
+    void beginTuple() override {
+        open();
+        nextTuple();
+    }
+
+    void nextTuple() override {
+        const char *left_row, *right_row;
+        end_ = !next_pair(&left_row, &right_row);
+        if (!end_) {
+            memcpy(record_->data, left_row, left_->tupleLen());
+            memcpy(record_->data + left_->tupleLen(), right_row, right_->tupleLen());
+        }
+    }
+
+    bool is_end() const override { return end_; }
+
+    std::unique_ptr<RmRecord> Next() override {
+        assert(!is_end());
+        return std::make_unique<RmRecord>(*record_);
+    }
+
+    void beginBatch() override {
+        open();
+        end_ = false;
+    }
+
+    /* 满足条件的一对记录直接写入batch */
+    bool NextBatch(TupleBatch &batch) override {
+        batch.reset(len_);
+        const char *left_row, *right_row;
+        while (!batch.full() && next_pair(&left_row, &right_row)) {
+            char *out = batch.append();
+            memcpy(out, left_row, left_->tupleLen());
+            memcpy(out + left_->tupleLen(), right_row, right_->tupleLen());
+        }
+        return batch.num_rows() > 0;
+    }
+
+    bool may_contain(const TabCol &col, const char *val, int len) override {
+        return join_may_contain(left_.get(), right_.get(), col, val, len);
+    }
+
+    Rid &rid() override { return _abstract_rid; }
+
+    size_t get_num_blocks() const { return num_blocks_; }
+
+   private:
+    void open() {
+        pred_.compile(cols_, fed_conds_);
+        left_->beginBatch();
+        left_batch_.reset(left_->tupleLen());
+        left_idx_ = 0;
+        left_done_ = false;
+        block_.reserve(std::min<size_t>(block_rows_max_, TUPLE_BATCH_SIZE) * left_->tupleLen());
+        block_rows_ = 0;
+        block_idx_ = 0;
+        right_batch_.reset(right_->tupleLen());
+        right_idx_ = 0;
+        num_blocks_ = 0;
+    }
+
+    /* 找到下一对满足连接条件的记录；当前块与右子节点比较完时读入下一块并从头扫描右子节点，左子节点读完时返回false */
+    bool next_pair(const char **left_row, const char **right_row) {
+        size_t left_len = left_->tupleLen();
+        while (true) {
+            while (right_idx_ < right_batch_.size()) {
+                const char *right = right_batch_.row(right_idx_);
+                while (block_idx_ < block_rows_) {
+                    const char *left = block_.data() + block_idx_ * left_len;
+                    block_idx_++;
+                    if (pred_.eval(left, right, left_len)) {
+                        *left_row = left;
+                        *right_row = right;
+                        return true;
+                    }
+                }
+                block_idx_ = 0;
+                right_idx_++;
+            }
+            right_idx_ = 0;
+            if (block_rows_ > 0 && right_->NextBatch(right_batch_)) {
+                continue;
+            }
+            if (!load_block()) {
+                return false;
+            }
+            right_->beginBatch();
+            right_batch_.reset(right_->tupleLen());
+        }
+    }
+
+    /* 把左子节点接下来的记录依次复制到块中，直到块满或左子节点读完；没有记录时返回false */
+    bool load_block() {
+        size_t left_len = left_->tupleLen();
+        block_.clear();
+        block_rows_ = 0;
+        block_idx_ = 0;
+        while (block_rows_ < block_rows_max_) {
+            if (left_idx_ >= left_batch_.size()) {
+                if (left_done_ || !left_->NextBatch(left_batch_)) {
+                    left_done_ = true;
+                    break;
+                }
+                left_idx_ = 0;
+                continue;
+            }
+            const char *row = left_batch_.row(left_idx_++);
+            block_.insert(block_.end(), row, row + left_len);
+            block_rows_++;
+        }
+        if (block_rows_ == 0) {
+            return false;
+        }
+        num_blocks_++;
+        return true;
+    }
+};
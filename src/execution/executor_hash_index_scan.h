@@ -0,0 +1,74 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "executor_index_scan.h"
+
+/**
+ * @brief 哈希索引扫描：索引的每个字段上都有与常量的等值条件，用这些值拼出key做一次点查，再由谓词程序过滤其余条件
+ */
+class HashIndexScanExecutor : public IndexScanExecutor {
+   private:
+    IxHashIndexHandle *hh_;         // 哈希索引句柄
+    std::vector<Rid> rids_;         // 点查得到的记录位置
+    size_t pos_;                    // 当前记录在rids_中的下标
+
+   public:
+    HashIndexScanExecutor(SmManager *sm_manager, std::string tab_name, std::vector<Condition> conds,
+                          std::vector<std::string> index_col_names, Context *context)
+        : IndexScanExecutor(sm_manager, std::move(tab_name), std::move(conds), std::move(index_col_names), context) {
+        hh_ = sm_manager_->hhs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index_col_names_)).get();
+        pos_ = 0;
+    }
+
+    std::string getType() override { return "HashIndexScan"; }
+
+    bool is_end() const override { return pos_ >= rids_.size(); }
+
+    void beginTuple() override {
+        check_runtime_conds();
+        pred_.compile(cols_, fed_conds_);
+
+        rids_.clear();
+        pos_ = 0;
+        auto key = std::make_unique<char[]>(index_meta_.col_tot_len);
+        int offset = 0;
+        for (auto &col : index_meta_.cols) {
+            auto cond = std::find_if(fed_conds_.begin(), fed_conds_.end(), [&](const Condition &cond) {
+                return cond.is_rhs_val && cond.op == OP_EQ && cond.lhs_col.col_name == col.name;
+            });
+            assert(cond != fed_conds_.end());
+            memcpy(key.get() + offset, cond->rhs_val.raw->data, col.len);
+            offset += col.len;
+        }
+        hh_->get_value(key.get(), &rids_, context_ == nullptr ? nullptr : context_->txn_);
+        seek();
+    }
+
+    void nextTuple() override {
+        check_runtime_conds();
+        assert(!is_end());
+        pos_++;
+        seek();
+    }
+
+   private:
+    // 从pos_开始找到第一个满足fed_conds_的记录
+    void seek() {
+        for (; pos_ < rids_.size(); pos_++) {
+            auto rec = fh_->get_record(rids_[pos_], context_);
+            if (pred_.eval(rec->data)) {
+                rid_ = rids_[pos_];
+                return;
+            }
+        }
+    }
+};
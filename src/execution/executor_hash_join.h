@@ -0,0 +1,434 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <string_view>
+
+#include "execution_defs.h"
+#include "executor_abstract.h"
+#include "predicate.h"
+#include "spill_file.h"
+
+constexpr size_t HASH_JOIN_MEM_BUDGET = 64 << 20;  // 哈希表（建表一侧的记录、key和桶）最多占用的内存
+constexpr int HASH_JOIN_PARTITION_BITS = 5;        // 溢出时每层按哈希值的5位分成32个分区
+constexpr int HASH_JOIN_MAX_LEVEL = 3;             // 分区最多划分的层数，之后即使超出预算也在内存中建表
+
+/**
+ * @brief 哈希连接：在一个子节点（建表一侧）的所有记录上按等值连接字段建立哈希表，再逐条读取另一个子节点（探测一侧）查找匹配的记录
+ * 连接key由各等值条件的字段依次拼接而成，定长；字符串按两侧较长的长度补0，浮点数的-0.0按0.0存放，相等的值key的字节也相同。
+ * 建表一侧超出内存预算时按grace hash join处理：两侧都按key的哈希值划分到临时文件中，再逐个分区建表和探测，
+ * 分区仍然过大时继续按哈希值的其他位划分；划分探测一侧时先用建表一侧的Bloom过滤器检查连接字段，一定没有匹配的探测记录不写入分区。
+ * 输出记录的布局为左记录接右记录
+ */
+class HashJoinExecutor : public AbstractExecutor {
+   private:
+    struct Partition {
+        std::unique_ptr<SpillFile> build;
+        std::unique_ptr<SpillFile> probe;
+        int level;                                  // 划分的层数，决定下一次划分使用哈希值的哪几位
+    };
+
+    std::unique_ptr<AbstractExecutor> left_;        // 左儿子节点
+    std::unique_ptr<AbstractExecutor> right_;       // 右儿子节点
+    AbstractExecutor *build_;                       // 建表一侧
+    AbstractExecutor *probe_;                       // 探测一侧
+    size_t len_;                                    // join后获得的每条记录的长度
+    std::vector<ColMeta> cols_;                     // join后获得的记录的字段
+    std::vector<Condition> fed_conds_;              // join条件
+    bool build_left_;                               // 在左儿子上建表
+    size_t mem_budget_;
+
+    // 第i个等值条件在建表一侧和探测一侧的字段，在key中占key_lens_[i]字节
+    std::vector<ColMeta> build_keys_;
+    std::vector<ColMeta> probe_keys_;
+    std::vector<int> key_lens_;
+    size_t key_len_ = 0;
+    Predicate pred_;                                // 其余连接条件，对连接结果求值
+
+    // 哈希表：第i条建表记录存放在build_rows_中，其key和哈希值分别在keys_和hashes_中；
+    // buckets_[hash & bucket_mask_]为桶中最后加入的记录，next_[i]为同一桶中在它之前加入的记录，-1表示没有
+    std::vector<char> build_rows_;
+    std::vector<char> keys_;
+    std::vector<uint64_t> hashes_;
+    std::vector<int> buckets_;
+    std::vector<int> next_;
+    size_t bucket_mask_ = 0;
+
+    std::vector<Partition> partitions_;             // 尚未处理的分区
+    std::unique_ptr<SpillFile> probe_file_;         // 当前分区的探测一侧，为空时直接从探测子节点读取
+    size_t num_partitions_ = 0;                     // 处理过的分区数，没有溢出时为0
+    size_t num_bloom_skipped_ = 0;                  // 划分时因建表一侧的Bloom过滤器跳过的探测记录数
+
+    // 探测状态：当前探测记录为probe_batch_中第probe_idx_个有效行，match_为哈希表中下一条待比较的记录
+    TupleBatch probe_batch_;
+    int probe_idx_ = -1;
+    std::vector<char> probe_key_;
+    uint64_t probe_hash_ = 0;
+    int match_ = -1;
+    bool end_ = true;
+    std::unique_ptr<RmRecord> record_;              // 当前的连接结果
+
+   public:
+    HashJoinExecutor(std::unique_ptr<AbstractExecutor> left, std::unique_ptr<AbstractExecutor> right,
+                     std::vector<Condition> conds, bool build_left = false, size_t mem_budget = HASH_JOIN_MEM_BUDGET) {
+        left_ = std::move(left);
+        right_ = std::move(right);
+        build_left_ = build_left;
+        build_ = build_left_ ? left_.get() : right_.get();
+        probe_ = build_left_ ? right_.get() : left_.get();
+        mem_budget_ = mem_budget;
+        len_ = left_->tupleLen() + right_->tupleLen();
+        cols_ = left_->cols();
+        auto right_cols = right_->cols();
+        for (auto &col : right_cols) {
+            col.offset += left_->tupleLen();
+        }
+        cols_.insert(cols_.end(), right_cols.begin(), right_cols.end());
+        fed_conds_ = std::move(conds);
+
+        std::vector<Condition> residual_conds;
+        for (auto &cond : fed_conds_) {
+            if (!add_key(cond)) {
+                residual_conds.push_back(cond);
+            }
+        }
+        if (build_keys_.empty()) {
+            throw InternalError("Hash join requires an equality condition between its children");
+        }
+        pred_.compile(cols_, residual_conds);
+        probe_key_.resize(key_len_);
+        record_ = std::make_unique<RmRecord>(len_);
+    }
+
+    std::string getType() override { return "HashJoin"; }
+
+    size_t tupleLen() const override { return len_; }
+
+    const std::vector<ColMeta> &cols() const override { return cols_; }
+
+    void beginTuple() override {
+        open();
+        if (!end_) {
+            find_match();
+        }
+    }
+
+    void nextTuple() override {
+        assert(!is_end());
+        find_match();
+    }
+
+    bool is_end() const override { return end_; }
+
+    std::unique_ptr<RmRecord> Next() override {
+        assert(!is_end());
+        return std::make_unique<RmRecord>(*record_);
+    }
+
+    bool NextBatch(TupleBatch &batch) override {
+        batch.reset(len_);
+        for (; !is_end() && !batch.full(); nextTuple()) {
+            batch.append(record_->data);
+        }
+        return batch.num_rows() > 0;
+    }
+
+    bool may_contain(const TabCol &col, const char *val, int len) override {
+        return join_may_contain(left_.get(), right_.get(), col, val, len);
+    }
+
+    Rid &rid() override { return _abstract_rid; }
+
+    size_t get_num_partitions() const { return num_partitions_; }
+
+    size_t get_num_bloom_skipped() const { return num_bloom_skipped_; }
+
+   private:
+    /* 两侧字段分属左右儿子、类型相同的等值条件作为连接key */
+    bool add_key(const Condition &cond) {
+        const ColMeta *left_col, *right_col;
+        if (!get_join_key(left_->cols(), right_->cols(), cond, &left_col, &right_col)) {
+            return false;
+        }
+        build_keys_.push_back(build_left_ ? *left_col : *right_col);
+        probe_keys_.push_back(build_left_ ? *right_col : *left_col);
+        key_lens_.push_back(std::max(left_col->len, right_col->len));
+        key_len_ += key_lens_.back();
+        return true;
+    }
+
+    /* 读取建表一侧，内存足够时直接建表，否则把两侧都划分到临时文件中 */
+    void open() {
+        clear_table();
+        partitions_.clear();
+        probe_file_.reset();
+        num_partitions_ = 0;
+        num_bloom_skipped_ = 0;
+        probe_batch_.reset(probe_->tupleLen());
+        probe_idx_ = -1;
+        match_ = -1;
+        end_ = false;
+
+        std::vector<std::unique_ptr<SpillFile>> build_parts;
+        std::vector<char> key(key_len_);
+        TupleBatch batch;
+        build_->beginBatch();
+        while (build_->NextBatch(batch)) {
+            for (int i = 0; i < batch.size(); i++) {
+                if (!build_parts.empty()) {
+                    build_parts[partition_of(hash_key(batch.row(i), build_keys_, key.data()), 0)]->append(batch.row(i));
+                    continue;
+                }
+                add_build_row(batch.row(i));
+                if (table_bytes() > mem_budget_) {
+                    // 超出预算，已读入的记录连同之后的记录一起写入分区
+                    build_parts = make_parts(build_->tupleLen());
+                    for (size_t j = 0; j < hashes_.size(); j++) {
+                        build_parts[partition_of(hashes_[j], 0)]->append(build_row(j));
+                    }
+                    clear_table();
+                }
+            }
+        }
+        if (build_parts.empty()) {
+            if (hashes_.empty()) {
+                end_ = true;  // 建表一侧为空，不必读取探测一侧
+                return;
+            }
+            build_index();
+            probe_->beginBatch();
+            return;
+        }
+
+        // 写入分区的代价较高，建表一侧一定没有的连接key不写入
+        auto probe_parts = make_parts(probe_->tupleLen());
+        probe_->beginBatch();
+        while (probe_->NextBatch(batch)) {
+            for (int i = 0; i < batch.size(); i++) {
+                if (!build_may_match(batch.row(i))) {
+                    num_bloom_skipped_++;
+                    continue;
+                }
+                probe_parts[partition_of(hash_key(batch.row(i), probe_keys_, key.data()), 0)]->append(batch.row(i));
+            }
+        }
+        add_partitions(std::move(build_parts), std::move(probe_parts), 0);
+        if (!next_partition()) {
+            end_ = true;
+        }
+    }
+
+    /* 从当前位置开始找到下一对满足所有连接条件的记录，写入record_；没有时end_置为true */
+    void find_match() {
+        while (true) {
+            while (match_ != -1) {
+                int i = match_;
+                match_ = next_[i];
+                if (hashes_[i] != probe_hash_ || memcmp(keys_.data() + i * key_len_, probe_key_.data(), key_len_) != 0) {
+                    continue;
+                }
+                const char *probe_row = probe_batch_.row(probe_idx_);
+                const char *left_row = build_left_ ? build_row(i) : probe_row;
+                const char *right_row = build_left_ ? probe_row : build_row(i);
+                memcpy(record_->data, left_row, left_->tupleLen());
+                memcpy(record_->data + left_->tupleLen(), right_row, right_->tupleLen());
+                if (pred_.eval(record_->data)) {
+                    return;
+                }
+            }
+            if (!next_probe_row()) {
+                end_ = true;
+                return;
+            }
+        }
+    }
+
+    /* 移到下一条探测记录并找到其所在的桶，当前分区读完时转到下一个分区 */
+    bool next_probe_row() {
+        while (true) {
+            if (probe_idx_ + 1 < probe_batch_.size()) {
+                probe_idx_++;
+                probe_hash_ = hash_key(probe_batch_.row(probe_idx_), probe_keys_, probe_key_.data());
+                match_ = buckets_[probe_hash_ & bucket_mask_];
+                return true;
+            }
+            probe_idx_ = -1;
+            if (probe_file_ != nullptr) {
+                probe_batch_.reset(probe_file_->row_len());
+                probe_batch_.commit(probe_file_->read(probe_batch_.free_space(), probe_batch_.free_rows()));
+                if (probe_batch_.num_rows() > 0) {
+                    continue;
+                }
+            } else if (probe_->NextBatch(probe_batch_)) {
+                continue;
+            }
+            if (!next_partition()) {
+                return false;
+            }
+        }
+    }
+
+    /* 取出下一个分区建表，分区过大时继续划分；没有剩余分区时返回false */
+    bool next_partition() {
+        while (!partitions_.empty()) {
+            Partition part = std::move(partitions_.back());
+            partitions_.pop_back();
+            part.build->rewind();
+            part.probe->rewind();
+            if (part.build->num_rows() * row_bytes() > mem_budget_ && part.level + 1 < HASH_JOIN_MAX_LEVEL) {
+                split(std::move(part));
+                continue;
+            }
+            num_partitions_++;
+            clear_table();
+            TupleBatch batch;
+            while (read_file(part.build.get(), batch)) {
+                for (int i = 0; i < batch.size(); i++) {
+                    add_build_row(batch.row(i));
+                }
+            }
+            build_index();
+            probe_file_ = std::move(part.probe);
+            probe_batch_.reset(probe_file_->row_len());
+            probe_idx_ = -1;
+            match_ = -1;
+            return true;
+        }
+        probe_file_.reset();
+        return false;
+    }
+
+    /* 按哈希值的下一层位把分区的两侧划分为更小的分区 */
+    void split(Partition part) {
+        std::vector<char> key(key_len_);
+        TupleBatch batch;
+        auto build_parts = make_parts(build_->tupleLen());
+        while (read_file(part.build.get(), batch)) {
+            for (int i = 0; i < batch.size(); i++) {
+                uint64_t hash = hash_key(batch.row(i), build_keys_, key.data());
+                build_parts[partition_of(hash, part.level + 1)]->append(batch.row(i));
+            }
+        }
+        auto probe_parts = make_parts(probe_->tupleLen());
+        while (read_file(part.probe.get(), batch)) {
+            for (int i = 0; i < batch.size(); i++) {
+                uint64_t hash = hash_key(batch.row(i), probe_keys_, key.data());
+                probe_parts[partition_of(hash, part.level + 1)]->append(batch.row(i));
+            }
+        }
+        add_partitions(std::move(build_parts), std::move(probe_parts), part.level + 1);
+    }
+
+    /* 只保留两侧都有记录的分区，其余分区不会产生连接结果 */
+    void add_partitions(std::vector<std::unique_ptr<SpillFile>> build_parts,
+                        std::vector<std::unique_ptr<SpillFile>> probe_parts, int level) {
+        for (size_t i = 0; i < build_parts.size(); i++) {
+            if (build_parts[i]->num_rows() > 0 && probe_parts[i]->num_rows() > 0) {
+                partitions_.push_back({std::move(build_parts[i]), std::move(probe_parts[i]), level});
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<SpillFile>> make_parts(size_t row_len) {
+        std::vector<std::unique_ptr<SpillFile>> parts(1 << HASH_JOIN_PARTITION_BITS);
+        for (auto &part : parts) {
+            part = std::make_unique<SpillFile>(row_len);
+        }
+        return parts;
+    }
+
+    /* 探测记录的每个连接字段的值都可能在建表一侧出现时返回true */
+    bool build_may_match(const char *probe_row) {
+        for (size_t i = 0; i < build_keys_.size(); i++) {
+            auto &probe_key = probe_keys_[i];
+            TabCol build_col = {build_keys_[i].tab_name, build_keys_[i].name};
+            if (!build_->may_contain(build_col, probe_row + probe_key.offset, probe_key.len)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* 第level层的分区号取哈希值从高位开始的第level组位，桶号取低位，两者互不相关 */
+    static size_t partition_of(uint64_t hash, int level) {
+        return (hash >> (64 - HASH_JOIN_PARTITION_BITS * (level + 1))) & ((1 << HASH_JOIN_PARTITION_BITS) - 1);
+    }
+
+    static bool read_file(SpillFile *file, TupleBatch &batch) {
+        batch.reset(file->row_len());
+        batch.commit(file->read(batch.free_space(), batch.free_rows()));
+        return batch.num_rows() > 0;
+    }
+
+    /* 把记录row中key_cols的值依次拼接成key，返回key的哈希值 */
+    uint64_t hash_key(const char *row, const std::vector<ColMeta> &key_cols, char *key) const {
+        char *dest = key;
+        for (size_t i = 0; i < key_cols.size(); i++) {
+            auto &col = key_cols[i];
+            const char *val = row + col.offset;
+            if (col.type == TYPE_STRING) {
+                size_t n = strnlen(val, col.len);
+                memcpy(dest, val, n);
+                memset(dest + n, 0, key_lens_[i] - n);
+            } else if (col.type == TYPE_FLOAT) {
+                float f;
+                memcpy(&f, val, sizeof(float));
+                if (f == 0) {
+                    f = 0;
+                }
+                memcpy(dest, &f, sizeof(float));
+            } else {
+                memcpy(dest, val, col.len);
+            }
+            dest += key_lens_[i];
+        }
+        return std::hash<std::string_view>()(std::string_view(key, key_len_));
+    }
+
+    void add_build_row(const char *row) {
+        size_t i = hashes_.size();
+        build_rows_.insert(build_rows_.end(), row, row + build_->tupleLen());
+        keys_.resize(keys_.size() + key_len_);
+        hashes_.push_back(hash_key(row, build_keys_, keys_.data() + i * key_len_));
+    }
+
+    const char *build_row(size_t i) const { return build_rows_.data() + i * build_->tupleLen(); }
+
+    /* 桶数为不小于记录数两倍的2的幂 */
+    void build_index() {
+        size_t num_buckets = 1;
+        while (num_buckets < hashes_.size() * 2) {
+            num_buckets <<= 1;
+        }
+        buckets_.assign(num_buckets, -1);
+        bucket_mask_ = num_buckets - 1;
+        next_.resize(hashes_.size());
+        for (size_t i = 0; i < hashes_.size(); i++) {
+            int &head = buckets_[hashes_[i] & bucket_mask_];
+            next_[i] = head;
+            head = (int)i;
+        }
+    }
+
+    void clear_table() {
+        build_rows_.clear();
+        keys_.clear();
+        hashes_.clear();
+        buckets_.assign(1, -1);
+        next_.clear();
+        bucket_mask_ = 0;
+    }
+
+    /* 每条建表记录在哈希表中占用的内存，桶按两个计算 */
+    size_t row_bytes() const { return build_->tupleLen() + key_len_ + sizeof(uint64_t) + 3 * sizeof(int); }
+
+    size_t table_bytes() const { return hashes_.size() * row_bytes(); }
+};
@@ -0,0 +1,245 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "execution_defs.h"
+#include "execution_manager.h"
+#include "executor_abstract.h"
+#include "index/ix.h"
+#include "predicate.h"
+#include "system/sm.h"
+
+/**
+ * @brief 索引嵌套循环连接：内表在连接字段上有B+树索引时，用外侧每条记录中连接字段的值直接拼成索引key，
+ * 在内表索引中点查匹配的rid再回表，不重新扫描内表。
+ * 索引的每个字段都要由一个与外侧字段的等值条件或一个与常量的等值条件确定；内表上的其余条件和其余连接条件
+ * 由谓词程序对连接结果求值。批量探测时一次读取外侧的一批记录，用get_values_batch按key顺序一起查找。
+ * 输出记录的布局为外侧记录接内表记录
+ */
+class IndexNestedLoopJoinExecutor : public AbstractExecutor {
+   private:
+    // 索引key中的一个字段：取自外侧记录的outer_offset处，或取自常量
+    struct KeyPart {
+        bool from_outer;
+        int outer_offset;
+        int outer_len;
+        int len;                                // 索引字段的长度
+        ColType type;
+        std::vector<char> value;                // 常量字段的值
+    };
+
+    std::unique_ptr<AbstractExecutor> outer_;   // 外侧子节点
+    std::string tab_name_;                      // 内表名称
+    RmFileHandle *fh_;                          // 内表的数据文件句柄
+    IxIndexHandle *ih_;                         // 内表连接字段上的B+树索引句柄
+    size_t inner_len_;                          // 内表记录的长度
+    size_t len_;                                // join后获得的每条记录的长度
+    std::vector<ColMeta> cols_;                 // join后获得的记录的字段
+    std::vector<Condition> fed_conds_;          // 内表上的条件和join条件
+    std::vector<KeyPart> key_parts_;
+    int key_len_ = 0;
+    Predicate pred_;                            // 由fed_conds_编译出的谓词程序，对连接结果求值
+    bool batch_probes_;                         // 是否批量探测索引
+
+    // 外侧当前批次的记录及其在索引中匹配的rid，当前为第outer_idx_条外侧记录的第rid_idx_个rid
+    TupleBatch outer_batch_;
+    std::vector<char> keys_;
+    std::vector<std::vector<Rid>> matches_;
+    int outer_idx_ = 0;
+    size_t rid_idx_ = 0;
+    bool end_ = true;
+    std::unique_ptr<RmRecord> record_;          // 当前的连接结果
+
+   public:
+    IndexNestedLoopJoinExecutor(SmManager *sm_manager, std::unique_ptr<AbstractExecutor> outer, std::string tab_name,
+                                std::vector<Condition> inner_conds, std::vector<Condition> conds,
+                                const std::vector<std::string> &index_col_names, Context *context,
+                                bool batch_probes = true) {
+        context_ = context;
+        outer_ = std::move(outer);
+        tab_name_ = std::move(tab_name);
+        batch_probes_ = batch_probes;
+        TabMeta &tab = sm_manager->db_.get_table(tab_name_);
+        fh_ = sm_manager->fhs_.at(tab_name_).get();
+        ih_ = sm_manager->ihs_.at(sm_manager->get_ix_manager()->get_index_name(tab_name_, index_col_names)).get();
+        inner_len_ = tab.cols.back().offset + tab.cols.back().len;
+        len_ = outer_->tupleLen() + inner_len_;
+        cols_ = outer_->cols();
+        for (auto col : tab.cols) {
+            col.offset += outer_->tupleLen();
+            cols_.push_back(col);
+        }
+        fed_conds_ = std::move(inner_conds);
+        fed_conds_.insert(fed_conds_.end(), conds.begin(), conds.end());
+
+        for (auto &index_col : tab.get_index_meta(index_col_names)->cols) {
+            if (!add_key_part(index_col)) {
+                throw InternalError("Index nested loop join requires an equality condition on every index column");
+            }
+            key_len_ += index_col.len;
+        }
+        record_ = std::make_unique<RmRecord>(len_);
+    }
+
+    std::string getType() override { return "IndexNestedLoopJoin"; }
+
+    size_t tupleLen() const override { return len_; }
+
+    const std::vector<ColMeta> &cols() const override { return cols_; }
+
+    void beginTuple() override {
+        pred_.compile(cols_, fed_conds_);
+        outer_->beginBatch();
+        outer_batch_.reset(outer_->tupleLen());
+        matches_.clear();
+        outer_idx_ = 0;
+        rid_idx_ = 0;
+        end_ = false;
+        find_match();
+    }
+
+    void nextTuple() override {
+        assert(!is_end());
+        find_match();
+    }
+
+    bool is_end() const override { return end_; }
+
+    std::unique_ptr<RmRecord> Next() override {
+        assert(!is_end());
+        return std::make_unique<RmRecord>(*record_);
+    }
+
+    bool NextBatch(TupleBatch &batch) override {
+        batch.reset(len_);
+        for (; !is_end() && !batch.full(); nextTuple()) {
+            batch.append(record_->data);
+        }
+        return batch.num_rows() > 0;
+    }
+
+    bool may_contain(const TabCol &col, const char *val, int len) override {
+        if (col.tab_name != tab_name_) {
+            return outer_->may_contain(col, val, len);
+        }
+        return true;
+    }
+
+    Rid &rid() override { return _abstract_rid; }
+
+   private:
+    /* 为索引字段index_col找到确定它的值的等值条件：优先使用与外侧字段的连接条件，其次使用内表上与常量的条件 */
+    bool add_key_part(const ColMeta &index_col) {
+        auto is_index_col = [&](const TabCol &col) {
+            return col.tab_name == tab_name_ && col.col_name == index_col.name;
+        };
+        for (auto &cond : fed_conds_) {
+            if (cond.is_rhs_val || cond.op != OP_EQ) {
+                continue;
+            }
+            const TabCol *other = is_index_col(cond.lhs_col) ? &cond.rhs_col
+                                  : is_index_col(cond.rhs_col) ? &cond.lhs_col
+                                                               : nullptr;
+            const ColMeta *outer_col = other == nullptr ? nullptr : find_col(outer_->cols(), *other);
+            if (outer_col != nullptr && outer_col->type == index_col.type) {
+                key_parts_.push_back({true, outer_col->offset, outer_col->len, index_col.len, index_col.type, {}});
+                return true;
+            }
+        }
+        for (auto &cond : fed_conds_) {
+            if (cond.is_rhs_val && cond.op == OP_EQ && is_index_col(cond.lhs_col) && cond.rhs_val.type == index_col.type) {
+                const char *val = cond.rhs_val.raw->data;
+                key_parts_.push_back({false, 0, 0, index_col.len, index_col.type, std::vector<char>(val, val + index_col.len)});
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* 从当前位置开始找到下一对满足所有连接条件的记录，写入record_；没有时end_置为true */
+    void find_match() {
+        while (true) {
+            while (outer_idx_ < (int)matches_.size()) {
+                auto &rids = matches_[outer_idx_];
+                while (rid_idx_ < rids.size()) {
+                    auto inner = fh_->get_record(rids[rid_idx_++], context_);
+                    memcpy(record_->data, outer_batch_.row(outer_idx_), outer_->tupleLen());
+                    memcpy(record_->data + outer_->tupleLen(), inner->data, inner_len_);
+                    if (pred_.eval(record_->data)) {
+                        return;
+                    }
+                }
+                outer_idx_++;
+                rid_idx_ = 0;
+            }
+            if (!outer_->NextBatch(outer_batch_)) {
+                end_ = true;
+                return;
+            }
+            probe();
+        }
+    }
+
+    /* 为外侧当前批次的每条记录在索引中查找匹配的rid */
+    void probe() {
+        int n = outer_batch_.size();
+        matches_.assign(n, std::vector<Rid>());
+        outer_idx_ = 0;
+        rid_idx_ = 0;
+        keys_.resize((size_t)n * key_len_);
+        std::vector<const char *> probe_keys;
+        std::vector<int> probe_rows;
+        for (int i = 0; i < n; i++) {
+            char *key = keys_.data() + (size_t)i * key_len_;
+            if (make_key(outer_batch_.row(i), key)) {
+                probe_keys.push_back(key);
+                probe_rows.push_back(i);
+            }
+        }
+        if (!batch_probes_) {
+            for (size_t i = 0; i < probe_keys.size(); i++) {
+                ih_->get_value(probe_keys[i], &matches_[probe_rows[i]], context_txn());
+            }
+            return;
+        }
+        std::vector<std::vector<Rid>> results(probe_keys.size());
+        ih_->get_values_batch(probe_keys.data(), probe_keys.size(), results.data(), context_txn());
+        for (size_t i = 0; i < probe_keys.size(); i++) {
+            matches_[probe_rows[i]] = std::move(results[i]);
+        }
+    }
+
+    /**
+     * @brief 由外侧记录row拼出索引key，字符串按索引字段的长度截断或补0；
+     * 外侧字符串比索引字段长且超出部分非空时不可能相等，返回false
+     */
+    bool make_key(const char *row, char *key) const {
+        for (auto &part : key_parts_) {
+            if (!part.from_outer) {
+                memcpy(key, part.value.data(), part.len);
+            } else if (part.type != TYPE_STRING || part.outer_len == part.len) {
+                memcpy(key, row + part.outer_offset, part.len);
+            } else {
+                const char *val = row + part.outer_offset;
+                int n = std::min(part.outer_len, part.len);
+                if (std::any_of(val + n, val + part.outer_len, [](char c) { return c != 0; })) {
+                    return false;
+                }
+                memcpy(key, val, n);
+                memset(key + n, 0, part.len - n);
+            }
+            key += part.len;
+        }
+        return true;
+    }
+
+    Transaction *context_txn() const { return context_ == nullptr ? nullptr : context_->txn_; }
+};
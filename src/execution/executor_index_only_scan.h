@@ -0,0 +1,75 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "executor_index_scan.h"
+
+/**
+ * @brief 覆盖索引扫描：查询用到的字段全部包含在索引中时，直接从叶子结点的key中取值，不再回表读取记录
+ * 输出的元组即索引key的布局，cols_中各字段的offset按索引字段顺序重新计算
+ */
+class IndexOnlyScanExecutor : public IndexScanExecutor {
+   private:
+    std::unique_ptr<RmRecord> key_;             // 当前扫描到的索引key
+
+   public:
+    IndexOnlyScanExecutor(SmManager *sm_manager, std::string tab_name, std::vector<Condition> conds,
+                          std::vector<std::string> index_col_names, Context *context, bool is_desc = false)
+        : IndexScanExecutor(sm_manager, std::move(tab_name), std::move(conds), std::move(index_col_names), context,
+                            is_desc) {
+        cols_.clear();
+        int offset = 0;
+        for (auto col : index_meta_.cols) {
+            col.offset = offset;
+            offset += col.len;
+            cols_.push_back(col);
+        }
+        len_ = index_meta_.col_tot_len;
+        key_ = std::make_unique<RmRecord>(len_);
+    }
+
+    std::string getType() override { return "IndexOnlyScan"; }
+
+    void beginTuple() override {
+        check_runtime_conds();
+        pred_.compile(cols_, fed_conds_);
+
+        Iid lower, upper;
+        get_scan_range(&lower, &upper);
+        scan_ = std::make_unique<IxScan>(ih_, lower, upper, sm_manager_->get_bpm(), is_desc_);
+
+        while (!scan_->is_end()) {
+            ih_->get_key(scan_->iid(), key_->data);
+            if (pred_.eval(key_->data)) {
+                rid_ = scan_->rid();
+                return;
+            }
+            scan_->next();
+        }
+    }
+
+    void nextTuple() override {
+        check_runtime_conds();
+        assert(!is_end());
+        for (scan_->next(); !scan_->is_end(); scan_->next()) {
+            ih_->get_key(scan_->iid(), key_->data);
+            if (pred_.eval(key_->data)) {
+                rid_ = scan_->rid();
+                return;
+            }
+        }
+    }
+
+    std::unique_ptr<RmRecord> Next() override {
+        assert(!is_end());
+        return std::make_unique<RmRecord>(*key_);
+    }
+};
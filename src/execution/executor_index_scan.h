@@ -10,14 +10,17 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <limits>
+
 #include "execution_defs.h"
 #include "execution_manager.h"
 #include "executor_abstract.h"
 #include "index/ix.h"
+#include "predicate.h"
 #include "system/sm.h"
 
 class IndexScanExecutor : public AbstractExecutor {
-   private:
+   protected:
     std::string tab_name_;                      // 表名称
     TabMeta tab_;                               // 表的元数据
     std::vector<Condition> conds_;              // 扫描条件
@@ -25,19 +28,23 @@ class IndexScanExecutor : public AbstractExecutor {
     std::vector<ColMeta> cols_;                 // 需要读取的字段
     size_t len_;                                // 选取出来的一条记录的长度
     std::vector<Condition> fed_conds_;          // 扫描条件，和conds_字段相同
+    Predicate pred_;                            // 由fed_conds_编译出的谓词程序，beginTuple时按cols_编译
 
     std::vector<std::string> index_col_names_;  // index scan涉及到的索引包含的字段
     IndexMeta index_meta_;                      // index scan涉及到的索引元数据
+    IxIndexHandle *ih_;                         // index scan涉及到的索引句柄
+    bool is_desc_;                              // 是否按索引逆序输出，用于ORDER BY ... DESC
 
     Rid rid_;
-    std::unique_ptr<RecScan> scan_;
+    std::unique_ptr<IxScan> scan_;
 
     SmManager *sm_manager_;
 
    public:
     IndexScanExecutor(SmManager *sm_manager, std::string tab_name, std::vector<Condition> conds, std::vector<std::string> index_col_names,
-                    Context *context) {
+                    Context *context, bool is_desc = false) {
         sm_manager_ = sm_manager;
+        is_desc_ = is_desc;
         context_ = context;
         tab_name_ = std::move(tab_name);
         tab_ = sm_manager_->db_.get_table(tab_name_);
@@ -45,6 +52,10 @@ class IndexScanExecutor : public AbstractExecutor {
         // index_no_ = index_no;
         index_col_names_ = index_col_names; 
         index_meta_ = *(tab_.get_index_meta(index_col_names_));
+        // 哈希索引由HashIndexScanExecutor使用各自的句柄
+        ih_ = index_meta_.type == INDEX_BTREE
+                  ? sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index_col_names_)).get()
+                  : nullptr;
         fh_ = sm_manager_->fhs_.at(tab_name_).get();
         cols_ = tab_.cols;
         len_ = cols_.back().offset + cols_.back().len;
@@ -64,52 +75,45 @@ class IndexScanExecutor : public AbstractExecutor {
         fed_conds_ = conds_;
     }
 
+    const std::vector<ColMeta> &cols() const override { return cols_; }
+
+    bool is_end() const override { return scan_->is_end(); }
+
+    size_t tupleLen() const override { return len_; }
+
+    std::string getType() override { return "IndexScan"; }
+
     void beginTuple() override {
         check_runtime_conds();
+        pred_.compile(cols_, fed_conds_);
 
-    // 获取索引句柄
-    auto ih = sm_manager_->get_ix_manager()->open_index(tab_name_, index_col_names_);
-
-    // 根据扫描条件设置索引扫描的起始和结束位置
-    Iid lower = ih->leaf_begin();
-    Iid upper = ih->leaf_end();
-    for (const auto& cond : fed_conds_) {
-        if (cond.is_rhs_val && cond.lhs_col.col_name == index_col_names_.at(0)) {
-            auto rhs_key = cond.rhs_val.raw->data;
-            if (cond.op == OP_EQ) {
-                lower = ih->lower_bound(rhs_key);
-                upper = ih->upper_bound(rhs_key);
-            } else if (cond.op == OP_LT) {
-                upper = ih->lower_bound(rhs_key);
-            } else if (cond.op == OP_LE) {
-                upper = ih->upper_bound(rhs_key);
-            } else if (cond.op == OP_GT) {
-                lower = ih->upper_bound(rhs_key);
-            } else if (cond.op == OP_GE) {
-                lower = ih->lower_bound(rhs_key);
-            } else {
-                throw InternalError("Unexpected op type");
+        // 根据扫描条件设置索引扫描的起始和结束位置
+        Iid lower, upper;
+        get_scan_range(&lower, &upper);
+        scan_ = std::make_unique<IxScan>(ih_, lower, upper, sm_manager_->get_bpm(), is_desc_);
+
+        // 得到第一个满足fed_conds_条件的record
+        while (!scan_->is_end()) {
+            rid_ = scan_->rid();
+            auto rec = fh_->get_record(rid_, context_);
+            if (pred_.eval(rec->data)) {
+                return;
             }
+            scan_->next();
         }
     }
 
-    // 使用索引的起始和结束位置创建索引扫描器
-    // scan_ = std::make_unique<RecScan>(ih, lower, upper);
-    // rid_ = Rid();
-    }
-
     void nextTuple() override {
         check_runtime_conds();
-    assert(!is_end());
-    for (scan_->next(); !scan_->is_end(); scan_->next()) {
-        std::unique_ptr<RmRecord> record = fh_->get_record(rid_,context_);//尝试验证记录
-        if (eval_conds(cols_, conds_, record.get())) {
+        assert(!is_end());
+        for (scan_->next(); !scan_->is_end(); scan_->next()) {
             rid_ = scan_->rid();
-            return;
+            auto rec = fh_->get_record(rid_, context_);
+            if (pred_.eval(rec->data)) {
+                return;
+            }
         }
     }
-    rid_ = {0,0};
-    }
 
     std::unique_ptr<RmRecord> Next() override {
         assert(!is_end());
@@ -117,43 +121,149 @@ class IndexScanExecutor : public AbstractExecutor {
     }
 
     Rid &rid() override { return rid_; }
- bool eval_cond(const std::vector<ColMeta> &rec_cols, const Condition &cond, const RmRecord *rec) {
-        auto lhs_col = get_col(rec_cols, cond.lhs_col);
-        char *lhs = rec->data + lhs_col->offset;
-        char *rhs;
-        ColType rhs_type;
-        if (cond.is_rhs_val) {
-            rhs_type = cond.rhs_val.type;
-            rhs = cond.rhs_val.raw->data;
-        } else {
-            // rhs is a column
-            auto rhs_col = get_col(rec_cols, cond.rhs_col);
-            rhs_type = rhs_col->type;
-            rhs = rec->data + rhs_col->offset;
+
+    /**
+     * @brief 单字段的B+树索引直接检查索引的Bloom过滤器，否则检查表在col字段上的Bloom过滤器
+     */
+    bool may_contain(const TabCol &col, const char *val, int len) override {
+        if (col.tab_name != tab_name_) {
+            return true;
         }
-        assert(rhs_type == lhs_col->type);  // TODO convert to common type
-        int cmp = ix_compare(lhs, rhs, rhs_type, lhs_col->len);
-        if (cond.op == OP_EQ) {
-            return cmp == 0;
-        } else if (cond.op == OP_NE) {
-            return cmp != 0;
-        } else if (cond.op == OP_LT) {
-            return cmp < 0;
-        } else if (cond.op == OP_GT) {
-            return cmp > 0;
-        } else if (cond.op == OP_LE) {
-            return cmp <= 0;
-        } else if (cond.op == OP_GE) {
-            return cmp >= 0;
-        } else {
-            throw InternalError("Unexpected op type");
+        auto col_meta = get_col(cols_, col);
+        if (ih_ != nullptr && index_meta_.cols.size() == 1 && index_meta_.cols[0].name == col.col_name) {
+            if (col_meta->type == TYPE_STRING && (int)strnlen(val, len) > col_meta->len) {
+                return true;
+            }
+            std::vector<char> key(col_meta->len, 0);
+            memcpy(key.data(), val, std::min(len, col_meta->len));
+            return ih_->may_contain(key.data());
         }
+        fh_->enable_bloom_filter(col_meta->offset, col_meta->type, col_meta->len);
+        return fh_->may_contain(col_meta->offset, BloomFilter::hash_value(val, col_meta->type, len));
     }
 
-    bool eval_conds(const std::vector<ColMeta> &rec_cols, const std::vector<Condition> &conds, const RmRecord *rec) {
-        return std::all_of(conds.begin(), conds.end(),
-                           [&](const Condition &cond) { return eval_cond(rec_cols, cond, rec); });
+    /**
+     * @description: 根据索引字段上与常量比较的条件确定叶子层的扫描范围[lower, upper)
+     * 按最左前缀依次使用各字段上的等值条件，遇到第一个没有等值条件的字段时使用其上最紧的范围条件；
+     * key中未被条件约束的字段用该类型的最小/最大值填充，其余条件仍由谓词程序过滤；
+     * 所有字段上都有等值条件时先检查索引的Bloom过滤器，key一定不存在时不访问B+树；
+     * 规划器也用它估算扫描范围内的记录数
+     */
+    static void get_scan_range(IxIndexHandle *ih, const IndexMeta &index_meta, const std::vector<Condition> &conds,
+                               Iid *lower, Iid *upper) {
+        *lower = ih->leaf_begin();
+        *upper = ih->leaf_end();
+
+        auto lower_key = std::make_unique<char[]>(index_meta.col_tot_len);
+        auto upper_key = std::make_unique<char[]>(index_meta.col_tot_len);
+        bool lower_inclusive = true, upper_inclusive = true;
+        bool all_eq = true;
+        int offset = 0;
+        size_t i = 0;
+        for (; i < index_meta.cols.size(); i++) {
+            const ColMeta &col = index_meta.cols[i];
+            const char *eq_val = nullptr, *lower_val = nullptr, *upper_val = nullptr;
+            for (auto &cond : conds) {
+                if (!cond.is_rhs_val || cond.lhs_col.col_name != col.name) {
+                    continue;
+                }
+                const char *val = cond.rhs_val.raw->data;
+                if (cond.op == OP_EQ) {
+                    if (eq_val != nullptr && ix_compare(eq_val, val, col.type, col.len) != 0) {
+                        // 同一字段上有两个不同的等值条件，范围为空
+                        *lower = *upper;
+                        return;
+                    }
+                    eq_val = val;
+                }
+                if (cond.op == OP_GT || cond.op == OP_GE) {
+                    bool inclusive = cond.op == OP_GE;
+                    int cmp = lower_val == nullptr ? 1 : ix_compare(val, lower_val, col.type, col.len);
+                    if (cmp > 0 || (cmp == 0 && !inclusive)) {
+                        lower_val = val;
+                        lower_inclusive = inclusive;
+                    }
+                }
+                if (cond.op == OP_LT || cond.op == OP_LE) {
+                    bool inclusive = cond.op == OP_LE;
+                    int cmp = upper_val == nullptr ? -1 : ix_compare(val, upper_val, col.type, col.len);
+                    if (cmp < 0 || (cmp == 0 && !inclusive)) {
+                        upper_val = val;
+                        upper_inclusive = inclusive;
+                    }
+                }
+            }
+            if (eq_val != nullptr) {
+                memcpy(lower_key.get() + offset, eq_val, col.len);
+                memcpy(upper_key.get() + offset, eq_val, col.len);
+                offset += col.len;
+                continue;
+            }
+            // 范围字段：排他的下界之后填最大值，排他的上界之后填最小值，使得该值对应的所有key都被跳过
+            all_eq = false;
+            if (lower_val != nullptr) {
+                memcpy(lower_key.get() + offset, lower_val, col.len);
+            } else {
+                fill_key(col, lower_key.get() + offset, false);
+            }
+            if (upper_val != nullptr) {
+                memcpy(upper_key.get() + offset, upper_val, col.len);
+            } else {
+                fill_key(col, upper_key.get() + offset, true);
+            }
+            offset += col.len;
+            i++;
+            break;
+        }
+        if (offset == 0) {
+            // 第一个字段上没有可用的条件，扫描整个叶子层
+            return;
+        }
+        if (all_eq && !ih->may_contain(lower_key.get())) {
+            *lower = *upper;
+            return;
+        }
+        for (; i < index_meta.cols.size(); i++) {
+            const ColMeta &col = index_meta.cols[i];
+            fill_key(col, lower_key.get() + offset, !lower_inclusive);
+            fill_key(col, upper_key.get() + offset, upper_inclusive);
+            offset += col.len;
+        }
+
+        std::vector<ColType> col_types;
+        std::vector<int> col_lens;
+        for (auto &col : index_meta.cols) {
+            col_types.push_back(col.type);
+            col_lens.push_back(col.len);
+        }
+        int cmp = ix_compare(lower_key.get(), upper_key.get(), col_types, col_lens);
+        if (cmp > 0 || (cmp == 0 && !(lower_inclusive && upper_inclusive))) {
+            // 范围为空
+            *lower = *upper;
+            return;
+        }
+        *lower = lower_inclusive ? ih->lower_bound(lower_key.get()) : ih->upper_bound(lower_key.get());
+        *upper = upper_inclusive ? ih->upper_bound(upper_key.get()) : ih->lower_bound(upper_key.get());
+    }
+
+   protected:
+    void get_scan_range(Iid *lower, Iid *upper) { get_scan_range(ih_, index_meta_, fed_conds_, lower, upper); }
+
+    /**
+     * @description: 用字段类型的最小值或最大值填充key中的一个字段
+     */
+    static void fill_key(const ColMeta &col, char *dest, bool is_max) {
+        if (col.type == TYPE_INT) {
+            int val = is_max ? std::numeric_limits<int>::max() : std::numeric_limits<int>::min();
+            memcpy(dest, &val, sizeof(int));
+        } else if (col.type == TYPE_FLOAT) {
+            float val = is_max ? std::numeric_limits<float>::max() : std::numeric_limits<float>::lowest();
+            memcpy(dest, &val, sizeof(float));
+        } else {
+            memset(dest, is_max ? 0xff : 0, col.len);
+        }
     }
+
     void check_runtime_conds() {
         for (auto &cond : fed_conds_) {
             assert(cond.lhs_col.tab_name == tab_name_);
@@ -49,20 +49,31 @@ class InsertExecutor : public AbstractExecutor {
             val.init_raw(col.len);
             memcpy(rec.data + col.offset, val.raw->data, col.len);
         }
+
+        // Build index keys and check uniqueness before touching the record file
+        std::vector<std::unique_ptr<char[]>> keys(tab_.indexes.size());
+        std::vector<IxIndexRef> ihs(tab_.indexes.size());
+        for(size_t i = 0; i < tab_.indexes.size(); ++i) {
+            auto& index = tab_.indexes[i];
+            ihs[i] = sm_manager_->get_index_handle(tab_name_, index);
+            keys[i] = std::make_unique<char[]>(index.col_tot_len);
+            int offset = 0;
+            for(size_t j = 0; j < index.col_num; ++j) {
+                memcpy(keys[i].get() + offset, rec.data + index.cols[j].offset, index.cols[j].len);
+                offset += index.cols[j].len;
+            }
+            std::vector<Rid> result;
+            if (index.unique && ihs[i].get_value(keys[i].get(), &result, context_->txn_)) {
+                throw IndexEntryExistsError();
+            }
+        }
+
         // Insert into record file
         rid_ = fh_->insert_record(rec.data, context_);
         
         // Insert into index
         for(size_t i = 0; i < tab_.indexes.size(); ++i) {
-            auto& index = tab_.indexes[i];
-            auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
-            char* key = new char[index.col_tot_len];
-            int offset = 0;
-            for(size_t i = 0; i < index.col_num; ++i) {
-                memcpy(key + offset, rec.data + index.cols[i].offset, index.cols[i].len);
-                offset += index.cols[i].len;
-            }
-            ih->insert_entry(key, rid_, context_->txn_);
+            ihs[i].insert_entry(keys[i].get(), rid_, context_->txn_);
         }
         return nullptr;
     }
@@ -0,0 +1,110 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "execution_defs.h"
+#include "executor_abstract.h"
+
+/**
+ * @brief LIMIT n OFFSET m：跳过子节点的前m行，输出之后的至多n行，输出够n行后不再从子节点读取，
+ * 子节点中的扫描和连接随之停止。n + m小于一批的行数时逐条读取子节点，扫描和连接只产生需要的行，
+ * 否则按批读取，最多多读一批
+ */
+class LimitExecutor : public AbstractExecutor {
+   private:
+    std::unique_ptr<AbstractExecutor> prev_;
+    size_t limit_;
+    size_t offset_;
+    bool by_tuple_;                             // 是否逐条读取子节点
+    size_t num_read_ = 0;                       // 已经从子节点读取的行数，含跳过的行
+    TupleBatch prev_batch_;
+
+   public:
+    LimitExecutor(std::unique_ptr<AbstractExecutor> prev, size_t limit, size_t offset) {
+        prev_ = std::move(prev);
+        limit_ = limit;
+        offset_ = offset;
+        by_tuple_ = limit_ + offset_ < (size_t)TUPLE_BATCH_SIZE;
+    }
+
+    std::string getType() override { return "Limit"; }
+
+    size_t tupleLen() const override { return prev_->tupleLen(); }
+
+    const std::vector<ColMeta> &cols() const override { return prev_->cols(); }
+
+    void beginTuple() override {
+        num_read_ = 0;
+        if (limit_ == 0) {
+            return;
+        }
+        prev_->beginTuple();
+        for (; num_read_ < offset_ && !prev_->is_end(); prev_->nextTuple()) {
+            num_read_++;
+        }
+    }
+
+    void nextTuple() override {
+        assert(!is_end());
+        num_read_++;
+        if (!is_end()) {
+            prev_->nextTuple();
+        }
+    }
+
+    // LIMIT 0时beginTuple不会开始子节点，必须在访问prev_之前返回
+    bool is_end() const override { return limit_ == 0 || num_read_ >= limit_ + offset_ || prev_->is_end(); }
+
+    std::unique_ptr<RmRecord> Next() override {
+        assert(!is_end());
+        return prev_->Next();
+    }
+
+    void beginBatch() override {
+        if (by_tuple_) {
+            beginTuple();
+            return;
+        }
+        num_read_ = 0;
+        if (limit_ == 0) {
+            return;
+        }
+        prev_->beginBatch();
+    }
+
+    bool NextBatch(TupleBatch &batch) override {
+        batch.reset(tupleLen());
+        if (by_tuple_) {
+            for (; !is_end() && !batch.full(); nextTuple()) {
+                auto rec = prev_->Next();
+                batch.append(rec->data);
+            }
+            return batch.num_rows() > 0;
+        }
+        while (limit_ > 0 && num_read_ < limit_ + offset_ && prev_->NextBatch(prev_batch_)) {
+            for (int i = 0; i < prev_batch_.size() && num_read_ < limit_ + offset_; i++, num_read_++) {
+                if (num_read_ >= offset_) {
+                    batch.append(prev_batch_.row(i));
+                }
+            }
+            if (batch.num_rows() > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool may_contain(const TabCol &col, const char *val, int len) override {
+        return prev_->may_contain(col, val, len);
+    }
+
+    Rid &rid() override { return _abstract_rid; }
+};
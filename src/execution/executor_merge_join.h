@@ -0,0 +1,230 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "execution_defs.h"
+#include "executor_abstract.h"
+#include "predicate.h"
+
+/**
+ * @brief 排序合并连接：两个子节点的输出都已按连接key升序排列（如按key字段的B+树索引扫描、排序算子的输出），
+ * 同时向前推进两侧，只比较key相近的记录，不建哈希表。
+ * 连接key为第一个两侧字段分属左右子节点、类型相同的等值条件，其余条件由谓词程序对连接结果求值。
+ * 右侧key相同的一段记录（重复值段）缓存在内存中，与左侧key相同的每条记录依次组合；
+ * 输出按左侧的顺序，即同样按连接key升序，记录的布局为左记录接右记录
+ */
+class MergeJoinExecutor : public AbstractExecutor {
+   private:
+    std::unique_ptr<AbstractExecutor> left_;    // 左儿子节点
+    std::unique_ptr<AbstractExecutor> right_;   // 右儿子节点
+    size_t len_;                                // join后获得的每条记录的长度
+    std::vector<ColMeta> cols_;                 // join后获得的记录的字段
+    std::vector<Condition> fed_conds_;          // join条件
+    ColMeta left_key_;                          // 连接key在左记录中的字段
+    ColMeta right_key_;                         // 连接key在右记录中的字段
+    Predicate pred_;                            // 其余连接条件，对连接结果求值
+
+    // 左侧当前记录为left_batch_中第left_idx_个有效行；右侧下一条未读的记录为right_batch_中第right_idx_个有效行
+    TupleBatch left_batch_;
+    int left_idx_ = -1;
+    TupleBatch right_batch_;
+    int right_idx_ = 0;
+    bool right_end_ = true;
+
+    // 右侧当前的重复值段，共run_size_条记录，下一条与左侧当前记录组合的是第run_pos_条
+    std::vector<char> run_;
+    size_t run_size_ = 0;
+    size_t run_pos_ = 0;
+    bool end_ = true;
+    std::unique_ptr<RmRecord> record_;          // 当前的连接结果
+
+   public:
+    MergeJoinExecutor(std::unique_ptr<AbstractExecutor> left, std::unique_ptr<AbstractExecutor> right,
+                      std::vector<Condition> conds) {
+        left_ = std::move(left);
+        right_ = std::move(right);
+        len_ = left_->tupleLen() + right_->tupleLen();
+        cols_ = left_->cols();
+        auto right_cols = right_->cols();
+        for (auto &col : right_cols) {
+            col.offset += left_->tupleLen();
+        }
+        cols_.insert(cols_.end(), right_cols.begin(), right_cols.end());
+        fed_conds_ = std::move(conds);
+
+        std::vector<Condition> residual_conds;
+        bool has_key = false;
+        for (auto &cond : fed_conds_) {
+            if (has_key || !set_key(cond)) {
+                residual_conds.push_back(cond);
+            } else {
+                has_key = true;
+            }
+        }
+        if (!has_key) {
+            throw InternalError("Merge join requires an equality condition between its children");
+        }
+        pred_.compile(cols_, residual_conds);
+        record_ = std::make_unique<RmRecord>(len_);
+    }
+
+    std::string getType() override { return "MergeJoin"; }
+
+    size_t tupleLen() const override { return len_; }
+
+    const std::vector<ColMeta> &cols() const override { return cols_; }
+
+    void beginTuple() override {
+        left_batch_.reset(left_->tupleLen());
+        left_idx_ = -1;
+        run_.clear();
+        run_size_ = 0;
+        run_pos_ = 0;
+        left_->beginBatch();
+        right_->beginBatch();
+        right_batch_.reset(right_->tupleLen());
+        right_idx_ = 0;
+        right_end_ = false;
+        fetch_right();
+        end_ = right_end_;
+        if (!end_) {
+            find_match();
+        }
+    }
+
+    void nextTuple() override {
+        assert(!is_end());
+        find_match();
+    }
+
+    bool is_end() const override { return end_; }
+
+    std::unique_ptr<RmRecord> Next() override {
+        assert(!is_end());
+        return std::make_unique<RmRecord>(*record_);
+    }
+
+    bool NextBatch(TupleBatch &batch) override {
+        batch.reset(len_);
+        for (; !is_end() && !batch.full(); nextTuple()) {
+            batch.append(record_->data);
+        }
+        return batch.num_rows() > 0;
+    }
+
+    bool may_contain(const TabCol &col, const char *val, int len) override {
+        return join_may_contain(left_.get(), right_.get(), col, val, len);
+    }
+
+    Rid &rid() override { return _abstract_rid; }
+
+   private:
+    bool set_key(const Condition &cond) {
+        const ColMeta *left_col, *right_col;
+        if (!get_join_key(left_->cols(), right_->cols(), cond, &left_col, &right_col)) {
+            return false;
+        }
+        left_key_ = *left_col;
+        right_key_ = *right_col;
+        return true;
+    }
+
+    /* 从当前位置开始找到下一对满足所有连接条件的记录，写入record_；没有时end_置为true */
+    void find_match() {
+        while (true) {
+            while (run_pos_ < run_size_) {
+                const char *right_row = run_.data() + run_pos_ * right_->tupleLen();
+                run_pos_++;
+                memcpy(record_->data, left_batch_.row(left_idx_), left_->tupleLen());
+                memcpy(record_->data + left_->tupleLen(), right_row, right_->tupleLen());
+                if (pred_.eval(record_->data)) {
+                    return;
+                }
+            }
+            if (!next_left_row()) {
+                end_ = true;
+                return;
+            }
+            const char *left_row = left_batch_.row(left_idx_);
+            if (run_size_ > 0 && compare_key(left_row, run_.data()) == 0) {
+                // 左侧的重复值与上一条记录组合同一段右记录
+                run_pos_ = 0;
+                continue;
+            }
+            run_size_ = 0;
+            while (!right_end_ && compare_key(left_row, right_batch_.row(right_idx_)) > 0) {
+                next_right_row();
+            }
+            if (right_end_) {
+                // 右侧的key都小于左侧当前的key，之后的左记录也不会再有匹配
+                end_ = true;
+                return;
+            }
+            if (compare_key(left_row, right_batch_.row(right_idx_)) < 0) {
+                continue;
+            }
+            // 读入与左侧当前key相等的一段右记录
+            run_.clear();
+            while (!right_end_ && compare_key(left_row, right_batch_.row(right_idx_)) == 0) {
+                const char *right_row = right_batch_.row(right_idx_);
+                run_.insert(run_.end(), right_row, right_row + right_->tupleLen());
+                run_size_++;
+                next_right_row();
+            }
+            run_pos_ = 0;
+        }
+    }
+
+    bool next_left_row() {
+        while (left_idx_ + 1 >= left_batch_.size()) {
+            if (!left_->NextBatch(left_batch_)) {
+                return false;
+            }
+            left_idx_ = -1;
+        }
+        left_idx_++;
+        return true;
+    }
+
+    void next_right_row() {
+        right_idx_++;
+        fetch_right();
+    }
+
+    /* 当前批次读完时读取右侧的下一批，右侧读完时right_end_置为true */
+    void fetch_right() {
+        while (right_idx_ >= right_batch_.size()) {
+            if (!right_->NextBatch(right_batch_)) {
+                right_end_ = true;
+                return;
+            }
+            right_idx_ = 0;
+        }
+    }
+
+    /* 比较左记录与右记录的key，顺序与B+树索引相同；长度不同的字符串按较短的一侧补0比较 */
+    int compare_key(const char *left_row, const char *right_row) const {
+        const char *a = left_row + left_key_.offset;
+        const char *b = right_row + right_key_.offset;
+        if (left_key_.type != TYPE_STRING || left_key_.len == right_key_.len) {
+            return ix_compare(a, b, left_key_.type, left_key_.len);
+        }
+        int n = std::min(left_key_.len, right_key_.len);
+        int cmp = memcmp(a, b, n);
+        if (cmp != 0) {
+            return cmp;
+        }
+        if (left_key_.len > right_key_.len) {
+            return std::any_of(a + n, a + left_key_.len, [](char c) { return c != 0; }) ? 1 : 0;
+        }
+        return std::any_of(b + n, b + right_key_.len, [](char c) { return c != 0; }) ? -1 : 0;
+    }
+};
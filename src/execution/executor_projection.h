@@ -24,6 +24,7 @@ class ProjectionExecutor : public AbstractExecutor {
     
     // 记录当前元组的数据
     std::vector<Value> curr_tuple_;
+    TupleBatch prev_batch_;                         // 批量执行时从儿子节点读取的一批记录
    public:
     ProjectionExecutor(std::unique_ptr<AbstractExecutor> prev, const std::vector<TabCol> &sel_cols) {
          prev_ = std::move(prev);//权限转移
@@ -70,22 +71,35 @@ class ProjectionExecutor : public AbstractExecutor {
         return nullptr; // 如果上一个执行器返回空指针，表示已经到达末尾，直接返回空指针
     }
 
-    auto &prev_cols = prev_->cols();
-    auto &proj_cols = cols_;
     auto proj_rec = std::make_unique<RmRecord>(len_);
-
-    for (size_t proj_idx = 0; proj_idx < proj_cols.size(); proj_idx++) {
-        size_t prev_idx = sel_idxs_[proj_idx];
-        auto &prev_col = prev_cols[prev_idx];
-        auto &proj_col = proj_cols[proj_idx];
-
-        // 利用memcpy将数据从上一个记录复制到投影记录中
-        memcpy(proj_rec->data + proj_col.offset, prev_rec->data + prev_col.offset, proj_col.len);
-    }
-
+    project(prev_rec->data, proj_rec->data);
     return proj_rec;
     }
 
+    void beginBatch() override { prev_->beginBatch(); }
+
+    bool NextBatch(TupleBatch &batch) override {
+        batch.reset(len_);
+        if (!prev_->NextBatch(prev_batch_)) {
+            return false;
+        }
+        for (int i = 0; i < prev_batch_.size(); i++) {
+            project(prev_batch_.row(i), batch.append());
+        }
+        return true;
+    }
 
     Rid &rid() override { return _abstract_rid; }
+
+   private:
+    /* 从儿子节点的一条记录中取出投影的字段 */
+    void project(const char *prev_data, char *proj_data) const {
+        auto &prev_cols = prev_->cols();
+        for (size_t proj_idx = 0; proj_idx < cols_.size(); proj_idx++) {
+            auto &prev_col = prev_cols[sel_idxs_[proj_idx]];
+            auto &proj_col = cols_[proj_idx];
+            // 利用memcpy将数据从上一个记录复制到投影记录中
+            memcpy(proj_data + proj_col.offset, prev_data + prev_col.offset, proj_col.len);
+        }
+    }
 };
\ No newline at end of file
@@ -10,10 +10,14 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <cmath>
+
 #include "execution_defs.h"
 #include "execution_manager.h"
 #include "executor_abstract.h"
+#include "filter_kernels.h"
 #include "index/ix.h"
+#include "predicate.h"
 #include "system/sm.h"
 
 class SeqScanExecutor : public AbstractExecutor {
@@ -24,9 +28,11 @@ class SeqScanExecutor : public AbstractExecutor {
     std::vector<ColMeta> cols_;         // scan后生成的记录的字段
     size_t len_;                        // scan后生成的每条记录的长度
     std::vector<Condition> fed_conds_;  // 同conds_，两个字段相同
+    Predicate pred_;                    // 由fed_conds_编译出的谓词程序
+    RmSlotFilter slot_filter_;          // 批量执行时按页面求pred_的过滤函数，没有条件时为空
 
     Rid rid_;
-    std::unique_ptr<RecScan> scan_;     // table_iterator
+    std::unique_ptr<RmScan> scan_;      // table_iterator
 
     SmManager *sm_manager_;
     
@@ -67,7 +73,8 @@ class SeqScanExecutor : public AbstractExecutor {
 
     void beginTuple() override {
         check_runtime_conds();
-        scan_ = std::make_unique<RmScan>(fh_);
+        pred_.compile(cols_, fed_conds_);
+        scan_ = std::make_unique<RmScan>(fh_, get_zone_ranges());
 
         // 得到第一个满足fed_conds_条件的record,并把其rid赋给算子成员rid_
         while (!scan_->is_end()) {
@@ -77,8 +84,8 @@ class SeqScanExecutor : public AbstractExecutor {
                 // lab3 task2 todo
                  std::fstream outfile;
                  
-                // 利用eval_conds判断是否当前记录(rec.get())满足谓词条件
-                 if (eval_conds(cols_, conds_, rec.get())) {
+                // 利用谓词程序判断是否当前记录(rec.get())满足谓词条件
+                 if (pred_.eval(rec->data)) {
                 rid_ = scan_->rid();
                 return;
         }
@@ -104,7 +111,7 @@ class SeqScanExecutor : public AbstractExecutor {
         }
 
         // 判断是否满足谓词条件
-        if (eval_conds(cols_, conds_, record.get())) {
+        if (pred_.eval(record->data)) {
             rid_ = scan_->rid();
             return;
         }
@@ -129,6 +136,95 @@ class SeqScanExecutor : public AbstractExecutor {
     }
 
     Rid& rid() override { return rid_; }
+
+    void beginBatch() override {
+        check_runtime_conds();
+        pred_.compile(cols_, fed_conds_);
+        slot_filter_ = nullptr;
+        if (!pred_.empty()) {
+            slot_filter_ = [this](const char *slots, int n, int record_size, uint64_t *mask) {
+                filter_records(pred_, slots, n, record_size, mask);
+            };
+        }
+        scan_ = std::make_unique<RmScan>(fh_, get_zone_ranges());
+    }
+
+    /* 每次对一个页面上的记录整体求谓词，数值列与常量的比较由过滤内核完成，只把满足条件的记录复制到batch中 */
+    bool NextBatch(TupleBatch &batch) override {
+        assert(len_ == (size_t)fh_->get_file_hdr().record_size);
+        batch.reset(len_);
+        while (!scan_->is_end() && !batch.full()) {
+            batch.commit(scan_->next_records(batch.free_space(), batch.free_rows(), slot_filter_));
+        }
+        return batch.num_rows() > 0;
+    }
+
+    /* 在col字段上的Bloom过滤器中检查，第一次检查时为该字段建立过滤器 */
+    bool may_contain(const TabCol &col, const char *val, int len) override {
+        if (col.tab_name != tab_name_) {
+            return true;
+        }
+        auto col_meta = get_col(cols_, col);
+        fh_->enable_bloom_filter(col_meta->offset, col_meta->type, col_meta->len);
+        return fh_->may_contain(col_meta->offset, BloomFilter::hash_value(val, col_meta->type, len));
+    }
+
+    /* 最近一次扫描读取和跳过的数据页个数 */
+    RmScan::Stats scan_stats() const { return scan_ == nullptr ? RmScan::Stats() : scan_->stats(); }
+
+    /**
+     * @brief 把数值列与常量比较的条件转换为zone map上的取值范围，同一列上的多个条件求交
+     * 存在这样的条件时才为表建立zone map；不等条件不能排除页面，忽略
+     */
+    std::vector<RmZoneMap::Range> get_zone_ranges() {
+        std::vector<RmZoneMap::Column> zone_cols;
+        std::vector<int> zone_col_idx(cols_.size(), -1);
+        for (size_t i = 0; i < cols_.size(); i++) {
+            if (cols_[i].type == TYPE_INT || cols_[i].type == TYPE_FLOAT) {
+                zone_col_idx[i] = zone_cols.size();
+                zone_cols.push_back({cols_[i].offset, cols_[i].type});
+            }
+        }
+        std::vector<RmZoneMap::Range> ranges;
+        for (auto &cond : fed_conds_) {
+            if (!cond.is_rhs_val || cond.op == OP_NE) {
+                continue;
+            }
+            size_t i = get_col(cols_, cond.lhs_col) - cols_.cbegin();
+            if (zone_col_idx[i] == -1 || cond.rhs_val.type != cols_[i].type) {
+                continue;
+            }
+            RmZoneMap::Column col{0, cols_[i].type};
+            double val = RmZoneMap::get_value(col, cond.rhs_val.raw->data);
+            // 严格的比较转换为闭区间：INT取相邻整数，FLOAT取相邻的float
+            double below = col.type == TYPE_INT ? val - 1 : std::nextafter((float)val, -INFINITY);
+            double above = col.type == TYPE_INT ? val + 1 : std::nextafter((float)val, INFINITY);
+            double lo = -INFINITY, hi = INFINITY;
+            if (cond.op == OP_EQ) {
+                lo = hi = val;
+            } else if (cond.op == OP_LT) {
+                hi = below;
+            } else if (cond.op == OP_LE) {
+                hi = val;
+            } else if (cond.op == OP_GT) {
+                lo = above;
+            } else if (cond.op == OP_GE) {
+                lo = val;
+            }
+            auto it = std::find_if(ranges.begin(), ranges.end(),
+                                   [&](const RmZoneMap::Range &range) { return range.col == zone_col_idx[i]; });
+            if (it == ranges.end()) {
+                ranges.push_back({zone_col_idx[i], lo, hi});
+            } else {
+                it->lo = std::max(it->lo, lo);
+                it->hi = std::min(it->hi, hi);
+            }
+        }
+        if (!ranges.empty()) {
+            fh_->enable_zone_map(zone_cols);
+        }
+        return ranges;
+    }
     
 
     //
@@ -141,42 +237,5 @@ class SeqScanExecutor : public AbstractExecutor {
         }
     }
     //
-     bool eval_cond(const std::vector<ColMeta> &rec_cols, const Condition &cond, const RmRecord *rec) {
-        auto lhs_col = get_col(rec_cols, cond.lhs_col);
-        char *lhs = rec->data + lhs_col->offset;
-        char *rhs;
-        ColType rhs_type;
-        if (cond.is_rhs_val) {
-            rhs_type = cond.rhs_val.type;
-            rhs = cond.rhs_val.raw->data;
-        } else {
-            // rhs is a column
-            auto rhs_col = get_col(rec_cols, cond.rhs_col);
-            rhs_type = rhs_col->type;
-            rhs = rec->data + rhs_col->offset;
-        }
-        assert(rhs_type == lhs_col->type);  // TODO convert to common type
-        int cmp = ix_compare(lhs, rhs, rhs_type, lhs_col->len);
-        if (cond.op == OP_EQ) {
-            return cmp == 0;
-        } else if (cond.op == OP_NE) {
-            return cmp != 0;
-        } else if (cond.op == OP_LT) {
-            return cmp < 0;
-        } else if (cond.op == OP_GT) {
-            return cmp > 0;
-        } else if (cond.op == OP_LE) {
-            return cmp <= 0;
-        } else if (cond.op == OP_GE) {
-            return cmp >= 0;
-        } else {
-            throw InternalError("Unexpected op type");
-        }
-    }
-//
-    bool eval_conds(const std::vector<ColMeta> &rec_cols, const std::vector<Condition> &conds, const RmRecord *rec) {
-        return std::all_of(conds.begin(), conds.end(),
-                           [&](const Condition &cond) { return eval_cond(rec_cols, cond, rec); });
-    }
 
 };
\ No newline at end of file
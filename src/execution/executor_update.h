@@ -37,7 +37,22 @@ class UpdateExecutor : public AbstractExecutor {
         rids_ = rids;
         context_ = context;
     }
+    /**
+     * @description: 按照索引字段的顺序从记录中拼出索引的key
+     */
+    static void make_key(const IndexMeta &index, const char *data, char *key) {
+        int offset = 0;
+        for (int i = 0; i < index.col_num; i++) {
+            memcpy(key + offset, data + index.cols[i].offset, index.cols[i].len);
+            offset += index.cols[i].len;
+        }
+    }
+
     std::unique_ptr<RmRecord> Next() override {
+        std::vector<IxIndexRef> ihs(tab_.indexes.size());
+        for (size_t i = 0; i < tab_.indexes.size(); i++) {
+            ihs[i] = sm_manager_->get_index_handle(tab_name_, tab_.indexes[i]);
+        }
         //  Make record buffer
         for (auto &rid:  rids_) {
             auto Tuple = fh_->get_record(rid,context_);
@@ -58,6 +73,28 @@ class UpdateExecutor : public AbstractExecutor {
                     }    
                 }
             
+            // 更新索引：key发生变化的索引先检查唯一性（非唯一索引不检查），再删除旧key并插入新key
+            std::vector<std::unique_ptr<char[]>> old_keys(tab_.indexes.size()), new_keys(tab_.indexes.size());
+            std::vector<bool> changed(tab_.indexes.size(), false);
+            for (size_t i = 0; i < tab_.indexes.size(); i++) {
+                auto &index = tab_.indexes[i];
+                old_keys[i] = std::make_unique<char[]>(index.col_tot_len);
+                new_keys[i] = std::make_unique<char[]>(index.col_tot_len);
+                make_key(index, Tuple->data, old_keys[i].get());
+                make_key(index, rec.data, new_keys[i].get());
+                changed[i] = memcmp(old_keys[i].get(), new_keys[i].get(), index.col_tot_len) != 0;
+                std::vector<Rid> result;
+                if (changed[i] && index.unique && ihs[i].get_value(new_keys[i].get(), &result, context_->txn_)) {
+                    throw IndexEntryExistsError();
+                }
+            }
+            for (size_t i = 0; i < tab_.indexes.size(); i++) {
+                if (changed[i]) {
+                    ihs[i].delete_entry(old_keys[i].get(), rid, context_->txn_);
+                    ihs[i].insert_entry(new_keys[i].get(), rid, context_->txn_);
+                }
+            }
+
             fh_->update_record(rid,rec.data,context_);
             // WType wtype = WType::UPDATE_TUPLE;
             // WriteRecord* writeRecord = new WriteRecord(wtype,tab_name_ , rid);
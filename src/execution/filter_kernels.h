@@ -0,0 +1,316 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define RMDB_FILTER_SIMD 1
+#endif
+
+#include "predicate.h"
+
+/**
+ * 数值列的过滤内核：对n条间隔为stride字节、连续存放的定长记录（一个数据页上的所有槽，或一个TupleBatch），
+ * 求offset处的INT/FLOAT字段与常量的比较结果，结果以位图给出：第i条记录对应mask[i / 64]的第i % 64位；
+ * 调用前mask中置位的记录才参与比较（如页面上已被占用的槽），不满足条件的记录的位被清除。
+ * AVX2每次用gather读取8条记录的字段，SSE4每次比较4条，运行时按CPU支持的指令集选择，不支持时使用标量实现
+ */
+
+enum class FilterIsa { SCALAR, SSE4, AVX2 };
+
+/* mask中记录数n对应的字数 */
+inline int filter_mask_words(int n) { return (n + 63) / 64; }
+
+namespace filter_kernels {
+
+template <typename T, CompOp OP>
+inline bool compare(T a, T b) {
+    if constexpr (OP == OP_EQ) {
+        return a == b;
+    } else if constexpr (OP == OP_NE) {
+        return a != b;
+    } else if constexpr (OP == OP_LT) {
+        return a < b;
+    } else if constexpr (OP == OP_GT) {
+        return a > b;
+    } else if constexpr (OP == OP_LE) {
+        return a <= b;
+    } else {
+        return a >= b;
+    }
+}
+
+/* 对第begin条起的cnt（不超过64）条记录逐条比较，返回结果位 */
+template <typename T, CompOp OP>
+inline uint64_t scalar_bits(const char *base, int begin, int cnt, int stride, T val) {
+    uint64_t bits = 0;
+    const char *p = base + (size_t)begin * stride;
+    for (int i = 0; i < cnt; i++, p += stride) {
+        T x;
+        memcpy(&x, p, sizeof(T));
+        bits |= (uint64_t)compare<T, OP>(x, val) << i;
+    }
+    return bits;
+}
+
+template <typename T, CompOp OP>
+void filter_scalar(const char *base, int n, int stride, T val, uint64_t *mask) {
+    for (int w = 0; w < filter_mask_words(n); w++) {
+        if (mask[w] != 0) {
+            mask[w] &= scalar_bits<T, OP>(base, w * 64, std::min(64, n - w * 64), stride, val);
+        }
+    }
+}
+
+#ifdef RMDB_FILTER_SIMD
+inline bool has_avx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+inline bool has_sse4() {
+    static const bool supported = __builtin_cpu_supports("sse4.1");
+    return supported;
+}
+
+template <typename T, CompOp OP>
+__attribute__((target("avx2"))) inline int avx2_bits8(const char *p, __m256i idx, T val) {
+    if constexpr (std::is_same_v<T, int>) {
+        __m256i x = _mm256_i32gather_epi32(reinterpret_cast<const int *>(p), idx, 1);
+        __m256i v = _mm256_set1_epi32(val);
+        __m256i r;
+        if constexpr (OP == OP_EQ || OP == OP_NE) {
+            r = _mm256_cmpeq_epi32(x, v);
+        } else if constexpr (OP == OP_GT || OP == OP_LE) {
+            r = _mm256_cmpgt_epi32(x, v);
+        } else {
+            r = _mm256_cmpgt_epi32(v, x);
+        }
+        int bits = _mm256_movemask_ps(_mm256_castsi256_ps(r));
+        // NE、LE、GE由EQ、GT、LT取反得到
+        return (OP == OP_NE || OP == OP_LE || OP == OP_GE) ? (~bits & 0xff) : bits;
+    } else {
+        __m256 x = _mm256_i32gather_ps(reinterpret_cast<const float *>(p), idx, 1);
+        __m256 v = _mm256_set1_ps(val);
+        constexpr int pred = OP == OP_EQ   ? _CMP_EQ_OQ
+                             : OP == OP_NE ? _CMP_NEQ_UQ
+                             : OP == OP_LT ? _CMP_LT_OQ
+                             : OP == OP_GT ? _CMP_GT_OQ
+                             : OP == OP_LE ? _CMP_LE_OQ
+                                           : _CMP_GE_OQ;
+        return _mm256_movemask_ps(_mm256_cmp_ps(x, v, pred));
+    }
+}
+
+template <typename T, CompOp OP>
+__attribute__((target("avx2"))) void filter_avx2(const char *base, int n, int stride, T val, uint64_t *mask) {
+    const __m256i idx = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+    for (int w = 0; w < filter_mask_words(n); w++) {
+        uint64_t m = mask[w];
+        if (m == 0) {
+            continue;
+        }
+        int begin = w * 64;
+        int cnt = std::min(64, n - begin);
+        uint64_t bits = 0;
+        int i = 0;
+        for (; i + 8 <= cnt; i += 8) {
+            if (((m >> i) & 0xff) != 0) {
+                bits |= (uint64_t)avx2_bits8<T, OP>(base + (size_t)(begin + i) * stride, idx, val) << i;
+            }
+        }
+        if (i < cnt) {
+            bits |= scalar_bits<T, OP>(base, begin + i, cnt - i, stride, val) << i;
+        }
+        mask[w] = m & bits;
+    }
+}
+
+template <typename T, CompOp OP>
+__attribute__((target("sse4.1"))) inline int sse4_bits4(const char *p, int stride, T val) {
+    T xs[4];
+    for (int j = 0; j < 4; j++) {
+        memcpy(&xs[j], p + (size_t)j * stride, sizeof(T));
+    }
+    if constexpr (std::is_same_v<T, int>) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(xs));
+        __m128i v = _mm_set1_epi32(val);
+        __m128i r;
+        if constexpr (OP == OP_EQ || OP == OP_NE) {
+            r = _mm_cmpeq_epi32(x, v);
+        } else if constexpr (OP == OP_GT || OP == OP_LE) {
+            r = _mm_cmpgt_epi32(x, v);
+        } else {
+            r = _mm_cmplt_epi32(x, v);
+        }
+        int bits = _mm_movemask_ps(_mm_castsi128_ps(r));
+        return (OP == OP_NE || OP == OP_LE || OP == OP_GE) ? (~bits & 0xf) : bits;
+    } else {
+        __m128 x = _mm_loadu_ps(xs);
+        __m128 v = _mm_set1_ps(val);
+        __m128 r;
+        if constexpr (OP == OP_EQ) {
+            r = _mm_cmpeq_ps(x, v);
+        } else if constexpr (OP == OP_NE) {
+            r = _mm_cmpneq_ps(x, v);
+        } else if constexpr (OP == OP_LT) {
+            r = _mm_cmplt_ps(x, v);
+        } else if constexpr (OP == OP_GT) {
+            r = _mm_cmpgt_ps(x, v);
+        } else if constexpr (OP == OP_LE) {
+            r = _mm_cmple_ps(x, v);
+        } else {
+            r = _mm_cmpge_ps(x, v);
+        }
+        return _mm_movemask_ps(r);
+    }
+}
+
+template <typename T, CompOp OP>
+__attribute__((target("sse4.1"))) void filter_sse4(const char *base, int n, int stride, T val, uint64_t *mask) {
+    for (int w = 0; w < filter_mask_words(n); w++) {
+        uint64_t m = mask[w];
+        if (m == 0) {
+            continue;
+        }
+        int begin = w * 64;
+        int cnt = std::min(64, n - begin);
+        uint64_t bits = 0;
+        int i = 0;
+        for (; i + 4 <= cnt; i += 4) {
+            if (((m >> i) & 0xf) != 0) {
+                bits |= (uint64_t)sse4_bits4<T, OP>(base + (size_t)(begin + i) * stride, stride, val) << i;
+            }
+        }
+        if (i < cnt) {
+            bits |= scalar_bits<T, OP>(base, begin + i, cnt - i, stride, val) << i;
+        }
+        mask[w] = m & bits;
+    }
+}
+#endif
+
+template <typename T, CompOp OP>
+void filter(FilterIsa isa, const char *base, int n, int stride, T val, uint64_t *mask) {
+#ifdef RMDB_FILTER_SIMD
+    if (isa == FilterIsa::AVX2) {
+        return filter_avx2<T, OP>(base, n, stride, val, mask);
+    }
+    if (isa == FilterIsa::SSE4) {
+        return filter_sse4<T, OP>(base, n, stride, val, mask);
+    }
+#endif
+    filter_scalar<T, OP>(base, n, stride, val, mask);
+}
+
+template <typename T>
+void filter(FilterIsa isa, CompOp op, const char *base, int n, int stride, T val, uint64_t *mask) {
+    switch (op) {
+        case OP_EQ:
+            return filter<T, OP_EQ>(isa, base, n, stride, val, mask);
+        case OP_NE:
+            return filter<T, OP_NE>(isa, base, n, stride, val, mask);
+        case OP_LT:
+            return filter<T, OP_LT>(isa, base, n, stride, val, mask);
+        case OP_GT:
+            return filter<T, OP_GT>(isa, base, n, stride, val, mask);
+        case OP_LE:
+            return filter<T, OP_LE>(isa, base, n, stride, val, mask);
+        case OP_GE:
+            return filter<T, OP_GE>(isa, base, n, stride, val, mask);
+        default:
+            throw InternalError("Unexpected op type");
+    }
+}
+
+}  // namespace filter_kernels
+
+/* 当前CPU支持的最快的实现 */
+inline FilterIsa filter_best_isa() {
+#ifdef RMDB_FILTER_SIMD
+    if (filter_kernels::has_avx2()) {
+        return FilterIsa::AVX2;
+    }
+    if (filter_kernels::has_sse4()) {
+        return FilterIsa::SSE4;
+    }
+#endif
+    return FilterIsa::SCALAR;
+}
+
+/* CPU是否支持isa */
+inline bool filter_isa_supported(FilterIsa isa) {
+    return isa == FilterIsa::SCALAR || isa <= filter_best_isa();
+}
+
+/* 字段与常量比较的term可以由过滤内核求值 */
+inline bool filter_vectorizable(const Predicate::Term &term) {
+    return !term.rhs_is_col && (term.type == TYPE_INT || term.type == TYPE_FLOAT);
+}
+
+/**
+ * @brief 对n条记录中offset处的type字段与常量val做op比较，清除mask中不满足条件的记录的位
+ * @param base 第一条记录的地址
+ * @param val 与字段类型相同的常量
+ */
+inline void filter_column(const char *base, int n, int stride, int offset, ColType type, CompOp op, const char *val,
+                          uint64_t *mask, FilterIsa isa = filter_best_isa()) {
+    assert(filter_isa_supported(isa));
+    if (type == TYPE_INT) {
+        int v;
+        memcpy(&v, val, sizeof(int));
+        filter_kernels::filter<int>(isa, op, base + offset, n, stride, v, mask);
+    } else if (type == TYPE_FLOAT) {
+        float v;
+        memcpy(&v, val, sizeof(float));
+        filter_kernels::filter<float>(isa, op, base + offset, n, stride, v, mask);
+    } else {
+        throw InternalError("Unexpected data type");
+    }
+}
+
+/**
+ * @brief 对n条记录求谓词程序pred，清除mask中不满足的记录的位
+ * 可以向量化的term依次用过滤内核按列求值，其余term只对仍然满足条件的记录逐条求值
+ */
+inline void filter_records(const Predicate &pred, const char *base, int n, int stride, uint64_t *mask,
+                           FilterIsa isa = filter_best_isa()) {
+    bool has_residual = false;
+    for (auto &term : pred.terms()) {
+        if (filter_vectorizable(term)) {
+            filter_column(base, n, stride, term.lhs_offset, term.type, term.op, pred.const_value(term), mask, isa);
+        } else {
+            has_residual = true;
+        }
+    }
+    if (!has_residual) {
+        return;
+    }
+    for (int w = 0; w < filter_mask_words(n); w++) {
+        for (uint64_t m = mask[w]; m != 0; m &= m - 1) {
+            int i = w * 64 + __builtin_ctzll(m);
+            const char *rec = base + (size_t)i * stride;
+            for (auto &term : pred.terms()) {
+                if (!filter_vectorizable(term) && !pred.eval_term(term, rec)) {
+                    mask[w] &= ~(1ULL << (i % 64));
+                    break;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,180 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "common/common.h"
+#include "errors.h"
+#include "execution_defs.h"
+#include "system/sm_meta.h"
+
+/**
+ * @brief 预编译的谓词程序，对一条定长记录求一组条件的合取
+ * 编译时把每个条件的字段解析为记录中的偏移，常量复制到程序内部，并按字段类型和比较运算符选出对应的比较函数；
+ * 求值时不再查找字段，也不再按类型和运算符分支
+ */
+class Predicate {
+   public:
+    using CompareFn = bool (*)(const char *lhs, const char *rhs, int lhs_len, int rhs_len);
+
+    struct Term {
+        int lhs_offset;         // 左侧字段在记录中的偏移
+        bool rhs_is_col;        // 右侧是记录中的字段还是常量
+        int rhs_offset;         // 右侧字段在记录中的偏移，或常量在consts_中的偏移
+        int len;                // 左侧字段长度
+        int rhs_len;            // 右侧字段或常量的长度，只有CHAR字段之间比较时可能与len不同
+        ColType type;
+        CompOp op;
+        CompareFn cmp;
+    };
+
+   private:
+    std::vector<Term> terms_;
+    std::vector<char> consts_;  // 所有常量依次存放
+
+   public:
+    /* 编译conds，字段按名字在cols中查找，条件的两侧都必须是cols中的字段或常量 */
+    void compile(const std::vector<ColMeta> &cols, const std::vector<Condition> &conds) {
+        terms_.clear();
+        consts_.clear();
+        auto get_col = [&](const TabCol &target) -> const ColMeta & {
+            auto col = find_col(cols, target);
+            if (col == nullptr) {
+                throw ColumnNotFoundError(target.tab_name + '.' + target.col_name);
+            }
+            return *col;
+        };
+        for (auto &cond : conds) {
+            auto &lhs_col = get_col(cond.lhs_col);
+            Term term;
+            term.lhs_offset = lhs_col.offset;
+            term.len = lhs_col.len;
+            term.rhs_len = lhs_col.len;
+            term.type = lhs_col.type;
+            term.op = cond.op;
+            term.rhs_is_col = !cond.is_rhs_val;
+            if (cond.is_rhs_val) {
+                term.rhs_offset = consts_.size();
+                if (cond.rhs_val.type == lhs_col.type) {
+                    consts_.insert(consts_.end(), cond.rhs_val.raw->data, cond.rhs_val.raw->data + lhs_col.len);
+                } else if (lhs_col.type == TYPE_FLOAT && cond.rhs_val.type == TYPE_INT) {
+                    // 整数常量转换为浮点数后与FLOAT字段比较，结果不变
+                    float val = (float)cond.rhs_val.int_val;
+                    consts_.insert(consts_.end(), (const char *)&val, (const char *)&val + sizeof(float));
+                } else {
+                    // FLOAT常量转换为INT会截断，改变比较结果
+                    throw IncompatibleTypeError(coltype2str(lhs_col.type), coltype2str(cond.rhs_val.type));
+                }
+            } else {
+                auto &rhs_col = get_col(cond.rhs_col);
+                if (rhs_col.type != lhs_col.type) {
+                    throw IncompatibleTypeError(coltype2str(lhs_col.type), coltype2str(rhs_col.type));
+                }
+                term.rhs_offset = rhs_col.offset;
+                term.rhs_len = rhs_col.len;
+            }
+            term.cmp = select(term.type, term.op);
+            terms_.push_back(term);
+        }
+    }
+
+    bool empty() const { return terms_.empty(); }
+
+    const std::vector<Term> &terms() const { return terms_; }
+
+    /* 常量term的右侧值 */
+    const char *const_value(const Term &term) const { return consts_.data() + term.rhs_offset; }
+
+    bool eval_term(const Term &term, const char *rec) const {
+        const char *rhs = term.rhs_is_col ? rec + term.rhs_offset : consts_.data() + term.rhs_offset;
+        return term.cmp(rec + term.lhs_offset, rhs, term.len, term.rhs_len);
+    }
+
+    bool eval(const char *rec) const {
+        return std::all_of(terms_.begin(), terms_.end(), [&](const Term &term) { return eval_term(term, rec); });
+    }
+
+    /**
+     * @brief 对左记录接右记录的连接结果求值，但不实际拼接：偏移小于left_len的字段在left中，其余在right中
+     * 用于连接算子先判断一对记录是否满足条件，满足时再写出连接结果
+     */
+    bool eval(const char *left, const char *right, int left_len) const {
+        auto field = [&](int offset) { return offset < left_len ? left + offset : right + (offset - left_len); };
+        for (auto &term : terms_) {
+            const char *rhs = term.rhs_is_col ? field(term.rhs_offset) : consts_.data() + term.rhs_offset;
+            if (!term.cmp(field(term.lhs_offset), rhs, term.len, term.rhs_len)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* 按字段类型和比较运算符选出比较函数，比较结果与ix_compare相同 */
+    static CompareFn select(ColType type, CompOp op) {
+        switch (op) {
+            case OP_EQ:
+                return select<std::equal_to>(type);
+            case OP_NE:
+                return select<std::not_equal_to>(type);
+            case OP_LT:
+                return select<std::less>(type);
+            case OP_GT:
+                return select<std::greater>(type);
+            case OP_LE:
+                return select<std::less_equal>(type);
+            case OP_GE:
+                return select<std::greater_equal>(type);
+            default:
+                throw InternalError("Unexpected op type");
+        }
+    }
+
+   private:
+    template <template <typename> class Cmp>
+    static CompareFn select(ColType type) {
+        switch (type) {
+            case TYPE_INT:
+                return compare_num<int, Cmp>;
+            case TYPE_FLOAT:
+                return compare_num<float, Cmp>;
+            case TYPE_STRING:
+                return compare_str<Cmp>;
+            default:
+                throw InternalError("Unexpected data type");
+        }
+    }
+
+    template <typename T, template <typename> class Cmp>
+    static bool compare_num(const char *lhs, const char *rhs, int, int) {
+        T a, b;
+        memcpy(&a, lhs, sizeof(T));
+        memcpy(&b, rhs, sizeof(T));
+        return Cmp<T>()(a, b);
+    }
+
+    /* 长度不同的CHAR字段按较短的一侧补0后比较，与MergeJoinExecutor::compare_key相同，不读取较短一侧之后的字节 */
+    template <template <typename> class Cmp>
+    static bool compare_str(const char *lhs, const char *rhs, int lhs_len, int rhs_len) {
+        int n = std::min(lhs_len, rhs_len);
+        int cmp = memcmp(lhs, rhs, n);
+        if (cmp == 0 && lhs_len > rhs_len) {
+            cmp = std::any_of(lhs + n, lhs + lhs_len, [](char c) { return c != 0; }) ? 1 : 0;
+        } else if (cmp == 0 && lhs_len < rhs_len) {
+            cmp = std::any_of(rhs + n, rhs + rhs_len, [](char c) { return c != 0; }) ? -1 : 0;
+        }
+        return Cmp<int>()(cmp, 0);
+    }
+};
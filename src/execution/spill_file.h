@@ -0,0 +1,68 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstdio>
+
+#include "errors.h"
+
+/**
+ * @brief 算子在内存不足时使用的临时文件，依次写入定长的行，写完后从头顺序读出
+ * 文件由tmpfile创建，不经过缓冲池，关闭后由系统删除
+ */
+class SpillFile {
+   private:
+    FILE *file_;
+    size_t row_len_;
+    size_t num_rows_ = 0;
+
+   public:
+    explicit SpillFile(size_t row_len) : row_len_(row_len) {
+        file_ = std::tmpfile();
+        if (file_ == nullptr) {
+            throw UnixError();
+        }
+    }
+
+    ~SpillFile() { fclose(file_); }
+
+    SpillFile(const SpillFile &) = delete;
+    SpillFile &operator=(const SpillFile &) = delete;
+
+    size_t row_len() const { return row_len_; }
+
+    size_t num_rows() const { return num_rows_; }
+
+    void append(const char *row) { append(row, 1); }
+
+    void append(const char *rows, size_t n) {
+        if (n > 0 && fwrite(rows, row_len_, n, file_) != n) {
+            throw UnixError();
+        }
+        num_rows_ += n;
+    }
+
+    /* 回到文件开头，之后用read读出所有行 */
+    void rewind() {
+        if (fflush(file_) != 0 || fseek(file_, 0, SEEK_SET) != 0) {
+            throw UnixError();
+        }
+    }
+
+    /* 读出最多max_n行到dest，返回读出的行数，读完时返回0 */
+    size_t read(char *dest, size_t max_n) {
+        size_t n = fread(dest, row_len_, max_n, file_);
+        if (n < max_n && ferror(file_)) {
+            throw UnixError();
+        }
+        return n;
+    }
+};
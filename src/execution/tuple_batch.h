@@ -0,0 +1,98 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+constexpr int TUPLE_BATCH_SIZE = 1024;  // 每批最多的行数
+
+/**
+ * @brief 算子之间批量传递的一组定长记录
+ * 记录按行依次存放在连续的缓冲区中，选择向量记录其中有效行的下标；
+ * 过滤时只修改选择向量，不移动记录
+ */
+class TupleBatch {
+    size_t tuple_len_ = 0;
+    int num_rows_ = 0;              // 缓冲区中的行数，包括被过滤掉的行
+    std::vector<char> data_;
+    std::vector<int> sel_;          // 有效行的下标，递增
+
+   public:
+    TupleBatch() = default;
+
+    explicit TupleBatch(size_t tuple_len) { reset(tuple_len); }
+
+    /* 清空，之后每行长度为tuple_len */
+    void reset(size_t tuple_len) {
+        if (tuple_len != tuple_len_ || data_.empty()) {
+            tuple_len_ = tuple_len;
+            data_.resize(std::max<size_t>(tuple_len, 1) * TUPLE_BATCH_SIZE);
+        }
+        num_rows_ = 0;
+        sel_.clear();
+    }
+
+    size_t tuple_len() const { return tuple_len_; }
+
+    int num_rows() const { return num_rows_; }
+
+    bool full() const { return num_rows_ == TUPLE_BATCH_SIZE; }
+
+    /* 有效行数 */
+    int size() const { return static_cast<int>(sel_.size()); }
+
+    bool empty() const { return sel_.empty(); }
+
+    /* 第i个有效行 */
+    char *row(int i) { return data_.data() + sel_[i] * tuple_len_; }
+
+    const char *row(int i) const { return data_.data() + sel_[i] * tuple_len_; }
+
+    /* 追加一个有效行，返回其地址，由调用者写入内容 */
+    char *append() {
+        assert(!full());
+        sel_.push_back(num_rows_);
+        return data_.data() + tuple_len_ * num_rows_++;
+    }
+
+    void append(const char *tuple) { memcpy(append(), tuple, tuple_len_); }
+
+    /* 缓冲区中下一行的地址，由调用者直接写入若干行后调用commit */
+    char *free_space() { return data_.data() + tuple_len_ * num_rows_; }
+
+    int free_rows() const { return TUPLE_BATCH_SIZE - num_rows_; }
+
+    /* 把free_space处写入的n行追加为有效行 */
+    void commit(int n) {
+        assert(n <= free_rows());
+        for (int i = 0; i < n; i++) {
+            sel_.push_back(num_rows_++);
+        }
+    }
+
+    /* 撤销最后一次append */
+    void pop_back() {
+        assert(!sel_.empty() && sel_.back() == num_rows_ - 1);
+        sel_.pop_back();
+        num_rows_--;
+    }
+
+    /* 只保留pred返回true的有效行 */
+    template <typename Pred>
+    void filter(Pred pred) {
+        sel_.erase(std::remove_if(sel_.begin(), sel_.end(),
+                                  [&](int idx) { return !pred(data_.data() + idx * tuple_len_); }),
+                   sel_.end());
+    }
+};
@@ -0,0 +1,240 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ix_defs.h"
+
+constexpr size_t IX_AHI_DEFAULT_MAX_BYTES = 1 << 20;  // 每个索引的自适应哈希默认最多占用1MB内存
+constexpr int IX_AHI_SKETCH_SIZE = 4096;              // 访问统计的计数器个数
+constexpr int IX_AHI_HOT_LOOKUPS = 2;                 // key被点查到这么多次后加入自适应哈希
+constexpr size_t IX_AHI_ENTRY_OVERHEAD = 64;          // 估算每项在哈希表和槽数组中的额外开销
+constexpr int IX_AHI_WINDOW = 1024;                   // 每隔这么多次点查重新评估命中率
+constexpr int IX_AHI_MIN_HIT_RATIO = 8;               // 命中率低于1/8时只按采样加入新的项
+constexpr int IX_AHI_SAMPLE_RATE = 16;                // 命中率低时每16个热key才加入1个
+
+/**
+ * @brief B+树之上的自适应哈希索引，只存在于内存中
+ * 把频繁点查的key映射到它所在的叶子结点和槽位，命中时跳过从根到叶的查找；
+ * 访问统计用一组按key哈希值索引的计数器近似，计数达到IX_AHI_HOT_LOOKUPS的key才会加入，计数器定期减半；
+ * 访问分散、最近一个窗口内命中率很低时只按采样加入，避免冷key反复加入和淘汰拖慢点查；
+ * 项数受内存上限约束，满了之后按CLOCK算法淘汰；
+ * 叶子结点分裂、合并或重分配时调用invalidate_page，该页面上的项随之失效，在下次访问或淘汰时清除；
+ * 结点内的插入删除不会使项失效，槽位移动时由调用者在该叶子结点内重新查找并update
+ */
+class IxAdaptiveHash {
+   public:
+    struct Stats {
+        size_t hits = 0;            // 命中的点查次数
+        size_t misses = 0;          // 未命中的点查次数
+        size_t inserts = 0;         // 加入的项数
+        size_t evictions = 0;       // 因内存上限被淘汰的项数
+        size_t invalidations = 0;   // 因结点分裂、合并、删除而失效的项数
+    };
+
+   private:
+    struct Slot {
+        std::string key;
+        Iid iid;
+        uint32_t version;           // 加入时所在页面的版本，与页面当前版本不同即已失效
+        bool referenced;            // CLOCK算法的访问位
+    };
+
+    struct PageInfo {
+        uint32_t version = 0;
+        int num_slots = 0;          // 指向该页面的项数（包括已失效但未清除的项），为0时删除PageInfo
+    };
+
+    int key_len_;
+    size_t capacity_ = 0;           // 最多容纳的项数，为0时表示关闭
+    std::deque<Slot> slots_;        // 追加时已有元素的地址不变，map_中的key可以直接指向Slot中的字符串
+    std::vector<int> free_slots_;
+    size_t hand_ = 0;               // CLOCK指针
+    std::unordered_map<std::string_view, int> map_;    // key -> slots_下标
+    std::unordered_map<page_id_t, PageInfo> pages_;
+    std::array<uint8_t, IX_AHI_SKETCH_SIZE> heat_{};
+    size_t num_records_ = 0;
+    int window_lookups_ = 0;        // 当前窗口内的点查次数和命中次数
+    int window_hits_ = 0;
+    bool admit_all_ = true;         // 上一个窗口的命中率是否足够高
+    size_t num_candidates_ = 0;
+    Stats stats_;
+
+   public:
+    explicit IxAdaptiveHash(int key_len = 0, size_t max_bytes = 0) : key_len_(key_len) {
+        set_max_bytes(max_bytes);
+    }
+
+    /* 设置内存上限并清空，max_bytes为0时关闭自适应哈希 */
+    void set_max_bytes(size_t max_bytes) {
+        clear();
+        capacity_ = max_bytes / (key_len_ + sizeof(Slot) + IX_AHI_ENTRY_OVERHEAD);
+    }
+
+    bool enabled() const { return capacity_ > 0; }
+
+    size_t size() const { return map_.size(); }
+
+    size_t capacity() const { return capacity_; }
+
+    /* 估算当前占用的内存 */
+    size_t memory_bytes() const {
+        return slots_.size() * (key_len_ + sizeof(Slot) + IX_AHI_ENTRY_OVERHEAD) +
+               pages_.size() * (sizeof(page_id_t) + sizeof(PageInfo) + IX_AHI_ENTRY_OVERHEAD) + sizeof(heat_);
+    }
+
+    const Stats &stats() const { return stats_; }
+
+    /**
+     * @brief 查找key缓存的位置，每次调用计入一次命中或未命中
+     * @param[out] iid 命中时传出key所在的叶子结点和槽位，槽位可能已因结点内的插入删除而移动
+     */
+    bool lookup(const char *key, Iid *iid) {
+        if (!enabled()) {
+            return false;
+        }
+        if (++window_lookups_ == IX_AHI_WINDOW) {
+            admit_all_ = window_hits_ * IX_AHI_MIN_HIT_RATIO >= window_lookups_;
+            window_lookups_ = window_hits_ = 0;
+        }
+        auto it = map_.find(std::string_view(key, key_len_));
+        if (it == map_.end()) {
+            stats_.misses++;
+            return false;
+        }
+        Slot &slot = slots_[it->second];
+        if (slot.version != pages_.at(slot.iid.page_no).version) {
+            stats_.invalidations++;
+            remove(it->second);
+            stats_.misses++;
+            return false;
+        }
+        slot.referenced = true;
+        stats_.hits++;
+        window_hits_++;
+        *iid = slot.iid;
+        return true;
+    }
+
+    /**
+     * @brief 经过一次从根到叶的查找找到key之后调用，记录访问统计，key足够热时加入
+     */
+    void record(const char *key, const Iid &iid) {
+        if (!enabled()) {
+            return;
+        }
+        std::string_view view(key, key_len_);
+        if (++num_records_ % (IX_AHI_SKETCH_SIZE * 4) == 0) {
+            for (auto &heat : heat_) {
+                heat >>= 1;
+            }
+        }
+        uint8_t &heat = heat_[std::hash<std::string_view>()(view) % IX_AHI_SKETCH_SIZE];
+        if (heat < UINT8_MAX) {
+            heat++;
+        }
+        if (heat < IX_AHI_HOT_LOOKUPS || map_.count(view) > 0) {
+            return;
+        }
+        if (!admit_all_ && ++num_candidates_ % IX_AHI_SAMPLE_RATE != 0) {
+            return;
+        }
+        int idx = allocate_slot();
+        Slot &slot = slots_[idx];
+        slot.key.assign(key, key_len_);
+        slot.iid = iid;
+        PageInfo &page = pages_[iid.page_no];
+        page.num_slots++;
+        slot.version = page.version;
+        slot.referenced = false;
+        map_.emplace(std::string_view(slot.key), idx);
+        stats_.inserts++;
+    }
+
+    /* key仍在同一叶子结点中，只是槽位发生了移动 */
+    void update(const char *key, const Iid &iid) {
+        auto it = map_.find(std::string_view(key, key_len_));
+        if (it != map_.end() && slots_[it->second].iid.page_no == iid.page_no) {
+            slots_[it->second].iid = iid;
+        }
+    }
+
+    /* key被删除 */
+    void erase(const char *key) {
+        auto it = map_.find(std::string_view(key, key_len_));
+        if (it != map_.end()) {
+            stats_.invalidations++;
+            remove(it->second);
+        }
+    }
+
+    /* 页面上的key被移动到其他结点，指向该页面的项全部失效 */
+    void invalidate_page(page_id_t page_no) {
+        auto it = pages_.find(page_no);
+        if (it != pages_.end()) {
+            it->second.version++;
+        }
+    }
+
+    void clear() {
+        slots_.clear();
+        free_slots_.clear();
+        map_.clear();
+        pages_.clear();
+        heat_.fill(0);
+        hand_ = 0;
+        window_lookups_ = window_hits_ = 0;
+        admit_all_ = true;
+    }
+
+   private:
+    int allocate_slot() {
+        if (!free_slots_.empty()) {
+            int idx = free_slots_.back();
+            free_slots_.pop_back();
+            return idx;
+        }
+        if (slots_.size() < capacity_) {
+            slots_.emplace_back();
+            return slots_.size() - 1;
+        }
+        // CLOCK：跳过并清除访问位被置上的项，淘汰第一个访问位为0的项；已失效的项直接淘汰
+        while (true) {
+            int idx = hand_;
+            hand_ = (hand_ + 1) % slots_.size();
+            Slot &slot = slots_[idx];
+            if (slot.referenced && slot.version == pages_.at(slot.iid.page_no).version) {
+                slot.referenced = false;
+                continue;
+            }
+            stats_.evictions++;
+            remove(idx);
+            free_slots_.pop_back();
+            return idx;
+        }
+    }
+
+    void remove(int idx) {
+        Slot &slot = slots_[idx];
+        map_.erase(std::string_view(slot.key));
+        auto page = pages_.find(slot.iid.page_no);
+        if (--page->second.num_slots == 0) {
+            pages_.erase(page);
+        }
+        free_slots_.push_back(idx);
+    }
+};
@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 
 #include "defs.h"
@@ -21,6 +22,7 @@ constexpr int IX_LEAF_HEADER_PAGE = 1;
 constexpr int IX_INIT_ROOT_PAGE = 2;
 constexpr int IX_INIT_NUM_PAGES = 3;
 constexpr int IX_MAX_COL_LEN = 512;
+constexpr int IX_RID_KEY_LEN = 2 * sizeof(int);  // 非唯一索引的key中追加的rid长度
 
 class IxFileHdr {
 public: 
@@ -31,27 +33,34 @@ public:
     std::vector<ColType> col_types_;    // 字段的类型
     std::vector<int> col_lens_;         // 字段的长度
     int col_tot_len_;                   // 索引包含的字段的总长度
-    int btree_order_;                   // # children per page 每个结点最多可插入的键值对数量
-    int keys_size_;                     // keys_size = (btree_order + 1) * col_tot_len
+    bool unique_;                       // 是否为唯一索引
     // first_leaf初始化之后没有进行修改，只不过是在测试文件中遍历叶子结点的时候用了
     page_id_t first_leaf_;              // 首叶节点对应的页号，在上层IxManager的open函数进行初始化，初始化为root page_no
     page_id_t last_leaf_;               // 尾叶节点对应的页号
     int tot_len_;                       // 记录结构体的整体长度
+    // 以下两项不序列化，打开索引时推出
+    // 所有字段都是字符串时key可按字节比较，结点采用前缀压缩的变长格式
+    bool prefix_compress_;
+    // B+树中排序用的key长度：非唯一索引在索引字段之后追加大端序的rid，使每个键值对的key互不相同
+    int key_len_;
 
     IxFileHdr() {
         tot_len_ = col_num_ = 0;
+        unique_ = true;
+        prefix_compress_ = false;
     }
 
     IxFileHdr(page_id_t first_free_page_no, int num_pages, page_id_t root_page, int col_num,
-                int col_tot_len, int btree_order, int keys_size, page_id_t first_leaf, page_id_t last_leaf)
+                int col_tot_len, bool unique, page_id_t first_leaf, page_id_t last_leaf)
                 : first_free_page_no_(first_free_page_no), num_pages_(num_pages), root_page_(root_page), col_num_(col_num),
-                col_tot_len_(col_tot_len), btree_order_(btree_order), keys_size_(keys_size), first_leaf_(first_leaf), last_leaf_(last_leaf) {
+                col_tot_len_(col_tot_len), unique_(unique), first_leaf_(first_leaf), last_leaf_(last_leaf) {
                     tot_len_ = 0;
+                    prefix_compress_ = false;
                 } 
 
     void update_tot_len() {
         tot_len_ = 0;
-        tot_len_ += sizeof(page_id_t) * 4 + sizeof(int) * 6;
+        tot_len_ += sizeof(page_id_t) * 4 + sizeof(int) * 5;
         tot_len_ += sizeof(ColType) * col_num_ + sizeof(int) * col_num_;
     }
 
@@ -77,9 +86,8 @@ public:
         }
         memcpy(dest + offset, &col_tot_len_, sizeof(int));
         offset += sizeof(int);
-        memcpy(dest + offset, &btree_order_, sizeof(int));
-        offset += sizeof(int);
-        memcpy(dest + offset, &keys_size_, sizeof(int));
+        int unique = unique_;
+        memcpy(dest + offset, &unique, sizeof(int));
         offset += sizeof(int);
         memcpy(dest + offset, &first_leaf_, sizeof(page_id_t));
         offset += sizeof(page_id_t);
@@ -100,7 +108,6 @@ public:
         offset += sizeof(page_id_t);
         col_num_ = *reinterpret_cast<const int*>(src + offset);
         offset += sizeof(int);
-        std::cout << col_num_ << "\n";
         for(int i = 0; i < col_num_; ++i) {
             // col_types_[i] = *reinterpret_cast<const ColType*>(src + offset);
             ColType type = *reinterpret_cast<const ColType*>(src + offset);
@@ -115,18 +122,30 @@ public:
         }
         col_tot_len_ = *reinterpret_cast<const int*>(src + offset);
         offset += sizeof(int);
-        btree_order_ = *reinterpret_cast<const int*>(src + offset);
-        offset += sizeof(int);
-        keys_size_ = *reinterpret_cast<const int*>(src + offset);
+        unique_ = *reinterpret_cast<const int*>(src + offset) != 0;
         offset += sizeof(int);
         first_leaf_ = *reinterpret_cast<const page_id_t*>(src+ offset);
         offset += sizeof(page_id_t);
         last_leaf_ = *reinterpret_cast<const page_id_t*>(src + offset);
         offset += sizeof(page_id_t);
         assert(offset == tot_len_);
+        prefix_compress_ = std::all_of(col_types_.begin(), col_types_.end(),
+                                       [](ColType type) { return type == TYPE_STRING; });
+        key_len_ = col_tot_len_ + (unique_ ? 0 : IX_RID_KEY_LEN);
     }
 };
 
+/**
+ * @brief B+树结点的页头
+ * 页面布局为 [IxPageHdr][Rid * num_key][key部分]，key部分有两种格式：
+ * 1. 定长格式（索引含非字符串字段）：num_key个完整的key，每个长度为key_len
+ * 2. 前缀压缩格式（索引字段全为字符串）：[uint16_t end * num_key][公共前缀][各key的后缀]
+ *    key去掉公共前缀和末尾的'\0'后存为变长后缀，第i个后缀为[end[i-1], end[i])；
+ *    内部结点的第0个key不参与查找，其后缀长度为0，也不参与公共前缀的计算
+ * 非唯一索引的叶子结点按posting list存放：索引字段相同的键值对为一组，rid按序连续存放在Rid数组中，
+ * 每组只存一份长度为col_tot_len的索引字段，key部分之前多一个[uint16_t group_end * num_group]，
+ * 第i组包含的键值对为[group_end[i-1], group_end[i])；内部结点仍存放追加了rid的完整key
+ */
 class IxPageHdr {
 public:
     page_id_t next_free_page_no;    // unused
@@ -135,6 +154,9 @@ public:
     bool is_leaf;                   // 是否为叶节点
     page_id_t prev_leaf;            // previous leaf node's page_no, effective only when is_leaf is true
     page_id_t next_leaf;            // next leaf node's page_no, effective only when is_leaf is true
+    int prefix_len;                 // 结点内key的公共前缀长度，定长格式下为0
+    int suffix_bytes;               // 各key后缀的总字节数
+    int num_group;                  // 非唯一索引叶子结点中posting list的数量
 };
 
 class Iid {
@@ -145,4 +167,89 @@ public:
     friend bool operator==(const Iid &x, const Iid &y) { return x.page_no == y.page_no && x.slot_no == y.slot_no; }
 
     friend bool operator!=(const Iid &x, const Iid &y) { return !(x == y); }
-};
\ No newline at end of file
+};
+
+constexpr int IX_HASH_DIR_PAGE = 1;
+constexpr int IX_HASH_INIT_BUCKET_PAGE = 2;
+constexpr int IX_HASH_INIT_NUM_PAGES = 3;
+constexpr int IX_HASH_DIR_SLOTS_PER_PAGE = PAGE_SIZE / sizeof(page_id_t);
+constexpr int IX_HASH_MAX_GLOBAL_DEPTH = 18;    // 目录最多2^18项，即256个目录页
+
+/* 可扩展哈希索引的文件头，存放在第0页 */
+class IxHashFileHdr {
+public:
+    page_id_t first_free_page_no_;          // 回收的空闲页链表的表头，空闲页之间通过IxHashBucketHdr::next_free_page_no相连
+    int num_pages_;                         // 磁盘文件中页面的数量（高水位）
+    int global_depth_;                      // 全局深度，目录共有2^global_depth_项
+    int col_num_;                           // 索引包含的字段数量
+    std::vector<ColType> col_types_;        // 字段的类型
+    std::vector<int> col_lens_;             // 字段的长度
+    int col_tot_len_;                       // 索引包含的字段的总长度
+    int bucket_capacity_;                   // 每个桶最多存放的键值对数量
+    std::vector<page_id_t> dir_page_nos_;   // 目录页的页号，第i个目录页存放目录项[i*SLOTS, (i+1)*SLOTS)
+    int tot_len_;                           // 序列化后的长度
+
+    IxHashFileHdr() {
+        tot_len_ = col_num_ = 0;
+    }
+
+    void update_tot_len() {
+        tot_len_ = sizeof(page_id_t) + sizeof(int) * 7;
+        tot_len_ += (sizeof(ColType) + sizeof(int)) * col_num_;
+        tot_len_ += sizeof(page_id_t) * dir_page_nos_.size();
+    }
+
+    void serialize(char* dest) {
+        update_tot_len();
+        int offset = 0;
+        int num_dir_pages = dir_page_nos_.size();
+        auto put = [&](const void *src, size_t len) {
+            memcpy(dest + offset, src, len);
+            offset += len;
+        };
+        put(&tot_len_, sizeof(int));
+        put(&first_free_page_no_, sizeof(page_id_t));
+        put(&num_pages_, sizeof(int));
+        put(&global_depth_, sizeof(int));
+        put(&col_num_, sizeof(int));
+        for (int i = 0; i < col_num_; ++i) put(&col_types_[i], sizeof(ColType));
+        for (int i = 0; i < col_num_; ++i) put(&col_lens_[i], sizeof(int));
+        put(&col_tot_len_, sizeof(int));
+        put(&bucket_capacity_, sizeof(int));
+        put(&num_dir_pages, sizeof(int));
+        for (int i = 0; i < num_dir_pages; ++i) put(&dir_page_nos_[i], sizeof(page_id_t));
+        assert(offset == tot_len_);
+    }
+
+    void deserialize(const char* src) {
+        int offset = 0;
+        int num_dir_pages;
+        auto get = [&](void *dest, size_t len) {
+            memcpy(dest, src + offset, len);
+            offset += len;
+        };
+        get(&tot_len_, sizeof(int));
+        get(&first_free_page_no_, sizeof(page_id_t));
+        get(&num_pages_, sizeof(int));
+        get(&global_depth_, sizeof(int));
+        get(&col_num_, sizeof(int));
+        col_types_.resize(col_num_);
+        col_lens_.resize(col_num_);
+        for (int i = 0; i < col_num_; ++i) get(&col_types_[i], sizeof(ColType));
+        for (int i = 0; i < col_num_; ++i) get(&col_lens_[i], sizeof(int));
+        get(&col_tot_len_, sizeof(int));
+        get(&bucket_capacity_, sizeof(int));
+        get(&num_dir_pages, sizeof(int));
+        dir_page_nos_.resize(num_dir_pages);
+        for (int i = 0; i < num_dir_pages; ++i) get(&dir_page_nos_[i], sizeof(page_id_t));
+        assert(offset == tot_len_);
+    }
+};
+
+/* 哈希桶页的页头，其后紧跟bucket_capacity_个[key|Rid]键值对 */
+class IxHashBucketHdr {
+public:
+    page_id_t next_free_page_no;    // 页面被回收后指向下一个空闲页
+    int local_depth;                // 局部深度
+    int num_entries;                // 桶中已有的键值对数量
+};
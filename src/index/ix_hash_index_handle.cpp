@@ -0,0 +1,298 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "ix_hash_index_handle.h"
+
+#include <algorithm>
+
+IxHashIndexHandle::IxHashIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
+    : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd) {
+    char *buf = new char[PAGE_SIZE];
+    memset(buf, 0, PAGE_SIZE);
+    disk_manager_->read_page(fd, IX_FILE_HDR_PAGE, buf, PAGE_SIZE);
+    file_hdr_ = new IxHashFileHdr();
+    file_hdr_->deserialize(buf);
+    delete[] buf;
+
+    entry_size_ = file_hdr_->col_tot_len_ + sizeof(Rid);
+    disk_manager_->set_fd2pageno(fd, file_hdr_->num_pages_);
+
+    // 把目录读入内存
+    dir_.resize(1 << file_hdr_->global_depth_);
+    for (size_t i = 0; i < file_hdr_->dir_page_nos_.size(); ++i) {
+        PageId dir_page_id = {fd_, file_hdr_->dir_page_nos_[i]};
+        Page *dir_page = buffer_pool_manager_->fetch_page(dir_page_id);
+        size_t n = std::min(dir_.size() - i * IX_HASH_DIR_SLOTS_PER_PAGE, (size_t)IX_HASH_DIR_SLOTS_PER_PAGE);
+        memcpy(dir_.data() + i * IX_HASH_DIR_SLOTS_PER_PAGE, dir_page->get_data(), n * sizeof(page_id_t));
+        buffer_pool_manager_->unpin_page(dir_page_id, false);
+    }
+}
+
+/**
+ * @description: FNV-1a哈希；浮点数+0.0与-0.0比较相等，哈希前统一为+0.0
+ */
+uint32_t IxHashIndexHandle::hash(const char *key) const {
+    uint32_t h = 2166136261u;
+    int offset = 0;
+    for (int i = 0; i < file_hdr_->col_num_; ++i) {
+        const char *col = key + offset;
+        float zero = 0;
+        if (file_hdr_->col_types_[i] == TYPE_FLOAT && *reinterpret_cast<const float *>(col) == 0) {
+            col = reinterpret_cast<const char *>(&zero);
+        }
+        for (int j = 0; j < file_hdr_->col_lens_[i]; ++j) {
+            h ^= static_cast<unsigned char>(col[j]);
+            h *= 16777619u;
+        }
+        offset += file_hdr_->col_lens_[i];
+    }
+    return h;
+}
+
+/**
+ * @description: 在桶中查找key，返回其下标，不存在时返回-1
+ */
+int IxHashIndexHandle::find_entry(Page *page, const char *key) const {
+    int n = bucket_hdr(page)->num_entries;
+    for (int i = 0; i < n; ++i) {
+        if (key_equal(entry_key(page, i), key)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void IxHashIndexHandle::set_bucket_page_no(uint32_t dir_idx, page_id_t page_no) {
+    PageId dir_page_id = {fd_, file_hdr_->dir_page_nos_[dir_idx / IX_HASH_DIR_SLOTS_PER_PAGE]};
+    Page *dir_page = buffer_pool_manager_->fetch_page(dir_page_id);
+    reinterpret_cast<page_id_t *>(dir_page->get_data())[dir_idx % IX_HASH_DIR_SLOTS_PER_PAGE] = page_no;
+    buffer_pool_manager_->unpin_page(dir_page_id, true);
+    dir_[dir_idx] = page_no;
+}
+
+/**
+ * @description: 目录翻倍，新的目录项[n, 2n)复制自[0, n)
+ */
+void IxHashIndexHandle::expand_directory() {
+    int n = 1 << file_hdr_->global_depth_;
+    if (n < IX_HASH_DIR_SLOTS_PER_PAGE) {
+        // 目录只占一页，在页内复制
+        PageId dir_page_id = {fd_, file_hdr_->dir_page_nos_[0]};
+        Page *dir_page = buffer_pool_manager_->fetch_page(dir_page_id);
+        auto slots = reinterpret_cast<page_id_t *>(dir_page->get_data());
+        memcpy(slots + n, slots, n * sizeof(page_id_t));
+        buffer_pool_manager_->unpin_page(dir_page_id, true);
+    } else {
+        // 目录跨页，逐页复制出新的目录页
+        size_t num_dir_pages = file_hdr_->dir_page_nos_.size();
+        for (size_t i = 0; i < num_dir_pages; ++i) {
+            PageId old_page_id = {fd_, file_hdr_->dir_page_nos_[i]};
+            Page *old_page = buffer_pool_manager_->fetch_page(old_page_id);
+            Page *new_page = allocate_page();
+            memcpy(new_page->get_data(), old_page->get_data(), PAGE_SIZE);
+            file_hdr_->dir_page_nos_.push_back(new_page->get_page_id().page_no);
+            buffer_pool_manager_->unpin_page(new_page->get_page_id(), true);
+            buffer_pool_manager_->unpin_page(old_page_id, false);
+        }
+    }
+    dir_.insert(dir_.end(), dir_.begin(), dir_.end());
+    file_hdr_->global_depth_++;
+}
+
+/**
+ * @description: 当目录的前后两半完全相同（即所有桶的局部深度都小于全局深度）时，目录减半
+ */
+void IxHashIndexHandle::shrink_directory() {
+    while (file_hdr_->global_depth_ > 0) {
+        size_t half = dir_.size() / 2;
+        if (!std::equal(dir_.begin(), dir_.begin() + half, dir_.begin() + half)) {
+            break;
+        }
+        if (half >= (size_t)IX_HASH_DIR_SLOTS_PER_PAGE) {
+            // 后一半目录页不再使用，回收到空闲页链表
+            size_t half_pages = file_hdr_->dir_page_nos_.size() / 2;
+            for (size_t i = half_pages; i < half_pages * 2; ++i) {
+                free_page(file_hdr_->dir_page_nos_[i]);
+            }
+            file_hdr_->dir_page_nos_.resize(half_pages);
+        }
+        dir_.resize(half);
+        file_hdr_->global_depth_--;
+    }
+}
+
+/**
+ * @description: 分裂dir_idx指向的桶bucket，按哈希值的第local_depth位把键值对分到新桶中，并更新指向它的目录项
+ * @note 调用前需保证local_depth < global_depth，bucket由调用者unpin
+ */
+void IxHashIndexHandle::split_bucket(Page *bucket, uint32_t dir_idx) {
+    auto hdr = bucket_hdr(bucket);
+    int local_depth = hdr->local_depth;
+    uint32_t high_bit = 1u << local_depth;
+
+    Page *new_bucket = allocate_page();
+    auto new_hdr = bucket_hdr(new_bucket);
+    new_hdr->next_free_page_no = IX_NO_PAGE;
+    new_hdr->local_depth = local_depth + 1;
+    new_hdr->num_entries = 0;
+    hdr->local_depth = local_depth + 1;
+
+    int kept = 0;
+    for (int i = 0; i < hdr->num_entries; ++i) {
+        char *src = entry_key(bucket, i);
+        if (hash(src) & high_bit) {
+            memcpy(entry_key(new_bucket, new_hdr->num_entries++), src, entry_size_);
+        } else {
+            if (kept != i) {
+                memcpy(entry_key(bucket, kept), src, entry_size_);
+            }
+            kept++;
+        }
+    }
+    hdr->num_entries = kept;
+
+    // 低local_depth位与dir_idx相同、第local_depth位为1的目录项改为指向新桶
+    page_id_t new_page_no = new_bucket->get_page_id().page_no;
+    uint32_t dir_size = 1u << file_hdr_->global_depth_;
+    for (uint32_t i = (dir_idx & (high_bit - 1)) | high_bit; i < dir_size; i += high_bit << 1) {
+        set_bucket_page_no(i, new_page_no);
+    }
+    buffer_pool_manager_->unpin_page(new_bucket->get_page_id(), true);
+}
+
+/**
+ * @description: 分配一个页面，优先复用空闲页链表中的页面
+ * @note 返回的页面已pin，需要调用者unpin
+ */
+Page *IxHashIndexHandle::allocate_page() {
+    if (file_hdr_->first_free_page_no_ != IX_NO_PAGE) {
+        Page *page = buffer_pool_manager_->fetch_page(PageId{fd_, file_hdr_->first_free_page_no_});
+        file_hdr_->first_free_page_no_ = bucket_hdr(page)->next_free_page_no;
+        memset(page->get_data(), 0, PAGE_SIZE);
+        return page;
+    }
+    file_hdr_->num_pages_++;
+    PageId new_page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
+    return buffer_pool_manager_->new_page(&new_page_id);
+}
+
+void IxHashIndexHandle::free_page(page_id_t page_no) {
+    PageId page_id = {fd_, page_no};
+    Page *page = buffer_pool_manager_->fetch_page(page_id);
+    bucket_hdr(page)->next_free_page_no = file_hdr_->first_free_page_no_;
+    file_hdr_->first_free_page_no_ = page_no;
+    buffer_pool_manager_->unpin_page(page_id, true);
+}
+
+/**
+ * @description: 等值查找key对应的Rid
+ * @return bool 是否找到
+ */
+bool IxHashIndexHandle::get_value(const char *key, std::vector<Rid> *result, Transaction *transaction) {
+    std::scoped_lock lock{latch_};
+    uint32_t dir_idx = hash(key) & ((1u << file_hdr_->global_depth_) - 1);
+    PageId bucket_id = {fd_, get_bucket_page_no(dir_idx)};
+    Page *bucket = buffer_pool_manager_->fetch_page(bucket_id);
+    int pos = find_entry(bucket, key);
+    if (pos != -1) {
+        result->push_back(*entry_rid(bucket, pos));
+    }
+    buffer_pool_manager_->unpin_page(bucket_id, false);
+    return pos != -1;
+}
+
+/**
+ * @description: 插入键值对，桶满时分裂桶（局部深度等于全局深度时先将目录翻倍）后重试
+ * @return page_id_t 插入到的桶页号，key已存在时返回IX_NO_PAGE
+ */
+page_id_t IxHashIndexHandle::insert_entry(const char *key, const Rid &value, Transaction *transaction) {
+    std::scoped_lock lock{latch_};
+    uint32_t h = hash(key);
+    while (true) {
+        uint32_t dir_idx = h & ((1u << file_hdr_->global_depth_) - 1);
+        PageId bucket_id = {fd_, get_bucket_page_no(dir_idx)};
+        Page *bucket = buffer_pool_manager_->fetch_page(bucket_id);
+        auto hdr = bucket_hdr(bucket);
+        if (find_entry(bucket, key) != -1) {
+            buffer_pool_manager_->unpin_page(bucket_id, false);
+            return IX_NO_PAGE;
+        }
+        if (hdr->num_entries < file_hdr_->bucket_capacity_) {
+            memcpy(entry_key(bucket, hdr->num_entries), key, file_hdr_->col_tot_len_);
+            *entry_rid(bucket, hdr->num_entries) = value;
+            hdr->num_entries++;
+            buffer_pool_manager_->unpin_page(bucket_id, true);
+            return bucket_id.page_no;
+        }
+        if (hdr->local_depth == file_hdr_->global_depth_) {
+            if (file_hdr_->global_depth_ == IX_HASH_MAX_GLOBAL_DEPTH) {
+                buffer_pool_manager_->unpin_page(bucket_id, false);
+                throw InternalError("IxHashIndexHandle::insert_entry Directory exceeds max global depth");
+            }
+            expand_directory();
+        }
+        split_bucket(bucket, dir_idx);
+        buffer_pool_manager_->unpin_page(bucket_id, true);
+    }
+}
+
+/**
+ * @description: 删除key对应的键值对；桶删空后与局部深度相同的伙伴桶合并，并尝试缩小目录
+ * @return bool 是否删除成功
+ */
+bool IxHashIndexHandle::delete_entry(const char *key, Transaction *transaction) {
+    std::scoped_lock lock{latch_};
+    uint32_t dir_idx = hash(key) & ((1u << file_hdr_->global_depth_) - 1);
+    PageId bucket_id = {fd_, get_bucket_page_no(dir_idx)};
+    Page *bucket = buffer_pool_manager_->fetch_page(bucket_id);
+    auto hdr = bucket_hdr(bucket);
+    int pos = find_entry(bucket, key);
+    if (pos == -1) {
+        buffer_pool_manager_->unpin_page(bucket_id, false);
+        return false;
+    }
+    // 桶内无序，用最后一个键值对填补空位
+    hdr->num_entries--;
+    if (pos != hdr->num_entries) {
+        memcpy(entry_key(bucket, pos), entry_key(bucket, hdr->num_entries), entry_size_);
+    }
+
+    bool merged = false;
+    while (hdr->num_entries == 0 && hdr->local_depth > 0) {
+        int local_depth = hdr->local_depth;
+        uint32_t buddy_idx = dir_idx ^ (1u << (local_depth - 1));
+        PageId buddy_id = {fd_, get_bucket_page_no(buddy_idx)};
+        Page *buddy = buffer_pool_manager_->fetch_page(buddy_id);
+        if (bucket_hdr(buddy)->local_depth != local_depth) {
+            buffer_pool_manager_->unpin_page(buddy_id, false);
+            break;
+        }
+        // 所有指向空桶的目录项改为指向伙伴桶，伙伴桶局部深度减一
+        bucket_hdr(buddy)->local_depth--;
+        uint32_t low_mask = (1u << (local_depth - 1)) - 1;
+        uint32_t dir_size = 1u << file_hdr_->global_depth_;
+        for (uint32_t i = dir_idx & low_mask; i < dir_size; i += 1u << (local_depth - 1)) {
+            set_bucket_page_no(i, buddy_id.page_no);
+        }
+        buffer_pool_manager_->unpin_page(bucket_id, true);
+        free_page(bucket_id.page_no);
+
+        bucket_id = buddy_id;
+        bucket = buddy;
+        hdr = bucket_hdr(bucket);
+        dir_idx &= low_mask;
+        merged = true;
+    }
+    buffer_pool_manager_->unpin_page(bucket_id, true);
+    if (merged) {
+        shrink_directory();
+    }
+    return true;
+}
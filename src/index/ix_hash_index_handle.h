@@ -0,0 +1,102 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "ix_index_handle.h"
+
+/**
+ * @brief 可扩展哈希索引，只支持等值查找
+ * 第0页为文件头，目录页存放2^global_depth个桶页号，目录项下标为key哈希值的低global_depth位；
+ * 桶满时分裂（必要时目录翻倍），桶删空时与伙伴桶合并（必要时目录减半）；
+ * 打开索引时目录被读入内存，点查只需访问一个桶页
+ */
+class IxHashIndexHandle {
+    friend class IxManager;
+
+   private:
+    DiskManager *disk_manager_;
+    BufferPoolManager *buffer_pool_manager_;
+    int fd_;                        // 存储哈希索引的文件
+    IxHashFileHdr *file_hdr_;
+    int entry_size_;                // 每个键值对[key|Rid]的长度
+    std::vector<page_id_t> dir_;    // 目录在内存中的副本，修改时同时写回目录页，查找时无需再访问目录页
+    std::mutex latch_;
+
+   public:
+    IxHashIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
+
+    ~IxHashIndexHandle() { delete file_hdr_; }
+
+    bool get_value(const char *key, std::vector<Rid> *result, Transaction *transaction);
+
+    page_id_t insert_entry(const char *key, const Rid &value, Transaction *transaction);
+
+    bool delete_entry(const char *key, Transaction *transaction);
+
+    int get_global_depth() const { return file_hdr_->global_depth_; }
+
+    int get_fd() const { return fd_; }
+
+   private:
+    uint32_t hash(const char *key) const;
+
+    bool key_equal(const char *a, const char *b) const {
+        return ix_compare(a, b, file_hdr_->col_types_, file_hdr_->col_lens_) == 0;
+    }
+
+    // 桶页内的访问
+    static IxHashBucketHdr *bucket_hdr(Page *page) { return reinterpret_cast<IxHashBucketHdr *>(page->get_data()); }
+
+    char *entry_key(Page *page, int i) const {
+        return page->get_data() + sizeof(IxHashBucketHdr) + i * entry_size_;
+    }
+
+    Rid *entry_rid(Page *page, int i) const { return reinterpret_cast<Rid *>(entry_key(page, i) + file_hdr_->col_tot_len_); }
+
+    int find_entry(Page *page, const char *key) const;
+
+    // 目录的访问
+    page_id_t get_bucket_page_no(uint32_t dir_idx) const { return dir_[dir_idx]; }
+
+    void set_bucket_page_no(uint32_t dir_idx, page_id_t page_no);
+
+    void expand_directory();
+
+    void shrink_directory();
+
+    void split_bucket(Page *bucket, uint32_t dir_idx);
+
+    // 页面的分配与回收
+    Page *allocate_page();
+
+    void free_page(page_id_t page_no);
+};
+
+/**
+ * @brief 指向B+树索引或哈希索引句柄的引用（不持有句柄），DML执行器通过它统一维护表上的各类索引
+ */
+struct IxIndexRef {
+    IxIndexHandle *btree = nullptr;
+    IxHashIndexHandle *hash = nullptr;
+
+    bool get_value(const char *key, std::vector<Rid> *result, Transaction *transaction) {
+        return hash != nullptr ? hash->get_value(key, result, transaction) : btree->get_value(key, result, transaction);
+    }
+
+    page_id_t insert_entry(const char *key, const Rid &value, Transaction *transaction) {
+        return hash != nullptr ? hash->insert_entry(key, value, transaction) : btree->insert_entry(key, value, transaction);
+    }
+
+    // 哈希索引总是唯一索引，只按key删除；非唯一的B+树索引需要value确定要删除的键值对
+    bool delete_entry(const char *key, const Rid &value, Transaction *transaction) {
+        return hash != nullptr ? hash->delete_entry(key, transaction) : btree->delete_entry(key, value, transaction);
+    }
+};
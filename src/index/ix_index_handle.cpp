@@ -10,21 +10,215 @@ See the Mulan PSL v2 for more details. */
 
 #include "ix_index_handle.h"
 
+#include <numeric>
+
 #include "ix_scan.h"
 
+/* key去掉末尾'\0'后的长度 */
+static inline int ix_trimmed_len(const char *key, int len) {
+    while (len > 0 && key[len - 1] == '\0') {
+        len--;
+    }
+    return len;
+}
+
+/* 两个key的最长公共前缀长度 */
+static inline int ix_common_prefix_len(const char *a, const char *b, int len) {
+    int i = 0;
+    while (i < len && a[i] == b[i]) {
+        i++;
+    }
+    return i;
+}
+
+/* 非唯一索引的两个key的索引字段是否相同，即是否属于叶子结点中的同一组 */
+static inline bool ix_same_group(const IxFileHdr *file_hdr, const char *a, const char *b) {
+    if (file_hdr->prefix_compress_) {
+        return memcmp(a, b, file_hdr->col_tot_len_) == 0;
+    }
+    return ix_compare(a, b, file_hdr->col_types_, file_hdr->col_lens_) == 0;
+}
+
+/**
+ * @brief 分组的叶子结点中，第rid_idx个键值对所在的组
+ */
+int IxNodeHandle::group_of(int rid_idx) const {
+    const uint16_t *ends = group_ends();
+    return std::upper_bound(ends, ends + page_hdr->num_group, rid_idx) - ends;
+}
+
+/**
+ * @brief 取得第entry_idx个key去掉公共前缀后的部分
+ *
+ * @param[out] len 后缀长度；定长格式下即为entry_len
+ */
+const char *IxNodeHandle::get_suffix(int entry_idx, int *len) const {
+    if (!file_hdr->prefix_compress_) {
+        *len = entry_len();
+        return prefix() + entry_idx * entry_len();
+    }
+    const uint16_t *ends = suffix_ends();
+    int begin = entry_idx == 0 ? 0 : ends[entry_idx - 1];
+    *len = ends[entry_idx] - begin;
+    return prefix() + page_hdr->prefix_len + begin;
+}
+
+/**
+ * @brief 读取结点中存放的第entry_idx个key，还原为长度为entry_len的完整key
+ */
+void IxNodeHandle::get_entry(int entry_idx, char *key) const {
+    int prefix_len = page_hdr->prefix_len;
+    int len;
+    const char *suffix = get_suffix(entry_idx, &len);
+    memcpy(key, prefix(), prefix_len);
+    memcpy(key + prefix_len, suffix, len);
+    memset(key + prefix_len + len, 0, entry_len() - prefix_len - len);
+}
+
+/**
+ * @brief 读取第key_idx个key，还原为长度为key_len的完整key
+ * 分组的叶子结点中由所在组的索引字段和该键值对的rid拼成
+ *
+ * @param[out] key 传出参数，调用者需保证至少有key_len字节的空间
+ */
+void IxNodeHandle::get_key(int key_idx, char *key) const {
+    if (!is_grouped()) {
+        get_entry(key_idx, key);
+        return;
+    }
+    get_entry(group_of(key_idx), key);
+    ix_encode_rid(rids[key_idx], key + file_hdr->col_tot_len_);
+}
+
+/**
+ * @brief 前缀压缩格式下，比较第entry_idx个key的后缀与target去掉公共前缀后的部分rest
+ * 两者末尾的'\0'都已去掉，因此公共部分相同时较短者较小
+ */
+int IxNodeHandle::compare_suffix(int entry_idx, const char *rest, int rest_len) const {
+    int len;
+    const char *suffix = get_suffix(entry_idx, &len);
+    int res = memcmp(suffix, rest, std::min(len, rest_len));
+    if (res != 0) {
+        return res;
+    }
+    return len < rest_len ? -1 : (len > rest_len ? 1 : 0);
+}
+
+/**
+ * @brief 比较结点中存放的第entry_idx个key与target的前entry_len个字节
+ * 定长格式下先按字段类型比较索引字段，再按字节比较追加的rid
+ */
+int IxNodeHandle::compare_entry(int entry_idx, const char *target) const {
+    int len = entry_len();
+    if (!file_hdr->prefix_compress_) {
+        const char *key = prefix() + entry_idx * len;
+        int res = ix_compare(key, target, file_hdr->col_types_, file_hdr->col_lens_);
+        if (res != 0 || len == file_hdr->col_tot_len_) {
+            return res;
+        }
+        int col_tot_len = file_hdr->col_tot_len_;
+        return memcmp(key + col_tot_len, target + col_tot_len, len - col_tot_len);
+    }
+    int prefix_len = page_hdr->prefix_len;
+    int res = memcmp(prefix(), target, prefix_len);
+    if (res != 0) {
+        return res;
+    }
+    int rest_len = std::max(0, ix_trimmed_len(target, len) - prefix_len);
+    return compare_suffix(entry_idx, target + prefix_len, rest_len);
+}
+
+/**
+ * @brief 比较第key_idx个key与完整的target
+ */
+int IxNodeHandle::compare_key(int key_idx, const char *target) const {
+    if (!is_grouped()) {
+        return compare_entry(key_idx, target);
+    }
+    int res = compare_entry(group_of(key_idx), target);
+    if (res != 0) {
+        return res;
+    }
+    char rid[IX_RID_KEY_LEN];
+    ix_encode_rid(rids[key_idx], rid);
+    return memcmp(rid, target + file_hdr->col_tot_len_, IX_RID_KEY_LEN);
+}
+
+/**
+ * @brief 在结点中存放的[left,num_entries)个key上二分查找
+ * 前缀压缩格式下target先与公共前缀比较一次，之后只比较后缀
+ */
+int IxNodeHandle::search_entries(const char *target, bool upper, int left) const {
+    int right = num_entries();
+    if (!file_hdr->prefix_compress_) {
+        while (left < right) {
+            int mid = (left + right) / 2;
+            int res = compare_entry(mid, target);
+            if (res < 0 || (upper && res == 0)) {
+                left = mid + 1;
+            } else {
+                right = mid;
+            }
+        }
+        return left;
+    }
+    int prefix_len = page_hdr->prefix_len;
+    int res = memcmp(prefix(), target, prefix_len);
+    if (res != 0) {
+        // 公共前缀不同：target小于或大于结点内所有key
+        return res > 0 ? left : right;
+    }
+    const char *rest = target + prefix_len;
+    int rest_len = std::max(0, ix_trimmed_len(target, entry_len()) - prefix_len);
+    while (left < right) {
+        int mid = (left + right) / 2;
+        res = compare_suffix(mid, rest, rest_len);
+        if (res < 0 || (upper && res == 0)) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+/**
+ * @brief lower_bound和upper_bound的二分查找
+ * 内部结点的第0个key不参与查找，从1开始；
+ * 分组的叶子结点先按索引字段找到组，target的索引字段与该组相同时再在组内按rid查找
+ */
+int IxNodeHandle::search(const char *target, bool upper) const {
+    if (!is_grouped()) {
+        return search_entries(target, upper, page_hdr->is_leaf ? 0 : 1);
+    }
+    int group = search_entries(target, false, 0);
+    int left = group_begin(group);
+    if (group == page_hdr->num_group || compare_entry(group, target) != 0) {
+        return left;
+    }
+    int right = group_ends()[group];
+    const char *target_rid = target + file_hdr->col_tot_len_;
+    char rid[IX_RID_KEY_LEN];
+    while (left < right) {
+        int mid = (left + right) / 2;
+        ix_encode_rid(rids[mid], rid);
+        int res = memcmp(rid, target_rid, IX_RID_KEY_LEN);
+        if (res < 0 || (upper && res == 0)) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
 /**
  * @brief 在当前node中查找第一个>=target的key_idx
  *
  * @return key_idx，范围为[0,num_key)，如果返回的key_idx=num_key，则表示target大于最后一个key
  * @note 返回key index（同时也是rid index），作为slot no
  */
-int IxNodeHandle::lower_bound(const char *target) const {
-    // Todo:
-    // 查找当前节点中第一个大于等于target的key，并返回key的位置给上层
-    // 提示: 可以采用多种查找方式，如顺序遍历、二分查找等；使用ix_compare()函数进行比较
-
-    return -1;
-}
+int IxNodeHandle::lower_bound(const char *target) const { return search(target, false); }
 
 /**
  * @brief 在当前node中查找第一个>target的key_idx
@@ -32,13 +226,7 @@ int IxNodeHandle::lower_bound(const char *target) const {
  * @return key_idx，范围为[1,num_key)，如果返回的key_idx=num_key，则表示target大于等于最后一个key
  * @note 注意此处的范围从1开始
  */
-int IxNodeHandle::upper_bound(const char *target) const {
-    // Todo:
-    // 查找当前节点中第一个大于target的key，并返回key的位置给上层
-    // 提示: 可以采用多种查找方式：顺序遍历、二分查找等；使用ix_compare()函数进行比较
-
-    return -1;
-}
+int IxNodeHandle::upper_bound(const char *target) const { return search(target, true); }
 
 /**
  * @brief 用于叶子结点根据key来查找该结点中的键值对
@@ -49,13 +237,12 @@ int IxNodeHandle::upper_bound(const char *target) const {
  * @return 目标key是否存在
  */
 bool IxNodeHandle::leaf_lookup(const char *key, Rid **value) {
-    // Todo:
-    // 1. 在叶子节点中获取目标key所在位置
-    // 2. 判断目标key是否存在
-    // 3. 如果存在，获取key对应的Rid，并赋值给传出参数value
-    // 提示：可以调用lower_bound()和get_rid()函数。
-
-    return false;
+    int key_idx = lower_bound(key);
+    if (key_idx == page_hdr->num_key || compare_key(key_idx, key) != 0) {
+        return false;
+    }
+    *value = get_rid(key_idx);
+    return true;
 }
 
 /**
@@ -64,65 +251,282 @@ bool IxNodeHandle::leaf_lookup(const char *key, Rid **value) {
  * @return page_id_t 目标key所在的孩子节点（子树）的存储页面编号
  */
 page_id_t IxNodeHandle::internal_lookup(const char *key) {
-    // Todo:
-    // 1. 查找当前非叶子节点中目标key所在孩子节点（子树）的位置
-    // 2. 获取该孩子节点（子树）所在页面的编号
-    // 3. 返回页面编号
+    int key_idx = upper_bound(key);
+    return value_at(key_idx - 1);
+}
 
-    return -1;
+/**
+ * @brief 将结点中的全部键值对解压到image中
+ */
+void IxNodeHandle::load(IxNodeImage *image) const {
+    int n = page_hdr->num_key;
+    image->key_len = file_hdr->key_len_;
+    image->keys.resize(static_cast<size_t>(n) * image->key_len);
+    image->rids.assign(rids, rids + n);
+    if (!file_hdr->prefix_compress_ && !is_grouped()) {
+        memcpy(image->keys.data(), prefix(), image->keys.size());
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        get_key(i, image->key(i));
+    }
 }
 
 /**
- * @brief 在指定位置插入n个连续的键值对
- * 将key的前n位插入到原来keys中的pos位置；将rid的前n位插入到原来rids中的pos位置
- *
- * @param pos 要插入键值对的位置
- * @param (key, rid) 连续键值对的起始地址，也就是第一个键值对，可以通过(key, rid)来获取n个键值对
- * @param n 键值对数量
- * @note [0,pos)           [pos,num_key)
- *                            key_slot
- *                            /      \
- *                           /        \
- *       [0,pos)     [pos,pos+n)   [pos+n,num_key+n)
- *                      key           key_slot
+ * @brief image中[begin,end)的键值对写入当前结点时实际存放的各key的下标
+ * 分组的叶子结点中每组只存放第一个key的索引字段
  */
-void IxNodeHandle::insert_pairs(int pos, const char *key, const Rid *rid, int n) {
-    // Todo:
-    // 1. 判断pos的合法性
-    // 2. 通过key获取n个连续键值对的key值，并把n个key值插入到pos位置
-    // 3. 通过rid获取n个连续键值对的rid值，并把n个rid值插入到pos位置
-    // 4. 更新当前节点的键数量
+void IxNodeHandle::entry_heads(const IxNodeImage &image, int begin, int end, std::vector<int> *heads) const {
+    bool grouped = is_grouped();
+    heads->clear();
+    for (int i = begin; i < end; i++) {
+        if (!grouped || i == begin || !ix_same_group(file_hdr, image.key(i - 1), image.key(i))) {
+            heads->push_back(i);
+        }
+    }
+}
 
+/**
+ * @brief image中[begin,end)的键值对写入当前结点后，结点占用的字节数
+ * 有序的key的公共前缀即为首尾两个key的公共前缀；内部结点的第0个key不参与
+ */
+int IxNodeHandle::encoded_size(const IxNodeImage &image, int begin, int end) const {
+    std::vector<int> heads;
+    entry_heads(image, begin, end, &heads);
+    int n = end - begin;
+    int num = heads.size();
+    int len = entry_len();
+    int bytes = sizeof(IxPageHdr) + n * sizeof(Rid);
+    if (is_grouped()) {
+        bytes += num * sizeof(uint16_t);
+    }
+    if (!file_hdr->prefix_compress_) {
+        return bytes + num * len;
+    }
+    int first = page_hdr->is_leaf ? 0 : 1;
+    int prefix_len = 0;
+    if (first < num) {
+        const char *first_key = image.key(heads[first]);
+        prefix_len = first == num - 1 ? ix_trimmed_len(first_key, len)
+                                      : ix_common_prefix_len(first_key, image.key(heads[num - 1]), len);
+    }
+    bytes += num * sizeof(uint16_t) + prefix_len;
+    for (int k = first; k < num; k++) {
+        bytes += std::max(0, ix_trimmed_len(image.key(heads[k]), len) - prefix_len);
+    }
+    return bytes;
 }
 
 /**
- * @brief 用于在结点中插入单个键值对。
- * 函数返回插入后的键值对数量
+ * @brief 用image中[begin,end)的键值对重写当前结点
+ * 调用前结点的is_leaf需已设置好
  *
- * @param (key, value) 要插入的键值对
- * @return int 键值对数量
+ * @return 放不下时返回false，结点保持不变
  */
-int IxNodeHandle::insert(const char *key, const Rid &value) {
-    // Todo:
-    // 1. 查找要插入的键值对应该插入到当前节点的哪个位置
-    // 2. 如果key重复则不插入
-    // 3. 如果key不重复则插入键值对
-    // 4. 返回完成插入操作之后的键值对数量
+bool IxNodeHandle::store(const IxNodeImage &image, int begin, int end) {
+    if (encoded_size(image, begin, end) > PAGE_SIZE) {
+        return false;
+    }
+    std::vector<int> heads;
+    entry_heads(image, begin, end, &heads);
+    int n = end - begin;
+    int num = heads.size();
+    int len = entry_len();
+    page_hdr->num_key = n;
+    page_hdr->num_group = is_grouped() ? num : 0;
+    memcpy(rids, image.rids.data() + begin, n * sizeof(Rid));
+    if (is_grouped()) {
+        uint16_t *ends = group_ends();
+        for (int k = 0; k < num; k++) {
+            ends[k] = (k + 1 < num ? heads[k + 1] : end) - begin;
+        }
+    }
+    if (!file_hdr->prefix_compress_) {
+        page_hdr->prefix_len = 0;
+        page_hdr->suffix_bytes = num * len;
+        for (int k = 0; k < num; k++) {
+            memcpy(prefix() + k * len, image.key(heads[k]), len);
+        }
+        return true;
+    }
+    int first = page_hdr->is_leaf ? 0 : 1;
+    int prefix_len = 0;
+    if (first < num) {
+        const char *first_key = image.key(heads[first]);
+        prefix_len = first == num - 1 ? ix_trimmed_len(first_key, len)
+                                      : ix_common_prefix_len(first_key, image.key(heads[num - 1]), len);
+        memcpy(prefix(), first_key, prefix_len);
+    }
+    page_hdr->prefix_len = prefix_len;
+    uint16_t *ends = suffix_ends();
+    char *suffixes = prefix() + prefix_len;
+    int offset = 0;
+    for (int k = 0; k < num; k++) {
+        if (k >= first) {
+            const char *key = image.key(heads[k]);
+            int suffix_len = std::max(0, ix_trimmed_len(key, len) - prefix_len);
+            memcpy(suffixes + offset, key + prefix_len, suffix_len);
+            offset += suffix_len;
+        }
+        ends[k] = offset;
+    }
+    page_hdr->suffix_bytes = offset;
+    return true;
+}
 
-    return -1;
+/**
+ * @brief 分组的叶子结点中，把键值对原地加入pos两侧索引字段与key相同的组
+ *
+ * @return 没有这样的组或页面放不下时返回false
+ */
+bool IxNodeHandle::insert_into_group(int pos, const char *key, const Rid &rid) {
+    int n = page_hdr->num_key;
+    int group = -1;
+    if (pos > 0 && compare_entry(group_of(pos - 1), key) == 0) {
+        group = group_of(pos - 1);
+    } else if (pos < n && compare_entry(group_of(pos), key) == 0) {
+        group = group_of(pos);
+    }
+    int used = get_used_bytes();
+    if (group < 0 || used + static_cast<int>(sizeof(Rid)) > PAGE_SIZE) {
+        return false;
+    }
+    // rids增长一项，其后的部分整体后移sizeof(Rid)
+    char *tail = reinterpret_cast<char *>(rids + n);
+    memmove(tail + sizeof(Rid), tail, used - sizeof(IxPageHdr) - n * sizeof(Rid));
+    memmove(rids + pos + 1, rids + pos, (n - pos) * sizeof(Rid));
+    rids[pos] = rid;
+    page_hdr->num_key++;
+    uint16_t *ends = group_ends();
+    for (int g = group; g < page_hdr->num_group; g++) {
+        ends[g]++;
+    }
+    return true;
 }
 
 /**
- * @brief 用于在结点中的指定位置删除单个键值对
+ * @brief 在结点的pos位置原地插入一个键值对，保持结点的公共前缀不变
+ * 内部结点不会在第0个位置插入；分组的叶子结点只能原地加入已有的组
+ *
+ * @return key与公共前缀不符或页面放不下时返回false，结点保持不变，由调用者重写结点或分裂
+ */
+bool IxNodeHandle::insert_pair(int pos, const char *key, const Rid &rid) {
+    int n = page_hdr->num_key;
+    assert(pos >= 0 && pos <= n && (page_hdr->is_leaf || pos > 0));
+    if (is_grouped()) {
+        return insert_into_group(pos, key, rid);
+    }
+    int key_len = entry_len();
+    char *old_keys = prefix();
+    if (!file_hdr->prefix_compress_) {
+        if (get_used_bytes() + static_cast<int>(sizeof(Rid)) + key_len > PAGE_SIZE) {
+            return false;
+        }
+        // rids增长一项，key部分整体后移sizeof(Rid)
+        char *new_keys = old_keys + sizeof(Rid);
+        memmove(new_keys + (pos + 1) * key_len, old_keys + pos * key_len, (n - pos) * key_len);
+        memmove(new_keys, old_keys, pos * key_len);
+        memcpy(new_keys + pos * key_len, key, key_len);
+    } else {
+        int prefix_len = page_hdr->prefix_len;
+        if (memcmp(old_keys, key, prefix_len) != 0) {
+            return false;
+        }
+        int len = std::max(0, ix_trimmed_len(key, key_len) - prefix_len);
+        if (get_used_bytes() + static_cast<int>(sizeof(Rid) + sizeof(uint16_t)) + len > PAGE_SIZE) {
+            return false;
+        }
+        // rids和ends各增长一项，公共前缀和后缀整体后移sizeof(Rid) + sizeof(uint16_t)，从高地址往低地址依次搬动
+        const int shift = sizeof(Rid) + sizeof(uint16_t);
+        uint16_t *old_ends = suffix_ends();
+        uint16_t *new_ends = reinterpret_cast<uint16_t *>(reinterpret_cast<char *>(old_ends) + sizeof(Rid));
+        char *old_suffixes = old_keys + prefix_len;
+        char *new_suffixes = old_suffixes + shift;
+        int off = pos == 0 ? 0 : old_ends[pos - 1];
+        int total = page_hdr->suffix_bytes;
+        memmove(new_suffixes + off + len, old_suffixes + off, total - off);
+        memmove(new_suffixes, old_suffixes, off);
+        memcpy(new_suffixes + off, key + prefix_len, len);
+        memmove(old_keys + shift, old_keys, prefix_len);
+        for (int i = n - 1; i >= pos; i--) {
+            new_ends[i + 1] = old_ends[i] + len;
+        }
+        new_ends[pos] = off + len;
+        for (int i = pos - 1; i >= 0; i--) {
+            new_ends[i] = old_ends[i];
+        }
+        page_hdr->suffix_bytes += len;
+    }
+    memmove(rids + pos + 1, rids + pos, (n - pos) * sizeof(Rid));
+    rids[pos] = rid;
+    page_hdr->num_key++;
+    return true;
+}
+
+/**
+ * @brief 用于在结点中的指定位置删除单个键值对，保持结点的公共前缀不变
+ * 分组的叶子结点中删除一组的最后一个键值对时重写整个结点
  *
  * @param pos 要删除键值对的位置
  */
 void IxNodeHandle::erase_pair(int pos) {
-    // Todo:
-    // 1. 删除该位置的key
-    // 2. 删除该位置的rid
-    // 3. 更新结点的键值对数量
-
+    int n = page_hdr->num_key;
+    assert(pos >= 0 && pos < n);
+    if (is_grouped()) {
+        int group = group_of(pos);
+        if (group_ends()[group] - group_begin(group) == 1) {
+            // 去掉一组后占用的字节数只会减少，总能放下
+            IxNodeImage image;
+            load(&image);
+            image.erase(pos);
+            bool stored = store(image, 0, image.size());
+            assert(stored);
+            (void)stored;
+            return;
+        }
+        // rids减少一项，其后的部分整体前移sizeof(Rid)
+        int used = get_used_bytes();
+        char *tail = reinterpret_cast<char *>(rids + n);
+        memmove(rids + pos, rids + pos + 1, (n - pos - 1) * sizeof(Rid));
+        memmove(tail - sizeof(Rid), tail, used - sizeof(IxPageHdr) - n * sizeof(Rid));
+        page_hdr->num_key--;
+        uint16_t *ends = group_ends();
+        for (int g = group; g < page_hdr->num_group; g++) {
+            ends[g]--;
+        }
+        return;
+    }
+    int key_len = entry_len();
+    char *old_keys = prefix();
+    memmove(rids + pos, rids + pos + 1, (n - pos - 1) * sizeof(Rid));
+    if (!file_hdr->prefix_compress_) {
+        // rids减少一项，key部分整体前移sizeof(Rid)
+        char *new_keys = old_keys - sizeof(Rid);
+        memmove(new_keys, old_keys, pos * key_len);
+        memmove(new_keys + pos * key_len, old_keys + (pos + 1) * key_len, (n - pos - 1) * key_len);
+    } else {
+        // rids和ends各减少一项，从低地址往高地址依次搬动
+        const int shift = sizeof(Rid) + sizeof(uint16_t);
+        int prefix_len = page_hdr->prefix_len;
+        const uint16_t *old_ends = suffix_ends();
+        uint16_t *new_ends = reinterpret_cast<uint16_t *>(reinterpret_cast<char *>(rids) + (n - 1) * sizeof(Rid));
+        char *old_suffixes = old_keys + prefix_len;
+        char *new_suffixes = old_suffixes - shift;
+        int off = pos == 0 ? 0 : old_ends[pos - 1];
+        int len = old_ends[pos] - off;
+        int total = page_hdr->suffix_bytes;
+        for (int i = 0; i < pos; i++) {
+            new_ends[i] = old_ends[i];
+        }
+        for (int i = pos; i < n - 1; i++) {
+            new_ends[i] = old_ends[i + 1] - len;
+        }
+        memmove(old_keys - shift, old_keys, prefix_len);
+        memmove(new_suffixes, old_suffixes, off);
+        memmove(new_suffixes + off, old_suffixes + off + len, total - off - len);
+        page_hdr->suffix_bytes -= len;
+    }
+    page_hdr->num_key--;
 }
 
 /**
@@ -132,12 +536,11 @@ void IxNodeHandle::erase_pair(int pos) {
  * @return 完成删除操作后的键值对数量
  */
 int IxNodeHandle::remove(const char *key) {
-    // Todo:
-    // 1. 查找要删除键值对的位置
-    // 2. 如果要删除的键值对存在，删除键值对
-    // 3. 返回完成删除操作后的键值对数量
-
-    return -1;
+    int pos = lower_bound(key);
+    if (pos < page_hdr->num_key && compare_key(pos, key) == 0) {
+        erase_pair(pos);
+    }
+    return page_hdr->num_key;
 }
 
 IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
@@ -150,9 +553,13 @@ IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffe
     file_hdr_ = new IxFileHdr();
     file_hdr_->deserialize(buf);
     
+    delete[] buf;
+
     // disk_manager管理的fd对应的文件中，设置从file_hdr_->num_pages开始分配page_no
-    int now_page_no = disk_manager_->get_fd2pageno(fd);
-    disk_manager_->set_fd2pageno(fd, now_page_no + 1);
+    // 注意：被删除的结点页面不会被回收，num_pages_即为文件中已分配页面的高水位
+    disk_manager_->set_fd2pageno(fd, file_hdr_->num_pages_);
+    last_insert_leaf_ = file_hdr_->last_leaf_;
+    adaptive_hash_ = IxAdaptiveHash(file_hdr_->key_len_, file_hdr_->unique_ ? IX_AHI_DEFAULT_MAX_BYTES : 0);
 }
 
 /**
@@ -170,8 +577,51 @@ std::pair<IxNodeHandle *, bool> IxIndexHandle::find_leaf_page(const char *key, O
     // 1. 获取根节点
     // 2. 从根节点开始不断向下查找目标key
     // 3. 找到包含该key值的叶子结点停止查找，并返回叶子节点
-
-    return std::make_pair(nullptr, false);
+    // 先沿常驻内存的结点向下查找，孩子已转换为指针时无需访问缓冲池
+    IxNodeHandle *node = nullptr;
+    IxResidentNode *resident = nullptr;
+    if (resident_depth_ > 0) {
+        if (resident_root_ != nullptr && resident_root_->node.get_page_no() == file_hdr_->root_page_) {
+            resident = resident_root_;
+        } else {
+            release_resident();
+            node = fetch_node(file_hdr_->root_page_);
+            resident = resident_root_ = make_resident(node);
+            if (resident != nullptr) {
+                node = nullptr;
+            }
+        }
+    } else {
+        node = fetch_node(file_hdr_->root_page_);
+    }
+    for (int depth = 0; resident != nullptr; depth++) {
+        int idx = find_first ? 0 : resident->node.upper_bound(key) - 1;
+        assert(static_cast<int>(resident->children.size()) == resident->node.get_size());
+        IxResidentNode *&child = resident->children[idx];
+        if (child == nullptr) {
+            page_id_t child_page_no = resident->node.value_at(idx);
+            auto it = resident_.find(child_page_no);
+            if (it != resident_.end()) {
+                child = it->second.get();
+            } else {
+                node = fetch_node(child_page_no);
+                if (depth + 1 < resident_depth_) {
+                    child = make_resident(node);
+                }
+                if (child == nullptr) {
+                    break;
+                }
+            }
+        }
+        resident = child;
+    }
+    while (!node->is_leaf_page()) {
+        page_id_t child_page_no = find_first ? node->value_at(0) : node->internal_lookup(key);
+        buffer_pool_manager_->unpin_page(node->get_page_id(), false);
+        delete node;
+        node = fetch_node(child_page_no);
+    }
+    return std::make_pair(node, false);
 }
 
 /**
@@ -188,80 +638,369 @@ bool IxIndexHandle::get_value(const char *key, std::vector<Rid> *result, Transac
     // 2. 在叶子节点中查找目标key值的位置，并读取key对应的rid
     // 3. 把rid存入result参数中
     // 提示：使用完buffer_pool提供的page之后，记得unpin page；记得处理并发的上锁
+    std::scoped_lock lock{root_latch_};
+    if (!bloom_may_contain(key)) {
+        return false;
+    }
+    if (file_hdr_->unique_) {
+        if (lookup_adaptive_hash(key, result)) {
+            return true;
+        }
+        IxNodeHandle *leaf = find_leaf_page(key, Operation::FIND, transaction).first;
+        int pos = leaf->lower_bound(key);
+        bool found = pos < leaf->get_size() && leaf->compare_key(pos, key) == 0;
+        if (found) {
+            result->push_back(*leaf->get_rid(pos));
+            adaptive_hash_.record(key, Iid{.page_no = leaf->get_page_no(), .slot_no = pos});
+        }
+        buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+        delete leaf;
+        return found;
+    }
 
-    return false;
+    // 非唯一索引：key对应的键值对位于[key+最小rid, key+最大rid)之间，可能跨越多个叶子结点
+    int col_tot_len = file_hdr_->col_tot_len_;
+    std::vector<char> lower(file_hdr_->key_len_, 0), upper(file_hdr_->key_len_, static_cast<char>(0xff));
+    memcpy(lower.data(), key, col_tot_len);
+    memcpy(upper.data(), key, col_tot_len);
+    IxNodeHandle *leaf = find_leaf_page(lower.data(), Operation::FIND, transaction).first;
+    bool found = false;
+    int pos = leaf->lower_bound(lower.data());
+    while (true) {
+        if (pos == leaf->get_size()) {
+            if (leaf->get_page_no() == file_hdr_->last_leaf_) {
+                break;
+            }
+            page_id_t next = leaf->get_next_leaf();
+            buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+            delete leaf;
+            leaf = fetch_node(next);
+            pos = 0;
+            continue;
+        }
+        if (leaf->compare_key(pos, upper.data()) >= 0) {
+            break;
+        }
+        result->push_back(*leaf->get_rid(pos++));
+        found = true;
+    }
+    buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+    delete leaf;
+    return found;
+}
+
+/**
+ * @brief 一次查找多个key，结果与对每个key调用get_value相同
+ * 先将key排序，再按顺序查找：保留上一个key从根到叶的路径，下一个key在某一层仍落在同一个孩子中时
+ * （只需与该孩子右侧的分隔key比较一次）直接沿用下一层的结点，不必重新fetch和二分查找；
+ * 因此落在同一叶子结点的key只读取该叶子一次，路径上的结点在整批查找中只pin一次
+ *
+ * @param keys n个key，只包含索引字段
+ * @param[out] results n个结果容器，results[i]追加keys[i]对应的rid
+ * @return 找到的key的个数
+ */
+int IxIndexHandle::get_values_batch(const char *const *keys, int n, std::vector<Rid> *results,
+                                    Transaction *transaction) {
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return ix_compare(keys[a], keys[b], file_hdr_->col_types_, file_hdr_->col_lens_) < 0;
+    });
+
+    std::scoped_lock lock{root_latch_};
+    // Bloom过滤器确定不存在的key不必查找
+    order.erase(std::remove_if(order.begin(), order.end(), [&](int i) { return !bloom_may_contain(keys[i]); }),
+                order.end());
+    struct PathLevel {
+        IxNodeHandle *node;
+        int child_idx;      // 上一个key在该结点中进入的孩子
+    };
+    std::vector<PathLevel> path;
+    IxNodeHandle *leaf = nullptr;
+    auto release = [&](IxNodeHandle *node) {
+        buffer_pool_manager_->unpin_page(node->get_page_id(), false);
+        delete node;
+    };
+
+    bool unique = file_hdr_->unique_;
+    int col_tot_len = file_hdr_->col_tot_len_;
+    std::vector<char> lower(file_hdr_->key_len_, 0), upper(file_hdr_->key_len_, static_cast<char>(0xff));
+    int num_found = 0;
+    for (int i : order) {
+        // 非唯一索引中key对应的键值对位于[key+最小rid, key+最大rid)之间
+        const char *target = keys[i];
+        if (!unique) {
+            memcpy(lower.data(), keys[i], col_tot_len);
+            memcpy(upper.data(), keys[i], col_tot_len);
+            target = lower.data();
+        }
+        // 找到第一个target不再落在原孩子中的层，从该层开始重新向下查找
+        size_t level = 0;
+        while (level < path.size()) {
+            PathLevel &p = path[level];
+            int next = p.child_idx + 1;
+            if (next < p.node->get_size() && p.node->compare_key(next, target) <= 0) {
+                break;
+            }
+            level++;
+        }
+        bool descend = false;
+        if (leaf == nullptr) {
+            IxNodeHandle *root = fetch_node(file_hdr_->root_page_);
+            if (root->is_leaf_page()) {
+                leaf = root;
+            } else {
+                path.push_back({root, 0});
+                descend = true;
+            }
+        } else if (level < path.size()) {
+            for (size_t j = level + 1; j < path.size(); j++) {
+                release(path[j].node);
+            }
+            path.resize(level + 1);
+            release(leaf);
+            descend = true;
+        }
+        while (descend) {
+            PathLevel &p = path.back();
+            p.child_idx = p.node->upper_bound(target) - 1;
+            IxNodeHandle *child = fetch_node(p.node->value_at(p.child_idx));
+            if (child->is_leaf_page()) {
+                leaf = child;
+                break;
+            }
+            path.push_back({child, 0});
+        }
+
+        int pos = leaf->lower_bound(target);
+        if (unique) {
+            if (pos < leaf->get_size() && leaf->compare_key(pos, target) == 0) {
+                results[i].push_back(*leaf->get_rid(pos));
+                num_found++;
+            }
+            continue;
+        }
+        // 同一key的键值对可能延续到后面的叶子结点，后面的叶子另外读取，不影响保留的路径
+        IxNodeHandle *node = leaf;
+        bool found = false;
+        while (true) {
+            if (pos == node->get_size()) {
+                if (node->get_page_no() == file_hdr_->last_leaf_) {
+                    break;
+                }
+                page_id_t next = node->get_next_leaf();
+                if (node != leaf) {
+                    release(node);
+                }
+                node = fetch_node(next);
+                pos = 0;
+                continue;
+            }
+            if (node->compare_key(pos, upper.data()) >= 0) {
+                break;
+            }
+            results[i].push_back(*node->get_rid(pos++));
+            found = true;
+        }
+        if (node != leaf) {
+            release(node);
+        }
+        num_found += found;
+    }
+    for (auto &p : path) {
+        release(p.node);
+    }
+    if (leaf != nullptr) {
+        release(leaf);
+    }
+    return num_found;
 }
 
 /**
  * @brief  将传入的一个node拆分(Split)成两个结点，在node的右边生成一个新结点new node
  * @param node 需要拆分的结点
+ * @param image node插入新键值对之后的全部内容（已超出一个页面）
+ * @param mid 分裂位置，[0,mid)留在node中，[mid,size)移入new node
  * @return 拆分得到的new_node
  * @note need to unpin the new node outside
  * 注意：本函数执行完毕后，原node和new node都需要在函数外面进行unpin
  */
-IxNodeHandle *IxIndexHandle::split(IxNodeHandle *node) {
-    // Todo:
-    // 1. 将原结点的键值对平均分配，右半部分分裂为新的右兄弟结点
-    //    需要初始化新节点的page_hdr内容
-    // 2. 如果新的右兄弟结点是叶子结点，更新新旧节点的prev_leaf和next_leaf指针
-    //    为新节点分配键值对，更新旧节点的键值对数记录
-    // 3. 如果新的右兄弟结点不是叶子结点，更新该结点的所有孩子结点的父节点信息(使用IxIndexHandle::maintain_child())
+IxNodeHandle *IxIndexHandle::split(IxNodeHandle *node, const IxNodeImage &image, int mid) {
+    IxNodeHandle *new_node = create_node();
+    new_node->page_hdr->next_free_page_no = IX_NO_PAGE;
+    new_node->page_hdr->parent = node->get_parent_page_no();
+    new_node->page_hdr->num_key = 0;
+    new_node->page_hdr->is_leaf = node->is_leaf_page();
+    new_node->page_hdr->prev_leaf = IX_NO_PAGE;
+    new_node->page_hdr->next_leaf = IX_NO_PAGE;
+
+    bool stored = node->store(image, 0, mid) && new_node->store(image, mid, image.size());
+    assert(stored);
+    (void)stored;
+    invalidate_leaf(node);
 
-    return nullptr;
+    if (new_node->is_leaf_page()) {
+        new_node->set_prev_leaf(node->get_page_no());
+        new_node->set_next_leaf(node->get_next_leaf());
+        IxNodeHandle *next = fetch_node(node->get_next_leaf());
+        next->set_prev_leaf(new_node->get_page_no());
+        buffer_pool_manager_->unpin_page(next->get_page_id(), true);
+        delete next;
+        node->set_next_leaf(new_node->get_page_no());
+    } else {
+        for (int i = 0; i < new_node->get_size(); i++) {
+            maintain_child(new_node, i);
+        }
+        unswizzle(node->get_page_no());
+    }
+    return new_node;
 }
 
 /**
  * @brief Insert key & value pair into internal page after split
  * 拆分(Split)后，向上找到old_node的父结点
- * 将new_node的第一个key插入到父结点，其位置在 父结点指向old_node的孩子指针 之后
- * 如果插入后>=maxsize，则必须继续拆分父结点，然后在其父结点的父结点再插入，即需要递归
+ * 将分隔old_node和new_node的key插入到父结点，其位置在 父结点指向old_node的孩子指针 之后
+ * 如果插入后父结点放不下，则必须继续拆分父结点，然后在其父结点的父结点再插入，即需要递归
  * 直到找到的old_node为根结点时，结束递归（此时将会新建一个根R，关键字为key，old_node和new_node为其孩子）
  *
  * @param (old_node, new_node) 原结点为old_node，old_node被分裂之后产生了新的右兄弟结点new_node
- * @param key 要插入parent的key
- * @note 一个结点插入了键值对之后需要分裂，分裂后左半部分的键值对保留在原结点，在参数中称为old_node，
- * 右半部分的键值对分裂为新的右兄弟节点，在参数中称为new_node（参考Split函数来理解old_node和new_node）
+ * @param key 要插入parent的分隔键，old_node中的key都小于它，new_node中的key都不小于它
+ * @param append 是否为最右路径上的追加插入，此时父结点若需分裂，原有的孩子全部留在左边
  * @note 本函数执行完毕后，new node和old node都需要在函数外面进行unpin
  */
 void IxIndexHandle::insert_into_parent(IxNodeHandle *old_node, const char *key, IxNodeHandle *new_node,
-                                     Transaction *transaction) {
-    // Todo:
-    // 1. 分裂前的结点（原结点, old_node）是否为根结点，如果为根结点需要分配新的root
-    // 2. 获取原结点（old_node）的父亲结点
-    // 3. 获取key对应的rid，并将(key, rid)插入到父亲结点
-    // 4. 如果父亲结点仍需要继续分裂，则进行递归插入
-    // 提示：记得unpin page
+                                     Transaction *transaction, bool append) {
+    if (old_node->is_root_page()) {
+        IxNodeHandle *new_root = create_node();
+        new_root->page_hdr->next_free_page_no = IX_NO_PAGE;
+        new_root->page_hdr->parent = IX_NO_PAGE;
+        new_root->page_hdr->num_key = 0;
+        new_root->page_hdr->is_leaf = false;
+        new_root->page_hdr->prev_leaf = IX_NO_PAGE;
+        new_root->page_hdr->next_leaf = IX_NO_PAGE;
+        // 内部结点的第0个key不参与查找，这里用key占位
+        IxNodeImage image(file_hdr_->key_len_);
+        image.insert(0, key, Rid{old_node->get_page_no(), -1});
+        image.insert(1, key, Rid{new_node->get_page_no(), -1});
+        new_root->store(image, 0, image.size());
+        old_node->set_parent_page_no(new_root->get_page_no());
+        new_node->set_parent_page_no(new_root->get_page_no());
+        update_root_page_no(new_root->get_page_no());
+        release_resident();
+        buffer_pool_manager_->unpin_page(new_root->get_page_id(), true);
+        delete new_root;
+        return;
+    }
+
+    IxNodeHandle *parent = fetch_node(old_node->get_parent_page_no());
+    int rank = parent->find_child(old_node);
+    new_node->set_parent_page_no(parent->get_page_no());
+    if (!parent->insert_pair(rank + 1, key, Rid{new_node->get_page_no(), -1})) {
+        // 原地插入不了时重写整个结点，仍放不下则分裂
+        IxNodeImage image;
+        parent->load(&image);
+        image.insert(rank + 1, key, Rid{new_node->get_page_no(), -1});
+        if (!parent->store(image, 0, image.size())) {
+            // 内部结点分裂时，第mid个key上移到祖父结点，成为new_parent中不参与查找的第0个key
+            append = append && rank + 1 == image.size() - 1;
+            int mid = append ? image.size() - 1 : split_point(image, false);
+            IxNodeHandle *new_parent = split(parent, image, mid);
+            insert_into_parent(parent, image.key(mid), new_parent, transaction, append);
+            buffer_pool_manager_->unpin_page(new_parent->get_page_id(), true);
+            delete new_parent;
+        }
+    }
+    unswizzle(parent->get_page_no());
+    buffer_pool_manager_->unpin_page(parent->get_page_id(), true);
+    delete parent;
 }
 
 /**
  * @brief 将指定键值对插入到B+树中
  * @param (key, value) 要插入的键值对
  * @param transaction 事务指针
- * @return page_id_t 插入到的叶结点的page_no
+ * @return page_id_t 插入到的叶结点的page_no；键值对已存在时返回IX_NO_PAGE
+ * @note 非唯一索引中key可以重复，只有key和value都相同时才算已存在
  */
 page_id_t IxIndexHandle::insert_entry(const char *key, const Rid &value, Transaction *transaction) {
-    // Todo:
-    // 1. 查找key值应该插入到哪个叶子节点
-    // 2. 在该叶子节点中插入键值对
-    // 3. 如果结点已满，分裂结点，并把新结点的相关信息插入父节点
-    // 提示：记得unpin page；若当前叶子节点是最右叶子节点，则需要更新file_hdr_.last_leaf；记得处理并发的上锁
+    std::scoped_lock lock{root_latch_};
+    const char *col_key = key;
+    std::vector<char> tree_key;
+    key = make_tree_key(key, value, &tree_key);
+    IxNodeHandle *leaf = find_insert_leaf(key, transaction);
+    int pos = leaf->lower_bound(key);
+    if (pos < leaf->get_size() && leaf->compare_key(pos, key) == 0) {
+        // key重复，不插入
+        buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+        delete leaf;
+        return IX_NO_PAGE;
+    }
 
-    return -1;
+    // 在最右叶子的末尾追加，即按递增顺序插入
+    bool append = leaf->get_page_no() == file_hdr_->last_leaf_ && pos == leaf->get_size();
+    page_id_t leaf_page_no = leaf->get_page_no();
+    if (!leaf->insert_pair(pos, key, value)) {
+        // 原地插入不了时重写整个结点，仍放不下则分裂
+        IxNodeImage image;
+        leaf->load(&image);
+        image.insert(pos, key, value);
+        if (!leaf->store(image, 0, image.size())) {
+            // 放不下时分裂，分隔键取两侧key的最短区分前缀
+            // 递增插入时原有的key全部留在左边（100/0分裂），之后的key都会追加到新叶子中，叶子结点几乎是满的
+            int mid = append ? image.size() - 1 : split_point(image, true);
+            IxNodeHandle *new_leaf = split(leaf, image, mid);
+            if (file_hdr_->last_leaf_ == leaf->get_page_no()) {
+                file_hdr_->last_leaf_ = new_leaf->get_page_no();
+            }
+            std::vector<char> sep(file_hdr_->key_len_);
+            make_separator(image.key(mid - 1), image.key(mid), sep.data());
+            insert_into_parent(leaf, sep.data(), new_leaf, transaction, append);
+            if (pos >= mid) {
+                leaf_page_no = new_leaf->get_page_no();
+            }
+            buffer_pool_manager_->unpin_page(new_leaf->get_page_id(), true);
+            delete new_leaf;
+        }
+    }
+    buffer_pool_manager_->unpin_page(leaf->get_page_id(), true);
+    delete leaf;
+    last_insert_leaf_ = leaf_page_no;
+    bloom_insert(col_key);
+    return leaf_page_no;
 }
 
 /**
  * @brief 用于删除B+树中含有指定key的键值对
- * @param key 要删除的key值
+ * @param key 要删除的key值，非唯一索引中为追加了rid的完整key
  * @param transaction 事务指针
  */
 bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
-    // Todo:
-    // 1. 获取该键值对所在的叶子结点
-    // 2. 在该叶子结点中删除键值对
-    // 3. 如果删除成功需要调用CoalesceOrRedistribute来进行合并或重分配操作，并根据函数返回结果判断是否有结点需要删除
-    // 4. 如果需要并发，并且需要删除叶子结点，则需要在事务的delete_page_set中添加删除结点的对应页面；记得处理并发的上锁
+    std::scoped_lock lock{root_latch_};
+    IxNodeHandle *leaf = find_leaf_page(key, Operation::DELETE, transaction).first;
+    int old_size = leaf->get_size();
+    if (leaf->remove(key) == old_size) {
+        buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+        delete leaf;
+        return false;
+    }
+    adaptive_hash_.erase(key);
+    // 父结点中的分隔键仍不大于叶子中剩余的key，无需更新
+    bool should_delete = coalesce_or_redistribute(leaf, transaction);
+    PageId leaf_page_id = leaf->get_page_id();
+    buffer_pool_manager_->unpin_page(leaf_page_id, true);
+    if (should_delete) {
+        buffer_pool_manager_->delete_page(leaf_page_id);
+    }
+    delete leaf;
+    return true;
+}
 
-    return false;
+/**
+ * @brief 删除键值对(key, value)，非唯一索引中需要value才能确定要删除的键值对
+ */
+bool IxIndexHandle::delete_entry(const char *key, const Rid &value, Transaction *transaction) {
+    std::vector<char> tree_key;
+    return delete_entry(make_tree_key(key, value, &tree_key), transaction);
 }
 
 /**
@@ -271,21 +1010,63 @@ bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
  * @param transaction 事务指针
  * @param root_is_latched 传出参数：根节点是否上锁，用于并发操作
  * @return 是否需要删除结点
- * @note User needs to first find the sibling of input page.
- * If sibling's size + input page's size >= 2 * page's minsize, then redistribute.
- * Otherwise, merge(Coalesce).
+ * @note 结点占用不足半个页面时，若与兄弟结点合并后能放进一个页面则合并(Coalesce)，否则重新分配(Redistribute)
  */
 bool IxIndexHandle::coalesce_or_redistribute(IxNodeHandle *node, Transaction *transaction, bool *root_is_latched) {
-    // Todo:
-    // 1. 判断node结点是否为根节点
-    //    1.1 如果是根节点，需要调用AdjustRoot() 函数来进行处理，返回根节点是否需要被删除
-    //    1.2 如果不是根节点，并且不需要执行合并或重分配操作，则直接返回false，否则执行2
-    // 2. 获取node结点的父亲结点
-    // 3. 寻找node结点的兄弟结点（优先选取前驱结点）
-    // 4. 如果node结点和兄弟结点的键值对数量之和，能够支撑两个B+树结点（即node.size+neighbor.size >=
-    // NodeMinSize*2)，则只需要重新分配键值对（调用Redistribute函数）
-    // 5. 如果不满足上述条件，则需要合并两个结点，将右边的结点合并到左边的结点（调用Coalesce函数）
+    if (node->is_root_page()) {
+        return adjust_root(node);
+    }
+    if (!node->is_underflow()) {
+        return false;
+    }
+
+    IxNodeHandle *parent = fetch_node(node->get_parent_page_no());
+    if (parent->get_size() < 2) {
+        // 没有兄弟结点
+        buffer_pool_manager_->unpin_page(parent->get_page_id(), false);
+        delete parent;
+        return false;
+    }
+    int index = parent->find_child(node);
+    IxNodeHandle *neighbor = fetch_node(parent->value_at(index == 0 ? index + 1 : index - 1));
+
+    IxNodeImage image;
+    if (index == 0) {
+        merge_siblings(node, neighbor, parent, index + 1, &image);
+    } else {
+        merge_siblings(neighbor, node, parent, index, &image);
+    }
+    if (node->encoded_size(image, 0, image.size()) > PAGE_SIZE) {
+        redistribute(neighbor, node, parent, index);
+        buffer_pool_manager_->unpin_page(parent->get_page_id(), true);
+        buffer_pool_manager_->unpin_page(neighbor->get_page_id(), true);
+        delete parent;
+        delete neighbor;
+        return false;
+    }
+
+    // coalesce之后neighbor指向保留下来的左结点，right指向被合并掉的右结点
+    IxNodeHandle *right = node;
+    bool parent_should_delete = coalesce(&neighbor, &right, &parent, index, transaction, root_is_latched);
 
+    PageId parent_page_id = parent->get_page_id();
+    buffer_pool_manager_->unpin_page(parent_page_id, true);
+    if (parent_should_delete) {
+        buffer_pool_manager_->delete_page(parent_page_id);
+    }
+    delete parent;
+
+    if (right == node) {
+        // node在右边，由调用者负责unpin并删除node
+        buffer_pool_manager_->unpin_page(neighbor->get_page_id(), true);
+        delete neighbor;
+        return true;
+    }
+    // node在左边（index=0），被合并掉的是本函数取得的兄弟结点
+    PageId right_page_id = right->get_page_id();
+    buffer_pool_manager_->unpin_page(right_page_id, true);
+    buffer_pool_manager_->delete_page(right_page_id);
+    delete right;
     return false;
 }
 
@@ -296,18 +1077,26 @@ bool IxIndexHandle::coalesce_or_redistribute(IxNodeHandle *node, Transaction *tr
  * @note size of root page can be less than min size and this method is only called within coalesce_or_redistribute()
  */
 bool IxIndexHandle::adjust_root(IxNodeHandle *old_root_node) {
-    // Todo:
     // 1. 如果old_root_node是内部结点，并且大小为1，则直接把它的孩子更新成新的根结点
     // 2. 如果old_root_node是叶结点，且大小为0，则直接更新root page
     // 3. 除了上述两种情况，不需要进行操作
-
+    if (!old_root_node->is_leaf_page() && old_root_node->get_size() == 1) {
+        page_id_t child_page_no = old_root_node->remove_and_return_only_child();
+        IxNodeHandle *child = fetch_node(child_page_no);
+        child->set_parent_page_no(IX_NO_PAGE);
+        buffer_pool_manager_->unpin_page(child->get_page_id(), true);
+        delete child;
+        update_root_page_no(child_page_no);
+        release_resident();
+        return true;
+    }
+    // 根结点为空叶子时保留该结点，作为空树的根和唯一的叶子，后续插入无需重新建根
     return false;
 }
 
 /**
  * @brief 重新分配node和兄弟结点neighbor_node的键值对
- * Redistribute key & value pairs from one page to its sibling page. If index == 0, move sibling page's first key
- * & value pair into end of input "node", otherwise move sibling page's last key & value pair into head of input "node".
+ * 两个结点的键值对按字节数重新对半分配，并更新父结点中两者之间的分隔键
  *
  * @param neighbor_node sibling page of input "node"
  * @param node input from method coalesceOrRedistribute()
@@ -316,14 +1105,60 @@ bool IxIndexHandle::adjust_root(IxNodeHandle *old_root_node) {
  * @note node是之前刚被删除过一个key的结点
  * index=0，则neighbor是node后继结点，表示：node(left)      neighbor(right)
  * index>0，则neighbor是node前驱结点，表示：neighbor(left)  node(right)
- * 注意更新parent结点的相关kv对
+ * 新的分隔键可能比原来的长，父结点放不下时保持两个结点不变
  */
 void IxIndexHandle::redistribute(IxNodeHandle *neighbor_node, IxNodeHandle *node, IxNodeHandle *parent, int index) {
-    // Todo:
-    // 1. 通过index判断neighbor_node是否为node的前驱结点
-    // 2. 从neighbor_node中移动一个键值对到node结点中
-    // 3. 更新父节点中的相关信息，并且修改移动键值对对应孩字结点的父结点信息（maintain_child函数）
-    // 注意：neighbor_node的位置不同，需要移动的键值对不同，需要分类讨论
+    IxNodeHandle *left = index == 0 ? node : neighbor_node;
+    IxNodeHandle *right = index == 0 ? neighbor_node : node;
+    int sep_idx = index == 0 ? index + 1 : index;
+
+    IxNodeImage image;
+    merge_siblings(left, right, parent, sep_idx, &image);
+    int mid = split_point(image, left->is_leaf_page());
+    if (mid != left->get_size()) {
+        move_entries(left, right, parent, sep_idx, image, mid);
+    }
+}
+
+/**
+ * @brief 按mid重新划分相邻的left和right：image[0,mid)放入left，[mid,size)放入right，并更新父结点中的分隔键
+ *
+ * @param image merge_siblings得到的两个结点的全部键值对
+ * @param sep_idx 父结点中指向right的rid_idx
+ * @return 新的分隔键在父结点中放不下时返回false，两个结点保持不变
+ */
+bool IxIndexHandle::move_entries(IxNodeHandle *left, IxNodeHandle *right, IxNodeHandle *parent, int sep_idx,
+                                 const IxNodeImage &image, int mid) {
+    int left_size = left->get_size();
+    IxNodeImage parent_image;
+    parent->load(&parent_image);
+    if (left->is_leaf_page()) {
+        make_separator(image.key(mid - 1), image.key(mid), parent_image.key(sep_idx));
+    } else {
+        memcpy(parent_image.key(sep_idx), image.key(mid), file_hdr_->key_len_);
+    }
+    if (!parent->store(parent_image, 0, parent_image.size())) {
+        return false;
+    }
+    bool stored = left->store(image, 0, mid) && right->store(image, mid, image.size());
+    assert(stored);
+    (void)stored;
+    invalidate_leaf(left);
+    invalidate_leaf(right);
+    unswizzle(left->get_page_no());
+    unswizzle(right->get_page_no());
+
+    // 更新移动到另一侧的孩子结点的父结点信息
+    if (mid < left_size) {
+        for (int i = 0; i < left_size - mid; i++) {
+            maintain_child(right, i);
+        }
+    } else {
+        for (int i = left_size; i < mid; i++) {
+            maintain_child(left, i);
+        }
+    }
+    return true;
 }
 
 /**
@@ -342,13 +1177,369 @@ void IxIndexHandle::redistribute(IxNodeHandle *neighbor_node, IxNodeHandle *node
  */
 bool IxIndexHandle::coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node, IxNodeHandle **parent, int index,
                              Transaction *transaction, bool *root_is_latched) {
-    // Todo:
-    // 1. 用index判断neighbor_node是否为node的前驱结点，若不是则交换两个结点，让neighbor_node作为左结点，node作为右结点
-    // 2. 把node结点的键值对移动到neighbor_node中，并更新node结点孩子结点的父节点信息（调用maintain_child函数）
-    // 3. 释放和删除node结点，并删除parent中node结点的信息，返回parent是否需要被删除
-    // 提示：如果是叶子结点且为最右叶子结点，需要更新file_hdr_.last_leaf
+    if (index == 0) {
+        std::swap(*neighbor_node, *node);
+        index = 1;
+    }
+    IxNodeHandle *left = *neighbor_node;
+    IxNodeHandle *right = *node;
+    // right将被删除，它可能正是上次插入的叶子
+    last_insert_leaf_ = IX_NO_PAGE;
+    invalidate_leaf(right);
 
-    return false;
+    int pos = left->get_size();
+    IxNodeImage image;
+    merge_siblings(left, right, *parent, index, &image);
+    bool stored = left->store(image, 0, image.size());
+    assert(stored);
+    (void)stored;
+    for (int i = pos; i < left->get_size(); i++) {
+        maintain_child(left, i);
+    }
+    if (right->is_leaf_page()) {
+        erase_leaf(right);
+        if (file_hdr_->last_leaf_ == right->get_page_no()) {
+            file_hdr_->last_leaf_ = left->get_page_no();
+        }
+    } else {
+        unswizzle(left->get_page_no());
+        evict_resident(right->get_page_no());
+    }
+    (*parent)->erase_pair(index);
+    unswizzle((*parent)->get_page_no());
+    return coalesce_or_redistribute(*parent, transaction, root_is_latched);
+}
+
+/**
+ * @brief 按字节数选择分裂位置，使两侧占用的空间大致相等
+ * 以整体的公共前缀估算每个键值对的大小，两侧各自的公共前缀只会更长，因此两侧都能放进一个页面
+ *
+ * @return mid，范围为[1,size)
+ */
+int IxIndexHandle::split_point(const IxNodeImage &image, bool is_leaf) const {
+    int n = image.size();
+    assert(n >= 2);
+    // 非唯一索引的叶子结点中，每组的第一个键值对还要算上该组存放的索引字段
+    bool grouped = is_leaf && !file_hdr_->unique_;
+    int len = grouped ? file_hdr_->col_tot_len_ : file_hdr_->key_len_;
+    int first = is_leaf ? 0 : 1;
+    int prefix_len = 0;
+    if (file_hdr_->prefix_compress_ && first < n - 1) {
+        prefix_len = ix_common_prefix_len(image.key(first), image.key(n - 1), len);
+    }
+    std::vector<int> costs(n, sizeof(Rid));
+    for (int i = 0; i < n; i++) {
+        if (grouped && i > 0 && ix_same_group(file_hdr_, image.key(i - 1), image.key(i))) {
+            continue;
+        }
+        if (grouped) {
+            costs[i] += sizeof(uint16_t);
+        }
+        if (!file_hdr_->prefix_compress_) {
+            costs[i] += len;
+        } else {
+            int suffix_len = i < first ? 0 : std::max(0, ix_trimmed_len(image.key(i), len) - prefix_len);
+            costs[i] += sizeof(uint16_t) + suffix_len;
+        }
+    }
+    int total = 0;
+    for (int cost : costs) {
+        total += cost;
+    }
+    int mid = 0, acc = 0;
+    while (mid < n && acc * 2 < total) {
+        acc += costs[mid++];
+    }
+    return std::min(std::max(mid, 1), n - 1);
+}
+
+/**
+ * @brief 生成介于left和right之间的分隔键sep，满足left < sep <= right
+ * 前缀压缩格式下取right中能与left区分开的最短前缀，其余字节补'\0'，使内部结点中的key尽量短
+ */
+void IxIndexHandle::make_separator(const char *left, const char *right, char *sep) const {
+    int key_len = file_hdr_->key_len_;
+    if (!file_hdr_->prefix_compress_) {
+        memcpy(sep, right, key_len);
+        return;
+    }
+    int len = ix_common_prefix_len(left, right, key_len) + 1;
+    assert(len <= key_len);
+    memcpy(sep, right, len);
+    memset(sep + len, 0, key_len - len);
+}
+
+/**
+ * @brief 将相邻的left和right两个结点的键值对依次解压到image中
+ * 内部结点的第0个key不参与查找，right的第0个key放到left之后需要换成父结点中两者之间的分隔键
+ *
+ * @param sep_idx 父结点中指向right的rid_idx
+ */
+void IxIndexHandle::merge_siblings(IxNodeHandle *left, IxNodeHandle *right, IxNodeHandle *parent, int sep_idx,
+                                   IxNodeImage *image) const {
+    IxNodeImage right_image;
+    left->load(image);
+    right->load(&right_image);
+    if (!right->is_leaf_page() && right_image.size() > 0) {
+        parent->get_key(sep_idx, right_image.key(0));
+    }
+    image->append(right_image);
+}
+
+/**
+ * @brief 统计树中的结点数和叶子结点的填充率
+ */
+IxTreeStats IxIndexHandle::get_tree_stats() {
+    std::scoped_lock lock{root_latch_};
+    IxTreeStats stats;
+    double used_bytes = 0;
+    std::vector<page_id_t> pending = {file_hdr_->root_page_};
+    while (!pending.empty()) {
+        IxNodeHandle *node = fetch_node(pending.back());
+        pending.pop_back();
+        stats.num_nodes++;
+        if (node->is_leaf_page()) {
+            stats.num_leaves++;
+            used_bytes += node->get_used_bytes();
+        } else {
+            for (int i = 0; i < node->get_size(); i++) {
+                pending.push_back(node->value_at(i));
+            }
+        }
+        buffer_pool_manager_->unpin_page(node->get_page_id(), false);
+        delete node;
+    }
+    stats.leaf_fill = used_bytes / (static_cast<double>(stats.num_leaves) * PAGE_SIZE);
+    return stats;
+}
+
+/**
+ * @brief 整理B+树：合并删除后变得稀疏的结点，并使叶子结点按key的顺序存放在递增的页面中
+ * 自底向上逐层处理，每层从最左边的结点开始，每次对相邻的两个兄弟结点做一步合并或移动；
+ * 之后按key的顺序依次把每个叶子结点交换到叶子页面中第i小的页面上，使范围扫描顺序读取数据文件；
+ * 每一步单独持有root_latch_，步与步之间其他操作可以正常进行，下一步重新从根结点查找位置
+ *
+ * @param fill_factor 整理后结点的目标填充率
+ */
+IxCompactStats IxIndexHandle::compact(double fill_factor) {
+    IxCompactStats stats;
+    stats.before = get_tree_stats();
+    int target = static_cast<int>(PAGE_SIZE * fill_factor);
+    // 合并可能使树变矮，每一步都重新计算树高，处理到根结点所在的层为止
+    IxCompactStep step = IxCompactStep::LEVEL_DONE;
+    for (int level = 0; step != IxCompactStep::TREE_DONE; level++) {
+        std::vector<char> cursor;   // 当前结点的键值范围的下界，为空时表示该层最左边的结点
+        do {
+            step = compact_step(level, target, &cursor);
+            stats.num_steps++;
+        } while (step != IxCompactStep::LEVEL_DONE && step != IxCompactStep::TREE_DONE);
+    }
+
+    std::vector<page_id_t> pages;
+    {
+        std::scoped_lock lock{root_latch_};
+        for (page_id_t page_no = file_hdr_->first_leaf_; page_no != IX_LEAF_HEADER_PAGE;) {
+            pages.push_back(page_no);
+            IxNodeHandle *leaf = fetch_node(page_no);
+            page_no = leaf->get_next_leaf();
+            buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+            delete leaf;
+        }
+    }
+    std::sort(pages.begin(), pages.end());
+    for (size_t pos = 0; pos < pages.size();) {
+        relocate_step(pages, &pos, &stats.num_relocated);
+        stats.num_steps++;
+    }
+    stats.after = get_tree_stats();
+    {
+        // 删除的key仍留在Bloom过滤器中，整理后重建
+        std::scoped_lock lock{root_latch_};
+        bloom_stale_ = true;
+    }
+    return stats;
+}
+
+/**
+ * @brief 整理第level层（叶子为第0层）的一步：从根结点沿cursor找到该层的结点node及其右兄弟
+ * 两者合起来不超过target字节时合并；否则node不足target字节时从右兄弟移动一部分键值对过来；
+ * 都不满足时cursor移到node的键值范围的上界，下一步处理下一个结点
+ *
+ * @param target 整理后结点的目标字节数
+ * @param[in,out] cursor node的键值范围内的一个key
+ */
+IxCompactStep IxIndexHandle::compact_step(int level, int target, std::vector<char> *cursor) {
+    std::scoped_lock lock{root_latch_};
+    // 路径上第d个结点的page_no、下一层所在的孩子下标，以及第d个结点的键值范围的上界（为空时没有上界）
+    std::vector<page_id_t> path;
+    std::vector<int> child_idx;
+    std::vector<std::vector<char>> fences(1);
+    IxNodeHandle *node = fetch_node(file_hdr_->root_page_);
+    while (true) {
+        path.push_back(node->get_page_no());
+        if (node->is_leaf_page()) {
+            break;
+        }
+        int idx = cursor->empty() ? 0 : node->upper_bound(cursor->data()) - 1;
+        std::vector<char> fence = fences.back();
+        if (idx + 1 < node->get_size()) {
+            fence.resize(file_hdr_->key_len_);
+            node->get_key(idx + 1, fence.data());
+        }
+        child_idx.push_back(idx);
+        fences.push_back(std::move(fence));
+        page_id_t child_page_no = node->value_at(idx);
+        buffer_pool_manager_->unpin_page(node->get_page_id(), false);
+        delete node;
+        node = fetch_node(child_page_no);
+    }
+    buffer_pool_manager_->unpin_page(node->get_page_id(), false);
+    delete node;
+
+    int depth = static_cast<int>(path.size()) - 1 - level;
+    if (depth <= 0) {
+        // 已到根结点所在的层
+        return IxCompactStep::TREE_DONE;
+    }
+    int idx = child_idx[depth - 1];
+    IxNodeHandle *parent = fetch_node(path[depth - 1]);
+    if (idx + 1 == parent->get_size()) {
+        // 没有同一父结点下的右兄弟
+        buffer_pool_manager_->unpin_page(parent->get_page_id(), false);
+        delete parent;
+        if (fences[depth].empty()) {
+            return IxCompactStep::LEVEL_DONE;
+        }
+        *cursor = fences[depth];
+        return IxCompactStep::ADVANCED;
+    }
+
+    node = fetch_node(path[depth]);
+    IxNodeHandle *right = fetch_node(parent->value_at(idx + 1));
+    IxNodeImage image;
+    merge_siblings(node, right, parent, idx + 1, &image);
+    IxCompactStep step = IxCompactStep::ADVANCED;
+    if (node->encoded_size(image, 0, image.size()) <= target) {
+        // 与coalesce_or_redistribute中合并的处理相同，父结点随之可能与其兄弟结点合并或重分配
+        IxNodeHandle *left = node;
+        bool parent_should_delete = coalesce(&left, &right, &parent, idx + 1, nullptr, nullptr);
+        PageId parent_page_id = parent->get_page_id();
+        buffer_pool_manager_->unpin_page(parent_page_id, true);
+        if (parent_should_delete) {
+            buffer_pool_manager_->delete_page(parent_page_id);
+        }
+        PageId right_page_id = right->get_page_id();
+        buffer_pool_manager_->unpin_page(right_page_id, true);
+        buffer_pool_manager_->delete_page(right_page_id);
+        buffer_pool_manager_->unpin_page(node->get_page_id(), true);
+        delete parent;
+        delete right;
+        delete node;
+        return IxCompactStep::MERGED;
+    }
+    if (node->get_used_bytes() < target) {
+        // 从右兄弟移动尽量多的键值对，使node接近target字节，右兄弟至少保留一个
+        int size = node->get_size();
+        int mid = size;
+        while (mid + 1 < image.size() && node->encoded_size(image, 0, mid + 1) <= target) {
+            mid++;
+        }
+        if (mid > size && move_entries(node, right, parent, idx + 1, image, mid)) {
+            step = IxCompactStep::SHIFTED;
+        }
+    }
+    if (step == IxCompactStep::ADVANCED) {
+        cursor->resize(file_hdr_->key_len_);
+        parent->get_key(idx + 1, cursor->data());
+    }
+    bool dirty = step == IxCompactStep::SHIFTED;
+    buffer_pool_manager_->unpin_page(parent->get_page_id(), dirty);
+    buffer_pool_manager_->unpin_page(node->get_page_id(), dirty);
+    buffer_pool_manager_->unpin_page(right->get_page_id(), dirty);
+    delete parent;
+    delete node;
+    delete right;
+    return step;
+}
+
+/**
+ * @brief 叶子结点重新定位的一步：按key的顺序检查从第pos个开始的叶子结点，
+ * 遇到第一个不在pages[pos]上的叶子结点时把它与pages[pos]上的结点交换，或检查IX_COMPACT_STEP_PAGES个之后返回
+ *
+ * @param pages 全部叶子结点的页面，从小到大排列
+ * @param[in,out] pos 前pos个叶子结点已放在pages的前pos个页面上
+ */
+void IxIndexHandle::relocate_step(const std::vector<page_id_t> &pages, size_t *pos, int *num_relocated) {
+    std::scoped_lock lock{root_latch_};
+    for (int i = 0; i < IX_COMPACT_STEP_PAGES && *pos < pages.size(); i++) {
+        page_id_t page_no = file_hdr_->first_leaf_;
+        if (*pos > 0) {
+            IxNodeHandle *prev = fetch_node(pages[*pos - 1]);
+            page_no = prev->get_next_leaf();
+            buffer_pool_manager_->unpin_page(prev->get_page_id(), false);
+            delete prev;
+        }
+        page_id_t target = pages[(*pos)++];
+        if (page_no != target) {
+            swap_leaves(page_no, target);
+            (*num_relocated)++;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 交换两个叶子结点所在的页面，并更新叶子链表、父结点和文件头中指向它们的page_no
+ */
+void IxIndexHandle::swap_leaves(page_id_t page_no, page_id_t other_page_no) {
+    auto remap = [&](page_id_t p) { return p == page_no ? other_page_no : p == other_page_no ? page_no : p; };
+    IxNodeHandle *nodes[2] = {fetch_node(page_no), fetch_node(other_page_no)};
+    assert(nodes[0]->is_leaf_page() && nodes[1]->is_leaf_page());
+    std::vector<char> tmp(nodes[0]->page->get_data(), nodes[0]->page->get_data() + PAGE_SIZE);
+    memcpy(nodes[0]->page->get_data(), nodes[1]->page->get_data(), PAGE_SIZE);
+    memcpy(nodes[1]->page->get_data(), tmp.data(), PAGE_SIZE);
+
+    std::vector<page_id_t> parents;
+    for (IxNodeHandle *node : nodes) {
+        // 两者相邻时彼此的指针经remap即正确，其余的前驱和后继改为指向结点的新页面
+        node->set_prev_leaf(remap(node->get_prev_leaf()));
+        node->set_next_leaf(remap(node->get_next_leaf()));
+        page_id_t prev_page_no = node->get_prev_leaf();
+        if (prev_page_no != page_no && prev_page_no != other_page_no) {
+            IxNodeHandle *prev = fetch_node(prev_page_no);
+            prev->set_next_leaf(node->get_page_no());
+            buffer_pool_manager_->unpin_page(prev->get_page_id(), true);
+            delete prev;
+        }
+        page_id_t next_page_no = node->get_next_leaf();
+        if (next_page_no != page_no && next_page_no != other_page_no) {
+            IxNodeHandle *next = fetch_node(next_page_no);
+            next->set_prev_leaf(node->get_page_no());
+            buffer_pool_manager_->unpin_page(next->get_page_id(), true);
+            delete next;
+        }
+        if (std::find(parents.begin(), parents.end(), node->get_parent_page_no()) == parents.end()) {
+            parents.push_back(node->get_parent_page_no());
+        }
+        invalidate_leaf(node);
+    }
+    // 两者的父结点可能相同，在父结点中一次性交换两个孩子的page_no
+    for (page_id_t parent_page_no : parents) {
+        IxNodeHandle *parent = fetch_node(parent_page_no);
+        for (int i = 0; i < parent->get_size(); i++) {
+            parent->get_rid(i)->page_no = remap(parent->value_at(i));
+        }
+        unswizzle(parent_page_no);
+        buffer_pool_manager_->unpin_page(parent->get_page_id(), true);
+        delete parent;
+    }
+    file_hdr_->first_leaf_ = remap(file_hdr_->first_leaf_);
+    file_hdr_->last_leaf_ = remap(file_hdr_->last_leaf_);
+    last_insert_leaf_ = IX_NO_PAGE;
+    for (IxNodeHandle *node : nodes) {
+        buffer_pool_manager_->unpin_page(node->get_page_id(), true);
+        delete node;
+    }
 }
 
 /**
@@ -363,10 +1554,39 @@ bool IxIndexHandle::coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node,
 Rid IxIndexHandle::get_rid(const Iid &iid) const {
     IxNodeHandle *node = fetch_node(iid.page_no);
     if (iid.slot_no >= node->get_size()) {
+        buffer_pool_manager_->unpin_page(node->get_page_id(), false);
+        delete node;
         throw IndexEntryNotFoundError();
     }
+    Rid rid = *node->get_rid(iid.slot_no);
     buffer_pool_manager_->unpin_page(node->get_page_id(), false);  // unpin it!
-    return *node->get_rid(iid.slot_no);
+    delete node;
+    return rid;
+}
+
+/**
+ * @brief 读取iid对应索引槽中的key，key按索引字段顺序依次存放，总长度为col_tot_len
+ * 非唯一索引中不包含追加的rid
+ *
+ * @param iid
+ * @param[out] key 传出参数，调用者需保证至少有col_tot_len字节的空间
+ */
+void IxIndexHandle::get_key(const Iid &iid, char *key) const {
+    IxNodeHandle *node = fetch_node(iid.page_no);
+    if (iid.slot_no >= node->get_size()) {
+        buffer_pool_manager_->unpin_page(node->get_page_id(), false);
+        delete node;
+        throw IndexEntryNotFoundError();
+    }
+    if (file_hdr_->unique_) {
+        node->get_key(iid.slot_no, key);
+    } else {
+        std::vector<char> tree_key(file_hdr_->key_len_);
+        node->get_key(iid.slot_no, tree_key.data());
+        memcpy(key, tree_key.data(), file_hdr_->col_tot_len_);
+    }
+    buffer_pool_manager_->unpin_page(node->get_page_id(), false);
+    delete node;
 }
 
 /**
@@ -377,10 +1597,7 @@ Rid IxIndexHandle::get_rid(const Iid &iid) const {
  * @note 上层传入的key本来是int类型，通过(const char *)&key进行了转换
  * 可用*(int *)key转换回去
  */
-Iid IxIndexHandle::lower_bound(const char *key) {
-
-    return Iid{-1, -1};
-}
+Iid IxIndexHandle::lower_bound(const char *key) { return leaf_bound(key, false); }
 
 /**
  * @brief FindLeafPage + upper_bound
@@ -388,9 +1605,29 @@ Iid IxIndexHandle::lower_bound(const char *key) {
  * @param key
  * @return Iid
  */
-Iid IxIndexHandle::upper_bound(const char *key) {
-    
-    return Iid{-1, -1};
+Iid IxIndexHandle::upper_bound(const char *key) { return leaf_bound(key, true); }
+
+/**
+ * @brief lower_bound和upper_bound的实现，key只包含索引字段
+ * 非唯一索引中key追加最小的rid后取lower_bound，追加最大的rid后取upper_bound
+ */
+Iid IxIndexHandle::leaf_bound(const char *key, bool upper) {
+    std::vector<char> tree_key;
+    if (!file_hdr_->unique_) {
+        tree_key.assign(file_hdr_->key_len_, upper ? static_cast<char>(0xff) : 0);
+        memcpy(tree_key.data(), key, file_hdr_->col_tot_len_);
+        key = tree_key.data();
+    }
+    std::scoped_lock lock{root_latch_};
+    IxNodeHandle *leaf = find_leaf_page(key, Operation::FIND, nullptr).first;
+    int slot_no = upper ? leaf->upper_bound(key) : leaf->lower_bound(key);
+    Iid iid = {.page_no = leaf->get_page_no(), .slot_no = slot_no};
+    if (iid.slot_no == leaf->get_size() && iid.page_no != file_hdr_->last_leaf_) {
+        iid = {.page_no = leaf->get_next_leaf(), .slot_no = 0};
+    }
+    buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+    delete leaf;
+    return iid;
 }
 
 /**
@@ -403,6 +1640,7 @@ Iid IxIndexHandle::leaf_end() const {
     IxNodeHandle *node = fetch_node(file_hdr_->last_leaf_);
     Iid iid = {.page_no = file_hdr_->last_leaf_, .slot_no = node->get_size()};
     buffer_pool_manager_->unpin_page(node->get_page_id(), false);  // unpin it!
+    delete node;
     return iid;
 }
 
@@ -417,6 +1655,28 @@ Iid IxIndexHandle::leaf_begin() const {
     return iid;
 }
 
+/**
+ * @brief 统计叶子层[lower, upper)范围内的项数，用于规划器估算选择率
+ * 只沿叶子链表读取范围内的叶子结点，计数达到limit后提前返回limit，避免大范围的估算读完整个叶子层
+ */
+int IxIndexHandle::count_range(const Iid &lower, const Iid &upper, int limit) const {
+    int count = 0;
+    Iid iid = lower;
+    while (count < limit && iid != upper) {
+        IxNodeHandle *node = fetch_node(iid.page_no);
+        int end = iid.page_no == upper.page_no ? upper.slot_no : node->get_size();
+        count += end - iid.slot_no;
+        if (iid.page_no == upper.page_no || iid.page_no == file_hdr_->last_leaf_) {
+            iid = upper;
+        } else {
+            iid = {.page_no = node->get_next_leaf(), .slot_no = 0};
+        }
+        buffer_pool_manager_->unpin_page(node->get_page_id(), false);
+        delete node;
+    }
+    return std::min(count, limit);
+}
+
 /**
  * @brief 获取一个指定结点
  *
@@ -431,6 +1691,42 @@ IxNodeHandle *IxIndexHandle::fetch_node(int page_no) const {
     return node;
 }
 
+/**
+ * @brief 查找key应插入的叶子结点
+ * key落在上次插入的叶子结点的键值范围内时直接返回该结点，省去从根结点开始的查找；
+ * 最右叶子的范围没有上界，因此递增插入总能命中
+ *
+ * @note pin the page, remember to unpin it outside!
+ */
+IxNodeHandle *IxIndexHandle::find_insert_leaf(const char *key, Transaction *transaction) {
+    if (last_insert_leaf_ != IX_NO_PAGE) {
+        IxNodeHandle *leaf = fetch_node(last_insert_leaf_);
+        int size = leaf->get_size();
+        if (size > 0 && leaf->compare_key(0, key) <= 0 &&
+            (leaf->get_page_no() == file_hdr_->last_leaf_ || leaf->compare_key(size - 1, key) >= 0)) {
+            return leaf;
+        }
+        buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+        delete leaf;
+    }
+    return find_leaf_page(key, Operation::INSERT, transaction).first;
+}
+
+/**
+ * @brief 生成B+树中排序用的key：唯一索引即为key本身，非唯一索引在key之后追加value
+ *
+ * @param buf 非唯一索引时存放生成的key
+ */
+const char *IxIndexHandle::make_tree_key(const char *key, const Rid &value, std::vector<char> *buf) const {
+    if (file_hdr_->unique_) {
+        return key;
+    }
+    buf->resize(file_hdr_->key_len_);
+    memcpy(buf->data(), key, file_hdr_->col_tot_len_);
+    ix_encode_rid(value, buf->data() + file_hdr_->col_tot_len_);
+    return buf->data();
+}
+
 /**
  * @brief 创建一个新结点
  *
@@ -453,26 +1749,148 @@ IxNodeHandle *IxIndexHandle::create_node() {
 }
 
 /**
- * @brief 从node开始更新其父节点的第一个key，一直向上更新直到根节点
+ * @brief 通过自适应哈希直接定位key所在的叶子结点，省去从根结点开始的查找
+ * 结点内的插入删除可能使key的槽位发生移动，此时在该叶子结点内重新查找
  *
- * @param node
+ * @return 命中并找到key时返回true，否则由调用者从根结点开始查找
  */
-void IxIndexHandle::maintain_parent(IxNodeHandle *node) {
-    IxNodeHandle *curr = node;
-    while (curr->get_parent_page_no() != IX_NO_PAGE) {
-        // Load its parent
-        IxNodeHandle *parent = fetch_node(curr->get_parent_page_no());
-        int rank = parent->find_child(curr);
-        char *parent_key = parent->get_key(rank);
-        char *child_first_key = curr->get_key(0);
-        if (memcmp(parent_key, child_first_key, file_hdr_->col_tot_len_) == 0) {
-            assert(buffer_pool_manager_->unpin_page(parent->get_page_id(), true));
-            break;
+bool IxIndexHandle::lookup_adaptive_hash(const char *key, std::vector<Rid> *result) {
+    Iid iid;
+    if (!adaptive_hash_.lookup(key, &iid)) {
+        return false;
+    }
+    IxNodeHandle *leaf = fetch_node(iid.page_no);
+    assert(leaf->is_leaf_page());
+    int pos = iid.slot_no;
+    if (pos >= leaf->get_size() || leaf->compare_key(pos, key) != 0) {
+        pos = leaf->lower_bound(key);
+        iid.slot_no = pos;
+        adaptive_hash_.update(key, iid);
+    }
+    bool found = pos < leaf->get_size() && leaf->compare_key(pos, key) == 0;
+    if (found) {
+        result->push_back(*leaf->get_rid(pos));
+    } else {
+        adaptive_hash_.erase(key);
+    }
+    buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+    delete leaf;
+    return found;
+}
+
+/**
+ * @brief 用Bloom过滤器检查key是否可能存在，过滤器需要重建时先从叶子层重建
+ * @param key 只包含索引字段的key
+ * @note 调用者需持有root_latch_
+ */
+bool IxIndexHandle::bloom_may_contain(const char *key) {
+    if (!bloom_enabled_) {
+        return true;
+    }
+    if (bloom_stale_) {
+        build_bloom_filter();
+    }
+    return bloom_.may_contain(BloomFilter::hash_key(key, file_hdr_->col_types_, file_hdr_->col_lens_));
+}
+
+/**
+ * @brief 插入key后加入Bloom过滤器；key数超过过滤器的容量时标记为需要重建，下次检查时按更大的容量重建
+ * @note 调用者需持有root_latch_
+ */
+void IxIndexHandle::bloom_insert(const char *key) {
+    if (!bloom_enabled_ || bloom_stale_) {
+        return;
+    }
+    if (bloom_.num_keys() >= bloom_.capacity()) {
+        bloom_stale_ = true;
+        bloom_.clear();
+        return;
+    }
+    bloom_.insert(BloomFilter::hash_key(key, file_hdr_->col_types_, file_hdr_->col_lens_));
+}
+
+/**
+ * @brief 遍历叶子层重建Bloom过滤器，容量为当前key数的两倍，之后的插入随之加入
+ * @note 调用者需持有root_latch_
+ */
+void IxIndexHandle::build_bloom_filter() {
+    bloom_stale_ = false;
+    if (!bloom_enabled_) {
+        return;
+    }
+    std::vector<uint64_t> hashes;
+    std::vector<char> key(file_hdr_->key_len_);
+    for (page_id_t page_no = file_hdr_->first_leaf_; page_no != IX_LEAF_HEADER_PAGE && !is_empty();) {
+        IxNodeHandle *leaf = fetch_node(page_no);
+        for (int i = 0; i < leaf->get_size(); i++) {
+            leaf->get_key(i, key.data());
+            hashes.push_back(BloomFilter::hash_key(key.data(), file_hdr_->col_types_, file_hdr_->col_lens_));
         }
-        memcpy(parent_key, child_first_key, file_hdr_->col_tot_len_);  // 修改了parent node
-        curr = parent;
+        page_no = leaf->get_next_leaf();
+        buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+        delete leaf;
+    }
+    bloom_.reset(hashes.size() * 2);
+    for (uint64_t hash : hashes) {
+        bloom_.insert(hash);
+    }
+}
+
+/**
+ * @brief 把刚取得的内部结点转为常驻内存，保留其pin，node随之释放
+ * @return 常驻结点；node是叶子结点时返回nullptr，node不变
+ */
+IxResidentNode *IxIndexHandle::make_resident(IxNodeHandle *node) {
+    if (node->is_leaf_page()) {
+        return nullptr;
+    }
+    auto resident = std::make_unique<IxResidentNode>();
+    resident->node = *node;
+    resident->children.assign(node->get_size(), nullptr);
+    delete node;
+    IxResidentNode *ptr = resident.get();
+    resident_.emplace(ptr->node.get_page_no(), std::move(resident));
+    return ptr;
+}
+
+/**
+ * @brief 结点的孩子增加、删除或移动之后调用，其孩子指针恢复为按page_no查找，下次访问时重新转换
+ */
+void IxIndexHandle::unswizzle(page_id_t page_no) {
+    auto it = resident_.find(page_no);
+    if (it != resident_.end()) {
+        it->second->children.assign(it->second->node.get_size(), nullptr);
+    }
+}
 
-        assert(buffer_pool_manager_->unpin_page(parent->get_page_id(), true));
+/**
+ * @brief 内部结点被删除前调用，解除其常驻；指向它的只有父结点，父结点同时被修改并unswizzle
+ */
+void IxIndexHandle::evict_resident(page_id_t page_no) {
+    auto it = resident_.find(page_no);
+    if (it != resident_.end()) {
+        buffer_pool_manager_->unpin_page(it->second->node.get_page_id(), false);
+        resident_.erase(it);
+    }
+}
+
+/**
+ * @brief 解除全部结点的常驻，根结点改变（各结点的深度随之改变）以及关闭索引时调用
+ */
+void IxIndexHandle::release_resident() {
+    for (auto &[page_no, resident] : resident_) {
+        buffer_pool_manager_->unpin_page(resident->node.get_page_id(), false);
+    }
+    resident_.clear();
+    resident_root_ = nullptr;
+}
+
+/**
+ * @brief 叶子结点中的key被移动到其他结点时调用，自适应哈希中指向它的项全部失效
+ */
+void IxIndexHandle::invalidate_leaf(IxNodeHandle *node) {
+    if (node->is_leaf_page()) {
+        adaptive_hash_.invalidate_page(node->get_page_no());
     }
 }
 
@@ -487,10 +1905,12 @@ void IxIndexHandle::erase_leaf(IxNodeHandle *leaf) {
     IxNodeHandle *prev = fetch_node(leaf->get_prev_leaf());
     prev->set_next_leaf(leaf->get_next_leaf());
     buffer_pool_manager_->unpin_page(prev->get_page_id(), true);
+    delete prev;
 
     IxNodeHandle *next = fetch_node(leaf->get_next_leaf());
     next->set_prev_leaf(leaf->get_prev_leaf());  // 注意此处是SetPrevLeaf()
     buffer_pool_manager_->unpin_page(next->get_page_id(), true);
+    delete next;
 }
 
 /**
@@ -512,5 +1932,6 @@ void IxIndexHandle::maintain_child(IxNodeHandle *node, int child_idx) {
         IxNodeHandle *child = fetch_node(child_page_no);
         child->set_parent_page_no(node->get_page_no());
         buffer_pool_manager_->unpin_page(child->get_page_id(), true);
+        delete child;
     }
 }
\ No newline at end of file
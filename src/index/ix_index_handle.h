@@ -10,6 +10,11 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <memory>
+#include <unordered_map>
+
+#include "common/bloom_filter.h"
+#include "ix_adaptive_hash.h"
 #include "ix_defs.h"
 #include "transaction/transaction.h"
 
@@ -46,7 +51,48 @@ inline int ix_compare(const char* a, const char* b, const std::vector<ColType>&
     return 0;
 }
 
-/* 管理B+树中的每个节点 */
+/* 非唯一索引的key中追加的rid按大端序存放，使按字节比较的顺序与(page_no, slot_no)的顺序一致 */
+inline void ix_encode_rid(const Rid &rid, char *dest) {
+    uint32_t parts[2] = {static_cast<uint32_t>(rid.page_no), static_cast<uint32_t>(rid.slot_no)};
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 4; j++) {
+            dest[i * 4 + j] = static_cast<char>(parts[i] >> (24 - 8 * j));
+        }
+    }
+}
+
+/* 结点解压后的键值对，key均还原为长度为key_len的完整key（非唯一索引中包含追加的rid），用于结点的插入、分裂、合并与重分配 */
+struct IxNodeImage {
+    int key_len;
+    std::vector<char> keys;
+    std::vector<Rid> rids;
+
+    explicit IxNodeImage(int key_len_ = 0) : key_len(key_len_) {}
+
+    int size() const { return static_cast<int>(rids.size()); }
+
+    char *key(int i) { return keys.data() + static_cast<size_t>(i) * key_len; }
+
+    const char *key(int i) const { return keys.data() + static_cast<size_t>(i) * key_len; }
+
+    void insert(int pos, const char *key_, const Rid &rid) {
+        keys.insert(keys.begin() + static_cast<size_t>(pos) * key_len, key_, key_ + key_len);
+        rids.insert(rids.begin() + pos, rid);
+    }
+
+    void erase(int pos) {
+        auto it = keys.begin() + static_cast<size_t>(pos) * key_len;
+        keys.erase(it, it + key_len);
+        rids.erase(rids.begin() + pos);
+    }
+
+    void append(const IxNodeImage &other) {
+        keys.insert(keys.end(), other.keys.begin(), other.keys.end());
+        rids.insert(rids.end(), other.rids.begin(), other.rids.end());
+    }
+};
+
+/* 管理B+树中的每个节点，页面布局见IxPageHdr */
 class IxNodeHandle {
     friend class IxIndexHandle;
     friend class IxScan;
@@ -55,27 +101,33 @@ class IxNodeHandle {
     const IxFileHdr *file_hdr;      // 节点所在文件的头部信息
     Page *page;                     // 存储节点的页面
     IxPageHdr *page_hdr;            // page->data的第一部分，指针指向首地址，长度为sizeof(IxPageHdr)
-    char *keys;                     // page->data的第二部分，指针指向首地址，长度为file_hdr->keys_size，每个key的长度为file_hdr->col_len
-    Rid *rids;                      // page->data的第三部分，指针指向首地址
+    Rid *rids;                      // page->data的第二部分，紧跟页头，长度为num_key * sizeof(Rid)
 
    public:
     IxNodeHandle() = default;
 
     IxNodeHandle(const IxFileHdr *file_hdr_, Page *page_) : file_hdr(file_hdr_), page(page_) {
         page_hdr = reinterpret_cast<IxPageHdr *>(page->get_data());
-        keys = page->get_data() + sizeof(IxPageHdr);
-        rids = reinterpret_cast<Rid *>(keys + file_hdr->keys_size_);
+        rids = reinterpret_cast<Rid *>(page->get_data() + sizeof(IxPageHdr));
     }
 
     int get_size() { return page_hdr->num_key; }
 
-    void set_size(int size) { page_hdr->num_key = size; }
-
-    int get_max_size() { return file_hdr->btree_order_ + 1; }
-
-    int get_min_size() { return get_max_size() / 2; }
+    /* 结点当前占用的字节数，包括页头 */
+    int get_used_bytes() const {
+        int n = num_entries();
+        int bytes = sizeof(IxPageHdr) + page_hdr->num_key * sizeof(Rid);
+        if (is_grouped()) {
+            bytes += n * sizeof(uint16_t);
+        }
+        if (file_hdr->prefix_compress_) {
+            return bytes + n * sizeof(uint16_t) + page_hdr->prefix_len + page_hdr->suffix_bytes;
+        }
+        return bytes + n * entry_len();
+    }
 
-    int key_at(int i) { return *(int *)get_key(i); }
+    /* 占用不足半个页面时需要与兄弟结点合并或重分配 */
+    bool is_underflow() const { return get_used_bytes() * 2 < PAGE_SIZE; }
 
     /* 得到第i个孩子结点的page_no */
     page_id_t value_at(int i) { return get_rid(i)->page_no; }
@@ -100,11 +152,11 @@ class IxNodeHandle {
 
     void set_parent_page_no(page_id_t parent) { page_hdr->parent = parent; }
 
-    char *get_key(int key_idx) const { return keys + key_idx * file_hdr->col_tot_len_; }
+    void get_key(int key_idx, char *key) const;
 
-    Rid *get_rid(int rid_idx) const { return &rids[rid_idx]; }
+    int compare_key(int key_idx, const char *target) const;
 
-    void set_key(int key_idx, const char *key) { memcpy(keys + key_idx * file_hdr->col_tot_len_, key, file_hdr->col_tot_len_); }
+    Rid *get_rid(int rid_idx) const { return &rids[rid_idx]; }
 
     void set_rid(int rid_idx, const Rid &rid) { rids[rid_idx] = rid; }
 
@@ -112,16 +164,17 @@ class IxNodeHandle {
 
     int upper_bound(const char *target) const;
 
-    void insert_pairs(int pos, const char *key, const Rid *rid, int n);
-
     page_id_t internal_lookup(const char *key);
 
     bool leaf_lookup(const char *key, Rid **value);
 
-    int insert(const char *key, const Rid &value);
+    void load(IxNodeImage *image) const;
+
+    int encoded_size(const IxNodeImage &image, int begin, int end) const;
+
+    bool store(const IxNodeImage &image, int begin, int end);
 
-    // 用于在结点中的指定位置插入单个键值对
-    void insert_pair(int pos, const char *key, const Rid &rid) { insert_pairs(pos, key, &rid, 1); }
+    bool insert_pair(int pos, const char *key, const Rid &rid);
 
     void erase_pair(int pos);
 
@@ -155,8 +208,83 @@ class IxNodeHandle {
         assert(rid_idx < page_hdr->num_key);
         return rid_idx;
     }
+
+   private:
+    // 非唯一索引的叶子结点按posting list分组存放，每组只存一份索引字段
+    bool is_grouped() const { return !file_hdr->unique_ && page_hdr->is_leaf; }
+
+    // 结点中实际存放的key的个数和每个key还原后的长度：分组时为组数和col_tot_len，否则为num_key和key_len
+    int num_entries() const { return is_grouped() ? page_hdr->num_group : page_hdr->num_key; }
+
+    int entry_len() const { return is_grouped() ? file_hdr->col_tot_len_ : file_hdr->key_len_; }
+
+    // 分组时各组的结束位置（rid_idx）
+    uint16_t *group_ends() const { return reinterpret_cast<uint16_t *>(rids + page_hdr->num_key); }
+
+    int group_begin(int group) const { return group == 0 ? 0 : group_ends()[group - 1]; }
+
+    int group_of(int rid_idx) const;
+
+    // 前缀压缩格式下各后缀的结束位置
+    uint16_t *suffix_ends() const {
+        char *base = reinterpret_cast<char *>(rids + page_hdr->num_key);
+        return reinterpret_cast<uint16_t *>(is_grouped() ? base + page_hdr->num_group * sizeof(uint16_t) : base);
+    }
+
+    char *prefix() const {
+        char *base = reinterpret_cast<char *>(suffix_ends());
+        return file_hdr->prefix_compress_ ? base + num_entries() * sizeof(uint16_t) : base;
+    }
+
+    const char *get_suffix(int entry_idx, int *len) const;
+
+    void get_entry(int entry_idx, char *key) const;
+
+    int compare_suffix(int entry_idx, const char *rest, int rest_len) const;
+
+    int compare_entry(int entry_idx, const char *target) const;
+
+    int search_entries(const char *target, bool upper, int left) const;
+
+    int search(const char *target, bool upper) const;
+
+    void entry_heads(const IxNodeImage &image, int begin, int end, std::vector<int> *heads) const;
+
+    bool insert_into_group(int pos, const char *key, const Rid &rid);
+};
+
+constexpr int IX_DEFAULT_RESIDENT_DEPTH = 2;    // 默认常驻内存的层数：根结点及其孩子
+
+/**
+ * @brief 常驻内存的内部结点，页面在缓冲池中一直保持pin
+ * children与结点的孩子一一对应，已转换为指针的孩子直接指向其常驻结点，nullptr表示仍需按page_no查找
+ */
+struct IxResidentNode {
+    IxNodeHandle node;
+    std::vector<IxResidentNode *> children;
+};
+
+constexpr double IX_COMPACT_FILL_FACTOR = 0.9;  // 整理后结点的目标填充率，留出少量空间使随后的插入不会立即分裂
+constexpr int IX_COMPACT_STEP_PAGES = 64;       // 整理时每一步持有root_latch_期间最多顺序检查的叶子数
+
+/* B+树的结点数和叶子结点的填充率 */
+struct IxTreeStats {
+    int num_nodes = 0;          // 树中的结点数，不含文件头和叶子链表头
+    int num_leaves = 0;
+    double leaf_fill = 0;       // 叶子结点占用字节数的平均值与PAGE_SIZE之比
+};
+
+/* 一次整理(compact)前后的统计信息 */
+struct IxCompactStats {
+    IxTreeStats before;
+    IxTreeStats after;
+    int num_relocated = 0;      // 为使叶子结点按key的顺序存放而交换页面的次数
+    int num_steps = 0;          // 整理分成的步数，每一步单独持有root_latch_
 };
 
+/* 整理中的一步对当前结点所做的操作 */
+enum class IxCompactStep { MERGED, SHIFTED, ADVANCED, LEVEL_DONE, TREE_DONE };
+
 /* B+树 */
 class IxIndexHandle {
     friend class IxScan;
@@ -168,6 +296,14 @@ class IxIndexHandle {
     int fd_;                                    // 存储B+树的文件
     IxFileHdr* file_hdr_;                       // 存了root_page，但其初始化为2（第0页存FILE_HDR_PAGE，第1页存LEAF_HEADER_PAGE）
     std::mutex root_latch_;
+    page_id_t last_insert_leaf_;                // 上次插入的叶子结点，插入时优先尝试，有结点被合并删除时失效
+    IxAdaptiveHash adaptive_hash_;              // 热点key的点查缓存，只用于唯一索引
+    BloomFilter bloom_;                         // 索引中所有key（只包含索引字段）的Bloom过滤器，点查前先检查
+    bool bloom_enabled_ = true;
+    bool bloom_stale_ = true;                   // 过滤器需要重建，在下一次检查时从叶子层重新建立
+    int resident_depth_ = IX_DEFAULT_RESIDENT_DEPTH;    // 深度小于它的内部结点常驻内存
+    std::unordered_map<page_id_t, std::unique_ptr<IxResidentNode>> resident_;
+    IxResidentNode *resident_root_ = nullptr;
 
    public:
     IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
@@ -175,19 +311,26 @@ class IxIndexHandle {
     // for search
     bool get_value(const char *key, std::vector<Rid> *result, Transaction *transaction);
 
+    int get_values_batch(const char *const *keys, int n, std::vector<Rid> *results, Transaction *transaction);
+
+    bool is_unique() const { return file_hdr_->unique_; }
+
     std::pair<IxNodeHandle *, bool> find_leaf_page(const char *key, Operation operation, Transaction *transaction,
                                                  bool find_first = false);
 
     // for insert
     page_id_t insert_entry(const char *key, const Rid &value, Transaction *transaction);
 
-    IxNodeHandle *split(IxNodeHandle *node);
+    IxNodeHandle *split(IxNodeHandle *node, const IxNodeImage &image, int mid);
 
-    void insert_into_parent(IxNodeHandle *old_node, const char *key, IxNodeHandle *new_node, Transaction *transaction);
+    void insert_into_parent(IxNodeHandle *old_node, const char *key, IxNodeHandle *new_node, Transaction *transaction,
+                            bool append = false);
 
     // for delete
     bool delete_entry(const char *key, Transaction *transaction);
 
+    bool delete_entry(const char *key, const Rid &value, Transaction *transaction);
+
     bool coalesce_or_redistribute(IxNodeHandle *node, Transaction *transaction = nullptr,
                                 bool *root_is_latched = nullptr);
     bool adjust_root(IxNodeHandle *old_root_node);
@@ -197,6 +340,9 @@ class IxIndexHandle {
     bool coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node, IxNodeHandle **parent, int index,
                   Transaction *transaction, bool *root_is_latched);
 
+    bool move_entries(IxNodeHandle *left, IxNodeHandle *right, IxNodeHandle *parent, int sep_idx,
+                      const IxNodeImage &image, int mid);
+
     Iid lower_bound(const char *key);
 
     Iid upper_bound(const char *key);
@@ -205,6 +351,58 @@ class IxIndexHandle {
 
     Iid leaf_begin() const;
 
+    int count_range(const Iid &lower, const Iid &upper, int limit) const;
+
+    void get_key(const Iid &iid, char *key) const;
+
+    int get_num_pages() const { return file_hdr_->num_pages_; }
+
+    // for maintenance
+    IxTreeStats get_tree_stats();
+
+    IxCompactStats compact(double fill_factor = IX_COMPACT_FILL_FACTOR);
+
+    /* 设置自适应哈希的内存上限，为0时关闭 */
+    void set_adaptive_hash_max_bytes(size_t max_bytes) {
+        std::scoped_lock lock{root_latch_};
+        adaptive_hash_.set_max_bytes(file_hdr_->unique_ ? max_bytes : 0);
+    }
+
+    const IxAdaptiveHash &get_adaptive_hash() const { return adaptive_hash_; }
+
+    /* key（只包含索引字段）是否可能存在于索引中，返回false时一定不存在 */
+    bool may_contain(const char *key) {
+        std::scoped_lock lock{root_latch_};
+        return bloom_may_contain(key);
+    }
+
+    /* 从叶子层重建Bloom过滤器，批量插入后调用 */
+    void rebuild_bloom_filter() {
+        std::scoped_lock lock{root_latch_};
+        build_bloom_filter();
+    }
+
+    /* 打开或关闭Bloom过滤器，关闭时释放其内存 */
+    void set_bloom_filter_enabled(bool enabled) {
+        std::scoped_lock lock{root_latch_};
+        bloom_enabled_ = enabled;
+        bloom_stale_ = true;
+        bloom_.clear();
+    }
+
+    const BloomFilter &get_bloom_filter() const { return bloom_; }
+
+    /* 设置常驻内存的层数，为0时关闭 */
+    void set_resident_depth(int depth) {
+        std::scoped_lock lock{root_latch_};
+        release_resident();
+        resident_depth_ = depth;
+    }
+
+    size_t get_num_resident() const { return resident_.size(); }
+
+    void release_resident();
+
    private:
     // 辅助函数
     void update_root_page_no(page_id_t root) { file_hdr_->root_page_ = root; }
@@ -214,10 +412,47 @@ class IxIndexHandle {
     // for get/create node
     IxNodeHandle *fetch_node(int page_no) const;
 
+    IxNodeHandle *find_insert_leaf(const char *key, Transaction *transaction);
+
+    // for resident upper levels
+    IxResidentNode *make_resident(IxNodeHandle *node);
+
+    void unswizzle(page_id_t page_no);
+
+    void evict_resident(page_id_t page_no);
+
     IxNodeHandle *create_node();
 
+    // for non-unique index
+    const char *make_tree_key(const char *key, const Rid &value, std::vector<char> *buf) const;
+
+    Iid leaf_bound(const char *key, bool upper);
+
+    // for variable-length nodes
+    int split_point(const IxNodeImage &image, bool is_leaf) const;
+
+    void make_separator(const char *left, const char *right, char *sep) const;
+
+    void merge_siblings(IxNodeHandle *left, IxNodeHandle *right, IxNodeHandle *parent, int sep_idx,
+                        IxNodeImage *image) const;
+
+    // for compaction
+    IxCompactStep compact_step(int level, int target, std::vector<char> *cursor);
+
+    void relocate_step(const std::vector<page_id_t> &pages, size_t *pos, int *num_relocated);
+
+    void swap_leaves(page_id_t page_no, page_id_t other_page_no);
+
     // for maintain data structure
-    void maintain_parent(IxNodeHandle *node);
+    bool lookup_adaptive_hash(const char *key, std::vector<Rid> *result);
+
+    bool bloom_may_contain(const char *key);
+
+    void bloom_insert(const char *key);
+
+    void build_bloom_filter();
+
+    void invalidate_leaf(IxNodeHandle *node);
 
     void erase_leaf(IxNodeHandle *leaf);
 
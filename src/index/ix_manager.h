@@ -10,12 +10,14 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
 #include "system/sm_meta.h"
 #include "ix_defs.h"
 #include "ix_index_handle.h"
+#include "ix_hash_index_handle.h"
 
 class IxManager {
    private:
@@ -54,17 +56,13 @@ class IxManager {
         return disk_manager_->is_file(ix_name);
     }
 
-    void create_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
+    void create_index(const std::string &filename, const std::vector<ColMeta>& index_cols, bool unique = true) {
         std::string ix_name = get_index_name(filename, index_cols);
         // Create index file
         disk_manager_->create_file(ix_name);
         // Open index file
         int fd = disk_manager_->open_file(ix_name);
 
-        // Create file header and write to file
-        // Theoretically we have: |page_hdr| + (|attr| + |rid|) * n <= PAGE_SIZE
-        // but we reserve one slot for convenient inserting and deleting, i.e.
-        // |page_hdr| + (|attr| + |rid|) * (n + 1) <= PAGE_SIZE
         int col_tot_len = 0;
         int col_num = index_cols.size();
         for(auto& col: index_cols) {
@@ -73,15 +71,11 @@ class IxManager {
         if (col_tot_len > IX_MAX_COL_LEN) {
             throw InvalidColLengthError(col_tot_len);
         }
-        // 根据 |page_hdr| + (|attr| + |rid|) * (n + 1) <= PAGE_SIZE 求得n的最大值btree_order
-        // 即 n <= btree_order，那么btree_order就是每个结点最多可插入的键值对数量（实际还多留了一个空位，但其不可插入）
-        int btree_order = static_cast<int>((PAGE_SIZE - sizeof(IxPageHdr)) / (col_tot_len + sizeof(Rid)) - 1);
-        assert(btree_order > 2);
-
+        // 结点的容量由其中key实际占用的字节数决定（见IxPageHdr），
+        // IX_MAX_COL_LEN保证了每个结点至少能放下若干个完整的键值对
         // Create file header and write to file
         IxFileHdr* fhdr = new IxFileHdr(IX_NO_PAGE, IX_INIT_NUM_PAGES, IX_INIT_ROOT_PAGE,
-                                col_num, col_tot_len, btree_order, (btree_order + 1) * col_tot_len,
-                                IX_INIT_ROOT_PAGE, IX_INIT_ROOT_PAGE);
+                                col_num, col_tot_len, unique, IX_INIT_ROOT_PAGE, IX_INIT_ROOT_PAGE);
         for(int i = 0; i < col_num; ++i) {
             fhdr->col_types_.push_back(index_cols[i].type);
             fhdr->col_lens_.push_back(index_cols[i].len);
@@ -107,6 +101,9 @@ class IxManager {
                 .is_leaf = true,
                 .prev_leaf = IX_INIT_ROOT_PAGE,
                 .next_leaf = IX_INIT_ROOT_PAGE,
+                .prefix_len = 0,
+                .suffix_bytes = 0,
+                .num_group = 0,
             };
             disk_manager_->write_page(fd, IX_LEAF_HEADER_PAGE, page_buf, PAGE_SIZE);
         }
@@ -122,6 +119,9 @@ class IxManager {
                 .is_leaf = true,
                 .prev_leaf = IX_LEAF_HEADER_PAGE,
                 .next_leaf = IX_LEAF_HEADER_PAGE,
+                .prefix_len = 0,
+                .suffix_bytes = 0,
+                .num_group = 0,
             };
             // Must write PAGE_SIZE here in case of future fetch_node()
             disk_manager_->write_page(fd, IX_INIT_ROOT_PAGE, page_buf, PAGE_SIZE);
@@ -133,6 +133,55 @@ class IxManager {
         disk_manager_->close_file(fd);
     }
 
+    /**
+     * @description: 创建可扩展哈希索引文件：第0页为文件头，第1页为目录页（只有一项），第2页为初始的空桶
+     */
+    void create_hash_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
+        std::string ix_name = get_index_name(filename, index_cols);
+        disk_manager_->create_file(ix_name);
+        int fd = disk_manager_->open_file(ix_name);
+
+        IxHashFileHdr fhdr;
+        fhdr.first_free_page_no_ = IX_NO_PAGE;
+        fhdr.num_pages_ = IX_HASH_INIT_NUM_PAGES;
+        fhdr.global_depth_ = 0;
+        fhdr.col_num_ = index_cols.size();
+        fhdr.col_tot_len_ = 0;
+        for(auto& col: index_cols) {
+            fhdr.col_types_.push_back(col.type);
+            fhdr.col_lens_.push_back(col.len);
+            fhdr.col_tot_len_ += col.len;
+        }
+        if (fhdr.col_tot_len_ > IX_MAX_COL_LEN) {
+            disk_manager_->close_file(fd);
+            disk_manager_->destroy_file(ix_name);
+            throw InvalidColLengthError(fhdr.col_tot_len_);
+        }
+        // 每个桶最多存放BUCKET_SIZE个键值对，key较长时受页面大小限制
+        int page_capacity = (PAGE_SIZE - sizeof(IxHashBucketHdr)) / (fhdr.col_tot_len_ + sizeof(Rid));
+        fhdr.bucket_capacity_ = std::min(BUCKET_SIZE, page_capacity);
+        fhdr.dir_page_nos_.push_back(IX_HASH_DIR_PAGE);
+
+        char page_buf[PAGE_SIZE];
+        memset(page_buf, 0, PAGE_SIZE);
+        fhdr.serialize(page_buf);
+        disk_manager_->write_page(fd, IX_FILE_HDR_PAGE, page_buf, PAGE_SIZE);
+
+        memset(page_buf, 0, PAGE_SIZE);
+        *reinterpret_cast<page_id_t *>(page_buf) = IX_HASH_INIT_BUCKET_PAGE;
+        disk_manager_->write_page(fd, IX_HASH_DIR_PAGE, page_buf, PAGE_SIZE);
+
+        memset(page_buf, 0, PAGE_SIZE);
+        *reinterpret_cast<IxHashBucketHdr *>(page_buf) = {
+            .next_free_page_no = IX_NO_PAGE,
+            .local_depth = 0,
+            .num_entries = 0,
+        };
+        disk_manager_->write_page(fd, IX_HASH_INIT_BUCKET_PAGE, page_buf, PAGE_SIZE);
+
+        disk_manager_->close_file(fd);
+    }
+
     void destroy_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
         std::string ix_name = get_index_name(filename, index_cols);
         disk_manager_->destroy_file(ix_name);
@@ -156,12 +205,31 @@ class IxManager {
         return std::make_unique<IxIndexHandle>(disk_manager_, buffer_pool_manager_, fd);
     }
 
-    void close_index(const IxIndexHandle *ih) {
+    std::unique_ptr<IxHashIndexHandle> open_hash_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
+        std::string ix_name = get_index_name(filename, index_cols);
+        int fd = disk_manager_->open_file(ix_name);
+        return std::make_unique<IxHashIndexHandle>(disk_manager_, buffer_pool_manager_, fd);
+    }
+
+    void close_hash_index(const IxHashIndexHandle *ih) {
+        char page_buf[PAGE_SIZE];
+        memset(page_buf, 0, PAGE_SIZE);
+        ih->file_hdr_->serialize(page_buf);
+        disk_manager_->write_page(ih->fd_, IX_FILE_HDR_PAGE, page_buf, PAGE_SIZE);
+        buffer_pool_manager_->flush_all_pages(ih->fd_);
+        buffer_pool_manager_->delete_all_pages(ih->fd_);
+        disk_manager_->close_file(ih->fd_);
+    }
+
+    void close_index(IxIndexHandle *ih) {
+        ih->release_resident();
         char* data = new char[ih->file_hdr_->tot_len_];
         ih->file_hdr_->serialize(data);
         disk_manager_->write_page(ih->fd_, IX_FILE_HDR_PAGE, data, ih->file_hdr_->tot_len_);
         // 缓冲区的所有页刷到磁盘，注意这句话必须写在close_file前面
         buffer_pool_manager_->flush_all_pages(ih->fd_);
+        buffer_pool_manager_->delete_all_pages(ih->fd_);
+        delete[] data;
         disk_manager_->close_file(ih->fd_);
     }
 };
\ No newline at end of file
@@ -0,0 +1,232 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include "defs.h"
+
+/**
+ * @brief 压缩的rid集合，用于合并多个索引扫描的结果
+ * 参照Roaring Bitmap按page_no分桶，每个数据页一个容器：记录少时是有序的slot_no数组，
+ * 多于每页最大记录数的1/16时（此时数组比位图大）转为按slot_no寻址的位图；
+ * 页面按page_no有序，遍历时即按(page_no, slot_no)的顺序回表
+ */
+class RidBitmap {
+    struct Container {
+        std::vector<uint16_t> array;    // 有序的slot_no，位图容器中为空
+        std::vector<uint64_t> bits;     // 位图容器中每个slot_no一位，数组容器中为空
+        int cardinality = 0;
+
+        bool is_bitmap() const { return !bits.empty(); }
+
+        bool test(int slot_no) const { return (bits[slot_no >> 6] >> (slot_no & 63)) & 1; }
+    };
+
+    int max_slots_;                     // 每页最多的记录数，决定位图容器的大小
+    std::map<int, Container> pages_;    // page_no -> 容器
+    size_t cardinality_ = 0;
+
+   public:
+    /* 遍历集合中的rid，按(page_no, slot_no)递增 */
+    class Iterator {
+        const RidBitmap *bitmap_;
+        std::map<int, Container>::const_iterator page_;
+        int pos_ = 0;                   // 数组容器中的下标，或位图容器中下一个要检查的slot_no
+
+       public:
+        explicit Iterator(const RidBitmap *bitmap) : bitmap_(bitmap), page_(bitmap->pages_.begin()) {}
+
+        bool next(Rid *rid) {
+            for (; page_ != bitmap_->pages_.end(); ++page_, pos_ = 0) {
+                const Container &c = page_->second;
+                if (!c.is_bitmap()) {
+                    if (pos_ < static_cast<int>(c.array.size())) {
+                        *rid = Rid{page_->first, c.array[pos_++]};
+                        return true;
+                    }
+                    continue;
+                }
+                for (; pos_ < bitmap_->max_slots_; pos_++) {
+                    if (c.test(pos_)) {
+                        *rid = Rid{page_->first, pos_++};
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+    };
+
+    explicit RidBitmap(int max_slots) : max_slots_(max_slots) {}
+
+    size_t cardinality() const { return cardinality_; }
+
+    bool empty() const { return cardinality_ == 0; }
+
+    Iterator iterator() const { return Iterator(this); }
+
+    /* 估算占用的内存 */
+    size_t memory_bytes() const {
+        size_t bytes = 0;
+        for (auto &[page_no, c] : pages_) {
+            bytes += sizeof(page_no) + sizeof(Container) + c.array.size() * sizeof(uint16_t) +
+                     c.bits.size() * sizeof(uint64_t);
+        }
+        return bytes;
+    }
+
+    void add(const Rid &rid) {
+        Container &c = pages_[rid.page_no];
+        if (c.is_bitmap()) {
+            uint64_t &word = c.bits[rid.slot_no >> 6];
+            uint64_t mask = uint64_t(1) << (rid.slot_no & 63);
+            if ((word & mask) == 0) {
+                word |= mask;
+                c.cardinality++;
+                cardinality_++;
+            }
+            return;
+        }
+        auto it = std::lower_bound(c.array.begin(), c.array.end(), rid.slot_no);
+        if (it != c.array.end() && *it == rid.slot_no) {
+            return;
+        }
+        c.array.insert(it, rid.slot_no);
+        c.cardinality++;
+        cardinality_++;
+        if (c.cardinality > array_limit()) {
+            to_bitmap(&c);
+        }
+    }
+
+    bool contains(const Rid &rid) const {
+        auto it = pages_.find(rid.page_no);
+        if (it == pages_.end()) {
+            return false;
+        }
+        const Container &c = it->second;
+        return c.is_bitmap() ? c.test(rid.slot_no) : std::binary_search(c.array.begin(), c.array.end(), rid.slot_no);
+    }
+
+    /* 求交集，结果保存在this中 */
+    void intersect_with(const RidBitmap &other) {
+        cardinality_ = 0;
+        for (auto it = pages_.begin(); it != pages_.end();) {
+            auto other_it = other.pages_.find(it->first);
+            if (other_it == other.pages_.end()) {
+                it = pages_.erase(it);
+                continue;
+            }
+            Container &c = it->second;
+            const Container &o = other_it->second;
+            if (c.is_bitmap() && o.is_bitmap()) {
+                c.cardinality = 0;
+                for (size_t i = 0; i < c.bits.size(); i++) {
+                    c.bits[i] &= o.bits[i];
+                    c.cardinality += __builtin_popcountll(c.bits[i]);
+                }
+                if (c.cardinality <= array_limit()) {
+                    to_array(&c);
+                }
+            } else if (c.is_bitmap()) {
+                // 数组与位图的交集不会多于数组的大小，结果总是数组
+                Container result;
+                for (uint16_t slot_no : o.array) {
+                    if (c.test(slot_no)) {
+                        result.array.push_back(slot_no);
+                    }
+                }
+                result.cardinality = result.array.size();
+                c = std::move(result);
+            } else {
+                auto keep = [&](uint16_t slot_no) {
+                    return o.is_bitmap() ? o.test(slot_no)
+                                         : std::binary_search(o.array.begin(), o.array.end(), slot_no);
+                };
+                c.array.erase(std::remove_if(c.array.begin(), c.array.end(), [&](uint16_t s) { return !keep(s); }),
+                              c.array.end());
+                c.cardinality = c.array.size();
+            }
+            if (c.cardinality == 0) {
+                it = pages_.erase(it);
+                continue;
+            }
+            cardinality_ += c.cardinality;
+            ++it;
+        }
+    }
+
+    /* 求并集，结果保存在this中 */
+    void union_with(const RidBitmap &other) {
+        for (auto &[page_no, o] : other.pages_) {
+            Container &c = pages_[page_no];
+            cardinality_ -= c.cardinality;
+            if (!c.is_bitmap() && !o.is_bitmap()) {
+                std::vector<uint16_t> merged;
+                std::set_union(c.array.begin(), c.array.end(), o.array.begin(), o.array.end(),
+                               std::back_inserter(merged));
+                c.array = std::move(merged);
+                c.cardinality = c.array.size();
+                if (c.cardinality > array_limit()) {
+                    to_bitmap(&c);
+                }
+            } else {
+                if (!c.is_bitmap()) {
+                    to_bitmap(&c);
+                }
+                c.cardinality = 0;
+                for (size_t i = 0; i < c.bits.size(); i++) {
+                    if (o.is_bitmap()) {
+                        c.bits[i] |= o.bits[i];
+                    }
+                    c.cardinality += __builtin_popcountll(c.bits[i]);
+                }
+                if (!o.is_bitmap()) {
+                    for (uint16_t slot_no : o.array) {
+                        if (!c.test(slot_no)) {
+                            c.bits[slot_no >> 6] |= uint64_t(1) << (slot_no & 63);
+                            c.cardinality++;
+                        }
+                    }
+                }
+            }
+            cardinality_ += c.cardinality;
+        }
+    }
+
+   private:
+    /* 数组容器的最大长度，超过后位图更省空间 */
+    int array_limit() const { return max_slots_ / 16; }
+
+    void to_bitmap(Container *c) const {
+        c->bits.assign((max_slots_ + 63) / 64, 0);
+        for (uint16_t slot_no : c->array) {
+            c->bits[slot_no >> 6] |= uint64_t(1) << (slot_no & 63);
+        }
+        c->array.clear();
+        c->array.shrink_to_fit();
+    }
+
+    void to_array(Container *c) const {
+        for (int slot_no = 0; slot_no < max_slots_; slot_no++) {
+            if (c->test(slot_no)) {
+                c->array.push_back(slot_no);
+            }
+        }
+        c->bits.clear();
+        c->bits.shrink_to_fit();
+    }
+};
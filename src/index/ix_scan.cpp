@@ -16,6 +16,10 @@ See the Mulan PSL v2 for more details. */
  */
 void IxScan::next() {
     assert(!is_end());
+    if (reverse_) {
+        iid_ = prev(iid_);
+        return;
+    }
     IxNodeHandle *node = ih_->fetch_node(iid_.page_no);
     assert(node->is_leaf_page());
     assert(iid_.slot_no < node->get_size());
@@ -26,6 +30,30 @@ void IxScan::next() {
         iid_.slot_no = 0;
         iid_.page_no = node->get_next_leaf();
     }
+    bpm_->unpin_page(node->get_page_id(), false);
+    delete node;
+}
+
+/**
+ * @brief 叶子层中iid的前一项，iid为某个叶子的第0项时取前一个叶子的最后一项
+ * @return 第一个叶子的第0项之前返回{first_leaf, -1}
+ */
+Iid IxScan::prev(const Iid &iid) const {
+    if (iid.slot_no > 0) {
+        return {.page_no = iid.page_no, .slot_no = iid.slot_no - 1};
+    }
+    if (iid.page_no == ih_->file_hdr_->first_leaf_) {
+        return {.page_no = iid.page_no, .slot_no = -1};
+    }
+    IxNodeHandle *node = ih_->fetch_node(iid.page_no);
+    assert(node->is_leaf_page());
+    IxNodeHandle *prev = ih_->fetch_node(node->get_prev_leaf());
+    Iid prev_iid = {.page_no = prev->get_page_no(), .slot_no = prev->get_size() - 1};
+    bpm_->unpin_page(node->get_page_id(), false);
+    bpm_->unpin_page(prev->get_page_id(), false);
+    delete node;
+    delete prev;
+    return prev_iid;
 }
 
 Rid IxScan::rid() const {
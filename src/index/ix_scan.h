@@ -17,16 +17,23 @@ See the Mulan PSL v2 for more details. */
 
 // 用于遍历叶子结点
 // 用于直接遍历叶子结点，而不用findleafpage来得到叶子结点
+// 逆序扫描时沿prev_leaf从upper的前一项遍历到lower，iid_和end_都取正序时位置的前一项，第一个叶子的第0项之前记为slot_no=-1
 // TODO：对page遍历时，要加上读锁
 class IxScan : public RecScan {
     const IxIndexHandle *ih_;
     Iid iid_;  // 初始为lower（用于遍历的指针）
     Iid end_;  // 初始为upper
     BufferPoolManager *bpm_;
+    bool reverse_;
 
    public:
-    IxScan(const IxIndexHandle *ih, const Iid &lower, const Iid &upper, BufferPoolManager *bpm)
-        : ih_(ih), iid_(lower), end_(upper), bpm_(bpm) {}
+    IxScan(const IxIndexHandle *ih, const Iid &lower, const Iid &upper, BufferPoolManager *bpm, bool reverse = false)
+        : ih_(ih), iid_(lower), end_(upper), bpm_(bpm), reverse_(reverse) {
+        if (reverse_) {
+            iid_ = prev(upper);
+            end_ = prev(lower);
+        }
+    }
 
     void next() override;
 
@@ -35,4 +42,7 @@ class IxScan : public RecScan {
     Rid rid() const override;
 
     const Iid &iid() const { return iid_; }
+
+   private:
+    Iid prev(const Iid &iid) const;
 };
\ No newline at end of file
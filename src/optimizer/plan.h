@@ -28,6 +28,7 @@ typedef enum PlanTag{
     T_DropTable,
     T_CreateIndex,
     T_DropIndex,
+    T_OptimizeIndex,
     T_Insert,
     T_Update,
     T_Delete,
@@ -38,8 +39,17 @@ typedef enum PlanTag{
     T_Transaction_rollback,
     T_SeqScan,
     T_IndexScan,
-    T_NestLoop,
+    T_IndexOnlyScan,
+    T_HashIndexScan,
+    T_BitmapHeapScan,
+    T_NestLoop,         // 尚未选择连接方式的连接，由Planner::choose_join_methods改为下面的一种
+    T_IndexNestLoop,
+    T_BlockNestLoop,
+    T_HashJoin,
+    T_MergeJoin,
+    T_Aggregate,
     T_Sort,
+    T_Limit,
     T_Projection
 } PlanTag;
 
@@ -74,6 +84,9 @@ class ScanPlan : public Plan
         size_t len_;                               
         std::vector<Condition> fed_conds_;
         std::vector<std::string> index_col_names_;
+        std::vector<std::vector<std::string>> and_index_col_names_;   // BitmapHeapScan中与index_col_names_求交的其他索引
+        bool ordered_ = false;      // 索引扫描的输出已按ORDER BY的字段有序，无需再排序
+        bool is_desc_ = false;      // 按索引逆序扫描
     
 };
 
@@ -97,6 +110,7 @@ class JoinPlan : public Plan
         std::vector<Condition> conds_;
         // future TODO: 后续可以支持的连接类型
         JoinType type;
+        bool build_left_ = false;   // 哈希连接在左子节点上建哈希表，否则在右子节点上建
         
 };
 
@@ -115,20 +129,54 @@ class ProjectionPlan : public Plan
         
 };
 
+class AggregatePlan : public Plan
+{
+    public:
+        AggregatePlan(PlanTag tag, std::shared_ptr<Plan> subplan, std::vector<TabCol> group_cols,
+                      std::vector<AggExpr> aggs)
+        {
+            Plan::tag = tag;
+            subplan_ = std::move(subplan);
+            group_cols_ = std::move(group_cols);
+            aggs_ = std::move(aggs);
+        }
+        ~AggregatePlan(){}
+        std::shared_ptr<Plan> subplan_;
+        std::vector<TabCol> group_cols_;    // 分组字段，为空时所有记录聚合为一行
+        std::vector<AggExpr> aggs_;
+        
+};
+
 class SortPlan : public Plan
 {
     public:
-        SortPlan(PlanTag tag, std::shared_ptr<Plan> subplan, TabCol sel_col, bool is_desc)
+        SortPlan(PlanTag tag, std::shared_ptr<Plan> subplan, std::vector<SortKey> sort_keys)
         {
             Plan::tag = tag;
             subplan_ = std::move(subplan);
-            sel_col_ = sel_col;
-            is_desc_ = is_desc;
+            sort_keys_ = std::move(sort_keys);
         }
         ~SortPlan(){}
         std::shared_ptr<Plan> subplan_;
-        TabCol sel_col_;
-        bool is_desc_;
+        std::vector<SortKey> sort_keys_;    // 排序键，按优先级排列
+        int limit_ = -1;                    // 只需要输出的前limit_行，由上层的LIMIT下推，-1时输出全部
+        
+};
+
+class LimitPlan : public Plan
+{
+    public:
+        LimitPlan(PlanTag tag, std::shared_ptr<Plan> subplan, int limit, int offset)
+        {
+            Plan::tag = tag;
+            subplan_ = std::move(subplan);
+            limit_ = limit;
+            offset_ = offset;
+        }
+        ~LimitPlan(){}
+        std::shared_ptr<Plan> subplan_;
+        int limit_;
+        int offset_;
         
 };
 
@@ -159,17 +207,22 @@ class DMLPlan : public Plan
 class DDLPlan : public Plan
 {
     public:
-        DDLPlan(PlanTag tag, std::string tab_name, std::vector<std::string> col_names, std::vector<ColDef> cols)
+        DDLPlan(PlanTag tag, std::string tab_name, std::vector<std::string> col_names, std::vector<ColDef> cols,
+                IndexType index_type = INDEX_BTREE, bool unique = true)
         {
             Plan::tag = tag;
             tab_name_ = std::move(tab_name);
             cols_ = std::move(cols);
             tab_col_names_ = std::move(col_names);
+            index_type_ = index_type;
+            unique_ = unique;
         }
         ~DDLPlan(){}
         std::string tab_name_;
         std::vector<std::string> tab_col_names_;
         std::vector<ColDef> cols_;
+        IndexType index_type_;      // create index时索引的组织方式
+        bool unique_;               // create index时是否为唯一索引
 };
 
 // help; show tables; desc tables; begin; abort; commit; rollback语句对应的plan
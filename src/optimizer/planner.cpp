@@ -12,30 +12,314 @@ See the Mulan PSL v2 for more details. */
 
 #include "planner.h"
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
 #include <memory>
 
 #include "execution/executor_delete.h"
+#include "execution/executor_hash_join.h"
 #include "execution/executor_index_scan.h"
 #include "execution/executor_insert.h"
-#include "execution/executor_nestedloop_join.h"
 #include "execution/executor_projection.h"
 #include "execution/executor_seq_scan.h"
 #include "execution/executor_update.h"
 #include "index/ix.h"
 #include "record_printer.h"
 
-// 目前的索引匹配规则为：完全匹配索引字段，且全部为单点查询，不会自动调整where条件的顺序
+// 索引匹配规则为最左前缀匹配：从索引的第一个字段开始依次匹配等值条件，
+// 遇到第一个没有等值条件的字段时，若其上有范围条件也可使用，之后的字段不再参与匹配；与where条件的顺序无关
+// 等值匹配的字段越多越优先，其次是最后一个字段能否用上范围条件
+// 哈希索引只能做点查，要求每个字段上都有等值条件，此时其优先于等值匹配字段数相同的B+树索引
 bool Planner::get_index_cols(std::string tab_name, std::vector<Condition> curr_conds, std::vector<std::string>& index_col_names) {
     index_col_names.clear();
-    for(auto& cond: curr_conds) {
-        if(cond.is_rhs_val && cond.op == OP_EQ && cond.lhs_col.tab_name.compare(tab_name) == 0)
-            index_col_names.push_back(cond.lhs_col.col_name);
-    }
     TabMeta& tab = sm_manager_->db_.get_table(tab_name);
-    if(tab.is_index(index_col_names)) return true;
+    int best_score = 0;
+    for(auto& index: tab.indexes) {
+        int score = 0;
+        for(auto& col: index.cols) {
+            bool has_eq = false, has_range = false;
+            for(auto& cond: curr_conds) {
+                if(!cond.is_rhs_val || cond.lhs_col.tab_name.compare(tab_name) != 0 || cond.lhs_col.col_name.compare(col.name) != 0)
+                    continue;
+                if(cond.op == OP_EQ) has_eq = true;
+                else if(cond.op != OP_NE) has_range = true;
+            }
+            if(has_eq) {
+                score += 2;
+                continue;
+            }
+            if(index.type == INDEX_HASH) score = 0;
+            else if(has_range) score += 1;
+            break;
+        }
+        if(index.type == INDEX_HASH && score > 0) score += 1;
+        if(score > best_score) {
+            best_score = score;
+            index_col_names.clear();
+            for(auto& col: index.cols) index_col_names.push_back(col.name);
+        }
+    }
+    return best_score > 0;
+}
+
+/**
+ * @brief 判断get_index_cols选出的索引是否为哈希索引
+ */
+bool Planner::is_hash_index(const std::string &tab_name, const std::vector<std::string> &index_col_names) {
+    TabMeta &tab = sm_manager_->db_.get_table(tab_name);
+    return tab.get_index_meta(index_col_names)->type == INDEX_HASH;
+}
+
+/**
+ * @brief 判断select语句在tab_name上用到的字段（投影、过滤、连接、排序、分组、聚合）是否全部包含在索引字段中
+ *
+ * @param query 查询，其中conds为尚未下推到表上的连接条件
+ * @param curr_conds 已经下推到该表上的条件
+ * @param index_col_names 索引包含的字段
+ * @return 是否可以只扫描索引而不回表
+ */
+bool Planner::is_covering_index(std::shared_ptr<Query> query, const std::string &tab_name,
+                                const std::vector<Condition> &curr_conds, const std::vector<std::string> &index_col_names) {
+    auto x = std::dynamic_pointer_cast<ast::SelectStmt>(query->parse);
+    if (x == nullptr) {
+        return false;
+    }
+    auto covered = [&](const TabCol &col) {
+        return col.tab_name != tab_name ||
+               std::find(index_col_names.begin(), index_col_names.end(), col.col_name) != index_col_names.end();
+    };
+    for (auto &col : query->cols) {
+        if (!covered(col)) return false;
+    }
+    auto conds_covered = [&](const std::vector<Condition> &conds) {
+        return std::all_of(conds.begin(), conds.end(), [&](const Condition &cond) {
+            return covered(cond.lhs_col) && (cond.is_rhs_val || covered(cond.rhs_col));
+        });
+    };
+    if (!conds_covered(curr_conds) || !conds_covered(query->conds)) {
+        return false;
+    }
+    for (auto &key : query->sort_keys) {
+        if (!covered(key.col)) {
+            return false;
+        }
+    }
+    for (auto &col : query->group_cols) {
+        if (!covered(col)) {
+            return false;
+        }
+    }
+    for (auto &agg : query->aggs) {
+        if (!agg.col.col_name.empty() && !covered(agg.col)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 在表上所有索引中找出总长度最短的覆盖索引，用于没有可用等值条件时的索引扫描
+ */
+bool Planner::get_covering_index_cols(std::shared_ptr<Query> query, const std::string &tab_name,
+                                      const std::vector<Condition> &curr_conds, std::vector<std::string> &index_col_names) {
+    index_col_names.clear();
+    int best_len = -1;
+    TabMeta &tab = sm_manager_->db_.get_table(tab_name);
+    for (auto &index : tab.indexes) {
+        if (index.type == INDEX_HASH) {
+            continue;
+        }
+        std::vector<std::string> col_names;
+        for (auto &col : index.cols) {
+            col_names.push_back(col.name);
+        }
+        if ((best_len == -1 || index.col_tot_len < best_len) && is_covering_index(query, tab_name, curr_conds, col_names)) {
+            best_len = index.col_tot_len;
+            index_col_names = col_names;
+        }
+    }
+    return best_len != -1;
+}
+
+// 估算选择率时最多统计的索引项数，超过后按该值估算
+constexpr int BITMAP_HEAP_SCAN_ESTIMATE_LIMIT = 1 << 16;
+// 逐条回表访问数据页的次数至少是排序后访问次数的这么多倍时，才值得先收集rid再排序
+constexpr double BITMAP_HEAP_SCAN_MIN_REUSE = 2.0;
+// 以读取一个数据页为单位的代价：从根结点查找到叶子结点，以及在叶子层读取一个索引项并加入rid集合
+constexpr double INDEX_DESCENT_COST = 2.0;
+constexpr double INDEX_ENTRY_COST = 0.02;
+// 能提供ORDER BY顺序的索引扫描范围不超过原索引的这么多倍时，改用它扫描以省去排序
+constexpr double ORDER_INDEX_MAX_ROWS_RATIO = 4.0;
+
+/**
+ * @brief 估算B+树索引在curr_conds确定的扫描范围内的项数，即满足这些条件的记录数
+ */
+double Planner::estimate_index_rows(const std::string &tab_name, const std::vector<Condition> &curr_conds,
+                                    const std::vector<std::string> &index_col_names) {
+    TabMeta &tab = sm_manager_->db_.get_table(tab_name);
+    IndexMeta &index_meta = *tab.get_index_meta(index_col_names);
+    IxIndexHandle *ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name, index_col_names)).get();
+    Iid lower, upper;
+    IndexScanExecutor::get_scan_range(ih, index_meta, curr_conds, &lower, &upper);
+    return ih->count_range(lower, upper, BITMAP_HEAP_SCAN_ESTIMATE_LIMIT);
+}
+
+/**
+ * @brief 按rid排序回表时读取的数据页数
+ * 设表有pages个数据页，rows条记录均匀分布时落在约pages * (1 - (1 - 1/pages)^rows)个不同的数据页上（Cardenas公式）
+ */
+double Planner::estimate_heap_pages(const std::string &tab_name, double rows) {
+    double pages = std::max(sm_manager_->fhs_.at(tab_name)->get_file_hdr().num_pages - 1, 1);
+    return pages * (1 - std::pow(1 - 1 / pages, rows));
+}
+
+/**
+ * @brief 判断B+树索引扫描是否应按rid排序后回表
+ * 逐条回表要访问rows次数据页，按rid排序后每页只访问一次，两者相差足够多时选择BitmapHeapScan
+ */
+bool Planner::use_bitmap_heap_scan(const std::string &tab_name, const std::vector<Condition> &curr_conds,
+                                   const std::vector<std::string> &index_col_names) {
+    double rows = estimate_index_rows(tab_name, curr_conds, index_col_names);
+    return rows > 1 && rows >= estimate_heap_pages(tab_name, rows) * BITMAP_HEAP_SCAN_MIN_REUSE;
+}
+
+/**
+ * @brief 选出用rid集合求交的多个B+树索引
+ * 候选为第一个字段上有与常量比较的条件的B+树索引，按估算的记录数从少到多排列，
+ * 假设各条件相互独立，依次加入能降低总代价（各索引的扫描代价加上按rid排序回表的数据页数）的索引；
+ * 只用一个索引时的代价按该索引逐条回表和排序后回表中较小的计算
+ *
+ * @param[out] index_col_names 第一个索引
+ * @param[out] and_index_col_names 与第一个索引求交的其他索引，至少一个
+ * @return 多个索引求交是否优于只用一个索引
+ */
+bool Planner::get_bitmap_and_indexes(const std::string &tab_name, const std::vector<Condition> &curr_conds,
+                                     std::vector<std::string> &index_col_names,
+                                     std::vector<std::vector<std::string>> &and_index_col_names) {
+    TabMeta &tab = sm_manager_->db_.get_table(tab_name);
+    std::vector<std::pair<double, std::vector<std::string>>> candidates;
+    for (auto &index : tab.indexes) {
+        if (index.type != INDEX_BTREE) {
+            continue;
+        }
+        bool usable = std::any_of(curr_conds.begin(), curr_conds.end(), [&](const Condition &cond) {
+            return cond.is_rhs_val && cond.op != OP_NE && cond.lhs_col.tab_name == tab_name &&
+                   cond.lhs_col.col_name == index.cols[0].name;
+        });
+        if (!usable) {
+            continue;
+        }
+        std::vector<std::string> col_names;
+        for (auto &col : index.cols) {
+            col_names.push_back(col.name);
+        }
+        candidates.emplace_back(estimate_index_rows(tab_name, curr_conds, col_names), std::move(col_names));
+    }
+    if (candidates.size() < 2) {
+        return false;
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+    double table_rows =
+        estimate_index_rows(tab_name, std::vector<Condition>(), candidates[0].second);  // 无条件时即整个叶子层
+    double rows = candidates[0].first;
+    double scan_cost = INDEX_DESCENT_COST + rows * INDEX_ENTRY_COST;
+    double best_cost = scan_cost + std::min(rows, estimate_heap_pages(tab_name, rows));
+    and_index_col_names.clear();
+    for (size_t i = 1; i < candidates.size() && rows >= 1; i++) {
+        double index_rows = candidates[i].first;
+        double and_rows = rows * std::min(index_rows / std::max(table_rows, 1.0), 1.0);
+        double and_scan_cost = scan_cost + INDEX_DESCENT_COST + index_rows * INDEX_ENTRY_COST;
+        double cost = and_scan_cost + estimate_heap_pages(tab_name, and_rows);
+        if (cost < best_cost) {
+            best_cost = cost;
+            rows = and_rows;
+            scan_cost = and_scan_cost;
+            and_index_col_names.push_back(candidates[i].second);
+        }
+    }
+    if (and_index_col_names.empty()) {
+        return false;
+    }
+    index_col_names = candidates[0].second;
+    return true;
+}
+
+/**
+ * @brief 判断B+树索引扫描的输出是否按col_name有序
+ * col_name是索引的某个字段，且它之前的字段上都有与常量的等值条件时，扫描范围内的key按col_name排列
+ */
+bool Planner::index_provides_order(const std::string &tab_name, const std::vector<Condition> &curr_conds,
+                                   const std::vector<std::string> &index_col_names, const std::string &col_name) {
+    TabMeta &tab = sm_manager_->db_.get_table(tab_name);
+    if (tab.get_index_meta(index_col_names)->type != INDEX_BTREE) {
+        return false;
+    }
+    for (auto &index_col_name : index_col_names) {
+        if (index_col_name == col_name) {
+            return true;
+        }
+        bool has_eq = std::any_of(curr_conds.begin(), curr_conds.end(), [&](const Condition &cond) {
+            return cond.is_rhs_val && cond.op == OP_EQ && cond.lhs_col.tab_name == tab_name &&
+                   cond.lhs_col.col_name == index_col_name;
+        });
+        if (!has_eq) {
+            return false;
+        }
+    }
     return false;
 }
 
+/**
+ * @brief ORDER BY只有一个排序键且其字段能由B+树索引的顺序提供时，改为按该索引扫描（DESC时逆序扫描），省去排序
+ * 已选的B+树索引能提供顺序时沿用该索引，其中BitmapHeapScan按rid顺序输出，改为逐条回表的索引扫描；
+ * 否则在能提供顺序的索引中选扫描范围最小的：原计划为顺序扫描时直接改用它，
+ * 原计划扫描其他索引时，它的扫描范围不超过原索引的ORDER_INDEX_MAX_ROWS_RATIO倍才改用；
+ * 哈希索引点查不变
+ */
+void Planner::use_index_order(std::shared_ptr<Query> query, const std::shared_ptr<ScanPlan> &plan) {
+    const std::string &tab_name = plan->tab_name_;
+    if (query->sort_keys.size() != 1 || plan->tag == T_HashIndexScan) {
+        return;
+    }
+    auto &order_col = query->sort_keys.front().col;
+    TabMeta &tab = sm_manager_->db_.get_table(tab_name);
+    std::vector<std::string> index_col_names;
+    if (plan->tag != T_SeqScan &&
+        index_provides_order(tab_name, plan->conds_, plan->index_col_names_, order_col.col_name)) {
+        index_col_names = plan->index_col_names_;
+    } else {
+        double best_rows = 0;
+        for (auto &index : tab.indexes) {
+            std::vector<std::string> col_names;
+            for (auto &col : index.cols) {
+                col_names.push_back(col.name);
+            }
+            if (!index_provides_order(tab_name, plan->conds_, col_names, order_col.col_name)) {
+                continue;
+            }
+            double rows = estimate_index_rows(tab_name, plan->conds_, col_names);
+            if (index_col_names.empty() || rows < best_rows) {
+                index_col_names = col_names;
+                best_rows = rows;
+            }
+        }
+        if (!index_col_names.empty() && plan->tag != T_SeqScan &&
+            best_rows > estimate_index_rows(tab_name, plan->conds_, plan->index_col_names_) * ORDER_INDEX_MAX_ROWS_RATIO) {
+            return;
+        }
+    }
+    if (index_col_names.empty()) {
+        return;
+    }
+    plan->tag = is_covering_index(query, tab_name, plan->conds_, index_col_names) ? T_IndexOnlyScan : T_IndexScan;
+    plan->index_col_names_ = index_col_names;
+    plan->and_index_col_names_.clear();
+    plan->ordered_ = true;
+    plan->is_desc_ = query->sort_keys.front().is_desc;
+}
+
 /**
  * @brief 表算子条件谓词生成
  *
@@ -131,6 +415,12 @@ std::shared_ptr<Plan> Planner::physical_optimization(std::shared_ptr<Query> quer
     std::shared_ptr<Plan> plan = make_one_rel(query);
     
     // 其他物理优化
+    choose_join_methods(plan);
+
+    // 处理聚合，之后的排序在聚合的结果上进行
+    if (!query->aggs.empty() || !query->group_cols.empty()) {
+        plan = std::make_shared<AggregatePlan>(T_Aggregate, std::move(plan), query->group_cols, query->aggs);
+    }
 
     // 处理orderby
     plan = generate_sort_plan(query, std::move(plan)); 
@@ -150,11 +440,31 @@ std::shared_ptr<Plan> Planner::make_one_rel(std::shared_ptr<Query> query)
         auto curr_conds = pop_conds(query->conds, tables[i]);
         // int index_no = get_indexNo(tables[i], curr_conds);
         std::vector<std::string> index_col_names;
+        std::vector<std::vector<std::string>> and_index_col_names;
         bool index_exist = get_index_cols(tables[i], curr_conds, index_col_names);
         if (index_exist == false) {  // 该表没有索引
-            index_col_names.clear();
-            table_scan_executors[i] = 
-                std::make_shared<ScanPlan>(T_SeqScan, sm_manager_, tables[i], curr_conds, index_col_names);
+            if (get_covering_index_cols(query, tables[i], curr_conds, index_col_names)) {
+                // 没有可用的等值条件，但存在覆盖索引，扫描索引比扫描表读取的页面更少
+                table_scan_executors[i] =
+                    std::make_shared<ScanPlan>(T_IndexOnlyScan, sm_manager_, tables[i], curr_conds, index_col_names);
+            } else {
+                table_scan_executors[i] = 
+                    std::make_shared<ScanPlan>(T_SeqScan, sm_manager_, tables[i], curr_conds, index_col_names);
+            }
+        } else if (is_hash_index(tables[i], index_col_names)) {  // 哈希索引点查
+            table_scan_executors[i] =
+                std::make_shared<ScanPlan>(T_HashIndexScan, sm_manager_, tables[i], curr_conds, index_col_names);
+        } else if (is_covering_index(query, tables[i], curr_conds, index_col_names)) {  // 存在覆盖索引，无需回表
+            table_scan_executors[i] =
+                std::make_shared<ScanPlan>(T_IndexOnlyScan, sm_manager_, tables[i], curr_conds, index_col_names);
+        } else if (get_bitmap_and_indexes(tables[i], curr_conds, index_col_names, and_index_col_names)) {
+            // 多个索引的rid集合求交后按rid顺序回表
+            auto plan = std::make_shared<ScanPlan>(T_BitmapHeapScan, sm_manager_, tables[i], curr_conds, index_col_names);
+            plan->and_index_col_names_ = std::move(and_index_col_names);
+            table_scan_executors[i] = plan;
+        } else if (use_bitmap_heap_scan(tables[i], curr_conds, index_col_names)) {  // 范围内记录较多，按rid排序后回表
+            table_scan_executors[i] =
+                std::make_shared<ScanPlan>(T_BitmapHeapScan, sm_manager_, tables[i], curr_conds, index_col_names);
         } else {  // 存在索引
             table_scan_executors[i] =
                 std::make_shared<ScanPlan>(T_IndexScan, sm_manager_, tables[i], curr_conds, index_col_names);
@@ -163,6 +473,9 @@ std::shared_ptr<Plan> Planner::make_one_rel(std::shared_ptr<Query> query)
     // 只有一个表，不需要join。
     if(tables.size() == 1)
     {
+        if (!query->sort_keys.empty() && query->aggs.empty() && query->group_cols.empty()) {
+            use_index_order(query, std::static_pointer_cast<ScanPlan>(table_scan_executors[0]));
+        }
         return table_scan_executors[0];
     }
     // 获取where条件
@@ -250,26 +563,244 @@ std::shared_ptr<Plan> Planner::make_one_rel(std::shared_ptr<Query> query)
 }
 
 
+/**
+ * @brief 估算算子输出的记录数，只用于比较连接两侧的大小
+ * B+树索引扫描按扫描范围内的索引项数估算，哈希索引点查按1条估算，顺序扫描按数据页能容纳的记录数估算；
+ * 连接按较大的一侧估算
+ */
+double Planner::estimate_rows(const std::shared_ptr<Plan> &plan) {
+    if (auto join = std::dynamic_pointer_cast<JoinPlan>(plan)) {
+        return std::max(estimate_rows(join->left_), estimate_rows(join->right_));
+    }
+    auto scan = std::static_pointer_cast<ScanPlan>(plan);
+    if (scan->tag == T_HashIndexScan) {
+        return 1;
+    }
+    if (scan->tag != T_SeqScan) {
+        return estimate_index_rows(scan->tab_name_, scan->conds_, scan->index_col_names_);
+    }
+    RmFileHdr file_hdr = sm_manager_->fhs_.at(scan->tab_name_)->get_file_hdr();
+    return std::max(file_hdr.num_pages - 1, 1) * (double)file_hdr.num_records_per_page;
+}
+
+/* 收集算子输出的所有字段 */
+static void collect_cols(const std::shared_ptr<Plan> &plan, std::vector<ColMeta> &cols) {
+    if (auto join = std::dynamic_pointer_cast<JoinPlan>(plan)) {
+        collect_cols(join->left_, cols);
+        collect_cols(join->right_, cols);
+    } else {
+        auto &scan_cols = std::static_pointer_cast<ScanPlan>(plan)->cols_;
+        cols.insert(cols.end(), scan_cols.begin(), scan_cols.end());
+    }
+}
+
+/**
+ * @brief 判断连接条件中是否有两侧字段分属左右子节点、类型相同的等值条件，即能否用作哈希连接的key
+ */
+bool Planner::has_equi_join_cond(const std::shared_ptr<JoinPlan> &join) {
+    std::vector<ColMeta> left_cols, right_cols;
+    collect_cols(join->left_, left_cols);
+    collect_cols(join->right_, right_cols);
+    const ColMeta *left_key, *right_key;
+    return std::any_of(join->conds_.begin(), join->conds_.end(), [&](const Condition &cond) {
+        return get_join_key(left_cols, right_cols, cond, &left_key, &right_key);
+    });
+}
+
+/**
+ * @brief 判断算子的输出是否已按col升序排列，不需要额外的代价
+ * 升序的B+树索引扫描在索引能提供该字段的顺序时有序；合并连接按连接key有序，key两侧的字段相等，都算有序；
+ * 排序算子按第一个排序键升序时按该字段有序
+ */
+bool Planner::plan_ordered_by(const std::shared_ptr<Plan> &plan, const TabCol &col) {
+    if (auto scan = std::dynamic_pointer_cast<ScanPlan>(plan)) {
+        return (scan->tag == T_IndexScan || scan->tag == T_IndexOnlyScan) && !scan->is_desc_ &&
+               scan->tab_name_ == col.tab_name &&
+               index_provides_order(scan->tab_name_, scan->conds_, scan->index_col_names_, col.col_name);
+    }
+    if (auto join = std::dynamic_pointer_cast<JoinPlan>(plan); join != nullptr && join->tag == T_MergeJoin) {
+        // 合并连接的key为第一个连接条件，见use_merge_join
+        auto &key = join->conds_.front();
+        auto same_col = [&](const TabCol &other) {
+            return other.tab_name == col.tab_name && other.col_name == col.col_name;
+        };
+        return same_col(key.lhs_col) || same_col(key.rhs_col);
+    }
+    if (auto sort = std::dynamic_pointer_cast<SortPlan>(plan)) {
+        auto &key = sort->sort_keys_.front();
+        return !key.is_desc && key.col.tab_name == col.tab_name && key.col.col_name == col.col_name;
+    }
+    return false;
+}
+
+/**
+ * @brief 两个子节点的输出都已按某个等值连接条件两侧的字段有序时使用合并连接，
+ * 该条件移到连接条件的最前面，MergeJoinExecutor以它作为连接key
+ */
+bool Planner::use_merge_join(const std::shared_ptr<JoinPlan> &join) {
+    std::vector<ColMeta> left_cols, right_cols;
+    collect_cols(join->left_, left_cols);
+    collect_cols(join->right_, right_cols);
+    for (auto it = join->conds_.begin(); it != join->conds_.end(); ++it) {
+        const ColMeta *left_key, *right_key;
+        if (!get_join_key(left_cols, right_cols, *it, &left_key, &right_key)) {
+            continue;
+        }
+        if (plan_ordered_by(join->left_, {left_key->tab_name, left_key->name}) &&
+            plan_ordered_by(join->right_, {right_key->tab_name, right_key->name})) {
+            std::rotate(join->conds_.begin(), it, it + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 估算读取扫描算子全部输出的代价，以读取一个数据页为单位
+ */
+double Planner::estimate_scan_cost(const std::shared_ptr<ScanPlan> &scan) {
+    if (scan->tag == T_SeqScan) {
+        return std::max(sm_manager_->fhs_.at(scan->tab_name_)->get_file_hdr().num_pages - 1, 1);
+    }
+    double rows = estimate_rows(scan);
+    double cost = INDEX_DESCENT_COST + rows * INDEX_ENTRY_COST;
+    if (scan->tag != T_IndexOnlyScan) {
+        cost += estimate_heap_pages(scan->tab_name_, rows);
+    }
+    return cost;
+}
+
+/**
+ * @brief 找出内表上能用外侧记录直接点查的B+树索引：索引的每个字段都要有与外侧字段的同类型等值连接条件，
+ * 或内表上与常量的等值条件；有多个时选字段最多的
+ */
+bool Planner::get_join_index(const std::shared_ptr<ScanPlan> &inner, const std::vector<ColMeta> &outer_cols,
+                             const std::vector<Condition> &conds, std::vector<std::string> &index_col_names) {
+    TabMeta &tab = sm_manager_->db_.get_table(inner->tab_name_);
+    index_col_names.clear();
+    for (auto &index : tab.indexes) {
+        if (index.type != INDEX_BTREE || index.cols.size() <= index_col_names.size()) {
+            continue;
+        }
+        bool usable = std::all_of(index.cols.begin(), index.cols.end(), [&](const ColMeta &col) {
+            auto is_index_col = [&](const TabCol &tab_col) {
+                return tab_col.tab_name == inner->tab_name_ && tab_col.col_name == col.name;
+            };
+            bool joined = std::any_of(conds.begin(), conds.end(), [&](const Condition &cond) {
+                if (cond.is_rhs_val || cond.op != OP_EQ) {
+                    return false;
+                }
+                const TabCol *other = is_index_col(cond.lhs_col)   ? &cond.rhs_col
+                                      : is_index_col(cond.rhs_col) ? &cond.lhs_col
+                                                                   : nullptr;
+                const ColMeta *outer_col = other == nullptr ? nullptr : find_col(outer_cols, *other);
+                return outer_col != nullptr && outer_col->type == col.type;
+            });
+            return joined || std::any_of(inner->conds_.begin(), inner->conds_.end(), [&](const Condition &cond) {
+                       return cond.is_rhs_val && cond.op == OP_EQ && is_index_col(cond.lhs_col) &&
+                              cond.rhs_val.type == col.type;
+                   });
+        });
+        if (usable) {
+            index_col_names.clear();
+            for (auto &col : index.cols) {
+                index_col_names.push_back(col.name);
+            }
+        }
+    }
+    return !index_col_names.empty();
+}
+
+/**
+ * @brief 一侧为单表扫描且其上有能按连接字段点查的B+树索引时，比较逐条探测该索引与完整读取该表的代价，
+ * 外侧记录足够少时改用索引嵌套循环连接；两侧都可以作为内表时选代价较小的，内表放到右子节点
+ */
+bool Planner::use_index_nested_loop_join(const std::shared_ptr<JoinPlan> &join) {
+    bool found = false, best_inner_left = false;
+    double best_cost = 0;
+    std::vector<std::string> best_index_col_names;
+    for (bool inner_left : {false, true}) {
+        auto inner = std::dynamic_pointer_cast<ScanPlan>(inner_left ? join->left_ : join->right_);
+        auto &outer = inner_left ? join->right_ : join->left_;
+        std::vector<ColMeta> outer_cols;
+        std::vector<std::string> index_col_names;
+        if (inner == nullptr) {
+            continue;
+        }
+        collect_cols(outer, outer_cols);
+        if (!get_join_index(inner, outer_cols, join->conds_, index_col_names)) {
+            continue;
+        }
+        // 外侧的每条记录从根结点查找一次索引
+        double cost = estimate_rows(outer) * INDEX_DESCENT_COST;
+        if (cost < estimate_scan_cost(inner) && (!found || cost < best_cost)) {
+            found = true;
+            best_inner_left = inner_left;
+            best_cost = cost;
+            best_index_col_names = std::move(index_col_names);
+        }
+    }
+    if (!found) {
+        return false;
+    }
+    if (best_inner_left) {
+        std::swap(join->left_, join->right_);
+    }
+    auto inner = std::static_pointer_cast<ScanPlan>(join->right_);
+    inner->tag = T_IndexScan;
+    inner->index_col_names_ = std::move(best_index_col_names);
+    inner->and_index_col_names_.clear();
+    return true;
+}
+
+/**
+ * @brief 自底向上为每个连接选择连接方式
+ * 两侧的输出已按等值连接字段有序时使用合并连接；外侧记录较少且内表有连接字段上的索引时使用索引嵌套循环连接；
+ * 否则有可用的等值条件时使用哈希连接，在估算记录数较少的一侧建表；其余情况使用块嵌套循环连接，记录较少的一侧作外侧
+ */
+void Planner::choose_join_methods(const std::shared_ptr<Plan> &plan) {
+    auto join = std::dynamic_pointer_cast<JoinPlan>(plan);
+    if (join == nullptr) {
+        return;
+    }
+    choose_join_methods(join->left_);
+    choose_join_methods(join->right_);
+    if (use_merge_join(join)) {
+        join->tag = T_MergeJoin;
+    } else if (use_index_nested_loop_join(join)) {
+        join->tag = T_IndexNestLoop;
+    } else if (has_equi_join_cond(join)) {
+        join->tag = T_HashJoin;
+        join->build_left_ = estimate_rows(join->left_) < estimate_rows(join->right_);
+    } else {
+        // 外侧按块读入，放记录较少的一侧可以减少内侧的扫描次数
+        if (estimate_rows(join->left_) > estimate_rows(join->right_)) {
+            std::swap(join->left_, join->right_);
+        }
+        join->tag = T_BlockNestLoop;
+    }
+}
+
 std::shared_ptr<Plan> Planner::generate_sort_plan(std::shared_ptr<Query> query, std::shared_ptr<Plan> plan)
 {
-    auto x = std::dynamic_pointer_cast<ast::SelectStmt>(query->parse);
-    if(!x->has_sort) {
+    if (query->sort_keys.empty()) {
         return plan;
     }
-    std::vector<std::string> tables = query->tables;
-    std::vector<ColMeta> all_cols;
-    for (auto &sel_tab_name : tables) {
-        // 这里db_不能写成get_db(), 注意要传指针
-        const auto &sel_tab_cols = sm_manager_->db_.get_table(sel_tab_name).cols;
-        all_cols.insert(all_cols.end(), sel_tab_cols.begin(), sel_tab_cols.end());
-    }
-    TabCol sel_col;
-    for (auto &col : all_cols) {
-        if(col.name.compare(x->order->cols->col_name) == 0 )
-        sel_col = {.tab_name = col.tab_name, .col_name = col.name};
-    }
-    return std::make_shared<SortPlan>(T_Sort, std::move(plan), sel_col, 
-                                    x->order->orderby_dir == ast::OrderBy_DESC);
+    // 单表查询按索引顺序扫描时输出已经有序
+    if (auto scan = std::dynamic_pointer_cast<ScanPlan>(plan); scan != nullptr && scan->ordered_) {
+        return plan;
+    }
+    // 合并连接的输出已按连接key升序排列
+    auto &key = query->sort_keys.front();
+    if (query->sort_keys.size() == 1 && !key.is_desc && plan_ordered_by(plan, key.col)) {
+        return plan;
+    }
+    auto sort = std::make_shared<SortPlan>(T_Sort, std::move(plan), query->sort_keys);
+    if (query->limit >= 0) {
+        // 只需要排在最前面的limit + offset行，两者之和超过int范围时不再截断
+        sort->limit_ = (int)std::min((long long)query->limit + query->offset, (long long)INT_MAX);
+    }
+    return sort;
 }
 
 
@@ -287,6 +818,9 @@ std::shared_ptr<Plan> Planner::generate_select_plan(std::shared_ptr<Query> query
     //物理优化
     auto sel_cols = query->cols;
     std::shared_ptr<Plan> plannerRoot = physical_optimization(query, context);
+    if (query->limit >= 0) {
+        plannerRoot = std::make_shared<LimitPlan>(T_Limit, std::move(plannerRoot), query->limit, query->offset);
+    }
     plannerRoot = std::make_shared<ProjectionPlan>(T_Projection, std::move(plannerRoot), 
                                                         std::move(sel_cols));
 
@@ -316,10 +850,15 @@ std::shared_ptr<Plan> Planner::do_planner(std::shared_ptr<Query> query, Context
         plannerRoot = std::make_shared<DDLPlan>(T_DropTable, x->tab_name, std::vector<std::string>(), std::vector<ColDef>());
     } else if (auto x = std::dynamic_pointer_cast<ast::CreateIndex>(query->parse)) {
         // create index;
-        plannerRoot = std::make_shared<DDLPlan>(T_CreateIndex, x->tab_name, x->col_names, std::vector<ColDef>());
+        IndexType index_type = x->index_type == ast::SV_INDEX_HASH ? INDEX_HASH : INDEX_BTREE;
+        plannerRoot = std::make_shared<DDLPlan>(T_CreateIndex, x->tab_name, x->col_names, std::vector<ColDef>(), index_type,
+                                                x->unique);
     } else if (auto x = std::dynamic_pointer_cast<ast::DropIndex>(query->parse)) {
         // drop index
         plannerRoot = std::make_shared<DDLPlan>(T_DropIndex, x->tab_name, x->col_names, std::vector<ColDef>());
+    } else if (auto x = std::dynamic_pointer_cast<ast::OptimizeIndex>(query->parse)) {
+        // optimize index
+        plannerRoot = std::make_shared<DDLPlan>(T_OptimizeIndex, x->tab_name, x->col_names, std::vector<ColDef>());
     } else if (auto x = std::dynamic_pointer_cast<ast::InsertStmt>(query->parse)) {
         // insert;
         plannerRoot = std::make_shared<DMLPlan>(T_Insert, std::shared_ptr<Plan>(),  x->tab_name,  
@@ -339,7 +878,8 @@ std::shared_ptr<Plan> Planner::do_planner(std::shared_ptr<Query> query, Context
                 std::make_shared<ScanPlan>(T_SeqScan, sm_manager_, x->tab_name, query->conds, index_col_names);
         } else {  // 存在索引
             table_scan_executors =
-                std::make_shared<ScanPlan>(T_IndexScan, sm_manager_, x->tab_name, query->conds, index_col_names);
+                std::make_shared<ScanPlan>(is_hash_index(x->tab_name, index_col_names) ? T_HashIndexScan : T_IndexScan,
+                                           sm_manager_, x->tab_name, query->conds, index_col_names);
         }
 
         plannerRoot = std::make_shared<DMLPlan>(T_Delete, table_scan_executors, x->tab_name,  
@@ -359,7 +899,8 @@ std::shared_ptr<Plan> Planner::do_planner(std::shared_ptr<Query> query, Context
                 std::make_shared<ScanPlan>(T_SeqScan, sm_manager_, x->tab_name, query->conds, index_col_names);
         } else {  // 存在索引
             table_scan_executors =
-                std::make_shared<ScanPlan>(T_IndexScan, sm_manager_, x->tab_name, query->conds, index_col_names);
+                std::make_shared<ScanPlan>(is_hash_index(x->tab_name, index_col_names) ? T_HashIndexScan : T_IndexScan,
+                                           sm_manager_, x->tab_name, query->conds, index_col_names);
         }
         plannerRoot = std::make_shared<DMLPlan>(T_Update, table_scan_executors, x->tab_name,
                                                      std::vector<Value>(), query->conds, 
@@ -50,6 +50,48 @@ class Planner {
     // int get_indexNo(std::string tab_name, std::vector<Condition> curr_conds);
     bool get_index_cols(std::string tab_name, std::vector<Condition> curr_conds, std::vector<std::string>& index_col_names);
 
+    bool is_hash_index(const std::string &tab_name, const std::vector<std::string> &index_col_names);
+
+    bool is_covering_index(std::shared_ptr<Query> query, const std::string &tab_name,
+                           const std::vector<Condition> &curr_conds, const std::vector<std::string> &index_col_names);
+
+    bool get_covering_index_cols(std::shared_ptr<Query> query, const std::string &tab_name,
+                                 const std::vector<Condition> &curr_conds, std::vector<std::string> &index_col_names);
+
+    double estimate_index_rows(const std::string &tab_name, const std::vector<Condition> &curr_conds,
+                               const std::vector<std::string> &index_col_names);
+
+    double estimate_heap_pages(const std::string &tab_name, double rows);
+
+    bool use_bitmap_heap_scan(const std::string &tab_name, const std::vector<Condition> &curr_conds,
+                              const std::vector<std::string> &index_col_names);
+
+    bool get_bitmap_and_indexes(const std::string &tab_name, const std::vector<Condition> &curr_conds,
+                                std::vector<std::string> &index_col_names,
+                                std::vector<std::vector<std::string>> &and_index_col_names);
+
+    bool index_provides_order(const std::string &tab_name, const std::vector<Condition> &curr_conds,
+                              const std::vector<std::string> &index_col_names, const std::string &col_name);
+
+    void use_index_order(std::shared_ptr<Query> query, const std::shared_ptr<ScanPlan> &plan);
+
+    double estimate_rows(const std::shared_ptr<Plan> &plan);
+
+    bool has_equi_join_cond(const std::shared_ptr<JoinPlan> &join);
+
+    bool plan_ordered_by(const std::shared_ptr<Plan> &plan, const TabCol &col);
+
+    bool use_merge_join(const std::shared_ptr<JoinPlan> &join);
+
+    double estimate_scan_cost(const std::shared_ptr<ScanPlan> &scan);
+
+    bool get_join_index(const std::shared_ptr<ScanPlan> &inner, const std::vector<ColMeta> &outer_cols,
+                        const std::vector<Condition> &conds, std::vector<std::string> &index_col_names);
+
+    bool use_index_nested_loop_join(const std::shared_ptr<JoinPlan> &join);
+
+    void choose_join_methods(const std::shared_ptr<Plan> &plan);
+
     ColType interp_sv_type(ast::SvType sv_type) {
         std::map<ast::SvType, ColType> m = {
             {ast::SV_TYPE_INT, TYPE_INT}, {ast::SV_TYPE_FLOAT, TYPE_FLOAT}, {ast::SV_TYPE_STRING, TYPE_STRING}};
@@ -26,6 +26,14 @@ enum SvCompOp {
     SV_OP_EQ, SV_OP_NE, SV_OP_LT, SV_OP_GT, SV_OP_LE, SV_OP_GE
 };
 
+enum SvIndexType {
+    SV_INDEX_BTREE, SV_INDEX_HASH
+};
+
+enum SvAggFunc {
+    SV_AGG_COUNT, SV_AGG_SUM, SV_AGG_MIN, SV_AGG_MAX, SV_AGG_AVG
+};
+
 enum OrderByDir {
     OrderBy_DEFAULT,
     OrderBy_ASC,
@@ -96,9 +104,12 @@ struct DescTable : public TreeNode {
 struct CreateIndex : public TreeNode {
     std::string tab_name;
     std::vector<std::string> col_names;
+    SvIndexType index_type;
+    bool unique;
 
-    CreateIndex(std::string tab_name_, std::vector<std::string> col_names_) :
-            tab_name(std::move(tab_name_)), col_names(std::move(col_names_)) {}
+    CreateIndex(std::string tab_name_, std::vector<std::string> col_names_, SvIndexType index_type_ = SV_INDEX_BTREE,
+                bool unique_ = true) :
+            tab_name(std::move(tab_name_)), col_names(std::move(col_names_)), index_type(index_type_), unique(unique_) {}
 };
 
 struct DropIndex : public TreeNode {
@@ -109,6 +120,15 @@ struct DropIndex : public TreeNode {
             tab_name(std::move(tab_name_)), col_names(std::move(col_names_)) {}
 };
 
+// OPTIMIZE INDEX和REINDEX：整理B+树索引
+struct OptimizeIndex : public TreeNode {
+    std::string tab_name;
+    std::vector<std::string> col_names;
+
+    OptimizeIndex(std::string tab_name_, std::vector<std::string> col_names_) :
+            tab_name(std::move(tab_name_)), col_names(std::move(col_names_)) {}
+};
+
 struct Expr : public TreeNode {
 };
 
@@ -141,6 +161,14 @@ struct Col : public Expr {
             tab_name(std::move(tab_name_)), col_name(std::move(col_name_)) {}
 };
 
+// 选择列表中的聚合函数，COUNT(*)的表名和字段名都为空
+struct AggCol : public Col {
+    SvAggFunc func;
+
+    AggCol(SvAggFunc func_, std::string tab_name_, std::string col_name_) :
+            Col(std::move(tab_name_), std::move(col_name_)), func(func_) {}
+};
+
 struct SetClause : public TreeNode {
     std::string col_name;
     std::shared_ptr<Value> val;
@@ -166,6 +194,13 @@ struct OrderBy : public TreeNode
        cols(std::move(cols_)), orderby_dir(std::move(orderby_dir_)) {}
 };
 
+struct Limit : public TreeNode
+{
+    int limit;      // 最多输出的行数
+    int offset;     // 输出前跳过的行数
+    Limit(int limit_, int offset_) : limit(limit_), offset(offset_) {}
+};
+
 struct InsertStmt : public TreeNode {
     std::string tab_name;
     std::vector<std::shared_ptr<Value>> vals;
@@ -212,16 +247,20 @@ struct SelectStmt : public TreeNode {
 
     
     bool has_sort;
-    std::shared_ptr<OrderBy> order;
+    std::vector<std::shared_ptr<Col>> group_by;     // GROUP BY的分组字段
+    std::vector<std::shared_ptr<OrderBy>> orders;   // ORDER BY的各个排序键，按优先级排列
+    std::shared_ptr<Limit> limit;                   // 没有LIMIT子句时为空
 
 
     SelectStmt(std::vector<std::shared_ptr<Col>> cols_,
                std::vector<std::string> tabs_,
                std::vector<std::shared_ptr<BinaryExpr>> conds_,
-               std::shared_ptr<OrderBy> order_) :
-            cols(std::move(cols_)), tabs(std::move(tabs_)), conds(std::move(conds_)), 
-            order(std::move(order_)) {
-                has_sort = (bool)order;
+               std::vector<std::shared_ptr<Col>> group_by_,
+               std::vector<std::shared_ptr<OrderBy>> orders_,
+               std::shared_ptr<Limit> limit_ = nullptr) :
+            cols(std::move(cols_)), tabs(std::move(tabs_)), conds(std::move(conds_)), group_by(std::move(group_by_)),
+            orders(std::move(orders_)), limit(std::move(limit_)) {
+                has_sort = !orders.empty();
             }
 };
 
@@ -231,6 +270,8 @@ struct SemValue {
     float sv_float;
     std::string sv_str;
     OrderByDir sv_orderby_dir;
+    SvAggFunc sv_agg_func;
+    SvIndexType sv_index_type;
     std::vector<std::string> sv_strs;
 
     std::shared_ptr<TreeNode> sv_node;
@@ -257,6 +298,9 @@ struct SemValue {
     std::vector<std::shared_ptr<BinaryExpr>> sv_conds;
 
     std::shared_ptr<OrderBy> sv_orderby;
+    std::vector<std::shared_ptr<OrderBy>> sv_orderbys;
+
+    std::shared_ptr<Limit> sv_limit;
 };
 
 extern std::shared_ptr<ast::TreeNode> parse_tree;
@@ -95,12 +95,19 @@ private:
             // print_val(x->col_name, offset);
             for(auto col_name: x->col_names)
                 print_val(col_name, offset);
+            print_val(x->index_type == SV_INDEX_HASH ? "HASH" : "BTREE", offset);
+            print_val(x->unique ? "UNIQUE" : "NONUNIQUE", offset);
         } else if (auto x = std::dynamic_pointer_cast<DropIndex>(node)) {
             std::cout << "DROP_INDEX\n";
             print_val(x->tab_name, offset);
             // print_val(x->col_name, offset);
             for(auto col_name: x->col_names)
                 print_val(col_name, offset);
+        } else if (auto x = std::dynamic_pointer_cast<OptimizeIndex>(node)) {
+            std::cout << "OPTIMIZE_INDEX\n";
+            print_val(x->tab_name, offset);
+            for(auto col_name: x->col_names)
+                print_val(col_name, offset);
         } else if (auto x = std::dynamic_pointer_cast<ColDef>(node)) {
             std::cout << "COL_DEF\n";
             print_val(x->col_name, offset);
@@ -1,6 +1,6 @@
-#line 2 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/lex.yy.cpp"
+#line 2 "/root/repo/src/parser/lex.yy.cpp"
 
-#line 4 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/lex.yy.cpp"
+#line 4 "/root/repo/src/parser/lex.yy.cpp"
 
 #define  YY_INT_ALIGNED short int
 
@@ -379,8 +379,8 @@ static void yynoreturn yy_fatal_error ( const char* msg  );
 	(yy_hold_char) = *yy_cp; \
 	*yy_cp = '\0'; \
 	(yy_c_buf_p) = yy_cp;
-#define YY_NUM_RULES 47
-#define YY_END_OF_BUFFER 48
+#define YY_NUM_RULES 61
+#define YY_END_OF_BUFFER 62
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -388,25 +388,32 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static const flex_int16_t yy_accept[154] =
+static const flex_int16_t yy_accept[212] =
     {   0,
-        0,    0,    0,    0,   48,   46,    6,    7,    7,   46,
-       41,   46,   46,   46,   43,   41,   41,   42,   42,   42,
-       42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
-       42,   42,   42,   42,    3,    4,    6,    7,    0,   45,
-       43,    5,    1,   44,   39,   40,   38,   42,   42,   42,
-       42,   42,   36,   42,   42,   42,   42,   42,   42,   42,
-       42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
-       42,   42,    2,    5,   44,   42,   31,   37,   42,   42,
-       42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
-       42,   27,   42,   42,   42,   42,   25,   42,   42,   42,
-
-       42,   42,   42,   42,   28,   42,   42,   42,   17,   16,
-       33,   42,   22,   34,   42,   42,   19,   32,   42,   42,
-       42,    8,   42,   42,   42,   42,   11,    9,   42,   42,
-       42,   29,   30,   42,   35,   42,   42,   15,   42,   42,
-       23,   10,   14,   21,   18,   42,   26,   13,   24,   20,
-       42,   12,    0
+        0,    0,    0,    0,   62,   60,    6,    7,    7,   60,
+       55,   60,   60,   60,   57,   55,   55,   56,   56,   56,
+       56,   56,   56,   56,   56,   56,   56,   56,   56,   56,
+       56,   56,   56,   56,   56,   56,   56,   56,    3,    4,
+        6,    7,    0,   59,   57,    5,    1,   58,   53,   54,
+       52,   56,   56,   56,   56,   56,   56,   56,   42,   56,
+       56,   56,   56,   56,   56,   56,   56,   56,   56,   56,
+       56,   56,   56,   56,   56,   56,   56,   56,   56,   56,
+       56,   56,   56,   56,   56,   56,   56,   56,   56,    2,
+       56,   37,   43,   51,   56,   56,   56,   56,   56,   56,
+
+       56,   56,   56,   56,   56,   56,   56,   56,   56,   56,
+       56,   27,   56,   56,   50,   49,   56,   56,   56,   56,
+       56,   56,   56,   25,   56,   48,   56,   56,   56,   56,
+       56,   56,   56,   56,   28,   56,   56,   56,   56,   17,
+       16,   39,   56,   22,   56,   32,   40,   56,   56,   19,
+       38,   56,   56,   56,   56,   56,   56,   56,   56,    8,
+       56,   56,   56,   56,   56,   11,    9,   33,   56,   47,
+       56,   56,   29,   46,   30,   56,   44,   56,   56,   56,
+       41,   56,   56,   56,   15,   56,   31,   56,   23,   10,
+       14,   21,   18,   56,   45,   56,   56,   56,   26,   13,
+
+       24,   20,   56,   56,   36,   56,   56,   35,   12,   34,
+        0
     } ;
 
 static const YY_CHAR yy_ec[256] =
@@ -419,12 +426,12 @@ static const YY_CHAR yy_ec[256] =
        14,   14,   14,   14,   14,   14,   14,    1,   15,   16,
        17,   18,    1,    1,   19,   20,   21,   22,   23,   24,
        25,   26,   27,   28,   29,   30,   31,   32,   33,   34,
-       35,   36,   37,   38,   39,   40,   41,   42,   43,   35,
-        1,    1,    1,    1,   44,    1,   45,   46,   47,   48,
+       35,   36,   37,   38,   39,   40,   41,   42,   43,   44,
+        1,    1,    1,    1,   45,    1,   46,   47,   48,   49,
 
-       49,   50,   51,   52,   53,   54,   55,   56,   57,   58,
-       59,   60,   35,   61,   62,   63,   64,   65,   66,   67,
-       68,   35,    1,    1,    1,    1,    1,    1,    1,    1,
+       50,   51,   52,   53,   54,   55,   56,   57,   58,   59,
+       60,   61,   62,   63,   64,   65,   66,   67,   68,   69,
+       70,   71,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
@@ -441,105 +448,168 @@ static const YY_CHAR yy_ec[256] =
         1,    1,    1,    1,    1
     } ;
 
-static const YY_CHAR yy_meta[69] =
+static const YY_CHAR yy_meta[72] =
     {   0,
-        1,    1,    2,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    3,    1,    1,    1,    1,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1
     } ;
 
-static const flex_int16_t yy_base[158] =
+static const flex_int16_t yy_base[212] =
     {   0,
-        0,    0,  281,  280,  287,  306,  284,  306,  279,  274,
-      306,  261,   58,  265,   59,   57,  238,   50,   54,   50,
-       55,   38,   54,    0,   58,   56,   59,   58,   62,   75,
-       80,   66,   87,   87,  306,  176,  139,  306,   88,  306,
-      116,    0,  306,   75,  306,  306,  306,    0,   84,   98,
-      102,  104,    0,  112,  102,  111,  105,  103,  110,  105,
-      107,  114,  131,  118,  125,  118,  120,  118,  132,  132,
-      126,  142,  306,    0,   71,  136,    0,    0,  148,  145,
-      153,  166,  163,  166,  154,  152,  173,  164,  162,  175,
-      176,  167,  170,  180,  174,  182,    0,  166,  178,  190,
-
-      177,  181,  181,  188,    0,  196,  189,  195,    0,    0,
-        0,  198,    0,    0,  195,  202,    0,    0,  203,  220,
-      222,    0,  222,  209,  225,  227,    0,    0,  215,  228,
-      231,    0,    0,  218,    0,  238,  221,  223,  242,  230,
-        0,    0,    0,    0,    0,  247,    0,    0,    0,    0,
-      241,    0,  306,  296,  299,   76,  302
+        0,    0,   71,    0,  730,  730,  141,  730,  141,  144,
+      730,  202,  206,  210,  207,  205,  207,  211,  263,  261,
+      269,  266,  313,  302,  318,  308,  309,  246,  263,  326,
+      258,  322,  324,  336,  274,  345,  277,  318,  730,  213,
+      225,  730,    0,  730,    0,  406,  730,  214,  730,  730,
+      730,    0,  327,  339,  345,  453,  454,  444,    0,  462,
+      451,  460,  454,  452,  459,  454,  455,  456,  455,  463,
+      499,  468,  465,  455,  466,  467,  476,  463,  480,  476,
+      474,  502,  500,  503,  515,  516,  512,  511,  519,  730,
+      507,    0,    0,    0,  517,  522,  510,  516,  517,  531,
+
+      528,  531,  519,  516,  536,  525,  518,  532,  541,  563,
+      564,  555,  557,  563,    0,    0,  552,  555,  566,  571,
+      563,  566,  574,    0,  557,    0,  569,  581,  569,  564,
+      568,  567,  574,  584,    0,  581,  571,  572,  573,    0,
+        0,    0,  574,    0,  595,    0,    0,  598,  605,    0,
+        0,  604,  611,  621,  614,  610,  625,  628,  628,    0,
+      627,  613,  627,  630,  631,    0,    0,    0,  617,    0,
+      634,  635,    0,    0,    0,  621,    0,  633,  623,  635,
+        0,  640,  645,  627,  629,  660,    0,  657,    0,    0,
+        0,    0,    0,  660,    0,  652,  655,  677,    0,    0,
+
+        0,    0,  660,  677,    0,  672,  679,    0,    0,    0,
+      730
     } ;
 
-static const flex_int16_t yy_def[158] =
+static const flex_int16_t yy_def[212] =
     {   0,
-      153,    1,  154,  154,  153,  153,  153,  153,  153,  155,
-      153,  153,  153,  153,  153,  153,  153,  156,  156,  156,
-      156,  156,  156,  156,  156,  156,  156,  156,  156,  156,
-      156,  156,  156,  156,  153,  153,  153,  153,  155,  153,
-      153,  157,  153,  153,  153,  153,  153,  156,  156,  156,
-      156,  156,  156,  156,  156,  156,  156,  156,  156,  156,
-      156,  156,  156,  156,  156,  156,  156,  156,  156,  156,
-      156,  156,  153,  157,  153,  156,  156,  156,  156,  156,
-      156,  156,  156,  156,  156,  156,  156,  156,  156,  156,
-      156,  156,  156,  156,  156,  156,  156,  156,  156,  156,
-
-      156,  156,  156,  156,  156,  156,  156,  156,  156,  156,
-      156,  156,  156,  156,  156,  156,  156,  156,  156,  156,
-      156,  156,  156,  156,  156,  156,  156,  156,  156,  156,
-      156,  156,  156,  156,  156,  156,  156,  156,  156,  156,
-      156,  156,  156,  156,  156,  156,  156,  156,  156,  156,
-      156,  156,    0,  153,  153,  153,  153
+      211,    1,  211,    3,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,   18,   19,
+       19,   21,   21,   21,   21,   22,   22,   22,   28,   28,
+       27,   24,   27,   28,   28,   28,   28,   28,  211,  211,
+      211,  211,   10,  211,   15,  211,  211,  211,  211,  211,
+      211,   28,   27,   28,   28,   28,   28,   24,   28,   28,
+       28,   28,   28,   27,   28,   27,   27,   27,   28,   28,
+       28,   28,   28,   22,   26,   26,   28,   28,   28,   28,
+       28,   28,   27,   28,   28,   28,   28,   28,   28,  211,
+       24,   28,   28,   28,   28,   28,   24,   28,   26,   28,
+
+       28,   28,   28,   28,   28,   28,   28,   28,   28,   28,
+       28,   27,   26,   28,   28,   28,   28,   28,   28,   28,
+       26,   28,   28,   28,   28,   28,   28,   28,   26,   28,
+       24,   28,   26,   28,   28,   28,   28,   28,   28,   28,
+       28,   28,   28,   28,   28,   28,   28,   22,   24,   28,
+       28,   28,   26,   28,   28,   24,   28,   28,   28,   28,
+       28,   28,   28,   28,   28,   28,   28,   28,   28,   28,
+       28,   28,   28,   28,   28,   28,   28,   28,   28,   28,
+       28,   28,   28,   28,   28,   28,   28,   28,   28,   28,
+       28,   28,   28,   28,   28,   28,   22,   28,   28,   28,
+
+       28,   28,   28,   28,   28,   28,   28,   28,   28,   28,
+        0
     } ;
 
-static const flex_int16_t yy_nxt[375] =
+static const flex_int16_t yy_nxt[802] =
     {   0,
         6,    7,    8,    9,   10,   11,   11,   11,   12,   11,
        13,   11,   14,   15,   11,   16,   11,   17,   18,   19,
-       20,   21,   22,   23,   24,   25,   26,   27,   24,   24,
-       24,   24,   28,   24,   24,   29,   30,   31,   32,   33,
-       34,   24,   24,    6,   18,   19,   20,   21,   22,   23,
-       24,   25,   26,   27,   24,   24,   24,   24,   28,   24,
-       29,   30,   31,   32,   33,   34,   24,   24,   42,   49,
-       44,   41,   41,   45,   46,   54,   52,   57,   48,   59,
-       62,   50,   55,   60,   75,   56,   51,   63,   75,   61,
-       58,   64,   40,   65,   66,   49,   53,   67,   69,   70,
-
-       68,   54,   52,   57,   59,   71,   62,   50,   55,   60,
-       56,   51,   72,   63,   61,   58,   76,   64,   65,   77,
-       66,   53,   78,   67,   69,   70,   68,   44,   79,   41,
-       80,   71,   81,   82,   83,   85,   86,   87,   72,   88,
-       37,   84,   76,   89,   93,   77,   94,   95,   78,   96,
-       98,   99,   90,  100,   79,  101,   80,   97,   81,   82,
-       83,   85,   86,   87,  102,   88,   84,   91,   92,   89,
-       93,  103,   94,   95,  104,   96,   98,   99,   90,  100,
-      105,  101,   97,  106,  107,  108,  109,  110,   73,  111,
-      102,  112,   91,   92,  113,  114,  103,  115,  116,  117,
-
-      104,  118,  119,  120,  121,  105,  122,  123,  124,  106,
-      107,  108,  109,  110,  111,  125,  126,  112,  127,  128,
-      113,  114,  129,  115,  116,  117,  130,  118,  119,  120,
-      121,  122,  131,  123,  124,  132,  133,  134,  135,  136,
-      125,  126,  137,  127,  138,  128,  139,  140,  129,  141,
-      143,  130,  142,  144,   47,  145,  146,  131,  147,  148,
-      132,  133,  134,  135,  149,  136,  150,  151,  137,  152,
-      138,  139,   43,  140,   41,  141,  143,  142,   40,  144,
-      145,   38,  146,  147,  148,   37,  153,   36,   36,  153,
-      149,  150,  153,  151,  153,  152,   35,   35,   35,   39,
-
-       39,   39,   74,  153,   74,    5,  153,  153,  153,  153,
-      153,  153,  153,  153,  153,  153,  153,  153,  153,  153,
-      153,  153,  153,  153,  153,  153,  153,  153,  153,  153,
-      153,  153,  153,  153,  153,  153,  153,  153,  153,  153,
-      153,  153,  153,  153,  153,  153,  153,  153,  153,  153,
-      153,  153,  153,  153,  153,  153,  153,  153,  153,  153,
-      153,  153,  153,  153,  153,  153,  153,  153,  153,  153,
-      153,  153,  153,  153
+       20,   21,   22,   23,   24,   25,   26,   27,   28,   29,
+       30,   31,   32,   28,   28,   33,   34,   35,   36,   37,
+       38,   28,   28,   28,    6,   18,   19,   20,   21,   22,
+       23,   24,   25,   26,   27,   28,   29,   30,   31,   32,
+       28,   28,   33,   34,   35,   36,   37,   38,   28,   28,
+       28,   39,   39,   39,   39,   39,   39,   39,   40,   39,
+       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
+       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
+
+       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
+       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
+       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
+       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
+       39,   39,   41,   42,   43,   43,   43,   43,   44,   43,
+       43,   43,   43,   43,   43,   43,   43,   43,   43,   43,
+       43,   43,   43,   43,   43,   43,   43,   43,   43,   43,
+       43,   43,   43,   43,   43,   43,   43,   43,   43,   43,
+       43,   43,   43,   43,   43,   43,   43,   43,   43,   43,
+       43,   43,   43,   43,   43,   43,   43,   43,   43,   43,
+
+       43,   43,   43,   43,   43,   43,   43,   43,   43,   43,
+       43,   43,   43,   43,   43,   45,   46,   47,   48,   45,
+       45,   49,   50,   51,   52,   90,   41,   48,    0,   52,
+       53,   52,   52,   52,   52,   52,   52,   52,   52,   52,
+       52,   52,   54,   52,   52,   52,   52,   55,   52,   52,
+       56,   52,   52,   52,   52,   52,   52,   53,   52,   52,
+       52,   52,   52,   52,   52,   52,   52,   52,   52,   54,
+       52,   52,   52,   52,   55,   52,   52,   56,   52,   52,
+       52,   52,   52,   52,    0,   57,   60,   52,   52,   73,
+       76,   63,   85,   61,   52,   88,   62,    0,   52,   52,
+
+       58,   52,   52,   52,   64,   59,   52,   65,    0,   52,
+       52,   52,   57,   60,   52,   52,   73,   76,   63,   85,
+       61,   52,   88,   62,   52,   52,   52,   58,   52,   52,
+       52,   64,   59,   52,   65,   52,   69,   68,   52,   71,
+       70,   72,   66,   89,   74,   77,   80,    0,   67,   52,
+       52,   52,   75,   52,    0,   78,   81,   79,   82,   91,
+       92,   83,   52,   69,   68,   93,   71,   70,   72,   66,
+       89,   74,   77,   80,   84,   67,   52,   52,   86,   75,
+       52,   87,   78,   81,   79,   82,   91,   92,   83,    0,
+        0,    0,   93,    0,    0,    0,    0,    0,    0,    0,
+
+        0,   84,    0,    0,    0,   86,   46,   46,   87,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   94,   95,   96,
+       97,   98,  100,  101,  103,  104,  105,  106,  107,   99,
+      102,  108,  109,    0,  113,  114,  115,  116,  117,  118,
+
+      119,  120,  121,  122,   94,   95,   96,   97,   98,  100,
+      101,  103,  104,  105,  106,  107,   99,  102,  108,  109,
+      110,  113,  114,  115,  116,  117,  118,  119,  120,  121,
+      122,  123,  125,  126,  127,  111,  112,  128,  129,  124,
+      130,  131,  132,  133,  134,  135,  136,  110,  137,  138,
+      139,  140,  141,  142,  143,  144,  145,  146,  123,  125,
+      126,  127,  111,  112,  128,  129,  124,  130,  131,  132,
+      133,  134,  135,  136,  147,  137,  138,  139,  140,  141,
+      142,  143,  144,  145,  146,  148,  149,  150,  151,  152,
+      153,  154,  155,  156,  157,  158,  159,  160,  161,  162,
+
+      163,  147,  164,  165,  166,  167,  168,  169,  170,  171,
+      172,  173,  148,  149,  150,  151,  152,  153,  154,  155,
+      156,  157,  158,  159,  160,  161,  162,  163,  174,  164,
+      165,  166,  167,  168,  169,  170,  171,  172,  173,  175,
+      176,  177,  178,  179,  180,  181,  182,  183,  184,  185,
+      186,  187,  188,  189,  190,  174,  191,  192,  193,  194,
+      195,  196,  197,  198,  199,  200,  175,  176,  177,  178,
+      179,  180,  181,  182,  183,  184,  185,  186,  187,  188,
+      189,  190,  201,  191,  192,  193,  194,  195,  196,  197,
+      198,  199,  200,  202,  203,  204,  205,  206,  207,  208,
+
+      209,  210,    0,    0,    0,    0,    0,    0,    0,  201,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      202,  203,  204,  205,  206,  207,  208,  209,  210,    5,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+
+      211
     } ;
 
-static const flex_int16_t yy_chk[375] =
+static const flex_int16_t yy_chk[802] =
     {   0,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
@@ -547,41 +617,89 @@ static const flex_int16_t yy_chk[375] =
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,   13,   18,
-       15,   13,   15,   16,   16,   20,   19,   21,  156,   22,
-       25,   18,   20,   23,   75,   20,   18,   26,   44,   23,
-       21,   27,   39,   28,   29,   18,   19,   30,   31,   32,
-
-       30,   20,   19,   21,   22,   33,   25,   18,   20,   23,
-       20,   18,   34,   26,   23,   21,   49,   27,   28,   50,
-       29,   19,   51,   30,   31,   32,   30,   41,   52,   41,
-       54,   33,   55,   56,   57,   58,   59,   60,   34,   61,
-       37,   57,   49,   62,   64,   50,   65,   66,   51,   67,
-       68,   69,   63,   70,   52,   71,   54,   67,   55,   56,
-       57,   58,   59,   60,   72,   61,   57,   63,   63,   62,
-       64,   76,   65,   66,   79,   67,   68,   69,   63,   70,
-       80,   71,   67,   81,   82,   83,   84,   85,   36,   86,
-       72,   87,   63,   63,   88,   89,   76,   90,   91,   92,
-
-       79,   93,   94,   95,   96,   80,   98,   99,  100,   81,
-       82,   83,   84,   85,   86,  101,  102,   87,  103,  104,
-       88,   89,  106,   90,   91,   92,  107,   93,   94,   95,
-       96,   98,  108,   99,  100,  112,  115,  116,  119,  120,
-      101,  102,  121,  103,  123,  104,  124,  125,  106,  126,
-      130,  107,  129,  131,   17,  134,  136,  108,  137,  138,
-      112,  115,  116,  119,  139,  120,  140,  146,  121,  151,
-      123,  124,   14,  125,   12,  126,  130,  129,   10,  131,
-      134,    9,  136,  137,  138,    7,    5,    4,    3,    0,
-      139,  140,    0,  146,    0,  151,  154,  154,  154,  155,
-
-      155,  155,  157,    0,  157,  153,  153,  153,  153,  153,
-      153,  153,  153,  153,  153,  153,  153,  153,  153,  153,
-      153,  153,  153,  153,  153,  153,  153,  153,  153,  153,
-      153,  153,  153,  153,  153,  153,  153,  153,  153,  153,
-      153,  153,  153,  153,  153,  153,  153,  153,  153,  153,
-      153,  153,  153,  153,  153,  153,  153,  153,  153,  153,
-      153,  153,  153,  153,  153,  153,  153,  153,  153,  153,
-      153,  153,  153,  153
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    7,    9,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   12,   13,   14,   15,   13,
+       15,   16,   16,   17,   18,   40,   41,   48,    0,   18,
+       18,   18,   18,   18,   18,   18,   18,   18,   18,   18,
+       18,   18,   18,   18,   18,   18,   18,   18,   18,   18,
+       18,   18,   18,   18,   18,   18,   18,   18,   18,   18,
+       18,   18,   18,   18,   18,   18,   18,   18,   18,   18,
+       18,   18,   18,   18,   18,   18,   18,   18,   18,   18,
+       18,   18,   19,   20,    0,   19,   20,   28,   22,   29,
+       31,   21,   35,   20,   19,   37,   20,    0,   20,   19,
+
+       19,   22,   19,   20,   21,   19,   21,   22,    0,   19,
+       20,   21,   19,   20,   28,   22,   29,   31,   21,   35,
+       20,   19,   37,   20,   24,   20,   19,   19,   22,   19,
+       20,   21,   19,   21,   22,   23,   25,   24,   21,   26,
+       25,   27,   23,   38,   30,   32,   33,    0,   23,   26,
+       27,   24,   30,   25,    0,   32,   33,   32,   34,   53,
+       54,   34,   23,   25,   24,   55,   26,   25,   27,   23,
+       38,   30,   32,   33,   34,   23,   26,   27,   36,   30,
+       25,   36,   32,   33,   32,   34,   53,   54,   34,    0,
+        0,    0,   55,    0,    0,    0,    0,    0,    0,    0,
+
+        0,   34,    0,    0,    0,   36,   46,   46,   36,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   46,   46,   46,
+       46,   46,   46,   46,   46,   46,   46,   56,   57,   58,
+       60,   61,   62,   63,   64,   65,   66,   67,   68,   61,
+       63,   69,   70,    0,   72,   73,   74,   75,   76,   77,
+
+       78,   79,   80,   81,   56,   57,   58,   60,   61,   62,
+       63,   64,   65,   66,   67,   68,   61,   63,   69,   70,
+       71,   72,   73,   74,   75,   76,   77,   78,   79,   80,
+       81,   82,   83,   84,   85,   71,   71,   86,   87,   82,
+       88,   89,   91,   95,   96,   97,   98,   71,   99,  100,
+      101,  102,  103,  104,  105,  106,  107,  108,   82,   83,
+       84,   85,   71,   71,   86,   87,   82,   88,   89,   91,
+       95,   96,   97,   98,  109,   99,  100,  101,  102,  103,
+      104,  105,  106,  107,  108,  110,  111,  112,  113,  114,
+      117,  118,  119,  120,  121,  122,  123,  125,  127,  128,
+
+      129,  109,  130,  131,  132,  133,  134,  136,  137,  138,
+      139,  143,  110,  111,  112,  113,  114,  117,  118,  119,
+      120,  121,  122,  123,  125,  127,  128,  129,  145,  130,
+      131,  132,  133,  134,  136,  137,  138,  139,  143,  148,
+      149,  152,  153,  154,  155,  156,  157,  158,  159,  161,
+      162,  163,  164,  165,  169,  145,  171,  172,  176,  178,
+      179,  180,  182,  183,  184,  185,  148,  149,  152,  153,
+      154,  155,  156,  157,  158,  159,  161,  162,  163,  164,
+      165,  169,  186,  171,  172,  176,  178,  179,  180,  182,
+      183,  184,  185,  188,  194,  196,  197,  198,  203,  204,
+
+      206,  207,    0,    0,    0,    0,    0,    0,    0,  186,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      188,  194,  196,  197,  198,  203,  204,  206,  207,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+      211,  211,  211,  211,  211,  211,  211,  211,  211,  211,
+
+      211
     } ;
 
 static yy_state_type yy_last_accepting_state;
@@ -623,9 +741,9 @@ char *yytext;
         } \
     }
 
-#line 627 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/lex.yy.cpp"
+#line 745 "/root/repo/src/parser/lex.yy.cpp"
 
-#line 629 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/lex.yy.cpp"
+#line 747 "/root/repo/src/parser/lex.yy.cpp"
 
 #define INITIAL 0
 #define STATE_COMMENT 1
@@ -863,7 +981,7 @@ YY_DECL
 
 #line 48 "lex.l"
     /* block comment */
-#line 867 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/lex.yy.cpp"
+#line 985 "/root/repo/src/parser/lex.yy.cpp"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -890,13 +1008,13 @@ yy_match:
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 154 )
+				if ( yy_current_state >= 212 )
 					yy_c = yy_meta[yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
 			++yy_cp;
 			}
-		while ( yy_base[yy_current_state] != 306 );
+		while ( yy_base[yy_current_state] != 730 );
 
 yy_find_action:
 		yy_act = yy_accept[yy_current_state];
@@ -1078,89 +1196,159 @@ YY_RULE_SETUP
 case 31:
 YY_RULE_SETUP
 #line 82 "lex.l"
-{ return AND; }
+{ return USING; }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
 #line 83 "lex.l"
-{return JOIN;}
+{ yylval->sv_str = yytext; return HASH; }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
 #line 84 "lex.l"
-{ return EXIT; }
+{ yylval->sv_str = yytext; return BTREE; }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
 #line 85 "lex.l"
-{ return HELP; }
+{ return NONUNIQUE; }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
 #line 86 "lex.l"
-{ return ORDER; }
+{ return OPTIMIZE; }
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
 #line 87 "lex.l"
-{  return BY;  }
+{ return REINDEX; }
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
 #line 88 "lex.l"
-{ return ASC; }
+{ return AND; }
 	YY_BREAK
-/* operators */
 case 38:
 YY_RULE_SETUP
-#line 90 "lex.l"
-{ return GEQ; }
+#line 89 "lex.l"
+{return JOIN;}
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
-#line 91 "lex.l"
-{ return LEQ; }
+#line 90 "lex.l"
+{ return EXIT; }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 92 "lex.l"
-{ return NEQ; }
+#line 91 "lex.l"
+{ return HELP; }
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
+#line 92 "lex.l"
+{ return ORDER; }
+	YY_BREAK
+case 42:
+YY_RULE_SETUP
 #line 93 "lex.l"
+{  return BY;  }
+	YY_BREAK
+case 43:
+YY_RULE_SETUP
+#line 94 "lex.l"
+{ return ASC; }
+	YY_BREAK
+case 44:
+YY_RULE_SETUP
+#line 95 "lex.l"
+{ return LIMIT; }
+	YY_BREAK
+case 45:
+YY_RULE_SETUP
+#line 96 "lex.l"
+{ return OFFSET; }
+	YY_BREAK
+case 46:
+YY_RULE_SETUP
+#line 97 "lex.l"
+{ return GROUP; }
+	YY_BREAK
+case 47:
+YY_RULE_SETUP
+#line 98 "lex.l"
+{ yylval->sv_str = yytext; return COUNT; }
+	YY_BREAK
+case 48:
+YY_RULE_SETUP
+#line 99 "lex.l"
+{ yylval->sv_str = yytext; return SUM; }
+	YY_BREAK
+case 49:
+YY_RULE_SETUP
+#line 100 "lex.l"
+{ yylval->sv_str = yytext; return MIN; }
+	YY_BREAK
+case 50:
+YY_RULE_SETUP
+#line 101 "lex.l"
+{ yylval->sv_str = yytext; return MAX; }
+	YY_BREAK
+case 51:
+YY_RULE_SETUP
+#line 102 "lex.l"
+{ yylval->sv_str = yytext; return AVG; }
+	YY_BREAK
+/* operators */
+case 52:
+YY_RULE_SETUP
+#line 104 "lex.l"
+{ return GEQ; }
+	YY_BREAK
+case 53:
+YY_RULE_SETUP
+#line 105 "lex.l"
+{ return LEQ; }
+	YY_BREAK
+case 54:
+YY_RULE_SETUP
+#line 106 "lex.l"
+{ return NEQ; }
+	YY_BREAK
+case 55:
+YY_RULE_SETUP
+#line 107 "lex.l"
 { return yytext[0]; }
 	YY_BREAK
 /* id */
-case 42:
+case 56:
 YY_RULE_SETUP
-#line 95 "lex.l"
+#line 109 "lex.l"
 {
     yylval->sv_str = yytext;
     return IDENTIFIER;
 }
 	YY_BREAK
 /* literals */
-case 43:
+case 57:
 YY_RULE_SETUP
-#line 100 "lex.l"
+#line 114 "lex.l"
 {
     yylval->sv_int = atoi(yytext);
     return VALUE_INT;
 }
 	YY_BREAK
-case 44:
+case 58:
 YY_RULE_SETUP
-#line 104 "lex.l"
+#line 118 "lex.l"
 {
     yylval->sv_float = atof(yytext);
     return VALUE_FLOAT;
 }
 	YY_BREAK
-case 45:
-/* rule 45 can match eol */
+case 59:
+/* rule 59 can match eol */
 YY_RULE_SETUP
-#line 108 "lex.l"
+#line 122 "lex.l"
 {
     yylval->sv_str = std::string(yytext + 1, strlen(yytext) - 2);
     return VALUE_STRING;
@@ -1169,21 +1357,21 @@ YY_RULE_SETUP
 /* EOF */
 case YY_STATE_EOF(INITIAL):
 case YY_STATE_EOF(STATE_COMMENT):
-#line 113 "lex.l"
+#line 127 "lex.l"
 { return T_EOF; }
 	YY_BREAK
 /* unexpected char */
-case 46:
+case 60:
 YY_RULE_SETUP
-#line 115 "lex.l"
+#line 129 "lex.l"
 { std::cerr << "Lexer Error: unexpected character " << yytext[0] << std::endl; }
 	YY_BREAK
-case 47:
+case 61:
 YY_RULE_SETUP
-#line 116 "lex.l"
+#line 130 "lex.l"
 ECHO;
 	YY_BREAK
-#line 1187 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/lex.yy.cpp"
+#line 1375 "/root/repo/src/parser/lex.yy.cpp"
 
 	case YY_END_OF_BUFFER:
 		{
@@ -1478,7 +1666,7 @@ static int yy_get_next_buffer (void)
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 154 )
+			if ( yy_current_state >= 212 )
 				yy_c = yy_meta[yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
@@ -1506,11 +1694,11 @@ static int yy_get_next_buffer (void)
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 154 )
+		if ( yy_current_state >= 212 )
 			yy_c = yy_meta[yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-	yy_is_jam = (yy_current_state == 153);
+	yy_is_jam = (yy_current_state == 211);
 
 		return yy_is_jam ? 0 : yy_current_state;
 }
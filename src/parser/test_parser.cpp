@@ -13,6 +13,13 @@ See the Mulan PSL v2 for more details. */
 
 #include "parser.h"
 
+static std::shared_ptr<ast::TreeNode> parse(const std::string &sql) {
+    YY_BUFFER_STATE buf = yy_scan_string(sql.c_str());
+    assert(yyparse() == 0);
+    yy_delete_buffer(buf);
+    return ast::parse_tree;
+}
+
 int main() {
     std::vector<std::string> sqls = {
         "show tables;",
@@ -21,8 +28,13 @@ int main() {
         "drop table tb;",
         "create index tb(a);",
         "create index tb(a, b, c);",
+        "create index tb(a) using hash;",
+        "create index tb(a, b) using btree;",
+        "create nonunique index tb(a, b);",
         "drop index tb(a, b, c);",
         "drop index tb(b);",
+        "optimize index tb(a, b);",
+        "reindex tb(a);",
         "insert into tb values (1, 3.14, 'pi');",
         "delete from tb where a = 1;",
         "update tb set a = 1, b = 2.2, c = 'xyz' where x = 2 and y < 1.1 and z > 'abc';",
@@ -30,6 +42,12 @@ int main() {
         "select * from tb where x <> 2 and y >= 3. and z <= '123' and b < tb.a;",
         "select x.a, y.b from x, y where x.a = y.b and c = d;",
         "select x.a, y.b from x join y where x.a = y.b and c = d;",
+        "select count(*), sum(b), min(c), max(c), avg(tb.b) from tb;",
+        "select a, count(b), max(c) from tb where b > 1 group by a;",
+        "select a, c, sum(b) from tb group by a, c order by a desc, c limit 3;",
+        "select * from tb order by a desc, b asc, c;",
+        "select * from tb limit 10;",
+        "select * from tb where a > 1 order by a desc limit 10 offset 5;",
         "exit;",
         "help;",
         "",
@@ -46,6 +64,73 @@ int main() {
             std::cout << "exit/EOF" << std::endl;
         }
     }
+
+    // LIMIT n [OFFSET m]，没有OFFSET时为0，没有LIMIT子句时为空
+    auto select = std::dynamic_pointer_cast<ast::SelectStmt>(parse("select * from tb limit 10;"));
+    assert(select != nullptr && select->limit != nullptr);
+    assert(select->limit->limit == 10 && select->limit->offset == 0);
+    select = std::dynamic_pointer_cast<ast::SelectStmt>(parse("select * from tb order by a limit 0 offset 2;"));
+    assert(select != nullptr && select->limit != nullptr);
+    assert(select->limit->limit == 0 && select->limit->offset == 2);
+    select = std::dynamic_pointer_cast<ast::SelectStmt>(parse("select * from tb;"));
+    assert(select != nullptr && select->limit == nullptr);
+
+    // 聚合函数和GROUP BY，COUNT(*)的字段为空
+    select = std::dynamic_pointer_cast<ast::SelectStmt>(
+        parse("select a, count(*), sum(b), min(c), max(c), avg(tb.b) from tb group by a, c order by a desc, c;"));
+    assert(select != nullptr && select->cols.size() == 6 && select->group_by.size() == 2);
+    assert(std::dynamic_pointer_cast<ast::AggCol>(select->cols[0]) == nullptr);
+    std::vector<ast::SvAggFunc> funcs = {ast::SV_AGG_COUNT, ast::SV_AGG_SUM, ast::SV_AGG_MIN, ast::SV_AGG_MAX,
+                                         ast::SV_AGG_AVG};
+    for (size_t i = 0; i < funcs.size(); i++) {
+        auto agg = std::dynamic_pointer_cast<ast::AggCol>(select->cols[i + 1]);
+        assert(agg != nullptr && agg->func == funcs[i]);
+    }
+    assert(std::dynamic_pointer_cast<ast::AggCol>(select->cols[1])->col_name.empty());
+    assert(std::dynamic_pointer_cast<ast::AggCol>(select->cols[5])->tab_name == "tb");
+    assert(select->group_by[1]->col_name == "c");
+    assert(select->orders.size() == 2 && select->orders[0]->orderby_dir == ast::OrderBy_DESC);
+
+    // 聚合函数名不是保留字，仍可用作字段名，保留原来的大小写；后面跟'('时才是聚合函数
+    auto create = std::dynamic_pointer_cast<ast::CreateTable>(
+        parse("create table km (id int, Max int, sum float, count char(4), min int, avg float);"));
+    assert(create != nullptr && create->fields.size() == 6);
+    std::vector<std::string> names = {"id", "Max", "sum", "count", "min", "avg"};
+    for (size_t i = 0; i < names.size(); i++) {
+        assert(std::dynamic_pointer_cast<ast::ColDef>(create->fields[i])->col_name == names[i]);
+    }
+    select = std::dynamic_pointer_cast<ast::SelectStmt>(
+        parse("select km.max, sum, max(max), count(count) from km where min = 1 group by max, sum order by avg;"));
+    assert(select != nullptr && select->cols.size() == 4);
+    assert(std::dynamic_pointer_cast<ast::AggCol>(select->cols[1]) == nullptr && select->cols[1]->col_name == "sum");
+    auto max_max = std::dynamic_pointer_cast<ast::AggCol>(select->cols[2]);
+    assert(max_max != nullptr && max_max->func == ast::SV_AGG_MAX && max_max->col_name == "max");
+    assert(select->conds[0]->lhs->col_name == "min" && select->orders[0]->cols->col_name == "avg");
+    assert(std::dynamic_pointer_cast<ast::UpdateStmt>(parse("update km set count = 'a' where max > 2;")) != nullptr);
+
+    // HASH和BTREE只在USING之后表示索引类型，也可用作字段名
+    create = std::dynamic_pointer_cast<ast::CreateTable>(parse("create table kh (hash int, btree int);"));
+    assert(create != nullptr && create->fields.size() == 2);
+    assert(std::dynamic_pointer_cast<ast::ColDef>(create->fields[0])->col_name == "hash");
+    assert(std::dynamic_pointer_cast<ast::ColDef>(create->fields[1])->col_name == "btree");
+    auto create_index = std::dynamic_pointer_cast<ast::CreateIndex>(parse("create index kh(hash, btree) using hash;"));
+    assert(create_index != nullptr && create_index->index_type == ast::SV_INDEX_HASH);
+    assert((create_index->col_names == std::vector<std::string>{"hash", "btree"}));
+    select = std::dynamic_pointer_cast<ast::SelectStmt>(parse("select hash from kh where btree = 1 order by hash;"));
+    assert(select != nullptr && select->cols[0]->col_name == "hash" && select->conds[0]->lhs->col_name == "btree");
+
+    // GROUP仍是保留字
+    YY_BUFFER_STATE buf = yy_scan_string("create table group (a int);");
+    assert(yyparse() != 0);
+    yy_delete_buffer(buf);
+
+    // REINDEX与OPTIMIZE INDEX是同一条语句
+    for (auto sql : {"optimize index tb(a, b);", "reindex tb(a, b);"}) {
+        auto optimize = std::dynamic_pointer_cast<ast::OptimizeIndex>(parse(sql));
+        assert(optimize != nullptr && optimize->tab_name == "tb");
+        assert((optimize->col_names == std::vector<std::string>{"a", "b"}));
+    }
+
     ast::parse_tree.reset();
     return 0;
 }
@@ -67,7 +67,7 @@
 
 
 /* First part of user prologue.  */
-#line 1 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 1 "/root/repo/src/parser/yacc.y"
 
 #include "ast.h"
 #include "yacc.tab.h"
@@ -82,7 +82,7 @@ void yyerror(YYLTYPE *locp, const char* s) {
 
 using namespace ast;
 
-#line 86 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 86 "/root/repo/src/parser/yacc.tab.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -144,52 +144,73 @@ enum yysymbol_kind_t
   YYSYMBOL_TXN_ABORT = 31,                 /* TXN_ABORT  */
   YYSYMBOL_TXN_ROLLBACK = 32,              /* TXN_ROLLBACK  */
   YYSYMBOL_ORDER_BY = 33,                  /* ORDER_BY  */
-  YYSYMBOL_LEQ = 34,                       /* LEQ  */
-  YYSYMBOL_NEQ = 35,                       /* NEQ  */
-  YYSYMBOL_GEQ = 36,                       /* GEQ  */
-  YYSYMBOL_T_EOF = 37,                     /* T_EOF  */
-  YYSYMBOL_IDENTIFIER = 38,                /* IDENTIFIER  */
-  YYSYMBOL_VALUE_STRING = 39,              /* VALUE_STRING  */
-  YYSYMBOL_VALUE_INT = 40,                 /* VALUE_INT  */
-  YYSYMBOL_VALUE_FLOAT = 41,               /* VALUE_FLOAT  */
-  YYSYMBOL_42_ = 42,                       /* ';'  */
-  YYSYMBOL_43_ = 43,                       /* '('  */
-  YYSYMBOL_44_ = 44,                       /* ')'  */
-  YYSYMBOL_45_ = 45,                       /* ','  */
-  YYSYMBOL_46_ = 46,                       /* '.'  */
-  YYSYMBOL_47_ = 47,                       /* '='  */
-  YYSYMBOL_48_ = 48,                       /* '<'  */
-  YYSYMBOL_49_ = 49,                       /* '>'  */
-  YYSYMBOL_50_ = 50,                       /* '*'  */
-  YYSYMBOL_YYACCEPT = 51,                  /* $accept  */
-  YYSYMBOL_start = 52,                     /* start  */
-  YYSYMBOL_stmt = 53,                      /* stmt  */
-  YYSYMBOL_txnStmt = 54,                   /* txnStmt  */
-  YYSYMBOL_dbStmt = 55,                    /* dbStmt  */
-  YYSYMBOL_ddl = 56,                       /* ddl  */
-  YYSYMBOL_dml = 57,                       /* dml  */
-  YYSYMBOL_fieldList = 58,                 /* fieldList  */
-  YYSYMBOL_colNameList = 59,               /* colNameList  */
-  YYSYMBOL_field = 60,                     /* field  */
-  YYSYMBOL_type = 61,                      /* type  */
-  YYSYMBOL_valueList = 62,                 /* valueList  */
-  YYSYMBOL_value = 63,                     /* value  */
-  YYSYMBOL_condition = 64,                 /* condition  */
-  YYSYMBOL_optWhereClause = 65,            /* optWhereClause  */
-  YYSYMBOL_whereClause = 66,               /* whereClause  */
-  YYSYMBOL_col = 67,                       /* col  */
-  YYSYMBOL_colList = 68,                   /* colList  */
-  YYSYMBOL_op = 69,                        /* op  */
-  YYSYMBOL_expr = 70,                      /* expr  */
-  YYSYMBOL_setClauses = 71,                /* setClauses  */
-  YYSYMBOL_setClause = 72,                 /* setClause  */
-  YYSYMBOL_selector = 73,                  /* selector  */
-  YYSYMBOL_tableList = 74,                 /* tableList  */
-  YYSYMBOL_opt_order_clause = 75,          /* opt_order_clause  */
-  YYSYMBOL_order_clause = 76,              /* order_clause  */
-  YYSYMBOL_opt_asc_desc = 77,              /* opt_asc_desc  */
-  YYSYMBOL_tbName = 78,                    /* tbName  */
-  YYSYMBOL_colName = 79                    /* colName  */
+  YYSYMBOL_USING = 34,                     /* USING  */
+  YYSYMBOL_NONUNIQUE = 35,                 /* NONUNIQUE  */
+  YYSYMBOL_OPTIMIZE = 36,                  /* OPTIMIZE  */
+  YYSYMBOL_REINDEX = 37,                   /* REINDEX  */
+  YYSYMBOL_LIMIT = 38,                     /* LIMIT  */
+  YYSYMBOL_OFFSET = 39,                    /* OFFSET  */
+  YYSYMBOL_GROUP = 40,                     /* GROUP  */
+  YYSYMBOL_COUNT = 41,                     /* COUNT  */
+  YYSYMBOL_SUM = 42,                       /* SUM  */
+  YYSYMBOL_MIN = 43,                       /* MIN  */
+  YYSYMBOL_MAX = 44,                       /* MAX  */
+  YYSYMBOL_AVG = 45,                       /* AVG  */
+  YYSYMBOL_HASH = 46,                      /* HASH  */
+  YYSYMBOL_BTREE = 47,                     /* BTREE  */
+  YYSYMBOL_LEQ = 48,                       /* LEQ  */
+  YYSYMBOL_NEQ = 49,                       /* NEQ  */
+  YYSYMBOL_GEQ = 50,                       /* GEQ  */
+  YYSYMBOL_T_EOF = 51,                     /* T_EOF  */
+  YYSYMBOL_IDENTIFIER = 52,                /* IDENTIFIER  */
+  YYSYMBOL_VALUE_STRING = 53,              /* VALUE_STRING  */
+  YYSYMBOL_VALUE_INT = 54,                 /* VALUE_INT  */
+  YYSYMBOL_VALUE_FLOAT = 55,               /* VALUE_FLOAT  */
+  YYSYMBOL_56_ = 56,                       /* ';'  */
+  YYSYMBOL_57_ = 57,                       /* '('  */
+  YYSYMBOL_58_ = 58,                       /* ')'  */
+  YYSYMBOL_59_ = 59,                       /* ','  */
+  YYSYMBOL_60_ = 60,                       /* '.'  */
+  YYSYMBOL_61_ = 61,                       /* '='  */
+  YYSYMBOL_62_ = 62,                       /* '<'  */
+  YYSYMBOL_63_ = 63,                       /* '>'  */
+  YYSYMBOL_64_ = 64,                       /* '*'  */
+  YYSYMBOL_YYACCEPT = 65,                  /* $accept  */
+  YYSYMBOL_start = 66,                     /* start  */
+  YYSYMBOL_stmt = 67,                      /* stmt  */
+  YYSYMBOL_txnStmt = 68,                   /* txnStmt  */
+  YYSYMBOL_dbStmt = 69,                    /* dbStmt  */
+  YYSYMBOL_ddl = 70,                       /* ddl  */
+  YYSYMBOL_dml = 71,                       /* dml  */
+  YYSYMBOL_fieldList = 72,                 /* fieldList  */
+  YYSYMBOL_colNameList = 73,               /* colNameList  */
+  YYSYMBOL_field = 74,                     /* field  */
+  YYSYMBOL_type = 75,                      /* type  */
+  YYSYMBOL_valueList = 76,                 /* valueList  */
+  YYSYMBOL_value = 77,                     /* value  */
+  YYSYMBOL_condition = 78,                 /* condition  */
+  YYSYMBOL_optWhereClause = 79,            /* optWhereClause  */
+  YYSYMBOL_whereClause = 80,               /* whereClause  */
+  YYSYMBOL_col = 81,                       /* col  */
+  YYSYMBOL_colList = 82,                   /* colList  */
+  YYSYMBOL_op = 83,                        /* op  */
+  YYSYMBOL_expr = 84,                      /* expr  */
+  YYSYMBOL_setClauses = 85,                /* setClauses  */
+  YYSYMBOL_setClause = 86,                 /* setClause  */
+  YYSYMBOL_selector = 87,                  /* selector  */
+  YYSYMBOL_selList = 88,                   /* selList  */
+  YYSYMBOL_selItem = 89,                   /* selItem  */
+  YYSYMBOL_aggFunc = 90,                   /* aggFunc  */
+  YYSYMBOL_tableList = 91,                 /* tableList  */
+  YYSYMBOL_opt_group_clause = 92,          /* opt_group_clause  */
+  YYSYMBOL_opt_order_clause = 93,          /* opt_order_clause  */
+  YYSYMBOL_order_clause = 94,              /* order_clause  */
+  YYSYMBOL_order_item = 95,                /* order_item  */
+  YYSYMBOL_opt_limit_clause = 96,          /* opt_limit_clause  */
+  YYSYMBOL_opt_asc_desc = 97,              /* opt_asc_desc  */
+  YYSYMBOL_opt_using = 98,                 /* opt_using  */
+  YYSYMBOL_tbName = 99,                    /* tbName  */
+  YYSYMBOL_colName = 100                   /* colName  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -306,7 +327,7 @@ typedef int yytype_uint16;
 
 
 /* Stored state numbers (used for stacks). */
-typedef yytype_int8 yy_state_t;
+typedef yytype_uint8 yy_state_t;
 
 /* State numbers in computations.  */
 typedef int yy_state_fast_t;
@@ -518,21 +539,21 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  39
+#define YYFINAL  53
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   112
+#define YYLAST   204
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  51
+#define YYNTOKENS  65
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  29
+#define YYNNTS  36
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  69
+#define YYNRULES  99
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  127
+#define YYNSTATES  185
 
 /* YYMAXUTOK -- Last valid token kind.  */
-#define YYMAXUTOK   296
+#define YYMAXUTOK   310
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
@@ -550,9 +571,9 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      43,    44,    50,     2,    45,     2,    46,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,    42,
-      48,    47,    49,     2,     2,     2,     2,     2,     2,     2,
+      57,    58,    64,     2,    59,     2,    60,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    56,
+      62,    61,    63,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -575,20 +596,25 @@ static const yytype_int8 yytranslate[] =
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40,    41
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55
 };
 
 #if YYDEBUG
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,    56,    56,    61,    66,    71,    79,    80,    81,    82,
-      86,    90,    94,    98,   105,   112,   116,   120,   124,   128,
-     135,   139,   143,   147,   154,   158,   165,   169,   176,   183,
-     187,   191,   198,   202,   209,   213,   217,   224,   231,   232,
-     239,   243,   250,   254,   261,   265,   272,   276,   280,   284,
-     288,   292,   299,   303,   310,   314,   321,   328,   332,   336,
-     340,   344,   351,   355,   359,   366,   367,   368,   371,   373
+       0,    64,    64,    69,    74,    79,    87,    88,    89,    90,
+      94,    98,   102,   106,   113,   120,   124,   128,   132,   136,
+     140,   144,   148,   155,   159,   163,   167,   174,   178,   185,
+     189,   196,   203,   207,   211,   218,   222,   229,   233,   237,
+     244,   251,   252,   259,   263,   270,   274,   281,   285,   292,
+     296,   300,   304,   308,   312,   319,   323,   330,   334,   341,
+     348,   352,   356,   360,   367,   368,   372,   376,   383,   384,
+     385,   386,   390,   394,   398,   405,   409,   413,   417,   421,
+     425,   432,   439,   443,   447,   451,   452,   453,   457,   458,
+     459,   462,   465,   466,   467,   468,   469,   470,   471,   472
 };
 #endif
 
@@ -608,14 +634,18 @@ static const char *const yytname[] =
   "CREATE", "TABLE", "DROP", "DESC", "INSERT", "INTO", "VALUES", "DELETE",
   "FROM", "ASC", "ORDER", "BY", "WHERE", "UPDATE", "SET", "SELECT", "INT",
   "CHAR", "FLOAT", "INDEX", "AND", "JOIN", "EXIT", "HELP", "TXN_BEGIN",
-  "TXN_COMMIT", "TXN_ABORT", "TXN_ROLLBACK", "ORDER_BY", "LEQ", "NEQ",
-  "GEQ", "T_EOF", "IDENTIFIER", "VALUE_STRING", "VALUE_INT", "VALUE_FLOAT",
-  "';'", "'('", "')'", "','", "'.'", "'='", "'<'", "'>'", "'*'", "$accept",
+  "TXN_COMMIT", "TXN_ABORT", "TXN_ROLLBACK", "ORDER_BY", "USING",
+  "NONUNIQUE", "OPTIMIZE", "REINDEX", "LIMIT", "OFFSET", "GROUP", "COUNT",
+  "SUM", "MIN", "MAX", "AVG", "HASH", "BTREE", "LEQ", "NEQ", "GEQ",
+  "T_EOF", "IDENTIFIER", "VALUE_STRING", "VALUE_INT", "VALUE_FLOAT", "';'",
+  "'('", "')'", "','", "'.'", "'='", "'<'", "'>'", "'*'", "$accept",
   "start", "stmt", "txnStmt", "dbStmt", "ddl", "dml", "fieldList",
   "colNameList", "field", "type", "valueList", "value", "condition",
   "optWhereClause", "whereClause", "col", "colList", "op", "expr",
-  "setClauses", "setClause", "selector", "tableList", "opt_order_clause",
-  "order_clause", "opt_asc_desc", "tbName", "colName", YY_NULLPTR
+  "setClauses", "setClause", "selector", "selList", "selItem", "aggFunc",
+  "tableList", "opt_group_clause", "opt_order_clause", "order_clause",
+  "order_item", "opt_limit_clause", "opt_asc_desc", "opt_using", "tbName",
+  "colName", YY_NULLPTR
 };
 
 static const char *
@@ -625,33 +655,39 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-75)
+#define YYPACT_NINF (-101)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-69)
+#define YYTABLE_NINF (-92)
 
 #define yytable_value_is_error(Yyn) \
   0
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-static const yytype_int8 yypact[] =
+static const yytype_int16 yypact[] =
 {
-      42,    21,     5,     8,    -2,    32,    31,    -2,   -26,   -75,
-     -75,   -75,   -75,   -75,   -75,   -75,    52,     6,   -75,   -75,
-     -75,   -75,   -75,    -2,    -2,    -2,    -2,   -75,   -75,    -2,
-      -2,    34,    13,   -75,   -75,    16,    55,    39,   -75,   -75,
-     -75,    43,    44,   -75,    45,    78,    73,    53,    54,    -2,
-      53,    53,    53,    53,    50,    54,   -75,   -75,    -4,   -75,
-      51,   -75,    -7,   -75,   -75,   -11,   -75,    -5,    22,   -75,
-      33,    24,   -75,    74,    48,    53,   -75,    24,    -2,    -2,
-      85,   -75,    53,   -75,    58,   -75,   -75,   -75,    53,   -75,
-     -75,   -75,   -75,    36,   -75,    54,   -75,   -75,   -75,   -75,
-     -75,   -75,    17,   -75,   -75,   -75,   -75,    86,   -75,   -75,
-      63,   -75,   -75,    24,   -75,   -75,   -75,   -75,    54,    60,
-     -75,     1,   -75,   -75,   -75,   -75,   -75
+      63,    30,    -4,     3,   -14,    32,    23,   -14,    78,  -101,
+    -101,  -101,  -101,  -101,  -101,    16,   -14,  -101,    49,     6,
+    -101,  -101,  -101,  -101,  -101,   -14,   -14,    41,   -14,   -14,
+    -101,  -101,   -14,   -14,    48,    25,    40,    44,    50,    51,
+    -101,  -101,    20,  -101,  -101,    85,    47,  -101,    53,    66,
+    -101,   -14,    56,  -101,  -101,    70,    71,   -14,  -101,    72,
+     120,   122,   119,    91,   -14,   131,   143,   119,    83,   119,
+     119,   119,    84,   119,    87,   143,  -101,  -101,  -101,  -101,
+    -101,  -101,  -101,   -12,  -101,    92,    94,    96,   -16,  -101,
+    -101,   109,  -101,   119,   -36,  -101,   -13,  -101,    37,    -6,
+     119,    -3,    24,  -101,   144,    54,   119,  -101,    24,  -101,
+    -101,   -14,   -14,   128,  -101,    15,  -101,   119,  -101,   119,
+    -101,   113,  -101,  -101,   145,    26,  -101,  -101,  -101,  -101,
+      28,  -101,   143,  -101,  -101,  -101,  -101,  -101,  -101,   104,
+    -101,  -101,  -101,  -101,   164,   166,  -101,  -101,  -101,   137,
+      42,  -101,  -101,  -101,    24,  -101,  -101,  -101,  -101,   143,
+     176,   155,   124,  -101,  -101,  -101,  -101,   135,   143,   142,
+    -101,  -101,   143,    10,   138,  -101,   159,  -101,  -101,  -101,
+    -101,   143,   146,  -101,  -101
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -660,69 +696,95 @@ static const yytype_int8 yypact[] =
 static const yytype_int8 yydefact[] =
 {
        0,     0,     0,     0,     0,     0,     0,     0,     0,     4,
-       3,    10,    11,    12,    13,     5,     0,     0,     9,     6,
-       7,     8,    14,     0,     0,     0,     0,    68,    17,     0,
-       0,     0,    69,    57,    44,    58,     0,     0,    43,     1,
-       2,     0,     0,    16,     0,     0,    38,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,    21,    69,    38,    54,
-       0,    45,    38,    59,    42,     0,    24,     0,     0,    26,
-       0,     0,    40,    39,     0,     0,    22,     0,     0,     0,
-      63,    15,     0,    29,     0,    31,    28,    18,     0,    19,
-      36,    34,    35,     0,    32,     0,    50,    49,    51,    46,
-      47,    48,     0,    55,    56,    61,    60,     0,    23,    25,
-       0,    27,    20,     0,    41,    52,    53,    37,     0,     0,
-      33,    67,    62,    30,    66,    65,    64
+       3,    10,    11,    12,    13,     0,     0,     5,     0,     0,
+       9,     6,     7,     8,    14,     0,     0,     0,     0,     0,
+      91,    17,     0,     0,     0,    93,    94,    95,    96,    97,
+      98,    99,    92,    60,    64,     0,    61,    62,     0,     0,
+      46,     0,     0,     1,     2,     0,     0,     0,    16,     0,
+       0,    41,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,    24,    93,    94,    95,
+      96,    97,    92,    41,    57,     0,     0,     0,    41,    72,
+      63,     0,    45,     0,     0,    29,     0,    27,     0,     0,
+       0,     0,     0,    43,    42,     0,     0,    25,     0,    67,
+      66,     0,     0,    76,    65,     0,    22,     0,    15,     0,
+      32,     0,    34,    31,    90,     0,    20,    39,    37,    38,
+       0,    35,     0,    53,    52,    54,    49,    50,    51,     0,
+      58,    59,    74,    73,     0,    78,    21,    30,    28,     0,
+       0,    18,    19,    23,     0,    44,    55,    56,    40,     0,
+       0,    84,     0,    89,    88,    36,    47,    75,     0,     0,
+      26,    33,     0,    87,    77,    79,    82,    48,    86,    85,
+      81,     0,     0,    80,    83
 };
 
 /* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
+static const yytype_int16 yypgoto[] =
 {
-     -75,   -75,   -75,   -75,   -75,   -75,   -75,   -75,    56,    23,
-     -75,   -75,   -74,    11,   -27,   -75,    -8,   -75,   -75,   -75,
-     -75,    37,   -75,   -75,   -75,   -75,   -75,    -3,   -45
+    -101,  -101,  -101,  -101,  -101,  -101,  -101,  -101,   -52,    80,
+    -101,  -101,  -100,    69,   -53,  -101,   -63,  -101,  -101,  -101,
+    -101,    97,  -101,  -101,   139,  -101,  -101,  -101,  -101,  -101,
+      21,  -101,  -101,  -101,     0,   -56
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
+static const yytype_uint8 yydefgoto[] =
 {
-       0,    16,    17,    18,    19,    20,    21,    65,    68,    66,
-      86,    93,    94,    72,    56,    73,    74,    35,   102,   117,
-      58,    59,    36,    62,   108,   122,   126,    37,    38
+       0,    18,    19,    20,    21,    22,    23,    96,    94,    97,
+     123,   130,   131,   103,    76,   104,    44,   167,   139,   158,
+      83,    84,    45,    46,    47,    48,    88,   145,   161,   174,
+     175,   170,   180,   151,    49,    50
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
    positive, shift that token.  If negative, reduce the rule whose
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
-static const yytype_int8 yytable[] =
+static const yytype_int16 yytable[] =
 {
-      34,    28,    60,   104,    31,    64,    67,    69,    69,   124,
-      55,    23,    32,    55,    25,   125,    83,    84,    85,    78,
-      41,    42,    43,    44,    33,    22,    45,    46,   115,    24,
-      60,    76,    26,    81,    82,    80,    27,    67,    79,   120,
-      61,    75,    29,   111,    30,     1,    63,     2,    40,     3,
-       4,     5,    39,    47,     6,    32,    90,    91,    92,   -68,
-       7,    48,     8,    90,    91,    92,    87,    88,    49,     9,
-      10,    11,    12,    13,    14,   105,   106,    89,    88,    15,
-     112,   113,    96,    97,    98,    50,    51,    52,    53,    54,
-      55,    57,    32,    71,   116,    99,   100,   101,    77,    95,
-     107,   110,   118,   119,   123,   109,   114,     0,     0,    70,
-     121,     0,   103
+      87,    75,    25,    91,    31,    75,    85,    34,   141,    28,
+     111,    92,   105,    95,    98,    95,    52,    95,   178,    99,
+      26,   101,   116,   117,   179,    55,    56,    29,    58,    59,
+     107,    27,    60,    61,    24,   113,    33,    95,    30,   156,
+      51,   115,    32,   112,    95,   118,   119,   106,   125,    53,
+      85,    68,   124,   117,   165,   126,   117,    72,   120,   121,
+     122,   147,    54,    98,    89,    57,     1,    62,     2,   105,
+       3,     4,     5,   146,   117,     6,   157,   127,   128,   129,
+     -91,     7,    63,     8,   152,   117,   153,   154,   163,   164,
+       9,    10,    11,    12,    13,    14,   166,   -68,    64,    15,
+      16,   -69,   133,   134,   135,   173,    65,   -70,   -71,   177,
+      66,   142,   143,    69,    17,   136,   137,   138,   173,    35,
+      36,    37,    38,    39,    40,    41,    67,    70,    71,    73,
+      42,    74,    77,    78,    79,    80,    81,    40,    41,    75,
+      93,   100,    43,    42,   102,    77,    78,    79,    80,    81,
+      40,    41,   109,   108,   110,    86,    42,   127,   128,   129,
+      77,    78,    79,    80,    81,    40,    41,   114,   144,   132,
+     149,    82,    35,    36,    37,    38,    39,    40,    41,   150,
+     159,   160,   171,    42,    77,    78,    79,    80,    81,    40,
+      41,   162,   168,   169,   172,    42,   176,   181,   182,   148,
+     184,   155,   183,   140,    90
 };
 
-static const yytype_int8 yycheck[] =
+static const yytype_uint8 yycheck[] =
 {
-       8,     4,    47,    77,     7,    50,    51,    52,    53,     8,
-      17,     6,    38,    17,     6,    14,    21,    22,    23,    26,
-      23,    24,    25,    26,    50,     4,    29,    30,   102,    24,
-      75,    58,    24,    44,    45,    62,    38,    82,    45,   113,
-      48,    45,    10,    88,    13,     3,    49,     5,    42,     7,
-       8,     9,     0,    19,    12,    38,    39,    40,    41,    46,
-      18,    45,    20,    39,    40,    41,    44,    45,    13,    27,
-      28,    29,    30,    31,    32,    78,    79,    44,    45,    37,
-      44,    45,    34,    35,    36,    46,    43,    43,    43,    11,
-      17,    38,    38,    43,   102,    47,    48,    49,    47,    25,
-      15,    43,    16,    40,    44,    82,    95,    -1,    -1,    53,
-     118,    -1,    75
+      63,    17,     6,    66,     4,    17,    62,     7,   108,     6,
+      26,    67,    75,    69,    70,    71,    16,    73,     8,    71,
+      24,    73,    58,    59,    14,    25,    26,    24,    28,    29,
+      83,    35,    32,    33,     4,    88,    13,    93,    52,   139,
+      24,    93,    10,    59,   100,    58,    59,    59,   100,     0,
+     106,    51,    58,    59,   154,    58,    59,    57,    21,    22,
+      23,   117,    56,   119,    64,    24,     3,    19,     5,   132,
+       7,     8,     9,    58,    59,    12,   139,    53,    54,    55,
+      60,    18,    57,    20,    58,    59,    58,    59,    46,    47,
+      27,    28,    29,    30,    31,    32,   159,    57,    13,    36,
+      37,    57,    48,    49,    50,   168,    59,    57,    57,   172,
+      57,   111,   112,    57,    51,    61,    62,    63,   181,    41,
+      42,    43,    44,    45,    46,    47,    60,    57,    57,    57,
+      52,    11,    41,    42,    43,    44,    45,    46,    47,    17,
+      57,    57,    64,    52,    57,    41,    42,    43,    44,    45,
+      46,    47,    58,    61,    58,    64,    52,    53,    54,    55,
+      41,    42,    43,    44,    45,    46,    47,    58,    40,    25,
+      57,    52,    41,    42,    43,    44,    45,    46,    47,    34,
+      16,    15,    58,    52,    41,    42,    43,    44,    45,    46,
+      47,    54,    16,    38,    59,    52,    54,    59,    39,   119,
+      54,   132,   181,   106,    65
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
@@ -730,42 +792,54 @@ static const yytype_int8 yycheck[] =
 static const yytype_int8 yystos[] =
 {
        0,     3,     5,     7,     8,     9,    12,    18,    20,    27,
-      28,    29,    30,    31,    32,    37,    52,    53,    54,    55,
-      56,    57,     4,     6,    24,     6,    24,    38,    78,    10,
-      13,    78,    38,    50,    67,    68,    73,    78,    79,     0,
-      42,    78,    78,    78,    78,    78,    78,    19,    45,    13,
-      46,    43,    43,    43,    11,    17,    65,    38,    71,    72,
-      79,    67,    74,    78,    79,    58,    60,    79,    59,    79,
-      59,    43,    64,    66,    67,    45,    65,    47,    26,    45,
-      65,    44,    45,    21,    22,    23,    61,    44,    45,    44,
-      39,    40,    41,    62,    63,    25,    34,    35,    36,    47,
-      48,    49,    69,    72,    63,    78,    78,    15,    75,    60,
-      43,    79,    44,    45,    64,    63,    67,    70,    16,    40,
-      63,    67,    76,    44,     8,    14,    77
+      28,    29,    30,    31,    32,    36,    37,    51,    66,    67,
+      68,    69,    70,    71,     4,     6,    24,    35,     6,    24,
+      52,    99,    10,    13,    99,    41,    42,    43,    44,    45,
+      46,    47,    52,    64,    81,    87,    88,    89,    90,    99,
+     100,    24,    99,     0,    56,    99,    99,    24,    99,    99,
+      99,    99,    19,    57,    13,    59,    57,    60,    99,    57,
+      57,    57,    99,    57,    11,    17,    79,    41,    42,    43,
+      44,    45,    52,    85,    86,   100,    64,    81,    91,    99,
+      89,    81,   100,    57,    73,   100,    72,    74,   100,    73,
+      57,    73,    57,    78,    80,    81,    59,    79,    61,    58,
+      58,    26,    59,    79,    58,    73,    58,    59,    58,    59,
+      21,    22,    23,    75,    58,    73,    58,    53,    54,    55,
+      76,    77,    25,    48,    49,    50,    61,    62,    63,    83,
+      86,    77,    99,    99,    40,    92,    58,   100,    74,    57,
+      34,    98,    58,    58,    59,    78,    77,    81,    84,    16,
+      15,    93,    54,    46,    47,    77,    81,    82,    16,    38,
+      96,    58,    59,    81,    94,    95,    54,    81,     8,    14,
+      97,    59,    39,    95,    54
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
-       0,    51,    52,    52,    52,    52,    53,    53,    53,    53,
-      54,    54,    54,    54,    55,    56,    56,    56,    56,    56,
-      57,    57,    57,    57,    58,    58,    59,    59,    60,    61,
-      61,    61,    62,    62,    63,    63,    63,    64,    65,    65,
-      66,    66,    67,    67,    68,    68,    69,    69,    69,    69,
-      69,    69,    70,    70,    71,    71,    72,    73,    73,    74,
-      74,    74,    75,    75,    76,    77,    77,    77,    78,    79
+       0,    65,    66,    66,    66,    66,    67,    67,    67,    67,
+      68,    68,    68,    68,    69,    70,    70,    70,    70,    70,
+      70,    70,    70,    71,    71,    71,    71,    72,    72,    73,
+      73,    74,    75,    75,    75,    76,    76,    77,    77,    77,
+      78,    79,    79,    80,    80,    81,    81,    82,    82,    83,
+      83,    83,    83,    83,    83,    84,    84,    85,    85,    86,
+      87,    87,    88,    88,    89,    89,    89,    89,    90,    90,
+      90,    90,    91,    91,    91,    92,    92,    93,    93,    94,
+      94,    95,    96,    96,    96,    97,    97,    97,    98,    98,
+      98,    99,   100,   100,   100,   100,   100,   100,   100,   100
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     2,     6,     3,     2,     6,     6,
-       7,     4,     5,     6,     1,     3,     1,     3,     2,     1,
-       4,     1,     1,     3,     1,     1,     1,     3,     0,     2,
-       1,     3,     3,     1,     1,     3,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     3,     3,     1,     1,     1,
-       3,     3,     3,     0,     2,     1,     1,     0,     1,     1
+       1,     1,     1,     1,     2,     6,     3,     2,     7,     7,
+       6,     6,     5,     7,     4,     5,     8,     1,     3,     1,
+       3,     2,     1,     4,     1,     1,     3,     1,     1,     1,
+       3,     0,     2,     1,     3,     3,     1,     1,     3,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     3,     3,
+       1,     1,     1,     3,     1,     4,     4,     4,     1,     1,
+       1,     1,     1,     3,     3,     3,     0,     3,     0,     1,
+       3,     2,     2,     4,     0,     1,     1,     0,     2,     2,
+       0,     1,     1,     1,     1,     1,     1,     1,     1,     1
 };
 
 
@@ -1621,489 +1695,647 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* start: stmt ';'  */
-#line 57 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 65 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = (yyvsp[-1].sv_node);
         YYACCEPT;
     }
-#line 1630 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1704 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
   case 3: /* start: HELP  */
-#line 62 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 70 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = std::make_shared<Help>();
         YYACCEPT;
     }
-#line 1639 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1713 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
   case 4: /* start: EXIT  */
-#line 67 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 75 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1648 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1722 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
   case 5: /* start: T_EOF  */
-#line 72 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 80 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1657 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1731 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
   case 10: /* txnStmt: TXN_BEGIN  */
-#line 87 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 95 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnBegin>();
     }
-#line 1665 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1739 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
   case 11: /* txnStmt: TXN_COMMIT  */
-#line 91 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 99 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnCommit>();
     }
-#line 1673 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1747 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
   case 12: /* txnStmt: TXN_ABORT  */
-#line 95 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 103 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnAbort>();
     }
-#line 1681 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1755 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
   case 13: /* txnStmt: TXN_ROLLBACK  */
-#line 99 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 107 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnRollback>();
     }
-#line 1689 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1763 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
   case 14: /* dbStmt: SHOW TABLES  */
-#line 106 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 114 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowTables>();
     }
-#line 1697 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1771 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
   case 15: /* ddl: CREATE TABLE tbName '(' fieldList ')'  */
-#line 113 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 121 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-3].sv_str), (yyvsp[-1].sv_fields));
     }
-#line 1705 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1779 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
   case 16: /* ddl: DROP TABLE tbName  */
-#line 117 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 125 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropTable>((yyvsp[0].sv_str));
     }
-#line 1713 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1787 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
   case 17: /* ddl: DESC tbName  */
-#line 121 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 129 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DescTable>((yyvsp[0].sv_str));
     }
-#line 1721 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1795 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 18: /* ddl: CREATE INDEX tbName '(' colNameList ')'  */
-#line 125 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 18: /* ddl: CREATE INDEX tbName '(' colNameList ')' opt_using  */
+#line 133 "/root/repo/src/parser/yacc.y"
     {
-        (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
+        (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-4].sv_str), (yyvsp[-2].sv_strs), (yyvsp[0].sv_index_type));
     }
-#line 1729 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1803 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 19: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
-#line 129 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 19: /* ddl: CREATE NONUNIQUE INDEX tbName '(' colNameList ')'  */
+#line 137 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs), SV_INDEX_BTREE, false);
+    }
+#line 1811 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 20: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
+#line 141 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1737 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1819 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 21: /* ddl: OPTIMIZE INDEX tbName '(' colNameList ')'  */
+#line 145 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<OptimizeIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
+    }
+#line 1827 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 20: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
-#line 136 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 22: /* ddl: REINDEX tbName '(' colNameList ')'  */
+#line 149 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<OptimizeIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
+    }
+#line 1835 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 23: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
+#line 156 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<InsertStmt>((yyvsp[-4].sv_str), (yyvsp[-1].sv_vals));
     }
-#line 1745 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1843 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 21: /* dml: DELETE FROM tbName optWhereClause  */
-#line 140 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 24: /* dml: DELETE FROM tbName optWhereClause  */
+#line 160 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DeleteStmt>((yyvsp[-1].sv_str), (yyvsp[0].sv_conds));
     }
-#line 1753 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1851 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 22: /* dml: UPDATE tbName SET setClauses optWhereClause  */
-#line 144 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 25: /* dml: UPDATE tbName SET setClauses optWhereClause  */
+#line 164 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<UpdateStmt>((yyvsp[-3].sv_str), (yyvsp[-1].sv_set_clauses), (yyvsp[0].sv_conds));
     }
-#line 1761 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1859 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 23: /* dml: SELECT selector FROM tableList optWhereClause opt_order_clause  */
-#line 148 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 26: /* dml: SELECT selector FROM tableList optWhereClause opt_group_clause opt_order_clause opt_limit_clause  */
+#line 168 "/root/repo/src/parser/yacc.y"
     {
-        (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-4].sv_cols), (yyvsp[-2].sv_strs), (yyvsp[-1].sv_conds), (yyvsp[0].sv_orderby));
+        (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-6].sv_cols), (yyvsp[-4].sv_strs), (yyvsp[-3].sv_conds), (yyvsp[-2].sv_cols), (yyvsp[-1].sv_orderbys), (yyvsp[0].sv_limit));
     }
-#line 1769 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1867 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 24: /* fieldList: field  */
-#line 155 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 27: /* fieldList: field  */
+#line 175 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_fields) = std::vector<std::shared_ptr<Field>>{(yyvsp[0].sv_field)};
     }
-#line 1777 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1875 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 25: /* fieldList: fieldList ',' field  */
-#line 159 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 28: /* fieldList: fieldList ',' field  */
+#line 179 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_fields).push_back((yyvsp[0].sv_field));
     }
-#line 1785 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1883 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 26: /* colNameList: colName  */
-#line 166 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 29: /* colNameList: colName  */
+#line 186 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 1793 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1891 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 27: /* colNameList: colNameList ',' colName  */
-#line 170 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 30: /* colNameList: colNameList ',' colName  */
+#line 190 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 1801 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1899 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 28: /* field: colName type  */
-#line 177 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 31: /* field: colName type  */
+#line 197 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-1].sv_str), (yyvsp[0].sv_type_len));
     }
-#line 1809 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1907 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 29: /* type: INT  */
-#line 184 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 32: /* type: INT  */
+#line 204 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_INT, sizeof(int));
     }
-#line 1817 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1915 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 30: /* type: CHAR '(' VALUE_INT ')'  */
-#line 188 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 33: /* type: CHAR '(' VALUE_INT ')'  */
+#line 208 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_STRING, (yyvsp[-1].sv_int));
     }
-#line 1825 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1923 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 31: /* type: FLOAT  */
-#line 192 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 34: /* type: FLOAT  */
+#line 212 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(float));
     }
-#line 1833 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1931 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 32: /* valueList: value  */
-#line 199 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 35: /* valueList: value  */
+#line 219 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_vals) = std::vector<std::shared_ptr<Value>>{(yyvsp[0].sv_val)};
     }
-#line 1841 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1939 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 33: /* valueList: valueList ',' value  */
-#line 203 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 36: /* valueList: valueList ',' value  */
+#line 223 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_vals).push_back((yyvsp[0].sv_val));
     }
-#line 1849 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1947 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 34: /* value: VALUE_INT  */
-#line 210 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 37: /* value: VALUE_INT  */
+#line 230 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<IntLit>((yyvsp[0].sv_int));
     }
-#line 1857 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1955 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 35: /* value: VALUE_FLOAT  */
-#line 214 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 38: /* value: VALUE_FLOAT  */
+#line 234 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<FloatLit>((yyvsp[0].sv_float));
     }
-#line 1865 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1963 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 36: /* value: VALUE_STRING  */
-#line 218 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 39: /* value: VALUE_STRING  */
+#line 238 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<StringLit>((yyvsp[0].sv_str));
     }
-#line 1873 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1971 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 37: /* condition: col op expr  */
-#line 225 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 40: /* condition: col op expr  */
+#line 245 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_col), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
     }
-#line 1881 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1979 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 38: /* optWhereClause: %empty  */
-#line 231 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 41: /* optWhereClause: %empty  */
+#line 251 "/root/repo/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 1887 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1985 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 39: /* optWhereClause: WHERE whereClause  */
-#line 233 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 42: /* optWhereClause: WHERE whereClause  */
+#line 253 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds) = (yyvsp[0].sv_conds);
     }
-#line 1895 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 1993 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 40: /* whereClause: condition  */
-#line 240 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 43: /* whereClause: condition  */
+#line 260 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds) = std::vector<std::shared_ptr<BinaryExpr>>{(yyvsp[0].sv_cond)};
     }
-#line 1903 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2001 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 41: /* whereClause: whereClause AND condition  */
-#line 244 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 44: /* whereClause: whereClause AND condition  */
+#line 264 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds).push_back((yyvsp[0].sv_cond));
     }
-#line 1911 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2009 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 42: /* col: tbName '.' colName  */
-#line 251 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 45: /* col: tbName '.' colName  */
+#line 271 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
     }
-#line 1919 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2017 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 43: /* col: colName  */
-#line 255 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 46: /* col: colName  */
+#line 275 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[0].sv_str));
     }
-#line 1927 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2025 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 44: /* colList: col  */
-#line 262 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 47: /* colList: col  */
+#line 282 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[0].sv_col)};
     }
-#line 1935 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2033 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 45: /* colList: colList ',' col  */
-#line 266 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 48: /* colList: colList ',' col  */
+#line 286 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols).push_back((yyvsp[0].sv_col));
     }
-#line 1943 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2041 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 46: /* op: '='  */
-#line 273 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 49: /* op: '='  */
+#line 293 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_EQ;
     }
-#line 1951 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2049 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 47: /* op: '<'  */
-#line 277 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 50: /* op: '<'  */
+#line 297 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LT;
     }
-#line 1959 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2057 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 48: /* op: '>'  */
-#line 281 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 51: /* op: '>'  */
+#line 301 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GT;
     }
-#line 1967 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2065 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 49: /* op: NEQ  */
-#line 285 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 52: /* op: NEQ  */
+#line 305 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_NE;
     }
-#line 1975 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2073 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 50: /* op: LEQ  */
-#line 289 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 53: /* op: LEQ  */
+#line 309 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LE;
     }
-#line 1983 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2081 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 51: /* op: GEQ  */
-#line 293 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 54: /* op: GEQ  */
+#line 313 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GE;
     }
-#line 1991 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2089 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 52: /* expr: value  */
-#line 300 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 55: /* expr: value  */
+#line 320 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_val));
     }
-#line 1999 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2097 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 53: /* expr: col  */
-#line 304 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 56: /* expr: col  */
+#line 324 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_col));
     }
-#line 2007 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2105 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 54: /* setClauses: setClause  */
-#line 311 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 57: /* setClauses: setClause  */
+#line 331 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses) = std::vector<std::shared_ptr<SetClause>>{(yyvsp[0].sv_set_clause)};
     }
-#line 2015 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2113 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 55: /* setClauses: setClauses ',' setClause  */
-#line 315 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 58: /* setClauses: setClauses ',' setClause  */
+#line 335 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses).push_back((yyvsp[0].sv_set_clause));
     }
-#line 2023 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2121 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 56: /* setClause: colName '=' value  */
-#line 322 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 59: /* setClause: colName '=' value  */
+#line 342 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
     }
-#line 2031 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2129 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 57: /* selector: '*'  */
-#line 329 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 60: /* selector: '*'  */
+#line 349 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols) = {};
     }
-#line 2039 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2137 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 62: /* selList: selItem  */
+#line 357 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[0].sv_col)};
+    }
+#line 2145 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 63: /* selList: selList ',' selItem  */
+#line 361 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_cols).push_back((yyvsp[0].sv_col));
+    }
+#line 2153 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 65: /* selItem: aggFunc '(' col ')'  */
+#line 369 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_col) = std::make_shared<AggCol>((yyvsp[-3].sv_agg_func), (yyvsp[-1].sv_col)->tab_name, (yyvsp[-1].sv_col)->col_name);
+    }
+#line 2161 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 66: /* selItem: COUNT '(' col ')'  */
+#line 373 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_col) = std::make_shared<AggCol>(SV_AGG_COUNT, (yyvsp[-1].sv_col)->tab_name, (yyvsp[-1].sv_col)->col_name);
+    }
+#line 2169 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 67: /* selItem: COUNT '(' '*' ')'  */
+#line 377 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_col) = std::make_shared<AggCol>(SV_AGG_COUNT, "", "");
+    }
+#line 2177 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 68: /* aggFunc: SUM  */
+#line 383 "/root/repo/src/parser/yacc.y"
+                { (yyval.sv_agg_func) = SV_AGG_SUM; }
+#line 2183 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 69: /* aggFunc: MIN  */
+#line 384 "/root/repo/src/parser/yacc.y"
+                { (yyval.sv_agg_func) = SV_AGG_MIN; }
+#line 2189 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 70: /* aggFunc: MAX  */
+#line 385 "/root/repo/src/parser/yacc.y"
+                { (yyval.sv_agg_func) = SV_AGG_MAX; }
+#line 2195 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 71: /* aggFunc: AVG  */
+#line 386 "/root/repo/src/parser/yacc.y"
+                { (yyval.sv_agg_func) = SV_AGG_AVG; }
+#line 2201 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 59: /* tableList: tbName  */
-#line 337 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 72: /* tableList: tbName  */
+#line 391 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 2047 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2209 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 60: /* tableList: tableList ',' tbName  */
-#line 341 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 73: /* tableList: tableList ',' tbName  */
+#line 395 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2055 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2217 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 61: /* tableList: tableList JOIN tbName  */
-#line 345 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 74: /* tableList: tableList JOIN tbName  */
+#line 399 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2063 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2225 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 62: /* opt_order_clause: ORDER BY order_clause  */
-#line 352 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 75: /* opt_group_clause: GROUP BY colList  */
+#line 406 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_cols) = (yyvsp[0].sv_cols);
+    }
+#line 2233 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 76: /* opt_group_clause: %empty  */
+#line 409 "/root/repo/src/parser/yacc.y"
+                      { /* ignore*/ }
+#line 2239 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 77: /* opt_order_clause: ORDER BY order_clause  */
+#line 414 "/root/repo/src/parser/yacc.y"
     { 
-        (yyval.sv_orderby) = (yyvsp[0].sv_orderby); 
+        (yyval.sv_orderbys) = (yyvsp[0].sv_orderbys); 
     }
-#line 2071 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2247 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 63: /* opt_order_clause: %empty  */
-#line 355 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 78: /* opt_order_clause: %empty  */
+#line 417 "/root/repo/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 2077 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2253 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 64: /* order_clause: col opt_asc_desc  */
-#line 360 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 79: /* order_clause: order_item  */
+#line 422 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_orderbys) = std::vector<std::shared_ptr<OrderBy>>{(yyvsp[0].sv_orderby)};
+    }
+#line 2261 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 80: /* order_clause: order_clause ',' order_item  */
+#line 426 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_orderbys).push_back((yyvsp[0].sv_orderby));
+    }
+#line 2269 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 81: /* order_item: col opt_asc_desc  */
+#line 433 "/root/repo/src/parser/yacc.y"
     { 
         (yyval.sv_orderby) = std::make_shared<OrderBy>((yyvsp[-1].sv_col), (yyvsp[0].sv_orderby_dir));
     }
-#line 2085 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2277 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 82: /* opt_limit_clause: LIMIT VALUE_INT  */
+#line 440 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_limit) = std::make_shared<Limit>((yyvsp[0].sv_int), 0);
+    }
+#line 2285 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 83: /* opt_limit_clause: LIMIT VALUE_INT OFFSET VALUE_INT  */
+#line 444 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_limit) = std::make_shared<Limit>((yyvsp[-2].sv_int), (yyvsp[0].sv_int));
+    }
+#line 2293 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 65: /* opt_asc_desc: ASC  */
-#line 366 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 84: /* opt_limit_clause: %empty  */
+#line 447 "/root/repo/src/parser/yacc.y"
+                      { /* ignore*/ }
+#line 2299 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 85: /* opt_asc_desc: ASC  */
+#line 451 "/root/repo/src/parser/yacc.y"
                  { (yyval.sv_orderby_dir) = OrderBy_ASC;     }
-#line 2091 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2305 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 66: /* opt_asc_desc: DESC  */
-#line 367 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 86: /* opt_asc_desc: DESC  */
+#line 452 "/root/repo/src/parser/yacc.y"
                  { (yyval.sv_orderby_dir) = OrderBy_DESC;    }
-#line 2097 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2311 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 67: /* opt_asc_desc: %empty  */
-#line 368 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+  case 87: /* opt_asc_desc: %empty  */
+#line 453 "/root/repo/src/parser/yacc.y"
             { (yyval.sv_orderby_dir) = OrderBy_DEFAULT; }
-#line 2103 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2317 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 88: /* opt_using: USING BTREE  */
+#line 457 "/root/repo/src/parser/yacc.y"
+                    { (yyval.sv_index_type) = SV_INDEX_BTREE; }
+#line 2323 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 89: /* opt_using: USING HASH  */
+#line 458 "/root/repo/src/parser/yacc.y"
+                    { (yyval.sv_index_type) = SV_INDEX_HASH;  }
+#line 2329 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 90: /* opt_using: %empty  */
+#line 459 "/root/repo/src/parser/yacc.y"
+                    { (yyval.sv_index_type) = SV_INDEX_BTREE; }
+#line 2335 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
 
-#line 2107 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.tab.cpp"
+#line 2339 "/root/repo/src/parser/yacc.tab.cpp"
 
       default: break;
     }
@@ -2332,5 +2564,5 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 374 "/home/huanghanghua/src/db2023/db2023/rmdb/src/parser/yacc.y"
+#line 474 "/root/repo/src/parser/yacc.y"
 
@@ -35,8 +35,8 @@
    especially those whose name start with YY_ or yy_.  They are
    private implementation details that can be changed or removed.  */
 
-#ifndef YY_YY_HOME_HUANGHANGHUA_SRC_DB2023_DB2023_RMDB_SRC_PARSER_YACC_TAB_H_INCLUDED
-# define YY_YY_HOME_HUANGHANGHUA_SRC_DB2023_DB2023_RMDB_SRC_PARSER_YACC_TAB_H_INCLUDED
+#ifndef YY_YY_ROOT_REPO_SRC_PARSER_YACC_TAB_H_INCLUDED
+# define YY_YY_ROOT_REPO_SRC_PARSER_YACC_TAB_H_INCLUDED
 /* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
@@ -85,14 +85,28 @@ extern int yydebug;
     TXN_ABORT = 286,               /* TXN_ABORT  */
     TXN_ROLLBACK = 287,            /* TXN_ROLLBACK  */
     ORDER_BY = 288,                /* ORDER_BY  */
-    LEQ = 289,                     /* LEQ  */
-    NEQ = 290,                     /* NEQ  */
-    GEQ = 291,                     /* GEQ  */
-    T_EOF = 292,                   /* T_EOF  */
-    IDENTIFIER = 293,              /* IDENTIFIER  */
-    VALUE_STRING = 294,            /* VALUE_STRING  */
-    VALUE_INT = 295,               /* VALUE_INT  */
-    VALUE_FLOAT = 296              /* VALUE_FLOAT  */
+    USING = 289,                   /* USING  */
+    NONUNIQUE = 290,               /* NONUNIQUE  */
+    OPTIMIZE = 291,                /* OPTIMIZE  */
+    REINDEX = 292,                 /* REINDEX  */
+    LIMIT = 293,                   /* LIMIT  */
+    OFFSET = 294,                  /* OFFSET  */
+    GROUP = 295,                   /* GROUP  */
+    COUNT = 296,                   /* COUNT  */
+    SUM = 297,                     /* SUM  */
+    MIN = 298,                     /* MIN  */
+    MAX = 299,                     /* MAX  */
+    AVG = 300,                     /* AVG  */
+    HASH = 301,                    /* HASH  */
+    BTREE = 302,                   /* BTREE  */
+    LEQ = 303,                     /* LEQ  */
+    NEQ = 304,                     /* NEQ  */
+    GEQ = 305,                     /* GEQ  */
+    T_EOF = 306,                   /* T_EOF  */
+    IDENTIFIER = 307,              /* IDENTIFIER  */
+    VALUE_STRING = 308,            /* VALUE_STRING  */
+    VALUE_INT = 309,               /* VALUE_INT  */
+    VALUE_FLOAT = 310              /* VALUE_FLOAT  */
   };
   typedef enum yytokentype yytoken_kind_t;
 #endif
@@ -119,4 +133,4 @@ struct YYLTYPE
 int yyparse (void);
 
 
-#endif /* !YY_YY_HOME_HUANGHANGHUA_SRC_DB2023_DB2023_RMDB_SRC_PARSER_YACC_TAB_H_INCLUDED  */
+#endif /* !YY_YY_ROOT_REPO_SRC_PARSER_YACC_TAB_H_INCLUDED  */
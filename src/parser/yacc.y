@@ -22,7 +22,10 @@ using namespace ast;
 
 // keywords
 %token SHOW TABLES CREATE TABLE DROP DESC INSERT INTO VALUES DELETE FROM ASC ORDER BY
-WHERE UPDATE SET SELECT INT CHAR FLOAT INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_COMMIT TXN_ABORT TXN_ROLLBACK ORDER_BY
+WHERE UPDATE SET SELECT INT CHAR FLOAT INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_COMMIT TXN_ABORT TXN_ROLLBACK ORDER_BY USING NONUNIQUE OPTIMIZE REINDEX LIMIT OFFSET
+GROUP
+// aggregate function names and index types, also accepted as column names
+%token <sv_str> COUNT SUM MIN MAX AVG HASH BTREE
 // non-keywords
 %token LEQ NEQ GEQ T_EOF
 
@@ -43,13 +46,18 @@ WHERE UPDATE SET SELECT INT CHAR FLOAT INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_CO
 %type <sv_str> tbName colName
 %type <sv_strs> tableList colNameList
 %type <sv_col> col
-%type <sv_cols> colList selector
+%type <sv_col> selItem
+%type <sv_cols> colList selector selList opt_group_clause
+%type <sv_agg_func> aggFunc
 %type <sv_set_clause> setClause
 %type <sv_set_clauses> setClauses
 %type <sv_cond> condition
 %type <sv_conds> whereClause optWhereClause
-%type <sv_orderby>  order_clause opt_order_clause
+%type <sv_orderby>  order_item
+%type <sv_orderbys> order_clause opt_order_clause
 %type <sv_orderby_dir> opt_asc_desc
+%type <sv_limit> opt_limit_clause
+%type <sv_index_type> opt_using
 
 %%
 start:
@@ -121,14 +129,26 @@ ddl:
     {
         $$ = std::make_shared<DescTable>($2);
     }
-    |   CREATE INDEX tbName '(' colNameList ')'
+    |   CREATE INDEX tbName '(' colNameList ')' opt_using
     {
-        $$ = std::make_shared<CreateIndex>($3, $5);
+        $$ = std::make_shared<CreateIndex>($3, $5, $7);
+    }
+    |   CREATE NONUNIQUE INDEX tbName '(' colNameList ')'
+    {
+        $$ = std::make_shared<CreateIndex>($4, $6, SV_INDEX_BTREE, false);
     }
     |   DROP INDEX tbName '(' colNameList ')'
     {
         $$ = std::make_shared<DropIndex>($3, $5);
     }
+    |   OPTIMIZE INDEX tbName '(' colNameList ')'
+    {
+        $$ = std::make_shared<OptimizeIndex>($3, $5);
+    }
+    |   REINDEX tbName '(' colNameList ')'
+    {
+        $$ = std::make_shared<OptimizeIndex>($2, $4);
+    }
     ;
 
 dml:
@@ -144,9 +164,9 @@ dml:
     {
         $$ = std::make_shared<UpdateStmt>($2, $4, $5);
     }
-    |   SELECT selector FROM tableList optWhereClause opt_order_clause
+    |   SELECT selector FROM tableList optWhereClause opt_group_clause opt_order_clause opt_limit_clause
     {
-        $$ = std::make_shared<SelectStmt>($2, $4, $5, $6);
+        $$ = std::make_shared<SelectStmt>($2, $4, $5, $6, $7, $8);
     }
     ;
 
@@ -329,7 +349,41 @@ selector:
     {
         $$ = {};
     }
-    |   colList
+    |   selList
+    ;
+
+selList:
+        selItem
+    {
+        $$ = std::vector<std::shared_ptr<Col>>{$1};
+    }
+    |   selList ',' selItem
+    {
+        $$.push_back($3);
+    }
+    ;
+
+selItem:
+        col
+    |   aggFunc '(' col ')'
+    {
+        $$ = std::make_shared<AggCol>($1, $3->tab_name, $3->col_name);
+    }
+    |   COUNT '(' col ')'
+    {
+        $$ = std::make_shared<AggCol>(SV_AGG_COUNT, $3->tab_name, $3->col_name);
+    }
+    |   COUNT '(' '*' ')'
+    {
+        $$ = std::make_shared<AggCol>(SV_AGG_COUNT, "", "");
+    }
+    ;
+
+aggFunc:
+        SUM     { $$ = SV_AGG_SUM; }
+    |   MIN     { $$ = SV_AGG_MIN; }
+    |   MAX     { $$ = SV_AGG_MAX; }
+    |   AVG     { $$ = SV_AGG_AVG; }
     ;
 
 tableList:
@@ -347,6 +401,14 @@ tableList:
     }
     ;
 
+opt_group_clause:
+    GROUP BY colList
+    {
+        $$ = $3;
+    }
+    |   /* epsilon */ { /* ignore*/ }
+    ;
+
 opt_order_clause:
     ORDER BY order_clause      
     { 
@@ -356,19 +418,57 @@ opt_order_clause:
     ;
 
 order_clause:
+      order_item
+    {
+        $$ = std::vector<std::shared_ptr<OrderBy>>{$1};
+    }
+    |   order_clause ',' order_item
+    {
+        $$.push_back($3);
+    }
+    ;
+
+order_item:
       col  opt_asc_desc 
     { 
         $$ = std::make_shared<OrderBy>($1, $2);
     }
     ;   
 
+opt_limit_clause:
+    LIMIT VALUE_INT
+    {
+        $$ = std::make_shared<Limit>($2, 0);
+    }
+    |   LIMIT VALUE_INT OFFSET VALUE_INT
+    {
+        $$ = std::make_shared<Limit>($2, $4);
+    }
+    |   /* epsilon */ { /* ignore*/ }
+    ;
+
 opt_asc_desc:
     ASC          { $$ = OrderBy_ASC;     }
     |  DESC      { $$ = OrderBy_DESC;    }
     |       { $$ = OrderBy_DEFAULT; }
     ;    
 
+opt_using:
+        USING BTREE { $$ = SV_INDEX_BTREE; }
+    |   USING HASH  { $$ = SV_INDEX_HASH;  }
+    |               { $$ = SV_INDEX_BTREE; }
+    ;
+
 tbName: IDENTIFIER;
 
-colName: IDENTIFIER;
+colName:
+        IDENTIFIER
+    |   COUNT
+    |   SUM
+    |   MIN
+    |   MAX
+    |   AVG
+    |   HASH
+    |   BTREE
+    ;
 %%
@@ -15,14 +15,22 @@ See the Mulan PSL v2 for more details. */
 #include <string>
 #include "optimizer/plan.h"
 #include "execution/executor_abstract.h"
-#include "execution/executor_nestedloop_join.h"
+#include "execution/executor_block_nestedloop_join.h"
+#include "execution/executor_hash_join.h"
+#include "execution/executor_index_nestedloop_join.h"
+#include "execution/executor_merge_join.h"
 #include "execution/executor_projection.h"
 #include "execution/executor_seq_scan.h"
 #include "execution/executor_index_scan.h"
+#include "execution/executor_index_only_scan.h"
+#include "execution/executor_hash_index_scan.h"
+#include "execution/executor_bitmap_heap_scan.h"
 #include "execution/executor_update.h"
 #include "execution/executor_insert.h"
 #include "execution/executor_delete.h"
 #include "execution/execution_sort.h"
+#include "execution/executor_aggregate.h"
+#include "execution/executor_limit.h"
 #include "common/common.h"
 
 typedef enum portalTag{
@@ -164,19 +172,47 @@ class Portal
             if(x->tag == T_SeqScan) {
                 return std::make_unique<SeqScanExecutor>(sm_manager_, x->tab_name_, x->conds_, context);
             }
+            else if(x->tag == T_IndexOnlyScan) {
+                return std::make_unique<IndexOnlyScanExecutor>(sm_manager_, x->tab_name_, x->conds_, x->index_col_names_, context,
+                                                               x->is_desc_);
+            }
+            else if(x->tag == T_HashIndexScan) {
+                return std::make_unique<HashIndexScanExecutor>(sm_manager_, x->tab_name_, x->conds_, x->index_col_names_, context);
+            }
+            else if(x->tag == T_BitmapHeapScan) {
+                return std::make_unique<BitmapHeapScanExecutor>(sm_manager_, x->tab_name_, x->conds_, x->index_col_names_,
+                                                                x->and_index_col_names_, context);
+            }
             else {
-                return std::make_unique<IndexScanExecutor>(sm_manager_, x->tab_name_, x->conds_, x->index_col_names_, context);
+                return std::make_unique<IndexScanExecutor>(sm_manager_, x->tab_name_, x->conds_, x->index_col_names_, context,
+                                                           x->is_desc_);
             } 
         } else if(auto x = std::dynamic_pointer_cast<JoinPlan>(plan)) {
             std::unique_ptr<AbstractExecutor> left = convert_plan_executor(x->left_, context);
+            if (x->tag == T_IndexNestLoop) {
+                // 内表不生成扫描算子，由连接算子直接探测其索引
+                auto inner = std::static_pointer_cast<ScanPlan>(x->right_);
+                return std::make_unique<IndexNestedLoopJoinExecutor>(sm_manager_, std::move(left), inner->tab_name_,
+                                                                     inner->conds_, std::move(x->conds_),
+                                                                     inner->index_col_names_, context);
+            }
             std::unique_ptr<AbstractExecutor> right = convert_plan_executor(x->right_, context);
-            std::unique_ptr<AbstractExecutor> join = std::make_unique<NestedLoopJoinExecutor>(
-                                std::move(left), 
-                                std::move(right), std::move(x->conds_));
-            return join;
+            if (x->tag == T_HashJoin) {
+                return std::make_unique<HashJoinExecutor>(std::move(left), std::move(right), std::move(x->conds_),
+                                                          x->build_left_);
+            }
+            if (x->tag == T_MergeJoin) {
+                return std::make_unique<MergeJoinExecutor>(std::move(left), std::move(right), std::move(x->conds_));
+            }
+            return std::make_unique<BlockNestedLoopJoinExecutor>(std::move(left), std::move(right), std::move(x->conds_));
         } else if(auto x = std::dynamic_pointer_cast<SortPlan>(plan)) {
-            return std::make_unique<SortExecutor>(convert_plan_executor(x->subplan_, context), 
-                                            x->sel_col_, x->is_desc_);
+            return std::make_unique<SortExecutor>(convert_plan_executor(x->subplan_, context), x->sort_keys_,
+                                                  SORT_WORK_MEM, x->limit_);
+        } else if(auto x = std::dynamic_pointer_cast<AggregatePlan>(plan)) {
+            return std::make_unique<AggregateExecutor>(convert_plan_executor(x->subplan_, context), x->group_cols_,
+                                                       x->aggs_);
+        } else if(auto x = std::dynamic_pointer_cast<LimitPlan>(plan)) {
+            return std::make_unique<LimitExecutor>(convert_plan_executor(x->subplan_, context), x->limit_, x->offset_);
         }
          std::fstream outfile;
                    
@@ -10,6 +10,8 @@ See the Mulan PSL v2 for more details. */
 
 #include "rm_file_handle.h"
 
+#include <algorithm>
+
 /**
  * @description: 获取当前表中记录号为rid的记录
  * @param {Rid&} rid 记录号，指定记录的位置
@@ -50,6 +52,8 @@ Rid RmFileHandle::insert_record(char* buf, Context* context) {
     }
     char* slot = ph.get_slot(slot_no);
     memcpy(slot, buf, file_hdr_.record_size);
+    zone_map_.widen(ph.page->get_page_id().page_no, buf);
+    bloom_insert(buf);
     return Rid{ ph.page->get_page_id().page_no, slot_no};
 }
 
@@ -71,6 +75,8 @@ void RmFileHandle::insert_record(const Rid& rid, char* buf) {
     // 将buf复制到指定位置的slot
     char* slot = ph.get_slot(rid.slot_no);
     memcpy(slot, buf, file_hdr_.record_size);
+    zone_map_.widen(rid.page_no, buf);
+    bloom_insert(buf);
 
     // 如果页面满了，更新file_hdr_.first_free_page_no
     if (ph.page_hdr->num_records == file_hdr_.num_records_per_page) {
@@ -94,6 +100,9 @@ void RmFileHandle::delete_record(const Rid& rid, Context* context) {
     }
     Bitmap::reset(ph.bitmap, rid.slot_no);
     ph.page_hdr->num_records--;
+    if (ph.page_hdr->num_records == 0) {
+        zone_map_.clear_page(rid.page_no);
+    }
 }
 
 
@@ -110,6 +119,41 @@ void RmFileHandle::update_record(const Rid& rid, char* buf, Context* context) {
     RmPageHandle ph = fetch_page_handle(rid.page_no);
     char* slot = ph.get_slot(rid.slot_no);
     memcpy(slot, buf, file_hdr_.record_size);
+    zone_map_.widen(rid.page_no, buf);
+    bloom_insert(buf);
+}
+
+/**
+ * @description: 按照cols建立各数据页的zone map，之后插入、更新、删除记录时随之维护；cols与已建立的相同时直接返回
+ * @param {vector<RmZoneMap::Column>&} cols 要记录取值范围的数值列
+ */
+void RmFileHandle::enable_zone_map(const std::vector<RmZoneMap::Column>& cols) {
+    auto same_cols = [&]() {
+        auto& old_cols = zone_map_.cols();
+        if (old_cols.size() != cols.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < cols.size(); i++) {
+            if (old_cols[i].offset != cols[i].offset || old_cols[i].type != cols[i].type) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (zone_map_.enabled() && same_cols()) {
+        return;
+    }
+    zone_map_.reset(cols);
+    for (int page_no = RM_FIRST_RECORD_PAGE; page_no < file_hdr_.num_pages; page_no++) {
+        RmPageHandle ph = fetch_page_handle(page_no);
+        zone_map_.clear_page(page_no);
+        for (int slot_no = Bitmap::first_bit(true, ph.bitmap, file_hdr_.num_records_per_page);
+             slot_no < file_hdr_.num_records_per_page;
+             slot_no = Bitmap::next_bit(true, ph.bitmap, file_hdr_.num_records_per_page, slot_no)) {
+            zone_map_.widen(page_no, ph.get_slot(slot_no));
+        }
+        buffer_pool_manager_->unpin_page(ph.page->get_page_id(), false);
+    }
 }
 
 /**
@@ -190,4 +234,83 @@ void RmFileHandle::release_page_handle(RmPageHandle&page_handle) {
     // 2. file_hdr_.first_free_page_no
     page_handle.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
     file_hdr_.first_free_page_no = page_handle.page->get_page_id().page_no;
+}
+
+/**
+ * @description: 为偏移为offset的字段建立Bloom过滤器，在第一次检查时扫描整个表建立，之后插入、更新记录时随之维护
+ */
+void RmFileHandle::enable_bloom_filter(int offset, ColType type, int len) {
+    if (!has_bloom_filter(offset)) {
+        bloom_filters_.push_back(RmBloomFilter{.offset = offset, .type = type, .len = len});
+    }
+}
+
+bool RmFileHandle::has_bloom_filter(int offset) const {
+    return std::any_of(bloom_filters_.begin(), bloom_filters_.end(),
+                       [&](const RmBloomFilter &bloom) { return bloom.offset == offset; });
+}
+
+/**
+ * @description: 偏移为offset的字段上是否可能有哈希值为hash的值，返回false时一定没有；该字段没有Bloom过滤器时返回true
+ * @param {uint64_t} hash 由BloomFilter::hash_value计算的哈希值
+ */
+bool RmFileHandle::may_contain(int offset, uint64_t hash) {
+    auto it = std::find_if(bloom_filters_.begin(), bloom_filters_.end(),
+                           [&](const RmBloomFilter &bloom) { return bloom.offset == offset; });
+    if (it == bloom_filters_.end()) {
+        return true;
+    }
+    if (it->stale) {
+        build_bloom_filters();
+    }
+    return it->filter.may_contain(hash);
+}
+
+/**
+ * @description: 把插入或更新后的记录加入各字段的Bloom过滤器，值的个数超过容量时标记为需要重建
+ */
+void RmFileHandle::bloom_insert(const char* buf) {
+    for (auto& bloom : bloom_filters_) {
+        if (bloom.stale) {
+            continue;
+        }
+        if (bloom.filter.num_keys() >= bloom.filter.capacity()) {
+            bloom.stale = true;
+            bloom.filter.clear();
+            continue;
+        }
+        bloom.filter.insert(BloomFilter::hash_value(buf + bloom.offset, bloom.type, bloom.len));
+    }
+}
+
+/**
+ * @description: 扫描整个表重建所有需要重建的Bloom过滤器，容量为当前记录数的两倍
+ */
+void RmFileHandle::build_bloom_filters() {
+    std::vector<RmBloomFilter*> stale;
+    for (auto& bloom : bloom_filters_) {
+        if (bloom.stale) {
+            stale.push_back(&bloom);
+        }
+    }
+    std::vector<std::vector<uint64_t>> hashes(stale.size());
+    for (int page_no = RM_FIRST_RECORD_PAGE; page_no < file_hdr_.num_pages; page_no++) {
+        RmPageHandle ph = fetch_page_handle(page_no);
+        for (int slot_no = Bitmap::first_bit(true, ph.bitmap, file_hdr_.num_records_per_page);
+             slot_no < file_hdr_.num_records_per_page;
+             slot_no = Bitmap::next_bit(true, ph.bitmap, file_hdr_.num_records_per_page, slot_no)) {
+            char* slot = ph.get_slot(slot_no);
+            for (size_t i = 0; i < stale.size(); i++) {
+                hashes[i].push_back(BloomFilter::hash_value(slot + stale[i]->offset, stale[i]->type, stale[i]->len));
+            }
+        }
+        buffer_pool_manager_->unpin_page(ph.page->get_page_id(), false);
+    }
+    for (size_t i = 0; i < stale.size(); i++) {
+        stale[i]->filter.reset(hashes[i].size() * 2);
+        for (uint64_t hash : hashes[i]) {
+            stale[i]->filter.insert(hash);
+        }
+        stale[i]->stale = false;
+    }
 }
\ No newline at end of file
@@ -15,8 +15,10 @@ See the Mulan PSL v2 for more details. */
 #include <memory>
 
 #include "bitmap.h"
+#include "common/bloom_filter.h"
 #include "common/context.h"
 #include "rm_defs.h"
+#include "rm_zone_map.h"
 
 class RmManager;
 
@@ -40,6 +42,15 @@ struct RmPageHandle {
     }
 };
 
+/* 表中一个字段上的Bloom过滤器 */
+struct RmBloomFilter {
+    int offset;                 // 字段在记录中的偏移
+    ColType type;
+    int len;
+    BloomFilter filter;
+    bool stale = true;          // 需要重建，在下一次检查时扫描整个表重新建立
+};
+
 /* 每个RmFileHandle对应一个表的数据文件，里面有多个page，每个page的数据封装在RmPageHandle中 */
 class RmFileHandle {      
     friend class RmScan;    
@@ -50,6 +61,8 @@ class RmFileHandle {
     BufferPoolManager *buffer_pool_manager_;
     int fd_;        // 打开文件后产生的文件句柄
     RmFileHdr file_hdr_;    // 文件头，维护当前表文件的元数据
+    RmZoneMap zone_map_;    // 每个数据页上数值列的取值范围，第一次需要时才建立
+    std::vector<RmBloomFilter> bloom_filters_;  // 被选中的字段上的Bloom过滤器
 
    public:
     RmFileHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
@@ -85,8 +98,22 @@ class RmFileHandle {
 
     RmPageHandle fetch_page_handle(int page_no) const;
 
+    void enable_zone_map(const std::vector<RmZoneMap::Column> &cols);
+
+    const RmZoneMap &zone_map() const { return zone_map_; }
+
+    void enable_bloom_filter(int offset, ColType type, int len);
+
+    bool has_bloom_filter(int offset) const;
+
+    bool may_contain(int offset, uint64_t hash);
+
    private:
     RmPageHandle create_page_handle();
 
     void release_page_handle(RmPageHandle &page_handle);
+
+    void bloom_insert(const char *buf);
+
+    void build_bloom_filters();
 };
\ No newline at end of file
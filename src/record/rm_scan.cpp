@@ -15,7 +15,8 @@ See the Mulan PSL v2 for more details. */
  * @brief 初始化file_handle和rid
  * @param file_handle
  */
-RmScan::RmScan(const RmFileHandle *file_handle) : file_handle_(file_handle) {
+RmScan::RmScan(const RmFileHandle *file_handle, std::vector<RmZoneMap::Range> ranges)
+    : file_handle_(file_handle), ranges_(std::move(ranges)) {
     // Todo:
     // 初始化file_handle和rid（指向第一个存放了记录的位置）
     rid_ = Rid{ RM_FIRST_RECORD_PAGE, -1 };
@@ -35,6 +36,14 @@ void RmScan::next() {
                     // outfile << rid_.page_no <<"\n";
                     // outfile << rid_.slot_no <<"+\n";
                     // outfile.close();
+        if (rid_.slot_no == -1) {
+            if (!ranges_.empty() && !file_handle_->zone_map_.may_match(rid_.page_no, ranges_)) {
+                stats_.skipped_pages++;
+                rid_.page_no++;
+                continue;
+            }
+            stats_.scanned_pages++;
+        }
         RmPageHandle ph = file_handle_->fetch_page_handle(rid_.page_no);
         rid_.slot_no = Bitmap::next_bit(true, ph.bitmap, file_handle_->file_hdr_.num_records_per_page, rid_.slot_no);
         if (rid_.slot_no < file_handle_->file_hdr_.num_records_per_page) {
@@ -46,6 +55,59 @@ void RmScan::next() {
     rid_.page_no = RM_NO_PAGE;
 }
 
+/**
+ * @brief 批量读取：从当前记录开始，把当前页面上的记录依次复制到dest，最多max_n条，之后移到下一条未读取的记录
+ * 每次调用只访问一个页面，页面只pin一次
+ * @param filter 非空时先对页面上剩余的槽整体求值，只复制满足条件的记录
+ * @return 复制的记录数，扫描结束时返回0；有filter时页面上可能没有满足条件的记录，未结束时也可能返回0
+ */
+int RmScan::next_records(char *dest, int max_n, const RmSlotFilter &filter) {
+    if (is_end()) {
+        return 0;
+    }
+    const RmFileHdr &file_hdr = file_handle_->file_hdr_;
+    RmPageHandle ph = file_handle_->fetch_page_handle(rid_.page_no);
+    int n = 0;
+    int slot_no = rid_.slot_no;
+    if (filter == nullptr) {
+        while (slot_no < file_hdr.num_records_per_page && n < max_n) {
+            memcpy(dest + n * file_hdr.record_size, ph.get_slot(slot_no), file_hdr.record_size);
+            n++;
+            slot_no = Bitmap::next_bit(true, ph.bitmap, file_hdr.num_records_per_page, slot_no);
+        }
+    } else {
+        // mask中第i位对应第rid_.slot_no + i个槽
+        int num_slots = file_hdr.num_records_per_page - rid_.slot_no;
+        mask_.assign((num_slots + 63) / 64, 0);
+        for (int i = 0; i < num_slots; i++) {
+            if (Bitmap::is_set(ph.bitmap, rid_.slot_no + i)) {
+                mask_[i / 64] |= 1ULL << (i % 64);
+            }
+        }
+        filter(ph.get_slot(rid_.slot_no), num_slots, file_hdr.record_size, mask_.data());
+        slot_no = file_hdr.num_records_per_page;
+        for (size_t w = 0; w < mask_.size() && slot_no == file_hdr.num_records_per_page; w++) {
+            for (uint64_t m = mask_[w]; m != 0; m &= m - 1) {
+                int cur = rid_.slot_no + (int)w * 64 + __builtin_ctzll(m);
+                if (n == max_n) {
+                    slot_no = cur;
+                    break;
+                }
+                memcpy(dest + n * file_hdr.record_size, ph.get_slot(cur), file_hdr.record_size);
+                n++;
+            }
+        }
+    }
+    file_handle_->buffer_pool_manager_->unpin_page(ph.page->get_page_id(), false);
+    if (slot_no < file_hdr.num_records_per_page) {
+        rid_.slot_no = slot_no;
+    } else {
+        rid_ = Rid{rid_.page_no + 1, -1};
+        next();
+    }
+    return n;
+}
+
 /**
  * @brief ​ 判断是否到达文件末尾
  */
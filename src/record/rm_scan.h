@@ -10,19 +10,44 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <functional>
+
 #include "rm_defs.h"
+#include "rm_zone_map.h"
 
 class RmFileHandle;
 
+/**
+ * @brief 页面级的记录过滤函数
+ * slots为页面上从某个槽开始连续存放的n个槽，每个槽长度为record_size；第i个槽对应mask[i / 64]的第i % 64位，
+ * 调用前只有存放了记录的槽对应的位被置位，过滤函数清除不满足条件的记录对应的位
+ */
+using RmSlotFilter = std::function<void(const char *slots, int n, int record_size, uint64_t *mask)>;
+
 class RmScan : public RecScan {
+public:
+    struct Stats {
+        size_t scanned_pages = 0;   // 读取过的数据页个数
+        size_t skipped_pages = 0;   // 按zone map跳过的数据页个数
+    };
+
+private:
     const RmFileHandle *file_handle_;
     Rid rid_;
+    std::vector<RmZoneMap::Range> ranges_;  // 非空时跳过zone map中取值范围与之不相交的页面
+    Stats stats_;
+    std::vector<uint64_t> mask_;            // next_records中过滤当前页面时的位图
+
 public:
-    RmScan(const RmFileHandle *file_handle);
+    RmScan(const RmFileHandle *file_handle, std::vector<RmZoneMap::Range> ranges = {});
 
     void next() override;
 
+    int next_records(char *dest, int max_n, const RmSlotFilter &filter = nullptr);
+
     bool is_end() const override;
 
     Rid rid() const override;
+
+    const Stats &stats() const { return stats_; }
 };
@@ -0,0 +1,125 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "defs.h"
+
+/**
+ * @brief 表数据文件的页级zone map，只存在于内存中
+ * 对表中每个数值列（INT、FLOAT）记录每个数据页上的最小值和最大值，顺序扫描时跳过取值范围与谓词不相交的页面；
+ * 插入和更新记录时扩大所在页面的范围，删除记录时不收缩（页面删空时重置为空范围），因此范围总是包含页面上的所有值；
+ * INT和FLOAT的值都能精确地转换为double，统一按double比较
+ */
+class RmZoneMap {
+   public:
+    struct Column {
+        int offset;         // 列在记录中的偏移
+        ColType type;       // TYPE_INT或TYPE_FLOAT
+    };
+
+    /* 第col个数值列的取值必须落在闭区间[lo, hi]内 */
+    struct Range {
+        int col;
+        double lo;
+        double hi;
+    };
+
+   private:
+    std::vector<Column> cols_;
+    std::vector<double> mins_;      // mins_[page_no * cols_.size() + col]
+    std::vector<double> maxs_;
+    bool enabled_ = false;
+
+   public:
+    bool enabled() const { return enabled_; }
+
+    const std::vector<Column> &cols() const { return cols_; }
+
+    /* 清空并按照cols重新开始记录，所有页面都是空范围 */
+    void reset(std::vector<Column> cols) {
+        cols_ = std::move(cols);
+        mins_.clear();
+        maxs_.clear();
+        enabled_ = !cols_.empty();
+    }
+
+    void disable() {
+        reset({});
+    }
+
+    /* 用记录rec扩大page_no页面的范围 */
+    void widen(int page_no, const char *rec) {
+        if (!enabled_) {
+            return;
+        }
+        size_t base = ensure_page(page_no);
+        for (size_t i = 0; i < cols_.size(); i++) {
+            double val = get_value(cols_[i], rec);
+            if (val < mins_[base + i]) {
+                mins_[base + i] = val;
+            }
+            if (val > maxs_[base + i]) {
+                maxs_[base + i] = val;
+            }
+        }
+    }
+
+    /* page_no页面上已经没有记录 */
+    void clear_page(int page_no) {
+        if (!enabled_) {
+            return;
+        }
+        size_t base = ensure_page(page_no);
+        for (size_t i = 0; i < cols_.size(); i++) {
+            mins_[base + i] = std::numeric_limits<double>::infinity();
+            maxs_[base + i] = -std::numeric_limits<double>::infinity();
+        }
+    }
+
+    /* page_no页面上是否可能存在满足所有ranges的记录，没有记录过的页面总是返回true */
+    bool may_match(int page_no, const std::vector<Range> &ranges) const {
+        size_t base = (size_t)page_no * cols_.size();
+        if (!enabled_ || base >= mins_.size()) {
+            return true;
+        }
+        for (auto &range : ranges) {
+            if (maxs_[base + range.col] < range.lo || mins_[base + range.col] > range.hi) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static double get_value(const Column &col, const char *rec) {
+        if (col.type == TYPE_INT) {
+            int val;
+            memcpy(&val, rec + col.offset, sizeof(int));
+            return val;
+        }
+        float val;
+        memcpy(&val, rec + col.offset, sizeof(float));
+        return val;
+    }
+
+   private:
+    size_t ensure_page(int page_no) {
+        size_t base = (size_t)page_no * cols_.size();
+        if (base >= mins_.size()) {
+            mins_.resize(base + cols_.size(), std::numeric_limits<double>::infinity());
+            maxs_.resize(base + cols_.size(), -std::numeric_limits<double>::infinity());
+        }
+        return base;
+    }
+};
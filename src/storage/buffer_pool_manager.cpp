@@ -231,9 +231,12 @@ bool BufferPoolManager::delete_page(PageId page_id) {
     }
     //否则 删除此页 并且更新相关数据结构内容 返回true
     disk_manager_->deallocate_page(page_id.page_no);
-    page_id.page_no = INVALID_PAGE_ID;
     page_table_.erase(it);
     page->reset_memory();
+    page->is_dirty_ = false;
+    page->id_.page_no = INVALID_PAGE_ID;
+    // 帧已回到free_list_，需要同时从replacer中移除，避免被重复分配
+    replacer_->pin(frame_id);
     free_list_.push_back(frame_id);
     return true;
 }
@@ -256,4 +259,29 @@ void BufferPoolManager::flush_all_pages(int fd) {
     }
     
     
+}
+
+/**
+ * @description: 文件关闭时，将该文件在buffer_pool中的所有页写回磁盘并释放其帧
+ *               文件关闭后fd可能被复用，若不释放，新文件会读到旧文件的缓存页
+ * @param {int} fd 文件句柄
+ */
+void BufferPoolManager::delete_all_pages(int fd) {
+    std::unique_lock<std::mutex> lock(latch_);
+    for (size_t i = 0; i < pool_size_; i++) {
+        Page* page = &pages_[i];
+        if (page->get_page_id().fd != fd || page->get_page_id().page_no == INVALID_PAGE_ID) {
+            continue;
+        }
+        if (page->is_dirty_) {
+            disk_manager_->write_page(fd, page->get_page_id().page_no, page->get_data(), PAGE_SIZE);
+            page->is_dirty_ = false;
+        }
+        page_table_.erase(page->get_page_id());
+        page->reset_memory();
+        page->pin_count_ = 0;
+        page->id_.page_no = INVALID_PAGE_ID;
+        replacer_->pin(static_cast<frame_id_t>(i));
+        free_list_.push_back(static_cast<frame_id_t>(i));
+    }
 }
\ No newline at end of file
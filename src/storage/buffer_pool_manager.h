@@ -89,6 +89,8 @@ class BufferPoolManager {
 
     void flush_all_pages(int fd);
 
+    void delete_all_pages(int fd);
+
    private:
     bool find_victim_page(frame_id_t* frame_id);
 
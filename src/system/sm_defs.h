@@ -11,3 +11,12 @@ See the Mulan PSL v2 for more details. */
 
 #include "defs.h"
 #include <string>
+
+/* 索引的组织方式 */
+enum IndexType {
+    INDEX_BTREE, INDEX_HASH
+};
+
+inline std::string indextype2str(IndexType type) {
+    return type == INDEX_HASH ? "HASH" : "BTREE";
+}
@@ -103,15 +103,16 @@ void SmManager::open_db(const std::string& db_name) {
         auto &tab = entry.second;
         // fhs_[tab.name] = rm_manager_->open_file(tab.name);
         fhs_.emplace(tab.name, rm_manager_->open_file(tab.name));
-        // for (size_t i = 0; i < tab.cols.size(); i++) {
-        //     auto &col = tab.cols[i];
-        //     if (col.index) {
-        //         auto index_name = ix_manager_->get_index_name(tab.name, i);
-        //         assert(ihs_.count(index_name) == 0);
-        //         // ihs_[index_name] = ix_manager_->open_index(tab.name, i);
-        //         ihs_.emplace(index_name, ix_manager_->open_index(tab.name, i));
-        //     }
-        // }
+        for (auto &index : tab.indexes) {
+            auto index_name = ix_manager_->get_index_name(tab.name, index.cols);
+            if (index.type == INDEX_HASH) {
+                assert(hhs_.count(index_name) == 0);
+                hhs_.emplace(index_name, ix_manager_->open_hash_index(tab.name, index.cols));
+                continue;
+            }
+            assert(ihs_.count(index_name) == 0);
+            ihs_.emplace(index_name, ix_manager_->open_index(tab.name, index.cols));
+        }
     }
 }
 
@@ -132,6 +133,14 @@ void SmManager::close_db() {
      // 将数据落盘
     flush_meta();
 
+    // 索引文件头保存在句柄中，关闭时需要写回
+    for (auto &entry : ihs_) {
+        ix_manager_->close_index(entry.second.get());
+    }
+    for (auto &entry : hhs_) {
+        ix_manager_->close_hash_index(entry.second.get());
+    }
+
     // 清理数据库相关资源
     cleanup_database_resources();
 
@@ -244,9 +253,13 @@ void SmManager::drop_table(const std::string& tab_name, Context* context) {
         throw TableNotFoundError(tab_name);
     }
     
+    // 先删除表上的所有索引
+    TabMeta &tab = db_.get_table(tab_name);
+    while (!tab.indexes.empty()) {
+        drop_index(tab_name, tab.indexes.back().cols, context);
+    }
+
     // 关闭并删除文件句柄
-    
-    
     rm_manager_->close_file(fhs_[tab_name].get());
     rm_manager_->destroy_file(tab_name);
     fhs_.erase(tab_name);
@@ -276,14 +289,82 @@ void SmManager::drop_table(const std::string& tab_name, Context* context) {
 
 }
 
+/**
+ * @description: 把表中已有的记录插入新建的索引
+ * @return {bool} 已有记录是否满足索引的唯一性；非唯一索引中键值对不会重复，总是返回true
+ */
+template <typename IndexHandle>
+static bool load_index(IndexHandle *ih, RmFileHandle *fh, const std::vector<ColMeta> &cols, int col_tot_len,
+                       Context *context) {
+    Transaction *txn = context == nullptr ? nullptr : context->txn_;
+    auto key = std::make_unique<char[]>(col_tot_len);
+    for (RmScan scan(fh); !scan.is_end(); scan.next()) {
+        auto rec = fh->get_record(scan.rid(), context);
+        int offset = 0;
+        for (auto &col : cols) {
+            memcpy(key.get() + offset, rec->data + col.offset, col.len);
+            offset += col.len;
+        }
+        if (ih->insert_entry(key.get(), scan.rid(), txn) == IX_NO_PAGE) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * @description: 创建索引
  * @param {string&} tab_name 表的名称
  * @param {vector<string>&} col_names 索引包含的字段名称
+ * @param {IndexType} type 索引的组织方式，B+树或可扩展哈希
+ * @param {bool} unique 是否为唯一索引，非唯一索引只能是B+树
  * @param {Context*} context
  */
-void SmManager::create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context) {
-     
+void SmManager::create_index(const std::string& tab_name, const std::vector<std::string>& col_names, IndexType type,
+                             bool unique, Context* context) {
+    TabMeta &tab = db_.get_table(tab_name);
+    if (tab.is_index(col_names)) {
+        throw IndexExistsError(tab_name, col_names);
+    }
+    std::vector<ColMeta> cols;
+    int col_tot_len = 0;
+    for (auto &col_name : col_names) {
+        cols.push_back(*tab.get_col(col_name));
+        col_tot_len += cols.back().len;
+    }
+
+    // 创建索引文件，并把表中已有的记录插入索引；已有记录违反了索引的唯一性时放弃创建
+    auto index_name = ix_manager_->get_index_name(tab_name, col_names);
+    auto fh = fhs_.at(tab_name).get();
+    if (type == INDEX_HASH) {
+        ix_manager_->create_hash_index(tab_name, cols);
+        auto hh = ix_manager_->open_hash_index(tab_name, cols);
+        if (!load_index(hh.get(), fh, cols, col_tot_len, context)) {
+            ix_manager_->close_hash_index(hh.get());
+            ix_manager_->destroy_index(tab_name, cols);
+            throw IndexEntryExistsError();
+        }
+        hhs_.emplace(index_name, std::move(hh));
+    } else {
+        ix_manager_->create_index(tab_name, cols, unique);
+        auto ih = ix_manager_->open_index(tab_name, cols);
+        if (!load_index(ih.get(), fh, cols, col_tot_len, context)) {
+            ix_manager_->close_index(ih.get());
+            ix_manager_->destroy_index(tab_name, cols);
+            throw IndexEntryExistsError();
+        }
+        // 批量插入时不维护Bloom过滤器，插入完成后按实际的key数建立
+        ih->rebuild_bloom_filter();
+        ihs_.emplace(index_name, std::move(ih));
+    }
+
+    IndexMeta index_meta = {.tab_name = tab_name, .col_tot_len = col_tot_len,
+                            .col_num = static_cast<int>(cols.size()), .cols = cols, .type = type, .unique = unique};
+    tab.indexes.push_back(index_meta);
+    for (auto &col_name : col_names) {
+        tab.get_col(col_name)->index = true;
+    }
+    flush_meta();
 }
 
 /**
@@ -293,7 +374,70 @@ void SmManager::create_index(const std::string& tab_name, const std::vector<std:
  * @param {Context*} context
  */
 void SmManager::drop_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context) {
-    
+    TabMeta &tab = db_.get_table(tab_name);
+    if (!tab.is_index(col_names)) {
+        throw IndexNotFoundError(tab_name, col_names);
+    }
+    auto index_name = ix_manager_->get_index_name(tab_name, col_names);
+    if (tab.get_index_meta(col_names)->type == INDEX_HASH) {
+        ix_manager_->close_hash_index(hhs_.at(index_name).get());
+        hhs_.erase(index_name);
+    } else {
+        ix_manager_->close_index(ihs_.at(index_name).get());
+        ihs_.erase(index_name);
+    }
+    ix_manager_->destroy_index(tab_name, col_names);
+    tab.indexes.erase(tab.get_index_meta(col_names));
+
+    // 字段上不再有任何索引时清除其index标记
+    for (auto &col : tab.cols) {
+        col.index = false;
+        for (auto &index : tab.indexes) {
+            for (auto &index_col : index.cols) {
+                if (index_col.name == col.name) {
+                    col.index = true;
+                }
+            }
+        }
+    }
+    flush_meta();
+}
+
+/**
+ * @description: 整理B+树索引，合并稀疏的结点并使叶子结点按key的顺序存放，输出整理前后的结点数和叶子填充率
+ * @param {string&} tab_name 表名称
+ * @param {vector<string>&} col_names 索引包含的字段名称
+ * @param {Context*} context
+ */
+void SmManager::optimize_index(const std::string& tab_name, const std::vector<std::string>& col_names,
+                               Context* context) {
+    TabMeta &tab = db_.get_table(tab_name);
+    if (!tab.is_index(col_names)) {
+        throw IndexNotFoundError(tab_name, col_names);
+    }
+    if (tab.get_index_meta(col_names)->type == INDEX_HASH) {
+        throw IndexOperationNotSupportedError("OPTIMIZE", tab_name, col_names);
+    }
+    auto ih = ihs_.at(ix_manager_->get_index_name(tab_name, col_names)).get();
+    IxCompactStats stats = ih->compact();
+
+    auto fill = [](double leaf_fill) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%.1f%%", leaf_fill * 100);
+        return std::string(buf);
+    };
+    std::vector<std::string> captions = {"Stage", "Pages", "Leaf pages", "Leaf fill", "Relocated leaves"};
+    RecordPrinter printer(captions.size());
+    printer.print_separator(context);
+    printer.print_record(captions, context);
+    printer.print_separator(context);
+    printer.print_record({"before", std::to_string(stats.before.num_nodes), std::to_string(stats.before.num_leaves),
+                          fill(stats.before.leaf_fill), "-"},
+                         context);
+    printer.print_record({"after", std::to_string(stats.after.num_nodes), std::to_string(stats.after.num_leaves),
+                          fill(stats.after.leaf_fill), std::to_string(stats.num_relocated)},
+                         context);
+    printer.print_separator(context);
 }
 
 /**
@@ -303,5 +447,9 @@ void SmManager::drop_index(const std::string& tab_name, const std::vector<std::s
  * @param {Context*} context
  */
 void SmManager::drop_index(const std::string& tab_name, const std::vector<ColMeta>& cols, Context* context) {
-   
+    std::vector<std::string> col_names;
+    for (auto &col : cols) {
+        col_names.push_back(col.name);
+    }
+    drop_index(tab_name, col_names, context);
 }
\ No newline at end of file
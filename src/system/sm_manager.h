@@ -30,6 +30,7 @@ class SmManager {
     DbMeta db_;             // 当前打开的数据库的元数据
     std::unordered_map<std::string, std::unique_ptr<RmFileHandle>> fhs_;    // file name -> record file handle, 当前数据库中每张表的数据文件
     std::unordered_map<std::string, std::unique_ptr<IxIndexHandle>> ihs_;   // file name -> index file handle, 当前数据库中每个索引的文件
+    std::unordered_map<std::string, std::unique_ptr<IxHashIndexHandle>> hhs_;   // file name -> hash index file handle, 当前数据库中每个哈希索引的文件
    private:
     DiskManager* disk_manager_;
     BufferPoolManager* buffer_pool_manager_;
@@ -52,6 +53,15 @@ class SmManager {
 
     IxManager* get_ix_manager() { return ix_manager_; }  
 
+    /* 根据索引元数据取得对应的B+树或哈希索引句柄 */
+    IxIndexRef get_index_handle(const std::string& tab_name, const IndexMeta& index) {
+        auto index_name = ix_manager_->get_index_name(tab_name, index.cols);
+        if (index.type == INDEX_HASH) {
+            return {.hash = hhs_.at(index_name).get()};
+        }
+        return {.btree = ihs_.at(index_name).get()};
+    }
+
     bool is_dir(const std::string& db_name);
 
     void create_db(const std::string& db_name);
@@ -72,12 +82,15 @@ class SmManager {
 
     void drop_table(const std::string& tab_name, Context* context);
 
-    void create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context);
+    void create_index(const std::string& tab_name, const std::vector<std::string>& col_names, IndexType type,
+                      bool unique, Context* context);
 
     void drop_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context);
     
     void drop_index(const std::string& tab_name, const std::vector<ColMeta>& col_names, Context* context);
 
+    void optimize_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context);
+
   
 
 
@@ -88,6 +101,7 @@ void cleanup_database_resources() {
 
     // 释放索引文件句柄
     ihs_.clear();
+    hhs_.clear();
 
     // 清理缓冲池中的页面
     //buffer_pool_manager_->flush_all_pages();
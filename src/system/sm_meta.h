@@ -45,9 +45,11 @@ struct IndexMeta {
     int col_tot_len;                // 索引字段长度总和
     int col_num;                    // 索引字段数量
     std::vector<ColMeta> cols;      // 索引包含的字段
+    IndexType type = INDEX_BTREE;   // 索引的组织方式
+    bool unique = true;             // 是否为唯一索引；非唯一索引只能是B+树
 
     friend std::ostream &operator<<(std::ostream &os, const IndexMeta &index) {
-        os << index.tab_name << " " << index.col_tot_len << " " << index.col_num;
+        os << index.tab_name << " " << index.col_tot_len << " " << index.col_num << " " << index.type << " " << index.unique;
         for(auto& col: index.cols) {
             os << "\n" << col;
         }
@@ -55,7 +57,7 @@ struct IndexMeta {
     }
 
     friend std::istream &operator>>(std::istream &is, IndexMeta &index) {
-        is >> index.tab_name >> index.col_tot_len >> index.col_num;
+        is >> index.tab_name >> index.col_tot_len >> index.col_num >> index.type >> index.unique;
         for(int i = 0; i < index.col_num; ++i) {
             ColMeta col;
             is >> col;
@@ -76,8 +78,11 @@ struct TabMeta {
     TabMeta(const TabMeta &other) {
         name = other.name;
         for(auto col : other.cols) cols.push_back(col);
+        for(auto index : other.indexes) indexes.push_back(index);
     }
 
+    TabMeta &operator=(const TabMeta &other) = default;
+
     /* 判断当前表中是否存在名为col_name的字段 */
     bool is_col(const std::string &col_name) const {
         auto pos = std::find_if(cols.begin(), cols.end(), [&](const ColMeta &col) { return col.name == col_name; });
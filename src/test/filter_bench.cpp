@@ -0,0 +1,134 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+/**
+ * 过滤内核微基准：对按页面大小分组的定长记录求 a < const（INT）和 b >= const（FLOAT），
+ * 比较逐条调用谓词程序与标量、SSE4、AVX2过滤内核的性能，约一半记录满足条件，约90%的槽被占用
+ * 用法：filter_bench [num_records] [record_size]，默认1000000条长度为64字节的记录；项目默认以-O0编译，计时时应开启优化
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "execution/filter_kernels.h"
+
+template <typename Fn>
+static double time_ms(Fn &&fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char **argv) {
+    int num_records = argc > 1 ? atoi(argv[1]) : 1000000;
+    int record_size = argc > 2 ? atoi(argv[2]) : 64;
+    // 与数据页一样按组过滤，每组的槽数为一页能放下的记录数
+    int group = std::max(1, 4096 / record_size);
+    int rounds = 10;
+
+    std::mt19937 rng(1);
+    std::vector<char> recs((size_t)num_records * record_size);
+    for (int i = 0; i < num_records; i++) {
+        int a = rng() % 1000;
+        float b = (float)(rng() % 1000) / 10;
+        memcpy(&recs[(size_t)i * record_size], &a, sizeof(int));
+        memcpy(&recs[(size_t)i * record_size + sizeof(int)], &b, sizeof(float));
+    }
+    // 每组的占用位图，与页面上的位图一样第i个槽对应第i位
+    int num_groups = (num_records + group - 1) / group;
+    std::vector<std::vector<uint64_t>> occupied(num_groups);
+    for (int g = 0; g < num_groups; g++) {
+        int n = std::min(group, num_records - g * group);
+        occupied[g].resize(filter_mask_words(n));
+        for (int i = 0; i < n; i++) {
+            occupied[g][i / 64] |= (uint64_t)(rng() % 10 != 0) << (i % 64);
+        }
+    }
+    printf("%d records, record_size %d, %d slots per group\n", num_records, record_size, group);
+
+    std::vector<ColMeta> cols = {{"t", "a", TYPE_INT, 4, 0, false}, {"t", "b", TYPE_FLOAT, 4, 4, false}};
+    struct Case {
+        const char *name;
+        Condition cond;
+    };
+    std::vector<Case> cases(2);
+    cases[0].name = "int <";
+    cases[0].cond.lhs_col = {"t", "a"};
+    cases[0].cond.op = OP_LT;
+    cases[0].cond.is_rhs_val = true;
+    cases[0].cond.rhs_val.set_int(500);
+    cases[1].name = "float >=";
+    cases[1].cond.lhs_col = {"t", "b"};
+    cases[1].cond.op = OP_GE;
+    cases[1].cond.is_rhs_val = true;
+    cases[1].cond.rhs_val.set_float(50);
+    for (auto &c : cases) {
+        c.cond.rhs_val.init_raw(sizeof(int));
+    }
+
+    std::vector<uint64_t> mask(filter_mask_words(group));
+    for (auto &c : cases) {
+        Predicate pred;
+        pred.compile(cols, {c.cond});
+        // 逐条求值，只对被占用的槽调用谓词程序
+        size_t expected = 0;
+        double row_ms = time_ms([&]() {
+            for (int r = 0; r < rounds; r++) {
+                expected = 0;
+                for (int g = 0; g < num_groups; g++) {
+                    const char *base = &recs[(size_t)g * group * record_size];
+                    int n = std::min(group, num_records - g * group);
+                    for (int i = 0; i < n; i++) {
+                        if (((occupied[g][i / 64] >> (i % 64)) & 1) && pred.eval(base + (size_t)i * record_size)) {
+                            expected++;
+                        }
+                    }
+                }
+            }
+        });
+        printf("%-8s %-8s %8.2f ms (%5.2f ns/row)  %zu matched\n", c.name, "row", row_ms / rounds,
+               row_ms * 1e6 / rounds / num_records, expected);
+
+        for (auto isa : {FilterIsa::SCALAR, FilterIsa::SSE4, FilterIsa::AVX2}) {
+            const char *isa_name = isa == FilterIsa::SCALAR ? "scalar" : (isa == FilterIsa::SSE4 ? "sse4" : "avx2");
+            if (!filter_isa_supported(isa)) {
+                printf("%-8s %-8s not supported\n", c.name, isa_name);
+                continue;
+            }
+            size_t matched = 0;
+            double kernel_ms = time_ms([&]() {
+                for (int r = 0; r < rounds; r++) {
+                    matched = 0;
+                    for (int g = 0; g < num_groups; g++) {
+                        const char *base = &recs[(size_t)g * group * record_size];
+                        int n = std::min(group, num_records - g * group);
+                        std::copy(occupied[g].begin(), occupied[g].end(), mask.begin());
+                        filter_records(pred, base, n, record_size, mask.data(), isa);
+                        for (int w = 0; w < filter_mask_words(n); w++) {
+                            matched += __builtin_popcountll(mask[w]);
+                        }
+                    }
+                }
+            });
+            if (matched != expected) {
+                printf("%s %s: expected %zu matched, got %zu\n", c.name, isa_name, expected, matched);
+                return 1;
+            }
+            printf("%-8s %-8s %8.2f ms (%5.2f ns/row)\n", c.name, isa_name, kernel_ms / rounds,
+                   kernel_ms * 1e6 / rounds / num_records);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,217 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+/**
+ * 索引微基准：比较B+树索引与可扩展哈希索引的插入和等值点查性能，B+树按随机顺序和递增顺序插入时的页面数，
+ * B+树反复点查少量热点key时开启和关闭自适应哈希的性能，上层结点常驻内存与否的点查性能，以及逐个点查与批量点查的性能
+ * 用法：index_bench [num_keys] [key_len]，默认100000个INT key；key_len大于4时使用CHAR(key_len)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "index/ix.h"
+
+static const std::string BENCH_TAB_NAME = "index_bench";
+
+template <typename Fn>
+static double time_ms(Fn &&fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * @description: 对一种索引依次计时：按随机顺序插入全部key、按另一随机顺序查找全部key、查找同样数量的不存在的key
+ */
+template <typename IndexHandle>
+static void run(const char *name, IndexHandle *ih, const std::vector<std::string> &keys,
+                const std::vector<std::string> &lookups, const std::vector<std::string> &misses) {
+    size_t n = keys.size();
+    double insert_ms = time_ms([&]() {
+        for (size_t i = 0; i < n; i++) {
+            ih->insert_entry(keys[i].data(), Rid{static_cast<int>(i), 0}, nullptr);
+        }
+    });
+    size_t found = 0;
+    std::vector<Rid> result;
+    double hit_ms = time_ms([&]() {
+        for (auto &key : lookups) {
+            result.clear();
+            found += ih->get_value(key.data(), &result, nullptr);
+        }
+    });
+    double miss_ms = time_ms([&]() {
+        for (auto &key : misses) {
+            result.clear();
+            found += ih->get_value(key.data(), &result, nullptr);
+        }
+    });
+    if (found != n) {
+        printf("%s: expected %zu hits, got %zu\n", name, n, found);
+        exit(1);
+    }
+    printf("%-8s insert %8.1f ms (%6.0f ns/op)  lookup-hit %8.1f ms (%6.0f ns/op)  lookup-miss %8.1f ms (%6.0f ns/op)\n",
+           name, insert_ms, insert_ms * 1e6 / n, hit_ms, hit_ms * 1e6 / n, miss_ms, miss_ms * 1e6 / n);
+}
+
+int main(int argc, char **argv) {
+    int num_keys = argc > 1 ? atoi(argv[1]) : 100000;
+    int key_len = argc > 2 ? atoi(argv[2]) : sizeof(int);
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    ColType type = key_len == sizeof(int) ? TYPE_INT : TYPE_STRING;
+    std::vector<ColMeta> index_cols = {
+        {.tab_name = BENCH_TAB_NAME, .name = "k", .type = type, .len = key_len, .offset = 0, .index = true}};
+
+    // 偶数作为插入的key，奇数作为查找不到的key
+    std::mt19937 rng(2023);
+    std::vector<int> ids(num_keys);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::shuffle(ids.begin(), ids.end(), rng);
+    auto make_key = [&](int v) {
+        std::string key(key_len, '\0');
+        if (type == TYPE_INT) {
+            memcpy(&key[0], &v, sizeof(int));
+        } else {
+            snprintf(&key[0], key_len, "%010d", v);
+        }
+        return key;
+    };
+    std::vector<std::string> keys, misses;
+    for (int id : ids) {
+        keys.push_back(make_key(id * 2));
+        misses.push_back(make_key(id * 2 + 1));
+    }
+    std::vector<std::string> lookups = keys;
+    std::shuffle(lookups.begin(), lookups.end(), rng);
+
+    printf("%d keys, key_len %d\n", num_keys, key_len);
+    {
+        if (ix_manager->exists(BENCH_TAB_NAME, index_cols)) ix_manager->destroy_index(BENCH_TAB_NAME, index_cols);
+        ix_manager->create_index(BENCH_TAB_NAME, index_cols);
+        auto ih = ix_manager->open_index(BENCH_TAB_NAME, index_cols);
+        run("btree", ih.get(), keys, lookups, misses);
+        printf("%-8s %d pages\n", "btree", ih->get_num_pages());
+        ix_manager->close_index(ih.get());
+        ix_manager->destroy_index(BENCH_TAB_NAME, index_cols);
+    }
+    {
+        // 递增插入走最右叶子的追加路径
+        std::vector<std::string> ascending;
+        for (int i = 0; i < num_keys; i++) {
+            ascending.push_back(make_key(i * 2));
+        }
+        ix_manager->create_index(BENCH_TAB_NAME, index_cols);
+        auto ih = ix_manager->open_index(BENCH_TAB_NAME, index_cols);
+        double insert_ms = time_ms([&]() {
+            for (int i = 0; i < num_keys; i++) {
+                ih->insert_entry(ascending[i].data(), Rid{i, 0}, nullptr);
+            }
+        });
+        printf("%-8s insert %8.1f ms (%6.0f ns/op)  %d pages\n", "btree-asc", insert_ms, insert_ms * 1e6 / num_keys,
+               ih->get_num_pages());
+        ix_manager->close_index(ih.get());
+        ix_manager->destroy_index(BENCH_TAB_NAME, index_cols);
+    }
+    {
+        // 热点点查：反复查找1%的key，比较关闭和开启自适应哈希
+        ix_manager->create_index(BENCH_TAB_NAME, index_cols);
+        auto ih = ix_manager->open_index(BENCH_TAB_NAME, index_cols);
+        for (int i = 0; i < num_keys; i++) {
+            ih->insert_entry(keys[i].data(), Rid{i, 0}, nullptr);
+        }
+        std::vector<std::string> hot(keys.begin(), keys.begin() + std::max(1, num_keys / 100));
+        std::vector<Rid> result;
+        for (size_t max_bytes : {size_t(0), IX_AHI_DEFAULT_MAX_BYTES}) {
+            ih->set_adaptive_hash_max_bytes(max_bytes);
+            size_t num_lookups = 0;
+            double ms = time_ms([&]() {
+                for (int round = 0; round < 100; round++) {
+                    for (auto &key : hot) {
+                        result.clear();
+                        ih->get_value(key.data(), &result, nullptr);
+                        num_lookups++;
+                    }
+                }
+            });
+            auto &stats = ih->get_adaptive_hash().stats();
+            printf("%-8s lookup-hot %6.1f ms (%6.0f ns/op)  ahi %s: %zu hits, %zu misses, %zu entries, %zu bytes\n",
+                   "btree", ms, ms * 1e6 / num_lookups, max_bytes > 0 ? "on" : "off", stats.hits, stats.misses,
+                   ih->get_adaptive_hash().size(), ih->get_adaptive_hash().memory_bytes());
+        }
+        ix_manager->close_index(ih.get());
+        ix_manager->destroy_index(BENCH_TAB_NAME, index_cols);
+    }
+    {
+        // 批量点查：每批key排序后共享从根到叶的路径，比较与逐个点查的耗时
+        ix_manager->create_index(BENCH_TAB_NAME, index_cols);
+        auto ih = ix_manager->open_index(BENCH_TAB_NAME, index_cols);
+        ih->set_adaptive_hash_max_bytes(0);
+        for (int i = 0; i < num_keys; i++) {
+            ih->insert_entry(keys[i].data(), Rid{i, 0}, nullptr);
+        }
+        std::vector<const char *> probes;
+        for (auto &key : lookups) {
+            probes.push_back(key.data());
+        }
+        std::vector<Rid> result;
+        size_t found = 0;
+        for (int depth : {0, IX_DEFAULT_RESIDENT_DEPTH}) {
+            ih->set_resident_depth(depth);
+            double single_ms = time_ms([&]() {
+                for (auto probe : probes) {
+                    result.clear();
+                    found += ih->get_value(probe, &result, nullptr);
+                }
+            });
+            printf("%-8s lookup-single %6.1f ms (%6.0f ns/op)  resident depth %d: %zu nodes\n", "btree", single_ms,
+                   single_ms * 1e6 / num_keys, depth, ih->get_num_resident());
+        }
+        for (int batch : {16, 256, 4096}) {
+            std::vector<std::vector<Rid>> results(batch);
+            double batch_ms = time_ms([&]() {
+                for (int i = 0; i < num_keys; i += batch) {
+                    int n = std::min(batch, num_keys - i);
+                    for (int j = 0; j < n; j++) {
+                        results[j].clear();
+                    }
+                    found += ih->get_values_batch(probes.data() + i, n, results.data(), nullptr);
+                }
+            });
+            printf("%-8s lookup-batch  %6.1f ms (%6.0f ns/op)  batch %d\n", "btree", batch_ms,
+                   batch_ms * 1e6 / num_keys, batch);
+        }
+        if (found != static_cast<size_t>(num_keys) * 5) {
+            printf("btree: expected %d hits per run, got %zu in total\n", num_keys, found);
+            exit(1);
+        }
+        ix_manager->close_index(ih.get());
+        ix_manager->destroy_index(BENCH_TAB_NAME, index_cols);
+    }
+    {
+        ix_manager->create_hash_index(BENCH_TAB_NAME, index_cols);
+        auto hh = ix_manager->open_hash_index(BENCH_TAB_NAME, index_cols);
+        run("hash", hh.get(), keys, lookups, misses);
+        ix_manager->close_hash_index(hh.get());
+        ix_manager->destroy_index(BENCH_TAB_NAME, index_cols);
+    }
+    return 0;
+}
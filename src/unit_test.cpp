@@ -12,6 +12,18 @@ See the Mulan PSL v2 for more details. */
 
 #define private public
 
+#include "execution/execution_sort.h"
+#include "execution/executor_aggregate.h"
+#include "execution/executor_block_nestedloop_join.h"
+#include "execution/executor_limit.h"
+#include "execution/executor_hash_join.h"
+#include "execution/executor_index_nestedloop_join.h"
+#include "execution/executor_index_scan.h"
+#include "execution/executor_merge_join.h"
+#include "execution/filter_kernels.h"
+#include "execution/predicate.h"
+#include "execution/tuple_batch.h"
+#include "index/ix.h"
 #include "record/rm.h"
 #include "storage/buffer_pool_manager.h"
 
@@ -24,7 +36,9 @@ See the Mulan PSL v2 for more details. */
 #include <cstring>
 #include <ctime>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <numeric>
 #include <random>
 #include <set>
 #include <string>
@@ -661,3 +675,2305 @@ TEST(RecordManagerTest, SimpleTest) {
     rm_manager->close_file(file_handle.get());
     rm_manager->destroy_file(filename);
 }
+
+TEST(RecordManagerTest, ZoneMapTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "zone_map.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    // 记录为(int a, float b, 填充)，a按插入顺序递增
+    constexpr int record_size = 64;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+    std::unordered_map<Rid, std::pair<int, float>, rid_hash_t, rid_equal_t> mock;
+    char buf[record_size] = {};
+    auto put = [&](int a, float b) {
+        memcpy(buf, &a, sizeof(int));
+        memcpy(buf + sizeof(int), &b, sizeof(float));
+    };
+    std::mt19937 rng(7);
+    for (int a = 0; a < 5000; a++) {
+        float b = (float)(rng() % 1000) / 10;
+        put(a, b);
+        mock[file_handle->insert_record(buf, nullptr)] = {a, b};
+    }
+    file_handle->enable_zone_map({{0, TYPE_INT}, {(int)sizeof(int), TYPE_FLOAT}});
+    ASSERT_TRUE(file_handle->zone_map().enabled());
+
+    // 扫描结果与逐条判断的结果相同
+    auto check_scan = [&](const std::vector<RmZoneMap::Range> &ranges) {
+        std::set<std::pair<int, int>> expected, actual;
+        for (auto &[rid, vals] : mock) {
+            double vs[2] = {(double)vals.first, (double)vals.second};
+            if (std::all_of(ranges.begin(), ranges.end(),
+                            [&](const RmZoneMap::Range &r) { return vs[r.col] >= r.lo && vs[r.col] <= r.hi; })) {
+                expected.emplace(rid.page_no, rid.slot_no);
+            }
+        }
+        RmScan scan(file_handle.get(), ranges);
+        for (; !scan.is_end(); scan.next()) {
+            auto rec = file_handle->get_record(scan.rid(), nullptr);
+            double vs[2] = {(double)*(int *)rec->data, (double)*(float *)(rec->data + sizeof(int))};
+            if (std::all_of(ranges.begin(), ranges.end(),
+                            [&](const RmZoneMap::Range &r) { return vs[r.col] >= r.lo && vs[r.col] <= r.hi; })) {
+                actual.emplace(scan.rid().page_no, scan.rid().slot_no);
+            }
+        }
+        EXPECT_EQ(actual, expected);
+        EXPECT_EQ(scan.stats().scanned_pages + scan.stats().skipped_pages,
+                  (size_t)file_handle->file_hdr_.num_pages - RM_FIRST_RECORD_PAGE);
+        return scan.stats();
+    };
+    int num_pages = file_handle->file_hdr_.num_pages - RM_FIRST_RECORD_PAGE;
+    auto stats = check_scan({{0, 1000, 1999}});
+    EXPECT_GT(stats.skipped_pages, (size_t)num_pages / 2);
+    // b是随机的，每页的范围都覆盖了[50, 50]附近，不能跳过
+    stats = check_scan({{1, 50, 50}});
+    EXPECT_EQ(stats.skipped_pages, 0u);
+    stats = check_scan({{0, 100, 200}, {1, 1000, 2000}});
+    EXPECT_EQ(stats.scanned_pages, 0u);
+
+    // 更新和插入会扩大页面的范围
+    Rid first{RM_FIRST_RECORD_PAGE, 0};
+    put(1500, 200);
+    file_handle->update_record(first, buf, nullptr);
+    mock[first] = {1500, 200};
+    put(1600, -1);
+    mock[file_handle->insert_record(buf, nullptr)] = {1600, -1};
+    check_scan({{0, 1500, 1600}});
+    check_scan({{1, 150, 300}});
+    check_scan({{1, -10, -1}});
+
+    // 删空的页面总会被跳过，之后重新插入也能扫描到
+    for (int slot_no = 0; slot_no < file_handle->file_hdr_.num_records_per_page; slot_no++) {
+        Rid rid{RM_FIRST_RECORD_PAGE + 1, slot_no};
+        file_handle->delete_record(rid, nullptr);
+        mock.erase(rid);
+    }
+    stats = check_scan({{0, INT32_MIN, INT32_MAX}});
+    EXPECT_EQ(stats.skipped_pages, 1u);
+    put(7, 7);
+    Rid rid = file_handle->insert_record(buf, nullptr);
+    mock[rid] = {7, 7};
+    EXPECT_EQ(rid.page_no, RM_FIRST_RECORD_PAGE + 1);
+    check_scan({{0, 7, 7}});
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, BloomFilterTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "bloom_filter.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    // 记录为(int a, char(12) s)，只在a上建立过滤器
+    constexpr int record_size = 16;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+    char buf[record_size] = {};
+    auto hash_int = [](int a) { return BloomFilter::hash_value(reinterpret_cast<char *>(&a), TYPE_INT, sizeof(int)); };
+    std::vector<Rid> rids;
+    for (int a = 0; a < 3000; a += 3) {
+        memcpy(buf, &a, sizeof(int));
+        rids.push_back(file_handle->insert_record(buf, nullptr));
+    }
+    EXPECT_TRUE(file_handle->may_contain(0, hash_int(1)));  // 没有过滤器
+    file_handle->enable_bloom_filter(0, TYPE_INT, sizeof(int));
+    EXPECT_TRUE(file_handle->has_bloom_filter(0));
+    EXPECT_FALSE(file_handle->has_bloom_filter(sizeof(int)));
+    int num_negative = 0;
+    for (int a = 0; a < 3000; a++) {
+        bool positive = file_handle->may_contain(0, hash_int(a));
+        if (a % 3 == 0) {
+            ASSERT_TRUE(positive);
+        }
+        num_negative += !positive;
+    }
+    EXPECT_GT(num_negative, 2000 * 99 / 100);
+
+    // 插入和更新后的值随之加入，超出容量后重建
+    for (int a = 1; a < 30000; a += 3) {
+        memcpy(buf, &a, sizeof(int));
+        file_handle->insert_record(buf, nullptr);
+    }
+    int a = -7;
+    memcpy(buf, &a, sizeof(int));
+    file_handle->update_record(rids[0], buf, nullptr);
+    for (int a = 1; a < 30000; a += 3) {
+        ASSERT_TRUE(file_handle->may_contain(0, hash_int(a)));
+    }
+    EXPECT_TRUE(file_handle->may_contain(0, hash_int(-7)));
+    EXPECT_GE(file_handle->bloom_filters_[0].filter.capacity(), 11000u);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, BatchScanTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "batch_scan.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    constexpr int record_size = 24;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+    char buf[record_size] = {};
+    std::vector<Rid> rids;
+    for (int a = 0; a < 5000; a++) {
+        memcpy(buf, &a, sizeof(int));
+        rids.push_back(file_handle->insert_record(buf, nullptr));
+    }
+    // 删掉部分记录，包括一整页，使页面上出现空槽和空页
+    std::set<int> expected;
+    for (int a = 0; a < 5000; a++) {
+        if (a % 7 == 3 || rids[a].page_no == RM_FIRST_RECORD_PAGE + 2) {
+            file_handle->delete_record(rids[a], nullptr);
+        } else {
+            expected.insert(a);
+        }
+    }
+
+    // 批量读取的记录与逐条扫描的相同，每批不超过TUPLE_BATCH_SIZE行
+    std::vector<int> actual;
+    TupleBatch batch;
+    RmScan scan(file_handle.get());
+    while (!scan.is_end()) {
+        batch.reset(record_size);
+        while (!scan.is_end() && !batch.full()) {
+            batch.commit(scan.next_records(batch.free_space(), batch.free_rows()));
+        }
+        ASSERT_LE(batch.num_rows(), TUPLE_BATCH_SIZE);
+        batch.filter([](const char *data) { return *(const int *)data % 2 == 0; });
+        for (int i = 0; i < batch.size(); i++) {
+            actual.push_back(*(const int *)batch.row(i));
+        }
+    }
+    std::vector<int> even;
+    std::copy_if(expected.begin(), expected.end(), std::back_inserter(even), [](int a) { return a % 2 == 0; });
+    EXPECT_EQ(actual, even);
+    EXPECT_EQ(scan.next_records(batch.free_space(), batch.free_rows()), 0);
+
+    // 按页面过滤时只复制满足条件的记录
+    actual.clear();
+    RmSlotFilter filter = [](const char *slots, int n, int stride, uint64_t *mask) {
+        for (int i = 0; i < n; i++) {
+            if (*(const int *)(slots + i * stride) % 2 != 0) {
+                mask[i / 64] &= ~(1ULL << (i % 64));
+            }
+        }
+    };
+    RmScan filter_scan(file_handle.get());
+    while (!filter_scan.is_end()) {
+        batch.reset(record_size);
+        while (!filter_scan.is_end() && !batch.full()) {
+            batch.commit(filter_scan.next_records(batch.free_space(), std::min(batch.free_rows(), 100), filter));
+        }
+        for (int i = 0; i < batch.size(); i++) {
+            actual.push_back(*(const int *)batch.row(i));
+        }
+    }
+    EXPECT_EQ(actual, even);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(IxIndexHandleTest, SimpleTest) {
+    srand((unsigned)time(nullptr));
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    // 使用较长且长度不一的key，使前缀压缩后每个结点仍只能放下较少的key，从而能够测试到多层结点的分裂与合并
+    const int key_len = 420;
+    std::string tab_name = "ix_test";
+    std::vector<ColMeta> index_cols = {
+        {.tab_name = tab_name, .name = "k", .type = TYPE_STRING, .len = key_len, .offset = 0, .index = true}};
+    if (ix_manager->exists(tab_name, index_cols)) {
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+    ix_manager->create_index(tab_name, index_cols);
+    auto ih = ix_manager->open_index(tab_name, index_cols);
+
+    std::map<std::string, Rid> mock;
+    // 每位数字之后跟一段由之前各位决定的填充字符：相邻key的公共前缀很长，使内部结点中的分隔键也较长
+    auto make_key = [&](int k) {
+        std::string key(key_len, '\0');
+        char digits[16];
+        snprintf(digits, sizeof(digits), "%08lld", k * 15485863LL % 100000000);
+        int len = 0, v = 0;
+        for (int i = 0; i < 8; i++) {
+            key[len++] = digits[i];
+            v = v * 10 + (digits[i] - '0');
+            int fill = i < 7 ? 50 : k % 13;
+            for (int j = 0; j < fill; j++) {
+                key[len++] = static_cast<char>('a' + v % 26);
+            }
+        }
+        return key;
+    };
+    auto check_equal = [&]() {
+        IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager.get());
+        auto it = mock.begin();
+        std::string key(key_len, '\0');
+        for (; !scan.is_end(); scan.next(), it++) {
+            assert(it != mock.end());
+            ih->get_key(scan.iid(), &key[0]);
+            assert(key == it->first);
+            assert(scan.rid() == it->second);
+        }
+        assert(it == mock.end());
+    };
+
+    for (int round = 0; round < 3000; round++) {
+        double insert_prob = 1. - mock.size() / 1000.;
+        int k = rand() % 5000;
+        std::string key = make_key(k);
+        if (mock.empty() || rand() * 1. / RAND_MAX < insert_prob) {
+            Rid rid = {.page_no = k, .slot_no = round};
+            page_id_t page_no = ih->insert_entry(key.c_str(), rid, nullptr);
+            if (mock.count(key)) {
+                assert(page_no == IX_NO_PAGE);
+            } else {
+                assert(page_no != IX_NO_PAGE);
+                mock[key] = rid;
+            }
+        } else {
+            auto it = mock.lower_bound(key);
+            if (it == mock.end()) it = mock.begin();
+            assert(ih->delete_entry(it->first.c_str(), nullptr));
+            mock.erase(it);
+            // 删除不存在的key
+            assert(!ih->delete_entry(make_key(5000).c_str(), nullptr));
+        }
+        std::vector<Rid> result;
+        assert(ih->get_value(key.c_str(), &result, nullptr) == (mock.count(key) > 0));
+        // Randomly re-open file
+        if (round % 500 == 0) {
+            ix_manager->close_index(ih.get());
+            ih = ix_manager->open_index(tab_name, index_cols);
+            check_equal();
+        }
+    }
+    check_equal();
+
+    // lower_bound/upper_bound给出的范围与mock一致
+    for (int i = 0; i < 100; i++) {
+        std::string lo = make_key(rand() % 5000), hi = make_key(rand() % 5000);
+        if (hi < lo) std::swap(lo, hi);
+        IxScan scan(ih.get(), ih->lower_bound(lo.c_str()), ih->upper_bound(hi.c_str()), buffer_pool_manager.get());
+        size_t cnt = 0;
+        for (; !scan.is_end(); scan.next()) cnt++;
+        assert(cnt == (size_t)std::distance(mock.lower_bound(lo), mock.upper_bound(hi)));
+    }
+
+    // clean up
+    ix_manager->close_index(ih.get());
+    ix_manager->destroy_index(tab_name, index_cols);
+}
+
+TEST(IxIndexHandleTest, PrefixCompressionTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    // CHAR(64)的key不压缩时每个结点约能放50个，20000个key需要三层
+    const int key_len = 64;
+    const int num_keys = 20000;
+    std::string tab_name = "ix_prefix_test";
+    std::vector<ColMeta> index_cols = {
+        {.tab_name = tab_name, .name = "k", .type = TYPE_STRING, .len = key_len, .offset = 0, .index = true}};
+    if (ix_manager->exists(tab_name, index_cols)) {
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+    ix_manager->create_index(tab_name, index_cols);
+    auto ih = ix_manager->open_index(tab_name, index_cols);
+
+    auto make_key = [&](int k) {
+        std::string key(key_len, '\0');
+        snprintf(&key[0], key_len, "user_%010d", k);
+        return key;
+    };
+    std::vector<int> ks(num_keys);
+    for (int i = 0; i < num_keys; i++) ks[i] = i;
+    std::shuffle(ks.begin(), ks.end(), std::mt19937(42));
+    for (int k : ks) {
+        assert(ih->insert_entry(make_key(k).c_str(), Rid{.page_no = k, .slot_no = 0}, nullptr) != IX_NO_PAGE);
+    }
+
+    // 前缀压缩与分隔键截断之后只需要两层
+    int height = 1;
+    IxNodeHandle *node = ih->fetch_node(ih->file_hdr_->root_page_);
+    while (!node->is_leaf_page()) {
+        page_id_t child = node->value_at(0);
+        buffer_pool_manager->unpin_page(node->get_page_id(), false);
+        delete node;
+        node = ih->fetch_node(child);
+        height++;
+    }
+    buffer_pool_manager->unpin_page(node->get_page_id(), false);
+    delete node;
+    assert(height == 2);
+
+    int cnt = 0;
+    std::string key(key_len, '\0');
+    for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager.get()); !scan.is_end();
+         scan.next(), cnt++) {
+        ih->get_key(scan.iid(), &key[0]);
+        assert(key == make_key(cnt));
+        assert(scan.rid().page_no == cnt);
+    }
+    assert(cnt == num_keys);
+
+    for (int k : ks) {
+        std::vector<Rid> result;
+        assert(ih->get_value(make_key(k).c_str(), &result, nullptr));
+        assert(ih->delete_entry(make_key(k).c_str(), nullptr));
+    }
+    assert(ih->leaf_begin() == ih->leaf_end());
+
+    ix_manager->close_index(ih.get());
+    ix_manager->destroy_index(tab_name, index_cols);
+}
+
+TEST(IxIndexHandleTest, AscendingInsertTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    const int num_keys = 20000;
+    std::string tab_name = "ix_ascending_test";
+    std::vector<ColMeta> index_cols = {
+        {.tab_name = tab_name, .name = "k", .type = TYPE_INT, .len = sizeof(int), .offset = 0, .index = true}};
+    if (ix_manager->exists(tab_name, index_cols)) {
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+    ix_manager->create_index(tab_name, index_cols);
+    auto ih = ix_manager->open_index(tab_name, index_cols);
+
+    for (int k = 0; k < num_keys; k++) {
+        assert(ih->insert_entry(reinterpret_cast<const char *>(&k), Rid{.page_no = k, .slot_no = 0}, nullptr) ==
+               ih->file_hdr_->last_leaf_);
+    }
+    // 递增插入时叶子结点100/0分裂，除最后一个叶子外都是满的
+    const int leaf_capacity = (PAGE_SIZE - sizeof(IxPageHdr)) / (sizeof(Rid) + sizeof(int));
+    int num_leaves = 0, cnt = 0;
+    for (page_id_t page_no = ih->file_hdr_->first_leaf_; page_no != IX_LEAF_HEADER_PAGE;) {
+        IxNodeHandle *leaf = ih->fetch_node(page_no);
+        assert(leaf->get_size() == leaf_capacity || page_no == ih->file_hdr_->last_leaf_);
+        cnt += leaf->get_size();
+        num_leaves++;
+        page_no = leaf->get_next_leaf();
+        buffer_pool_manager->unpin_page(leaf->get_page_id(), false);
+        delete leaf;
+    }
+    assert(cnt == num_keys);
+    assert(num_leaves == (num_keys + leaf_capacity - 1) / leaf_capacity);
+
+    // 在已有范围内插入和删除之后仍然有序
+    for (int k = num_keys - 1; k >= 0; k -= 2) {
+        assert(ih->delete_entry(reinterpret_cast<const char *>(&k), nullptr));
+    }
+    for (int k = 1; k < num_keys; k += 2) {
+        assert(ih->insert_entry(reinterpret_cast<const char *>(&k), Rid{.page_no = k, .slot_no = 0}, nullptr) !=
+               IX_NO_PAGE);
+    }
+    int expect = 0;
+    for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager.get()); !scan.is_end();
+         scan.next(), expect++) {
+        assert(scan.rid().page_no == expect);
+    }
+    assert(expect == num_keys);
+
+    ix_manager->close_index(ih.get());
+    ix_manager->destroy_index(tab_name, index_cols);
+}
+
+TEST(IxIndexHandleTest, ReverseScanTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    const int num_keys = 20000;
+    std::string tab_name = "ix_reverse_scan_test";
+    std::vector<ColMeta> index_cols = {
+        {.tab_name = tab_name, .name = "k", .type = TYPE_INT, .len = sizeof(int), .offset = 0, .index = true}};
+    if (ix_manager->exists(tab_name, index_cols)) {
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+    ix_manager->create_index(tab_name, index_cols);
+    auto ih = ix_manager->open_index(tab_name, index_cols);
+
+    // 乱序插入，使叶子结点的prev_leaf链接经过多次分裂
+    std::vector<int> ks(num_keys);
+    for (int i = 0; i < num_keys; i++) ks[i] = i;
+    std::shuffle(ks.begin(), ks.end(), std::mt19937(7));
+    for (int k : ks) {
+        assert(ih->insert_entry(reinterpret_cast<const char *>(&k), Rid{.page_no = k, .slot_no = 0}, nullptr) !=
+               IX_NO_PAGE);
+    }
+
+    // 逆序扫描沿prev_leaf从范围的最后一项遍历到第一项，包括从第一个叶子开始和到最后一个叶子结束的范围
+    for (auto [lo_key, hi_key] : std::vector<std::pair<int, int>>{{100, num_keys - 100}, {-1, 5000}, {7, num_keys},
+                                                                  {-5, num_keys + 5}, {50, 50}, {51, 50}}) {
+        Iid lower = ih->lower_bound(reinterpret_cast<const char *>(&lo_key));
+        Iid upper = ih->upper_bound(reinterpret_cast<const char *>(&hi_key));
+        int k = std::min(hi_key, num_keys - 1);
+        for (IxScan scan(ih.get(), lower, upper, buffer_pool_manager.get(), true); !scan.is_end(); scan.next(), k--) {
+            assert(scan.rid().page_no == k);
+        }
+        assert(k == std::max(lo_key, 0) - 1 || (lo_key > hi_key && k == hi_key));
+    }
+
+    // 删除一半的键之后，逆序扫描与正序扫描的结果互为逆序
+    for (int k = 0; k < num_keys; k += 2) {
+        assert(ih->delete_entry(reinterpret_cast<const char *>(&k), nullptr));
+    }
+    std::vector<int> forward, backward;
+    for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager.get()); !scan.is_end();
+         scan.next()) {
+        forward.push_back(scan.rid().page_no);
+    }
+    for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager.get(), true); !scan.is_end();
+         scan.next()) {
+        backward.push_back(scan.rid().page_no);
+    }
+    assert((int)forward.size() == num_keys / 2);
+    std::reverse(backward.begin(), backward.end());
+    assert(forward == backward);
+
+    ix_manager->close_index(ih.get());
+    ix_manager->destroy_index(tab_name, index_cols);
+}
+
+TEST(IxIndexHandleTest, CountRangeTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    const int num_keys = 20000;
+    std::string tab_name = "ix_count_range_test";
+    std::vector<ColMeta> index_cols = {
+        {.tab_name = tab_name, .name = "k", .type = TYPE_INT, .len = sizeof(int), .offset = 0, .index = true}};
+    if (ix_manager->exists(tab_name, index_cols)) {
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+    ix_manager->create_index(tab_name, index_cols);
+    auto ih = ix_manager->open_index(tab_name, index_cols);
+
+    for (int k = 0; k < num_keys; k++) {
+        assert(ih->insert_entry(reinterpret_cast<const char *>(&k), Rid{.page_no = k, .slot_no = 0}, nullptr) !=
+               IX_NO_PAGE);
+    }
+
+    // 范围计数跨越多个叶子，达到上限时提前返回
+    int lo = 100, hi = num_keys - 100;
+    Iid lower = ih->lower_bound(reinterpret_cast<const char *>(&lo));
+    Iid upper = ih->upper_bound(reinterpret_cast<const char *>(&hi));
+    assert(ih->count_range(lower, upper, num_keys) == hi - lo + 1);
+    assert(ih->count_range(lower, upper, 10) == 10);
+    assert(ih->count_range(ih->leaf_begin(), ih->leaf_end(), num_keys) == num_keys);
+    assert(ih->count_range(upper, upper, num_keys) == 0);
+    // 单点范围与空范围
+    lower = ih->lower_bound(reinterpret_cast<const char *>(&lo));
+    upper = ih->upper_bound(reinterpret_cast<const char *>(&lo));
+    assert(ih->count_range(lower, upper, num_keys) == 1);
+    int missing = num_keys + 10;
+    lower = ih->lower_bound(reinterpret_cast<const char *>(&missing));
+    assert(lower == ih->leaf_end());
+    assert(ih->count_range(lower, ih->leaf_end(), num_keys) == 0);
+
+    ix_manager->close_index(ih.get());
+    ix_manager->destroy_index(tab_name, index_cols);
+}
+
+TEST(IxIndexHandleTest, NonUniqueTest) {
+    srand((unsigned)time(nullptr));
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    // 分别测试定长格式（INT）和前缀压缩格式（CHAR）的分组叶子结点
+    for (ColType type : {TYPE_INT, TYPE_STRING}) {
+        const int key_len = type == TYPE_INT ? sizeof(int) : 32;
+        const int num_distinct = 50;
+        std::string tab_name = "ix_nonunique_test";
+        std::vector<ColMeta> index_cols = {
+            {.tab_name = tab_name, .name = "k", .type = type, .len = key_len, .offset = 0, .index = true}};
+        if (ix_manager->exists(tab_name, index_cols)) {
+            ix_manager->destroy_index(tab_name, index_cols);
+        }
+        ix_manager->create_index(tab_name, index_cols, false);
+        auto ih = ix_manager->open_index(tab_name, index_cols);
+
+        auto make_key = [&](int k) {
+            std::string key(key_len, '\0');
+            if (type == TYPE_INT) {
+                memcpy(&key[0], &k, sizeof(int));
+            } else {
+                snprintf(&key[0], key_len, "key_%06d", k);
+            }
+            return key;
+        };
+        // key -> 按(page_no, slot_no)排序的rid
+        std::map<int, std::set<std::pair<int, int>>> mock;
+        int num_entries = 0;
+        auto check_key = [&](int k) {
+            std::vector<Rid> result;
+            std::string key = make_key(k);
+            bool found = ih->get_value(key.c_str(), &result, nullptr);
+            auto &expect = mock[k];
+            assert(found == !expect.empty());
+            assert(result.size() == expect.size());
+            auto it = expect.begin();
+            for (auto &rid : result) {
+                assert(rid.page_no == it->first && rid.slot_no == it->second);
+                ++it;
+            }
+            // 范围扫描[lower_bound, upper_bound)得到同样的rid，索引槽中的key不含rid
+            int cnt = 0;
+            char scan_key[32];
+            for (IxScan scan(ih.get(), ih->lower_bound(key.c_str()), ih->upper_bound(key.c_str()),
+                             buffer_pool_manager.get());
+                 !scan.is_end(); scan.next(), cnt++) {
+                assert(scan.rid() == result[cnt]);
+                ih->get_key(scan.iid(), scan_key);
+                assert(memcmp(scan_key, key.c_str(), key_len) == 0);
+            }
+            assert(cnt == static_cast<int>(result.size()));
+        };
+
+        for (int round = 0; round < 30000; round++) {
+            int k = rand() % num_distinct;
+            std::string key = make_key(k);
+            auto &rids = mock[k];
+            if (rids.empty() || rand() % 3 != 0) {
+                Rid rid = {.page_no = rand() % 1000, .slot_no = rand() % 100};
+                page_id_t page_no = ih->insert_entry(key.c_str(), rid, nullptr);
+                bool inserted = rids.emplace(rid.page_no, rid.slot_no).second;
+                assert((page_no != IX_NO_PAGE) == inserted);
+                num_entries += inserted;
+            } else {
+                auto it = std::next(rids.begin(), rand() % rids.size());
+                Rid rid = {.page_no = it->first, .slot_no = it->second};
+                assert(ih->delete_entry(key.c_str(), rid, nullptr));
+                assert(!ih->delete_entry(key.c_str(), rid, nullptr));
+                rids.erase(it);
+                num_entries--;
+            }
+            if (round % 5000 == 0) {
+                ix_manager->close_index(ih.get());
+                ih = ix_manager->open_index(tab_name, index_cols);
+                for (int i = 0; i < num_distinct; i++) {
+                    check_key(i);
+                }
+            }
+        }
+        for (int i = 0; i < num_distinct; i++) {
+            check_key(i);
+        }
+
+        // 每组只存一份key，叶子结点平均存放的键值对多于每个键值对都存完整key时一个页面的容量
+        int num_leaves = 0, cnt = 0;
+        for (page_id_t page_no = ih->file_hdr_->first_leaf_; page_no != IX_LEAF_HEADER_PAGE;) {
+            IxNodeHandle *leaf = ih->fetch_node(page_no);
+            cnt += leaf->get_size();
+            num_leaves++;
+            page_no = leaf->get_next_leaf();
+            buffer_pool_manager->unpin_page(leaf->get_page_id(), false);
+            delete leaf;
+        }
+        assert(cnt == num_entries);
+        const int plain_capacity = (PAGE_SIZE - sizeof(IxPageHdr)) / (sizeof(Rid) + ih->file_hdr_->key_len_);
+        assert(cnt > num_leaves * plain_capacity);
+
+        // 全部删除
+        for (auto &entry : mock) {
+            for (auto &rid : entry.second) {
+                assert(ih->delete_entry(make_key(entry.first).c_str(), Rid{rid.first, rid.second}, nullptr));
+            }
+            entry.second.clear();
+        }
+        for (int i = 0; i < num_distinct; i++) {
+            check_key(i);
+        }
+
+        ix_manager->close_index(ih.get());
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+}
+
+TEST(IxIndexHandleTest, AdaptiveHashTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string tab_name = "ix_adaptive_hash_test";
+    std::vector<ColMeta> index_cols = {
+        {.tab_name = tab_name, .name = "k", .type = TYPE_INT, .len = sizeof(int), .offset = 0, .index = true}};
+    if (ix_manager->exists(tab_name, index_cols)) {
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+    ix_manager->create_index(tab_name, index_cols);
+    auto ih = ix_manager->open_index(tab_name, index_cols);
+    auto &ahi = ih->get_adaptive_hash();
+
+    std::mt19937 rng(2023);
+    std::vector<int> keys(40000);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    auto insert = [&](int k) {
+        assert(ih->insert_entry(reinterpret_cast<const char *>(&k), Rid{.page_no = k, .slot_no = 1}, nullptr) !=
+               IX_NO_PAGE);
+    };
+    auto lookup = [&](int k) {
+        std::vector<Rid> result;
+        bool found = ih->get_value(reinterpret_cast<const char *>(&k), &result, nullptr);
+        assert(!found || (result.size() == 1 && result[0].page_no == k));
+        return found;
+    };
+    for (int i = 0; i < 20000; i++) {
+        insert(keys[i]);
+    }
+
+    // 反复点查的热点key被加入自适应哈希，之后的点查命中
+    std::vector<int> hot(keys.begin(), keys.begin() + 200);
+    for (int round = 0; round < 10; round++) {
+        for (int k : hot) {
+            assert(lookup(k));
+        }
+    }
+    assert(ahi.size() == hot.size());
+    assert(ahi.stats().hits >= hot.size() * 8);
+
+    // 插入引起叶子结点分裂，被移走的key对应的项失效，之后重新加入
+    for (int i = 20000; i < 40000; i++) {
+        insert(keys[i]);
+    }
+    size_t hits = ahi.stats().hits;
+    for (int round = 0; round < 3; round++) {
+        for (int k : hot) {
+            assert(lookup(k));
+        }
+    }
+    assert(ahi.stats().invalidations > 0);
+    assert(ahi.stats().hits > hits);
+
+    // 删除的key不会再命中
+    for (size_t i = 0; i < hot.size(); i += 2) {
+        assert(ih->delete_entry(reinterpret_cast<const char *>(&hot[i]), nullptr));
+    }
+    for (size_t i = 0; i < hot.size(); i++) {
+        assert(lookup(hot[i]) == (i % 2 == 1));
+    }
+
+    // 内存上限约束项数，超出时淘汰
+    ih->set_adaptive_hash_max_bytes(16 << 10);
+    size_t capacity = ahi.capacity();
+    assert(capacity > 0 && capacity < 1000);
+    for (int round = 0; round < 3; round++) {
+        for (int i = 1000; i < 3000; i++) {
+            assert(lookup(keys[i]));
+        }
+    }
+    assert(ahi.size() <= capacity && ahi.stats().evictions > 0);
+    assert(ahi.memory_bytes() < 2 * (16 << 10) + IX_AHI_SKETCH_SIZE);
+
+    // 关闭后不再使用
+    ih->set_adaptive_hash_max_bytes(0);
+    size_t misses = ahi.stats().misses;
+    hits = ahi.stats().hits;
+    for (int k : hot) {
+        lookup(k);
+    }
+    assert(ahi.size() == 0 && ahi.stats().hits == hits && ahi.stats().misses == misses);
+
+    ix_manager->close_index(ih.get());
+    ix_manager->destroy_index(tab_name, index_cols);
+}
+
+TEST(IxIndexHandleTest, BatchLookupTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string tab_name = "ix_batch_lookup_test";
+    std::vector<ColMeta> index_cols = {
+        {.tab_name = tab_name, .name = "k", .type = TYPE_INT, .len = sizeof(int), .offset = 0, .index = true}};
+    std::mt19937 rng(2023);
+    for (bool unique : {true, false}) {
+        if (ix_manager->exists(tab_name, index_cols)) {
+            ix_manager->destroy_index(tab_name, index_cols);
+        }
+        ix_manager->create_index(tab_name, index_cols, unique);
+        auto ih = ix_manager->open_index(tab_name, index_cols);
+        // 唯一索引插入偶数key，非唯一索引中每个key重复多次，使同一key的键值对跨越叶子结点
+        const int num_keys = unique ? 30000 : 300;
+        for (int i = 0; i < 30000; i++) {
+            int k = (unique ? i : i % num_keys) * 2;
+            assert(ih->insert_entry(reinterpret_cast<const char *>(&k), Rid{.page_no = i, .slot_no = 0}, nullptr) !=
+                   IX_NO_PAGE);
+        }
+        for (int n : {0, 1, 7, 500, 5000}) {
+            std::vector<int> probes(n);
+            for (auto &k : probes) {
+                k = rng() % (num_keys * 2 + 2) - 1;  // 包括不存在的奇数key和超出范围的key
+            }
+            std::vector<const char *> keys;
+            for (auto &k : probes) {
+                keys.push_back(reinterpret_cast<const char *>(&k));
+            }
+            std::vector<std::vector<Rid>> results(n);
+            int num_found = ih->get_values_batch(keys.data(), n, results.data(), nullptr);
+            int expect_found = 0;
+            for (int i = 0; i < n; i++) {
+                std::vector<Rid> expect;
+                expect_found += ih->get_value(keys[i], &expect, nullptr);
+                assert(results[i] == expect);
+            }
+            assert(num_found == expect_found);
+        }
+        ix_manager->close_index(ih.get());
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+}
+
+TEST(IxIndexHandleTest, BloomFilterTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string tab_name = "ix_bloom_filter_test";
+    std::vector<ColMeta> index_cols = {
+        {.tab_name = tab_name, .name = "k", .type = TYPE_INT, .len = sizeof(int), .offset = 0, .index = true}};
+    for (bool unique : {true, false}) {
+        if (ix_manager->exists(tab_name, index_cols)) {
+            ix_manager->destroy_index(tab_name, index_cols);
+        }
+        ix_manager->create_index(tab_name, index_cols, unique);
+        auto ih = ix_manager->open_index(tab_name, index_cols);
+        // 插入偶数key，插入过程中过滤器多次超出容量后重建
+        for (int i = 0; i < 20000; i++) {
+            int k = i * 2;
+            ASSERT_NE(ih->insert_entry(reinterpret_cast<const char *>(&k), Rid{.page_no = i, .slot_no = 0}, nullptr),
+                      IX_NO_PAGE);
+            if (i % 1000 == 0) {
+                std::vector<Rid> result;
+                ASSERT_TRUE(ih->get_value(reinterpret_cast<const char *>(&k), &result, nullptr));
+            }
+        }
+        auto count_negatives = [&](int begin, int end) {
+            int num_negative = 0;
+            for (int k = begin; k < end; k += 2) {
+                num_negative += !ih->may_contain(reinterpret_cast<const char *>(&k));
+            }
+            return num_negative;
+        };
+        EXPECT_EQ(count_negatives(0, 40000), 0);
+        EXPECT_GT(count_negatives(1, 40001), 20000 * 99 / 100);
+        for (int k : {1, 39999, 40000, -2}) {
+            std::vector<Rid> result;
+            EXPECT_FALSE(ih->get_value(reinterpret_cast<const char *>(&k), &result, nullptr));
+        }
+        EXPECT_GE(ih->get_bloom_filter().capacity(), ih->get_bloom_filter().num_keys());
+
+        // 删除的key仍在过滤器中，整理索引后重建时去掉
+        for (int i = 0; i < 10000; i++) {
+            int k = i * 2;
+            ASSERT_TRUE(ih->delete_entry(reinterpret_cast<const char *>(&k), Rid{.page_no = i, .slot_no = 0}, nullptr));
+        }
+        EXPECT_EQ(count_negatives(0, 20000), 0);
+        ih->compact();
+        EXPECT_GT(count_negatives(0, 20000), 10000 * 99 / 100);
+        EXPECT_EQ(count_negatives(20000, 40000), 0);
+        EXPECT_EQ(ih->get_bloom_filter().num_keys(), 10000u);
+
+        ih->set_bloom_filter_enabled(false);
+        EXPECT_EQ(count_negatives(1, 40001), 0);
+        EXPECT_TRUE(ih->get_bloom_filter().empty());
+        ix_manager->close_index(ih.get());
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+}
+
+TEST(IxIndexHandleTest, ResidentTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    // 随机的长key使每个结点只能放下十几个key，树有四层以上
+    const int key_len = 200;
+    std::string tab_name = "ix_resident_test";
+    std::vector<ColMeta> index_cols = {
+        {.tab_name = tab_name, .name = "k", .type = TYPE_STRING, .len = key_len, .offset = 0, .index = true}};
+    if (ix_manager->exists(tab_name, index_cols)) {
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+    ix_manager->create_index(tab_name, index_cols);
+    auto ih = ix_manager->open_index(tab_name, index_cols);
+    ih->set_adaptive_hash_max_bytes(0);
+    ih->set_resident_depth(3);
+
+    std::mt19937 rng(2023);
+    auto make_key = [&](int k) {
+        std::string key(key_len, '\0');
+        std::mt19937 key_rng(k);
+        for (auto &c : key) {
+            c = static_cast<char>('a' + key_rng() % 26);
+        }
+        return key;
+    };
+    // 常驻结点之外，缓冲池中该索引的页面都已unpin
+    auto num_pinned = [&]() {
+        size_t cnt = 0;
+        for (size_t i = 0; i < buffer_pool_manager->pool_size_; i++) {
+            Page &page = buffer_pool_manager->pages_[i];
+            cnt += page.get_page_id().fd == ih->fd_ && page.pin_count_ > 0;
+        }
+        return cnt;
+    };
+    auto check = [&](const std::set<int> &keys) {
+        for (int k = 0; k < 20000; k += 7) {
+            std::vector<Rid> result;
+            std::string key = make_key(k);
+            assert(ih->get_value(key.data(), &result, nullptr) == (keys.count(k) > 0));
+            assert(result.empty() || result[0].page_no == k);
+        }
+        assert(num_pinned() == ih->get_num_resident());
+    };
+
+    std::vector<int> order(20000);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    std::set<int> keys;
+    for (size_t i = 0; i < order.size(); i++) {
+        std::string key = make_key(order[i]);
+        assert(ih->insert_entry(key.data(), Rid{.page_no = order[i], .slot_no = 0}, nullptr) != IX_NO_PAGE);
+        keys.insert(order[i]);
+        if (i % 4000 == 0) {
+            check(keys);
+        }
+    }
+    check(keys);
+    // 根结点及下面两层内部结点常驻
+    assert(ih->get_num_resident() > 1);
+    for (auto &[page_no, resident] : ih->resident_) {
+        assert(!resident->node.is_leaf_page());
+    }
+
+    // 删除大部分key，内部结点合并、重分配以及根结点下降
+    std::shuffle(order.begin(), order.end(), rng);
+    for (size_t i = 0; i < order.size() - 50; i++) {
+        std::string key = make_key(order[i]);
+        assert(ih->delete_entry(key.data(), nullptr));
+        keys.erase(order[i]);
+        if (i % 4000 == 0) {
+            check(keys);
+        }
+    }
+    check(keys);
+
+    // 关闭常驻后所有页面都已unpin
+    ih->set_resident_depth(0);
+    assert(ih->get_num_resident() == 0 && num_pinned() == 0);
+    check(keys);
+
+    ix_manager->close_index(ih.get());
+    ix_manager->destroy_index(tab_name, index_cols);
+}
+
+TEST(IxIndexHandleTest, CompactTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    // 长key使树有多层内部结点，内部结点同样被整理
+    const int key_len = 200;
+    std::string tab_name = "ix_compact_test";
+    std::vector<ColMeta> index_cols = {
+        {.tab_name = tab_name, .name = "k", .type = TYPE_STRING, .len = key_len, .offset = 0, .index = true}};
+    auto make_key = [&](int k) {
+        std::string key(key_len, '\0');
+        std::mt19937 key_rng(k);
+        for (auto &c : key) {
+            c = static_cast<char>('a' + key_rng() % 26);
+        }
+        return key;
+    };
+    std::mt19937 rng(2023);
+    for (bool unique : {true, false}) {
+        if (ix_manager->exists(tab_name, index_cols)) {
+            ix_manager->destroy_index(tab_name, index_cols);
+        }
+        ix_manager->create_index(tab_name, index_cols, unique);
+        auto ih = ix_manager->open_index(tab_name, index_cols);
+        // 非唯一索引中每个key重复4次
+        auto key_of = [&](int i) { return make_key(unique ? i : i / 4); };
+        auto num_pinned = [&]() {
+            size_t cnt = 0;
+            for (size_t i = 0; i < buffer_pool_manager->pool_size_; i++) {
+                Page &page = buffer_pool_manager->pages_[i];
+                cnt += page.get_page_id().fd == ih->fd_ && page.pin_count_ > 0;
+            }
+            return cnt;
+        };
+        // 按key的顺序扫描叶子层，同时检查叶子结点的页面是递增的
+        auto check = [&](const std::set<int> &ids, bool sequential) {
+            std::vector<std::pair<std::string, int>> expect;
+            for (int i : ids) {
+                expect.emplace_back(key_of(i), i);
+            }
+            std::sort(expect.begin(), expect.end());
+            size_t n = 0;
+            page_id_t prev_page_no = IX_NO_PAGE;
+            IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager.get());
+            for (; !scan.is_end(); scan.next(), n++) {
+                std::vector<char> key(key_len);
+                ih->get_key(scan.iid(), key.data());
+                assert(std::string(key.data(), key_len) == expect[n].first);
+                if (unique) {
+                    assert(scan.rid().page_no == expect[n].second);
+                }
+                if (sequential) {
+                    assert(scan.iid().page_no >= prev_page_no);
+                }
+                prev_page_no = scan.iid().page_no;
+            }
+            assert(n == expect.size());
+            for (int i = 0; i < 24000; i += 13) {
+                std::vector<Rid> result;
+                std::string key = key_of(i);
+                ih->get_value(key.data(), &result, nullptr);
+                bool found = std::find(result.begin(), result.end(), Rid{.page_no = i, .slot_no = 0}) != result.end();
+                assert(found == (ids.count(i) > 0));
+            }
+            assert(num_pinned() == ih->get_num_resident());
+        };
+
+        std::vector<int> order(24000);
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), rng);
+        std::set<int> ids(order.begin(), order.end());
+        for (int i : order) {
+            assert(ih->insert_entry(key_of(i).data(), Rid{.page_no = i, .slot_no = 0}, nullptr) != IX_NO_PAGE);
+        }
+        // 删除大部分键值对，不足半个页面的结点在删除时已合并，多数叶子结点只用了一半多一点
+        std::shuffle(order.begin(), order.end(), rng);
+        for (size_t i = 0; i < order.size() * 3 / 4; i++) {
+            assert(ih->delete_entry(key_of(order[i]).data(), Rid{.page_no = order[i], .slot_no = 0}, nullptr));
+            ids.erase(order[i]);
+        }
+        check(ids, false);
+
+        IxCompactStats stats = ih->compact();
+        assert(ih->get_tree_stats().num_nodes == stats.after.num_nodes);
+        assert(stats.after.num_leaves < stats.before.num_leaves);
+        assert(stats.after.leaf_fill > 0.8 && stats.after.leaf_fill > stats.before.leaf_fill);
+        assert(stats.num_relocated > 0);
+        check(ids, true);
+
+        // 再次整理只会合并上一次因不在同一父结点下而跳过的结点，叶子结点已按顺序存放
+        IxCompactStats again = ih->compact();
+        assert(again.after.num_nodes <= stats.after.num_nodes && again.num_relocated == 0);
+
+        // 整理之后的树仍可正常插入和删除
+        for (size_t i = 0; i < order.size() / 4; i++) {
+            assert(ih->insert_entry(key_of(order[i]).data(), Rid{.page_no = order[i], .slot_no = 0}, nullptr) !=
+                   IX_NO_PAGE);
+            ids.insert(order[i]);
+        }
+        for (size_t i = order.size() / 2; i < order.size() * 3 / 4; i++) {
+            assert(ih->delete_entry(key_of(order[i]).data(), Rid{.page_no = order[i], .slot_no = 0}, nullptr) ==
+                   (ids.count(order[i]) > 0));
+            ids.erase(order[i]);
+        }
+        check(ids, false);
+
+        ix_manager->close_index(ih.get());
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+}
+
+TEST(IndexScanTest, ScanRangeTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    // 复合索引(a, b, c)，a, b取0..19，c取0..4，rid的page_no为key的编号
+    std::string tab_name = "ix_scan_range_test";
+    IndexMeta index_meta = {.tab_name = tab_name, .col_tot_len = 12, .col_num = 3};
+    for (std::string name : {"a", "b", "c"}) {
+        int offset = index_meta.cols.size() * sizeof(int);
+        index_meta.cols.push_back(
+            {.tab_name = tab_name, .name = name, .type = TYPE_INT, .len = sizeof(int), .offset = offset, .index = true});
+    }
+    if (ix_manager->exists(tab_name, index_meta.cols)) {
+        ix_manager->destroy_index(tab_name, index_meta.cols);
+    }
+    ix_manager->create_index(tab_name, index_meta.cols);
+    auto ih = ix_manager->open_index(tab_name, index_meta.cols);
+    auto make_key = [](int a, int b, int c) {
+        std::string key(12, '\0');
+        memcpy(&key[0], &a, sizeof(int));
+        memcpy(&key[4], &b, sizeof(int));
+        memcpy(&key[8], &c, sizeof(int));
+        return key;
+    };
+    for (int a = 0; a < 20; a++) {
+        for (int b = 0; b < 20; b++) {
+            for (int c = 0; c < 5; c++) {
+                int no = (a * 20 + b) * 5 + c;
+                ASSERT_NE(ih->insert_entry(make_key(a, b, c).c_str(), Rid{.page_no = no, .slot_no = 0}, nullptr),
+                          IX_NO_PAGE);
+            }
+        }
+    }
+    auto cond = [&](const std::string &col, CompOp op, int val) {
+        Condition cond = {.lhs_col = {tab_name, col}, .op = op, .is_rhs_val = true};
+        cond.rhs_val.set_int(val);
+        cond.rhs_val.init_raw(sizeof(int));
+        return cond;
+    };
+    // 范围内的key按(a, b, c)依次取出
+    auto scan_keys = [&](const Iid &lower, const Iid &upper) {
+        std::vector<std::tuple<int, int, int>> keys;
+        for (IxScan scan(ih.get(), lower, upper, buffer_pool_manager.get()); !scan.is_end(); scan.next()) {
+            int no = scan.rid().page_no;
+            keys.emplace_back(no / 100, no / 5 % 20, no % 5);
+        }
+        return keys;
+    };
+    auto expect_keys = [](int a_lo, int a_hi, int b_lo, int b_hi, int c_lo, int c_hi) {
+        std::vector<std::tuple<int, int, int>> keys;
+        for (int a = a_lo; a <= a_hi; a++) {
+            for (int b = b_lo; b <= b_hi; b++) {
+                for (int c = c_lo; c <= c_hi; c++) {
+                    keys.emplace_back(a, b, c);
+                }
+            }
+        }
+        return keys;
+    };
+    const int int_min = std::numeric_limits<int>::min(), int_max = std::numeric_limits<int>::max();
+    Iid lower, upper;
+
+    // 最左前缀上的等值条件：其余字段用最小/最大值填充
+    IndexScanExecutor::get_scan_range(ih.get(), index_meta, {cond("a", OP_EQ, 7)}, &lower, &upper);
+    EXPECT_EQ(lower, ih->lower_bound(make_key(7, int_min, int_min).c_str()));
+    EXPECT_EQ(upper, ih->upper_bound(make_key(7, int_max, int_max).c_str()));
+    EXPECT_EQ(scan_keys(lower, upper), expect_keys(7, 7, 0, 19, 0, 4));
+
+    // 前缀等值加下一个字段上的范围：排他的下界之后填最大值，取最紧的上界
+    IndexScanExecutor::get_scan_range(
+        ih.get(), index_meta, {cond("b", OP_LE, 12), cond("a", OP_EQ, 7), cond("b", OP_GT, 3), cond("b", OP_LE, 9)},
+        &lower, &upper);
+    EXPECT_EQ(lower, ih->upper_bound(make_key(7, 3, int_max).c_str()));
+    EXPECT_EQ(upper, ih->upper_bound(make_key(7, 9, int_max).c_str()));
+    EXPECT_EQ(scan_keys(lower, upper), expect_keys(7, 7, 4, 9, 0, 4));
+    IndexScanExecutor::get_scan_range(ih.get(), index_meta, {cond("a", OP_EQ, 7), cond("b", OP_EQ, 4), cond("c", OP_LT, 3)},
+                                      &lower, &upper);
+    EXPECT_EQ(lower, ih->lower_bound(make_key(7, 4, int_min).c_str()));
+    EXPECT_EQ(upper, ih->lower_bound(make_key(7, 4, 3).c_str()));
+    EXPECT_EQ(scan_keys(lower, upper), expect_keys(7, 7, 4, 4, 0, 2));
+    // 范围条件之后的字段不再收紧范围，交给谓词程序过滤
+    IndexScanExecutor::get_scan_range(ih.get(), index_meta, {cond("a", OP_GE, 18), cond("b", OP_EQ, 4)}, &lower, &upper);
+    EXPECT_EQ(scan_keys(lower, upper), expect_keys(18, 19, 0, 19, 0, 4));
+    // 前缀中间的字段没有条件时只用到它之前的字段
+    IndexScanExecutor::get_scan_range(ih.get(), index_meta, {cond("a", OP_EQ, 7), cond("c", OP_EQ, 2)}, &lower, &upper);
+    EXPECT_EQ(scan_keys(lower, upper), expect_keys(7, 7, 0, 19, 0, 4));
+    // 矛盾的条件得到空范围
+    IndexScanExecutor::get_scan_range(ih.get(), index_meta, {cond("a", OP_EQ, 7), cond("b", OP_GE, 5), cond("b", OP_LT, 5)},
+                                      &lower, &upper);
+    EXPECT_EQ(lower, upper);
+    IndexScanExecutor::get_scan_range(ih.get(), index_meta, {cond("a", OP_EQ, 7), cond("a", OP_EQ, 8)}, &lower, &upper);
+    EXPECT_EQ(lower, upper);
+
+    // 第一个字段上没有条件时扫描整个叶子层
+    IndexScanExecutor::get_scan_range(ih.get(), index_meta, {cond("b", OP_EQ, 4), cond("c", OP_GT, 1)}, &lower, &upper);
+    EXPECT_EQ(lower, ih->leaf_begin());
+    EXPECT_EQ(upper, ih->leaf_end());
+    EXPECT_EQ(scan_keys(lower, upper).size(), 2000u);
+
+    // 所有字段都是等值条件：存在的key得到一行，不存在的key大多被Bloom过滤器直接排除，范围为叶子层末尾
+    IndexScanExecutor::get_scan_range(ih.get(), index_meta, {cond("c", OP_EQ, 2), cond("a", OP_EQ, 7), cond("b", OP_EQ, 4)},
+                                      &lower, &upper);
+    EXPECT_EQ(scan_keys(lower, upper), expect_keys(7, 7, 4, 4, 2, 2));
+    int num_filtered = 0;
+    for (int c = 5; c < 105; c++) {
+        IndexScanExecutor::get_scan_range(ih.get(), index_meta, {cond("a", OP_EQ, 7), cond("b", OP_EQ, 4), cond("c", OP_EQ, c)},
+                                          &lower, &upper);
+        EXPECT_EQ(lower, upper);
+        num_filtered += lower == ih->leaf_end();
+    }
+    EXPECT_GT(num_filtered, 90);
+
+    ix_manager->close_index(ih.get());
+    ix_manager->destroy_index(tab_name, index_meta.cols);
+}
+
+TEST(BloomFilterTest, SimpleTest) {
+    std::mt19937_64 rng(40);
+    BloomFilter filter(100000);
+    std::set<uint64_t> inserted;
+    for (int i = 0; i < 100000; i++) {
+        uint64_t hash = rng();
+        filter.insert(hash);
+        inserted.insert(hash);
+    }
+    EXPECT_EQ(filter.num_keys(), 100000u);
+    for (uint64_t hash : inserted) {
+        ASSERT_TRUE(filter.may_contain(hash));
+    }
+    int num_positive = 0;
+    for (int i = 0; i < 100000; i++) {
+        uint64_t hash = rng();
+        bool positive = filter.may_contain(hash);
+        num_positive += positive && inserted.count(hash) == 0;
+        // 向量化的检查与逐字检查的结果相同
+        auto &block = filter.blocks_[filter.block_index(hash)];
+        uint32_t masks[8];
+        BloomFilter::make_masks(static_cast<uint32_t>(hash), masks);
+        bool expect = true;
+        for (int j = 0; j < 8; j++) {
+            expect = expect && (block.words[j] & masks[j]) == masks[j];
+        }
+        ASSERT_EQ(positive, expect);
+    }
+    EXPECT_LT(num_positive, 100000 / 100);
+
+    // 比较时相等的值哈希值也相同
+    char short_str[8] = "abc", long_str[12] = "abc";
+    EXPECT_EQ(BloomFilter::hash_value(short_str, TYPE_STRING, sizeof(short_str)),
+              BloomFilter::hash_value(long_str, TYPE_STRING, sizeof(long_str)));
+    float zero = 0, neg_zero = -0.0f;
+    EXPECT_EQ(BloomFilter::hash_value(reinterpret_cast<char *>(&zero), TYPE_FLOAT, sizeof(float)),
+              BloomFilter::hash_value(reinterpret_cast<char *>(&neg_zero), TYPE_FLOAT, sizeof(float)));
+    BloomFilter empty;
+    EXPECT_TRUE(empty.may_contain(rng()));
+}
+
+TEST(PredicateTest, SimpleTest) {
+    // 记录为(int a, float b, char(8) s, int c)，谓词程序的结果与按ix_compare逐个条件比较的结果相同
+    std::vector<ColMeta> cols = {{"t", "a", TYPE_INT, 4, 0, false},
+                                 {"t", "b", TYPE_FLOAT, 4, 4, false},
+                                 {"t", "s", TYPE_STRING, 8, 8, false},
+                                 {"t", "c", TYPE_INT, 4, 16, false}};
+    constexpr int record_size = 20;
+    std::mt19937 rng(42);
+    auto rand_record = [&](char *rec) {
+        int a = rng() % 10 - 5;
+        float b = (float)(rng() % 10) / 2 - 2;
+        char s[8] = {};
+        for (int i = 0; i < (int)(rng() % 4); i++) {
+            s[i] = 'a' + rng() % 3;
+        }
+        int c = rng() % 10 - 5;
+        memcpy(rec, &a, 4);
+        memcpy(rec + 4, &b, 4);
+        memcpy(rec + 8, s, 8);
+        memcpy(rec + 16, &c, 4);
+    };
+    auto expect = [](int cmp, CompOp op) {
+        switch (op) {
+            case OP_EQ: return cmp == 0;
+            case OP_NE: return cmp != 0;
+            case OP_LT: return cmp < 0;
+            case OP_GT: return cmp > 0;
+            case OP_LE: return cmp <= 0;
+            default: return cmp >= 0;
+        }
+    };
+    for (int round = 0; round < 200; round++) {
+        // 随机生成1~3个条件，右侧是常量或同类型的字段
+        std::vector<Condition> conds;
+        char val_rec[record_size];
+        rand_record(val_rec);
+        for (int i = 0; i < (int)(rng() % 3) + 1; i++) {
+            Condition cond;
+            int col = rng() % cols.size();
+            cond.lhs_col = {"t", cols[col].name};
+            cond.op = (CompOp)(rng() % 6);
+            cond.is_rhs_val = col == 1 || col == 2 || rng() % 2 == 0;
+            if (cond.is_rhs_val) {
+                const char *val = val_rec + cols[col].offset;
+                if (cols[col].type == TYPE_INT) {
+                    cond.rhs_val.set_int(*(const int *)val);
+                } else if (cols[col].type == TYPE_FLOAT) {
+                    cond.rhs_val.set_float(*(const float *)val);
+                } else {
+                    cond.rhs_val.set_str(std::string(val, strnlen(val, 8)));
+                }
+                cond.rhs_val.init_raw(cols[col].len);
+            } else {
+                cond.rhs_col = {"t", col == 0 ? "c" : "a"};
+            }
+            conds.push_back(cond);
+        }
+        Predicate pred;
+        pred.compile(cols, conds);
+        ASSERT_EQ(pred.terms().size(), conds.size());
+        for (int i = 0; i < 50; i++) {
+            char rec[record_size];
+            rand_record(rec);
+            bool expected = true;
+            for (auto &cond : conds) {
+                auto &lhs = *std::find_if(cols.begin(), cols.end(),
+                                          [&](const ColMeta &col) { return col.name == cond.lhs_col.col_name; });
+                const char *rhs = cond.is_rhs_val ? cond.rhs_val.raw->data : rec + (cond.rhs_col.col_name == "c" ? 16 : 0);
+                expected = expected && expect(ix_compare(rec + lhs.offset, rhs, lhs.type, lhs.len), cond.op);
+            }
+            ASSERT_EQ(pred.eval(rec), expected);
+        }
+    }
+
+    // 找不到的字段在编译时报错
+    Condition cond;
+    cond.lhs_col = {"t", "d"};
+    cond.op = OP_EQ;
+    cond.is_rhs_val = false;
+    cond.rhs_col = {"t", "a"};
+    Predicate pred;
+    EXPECT_THROW(pred.compile(cols, {cond}), ColumnNotFoundError);
+
+    // FLOAT字段与整数常量比较时常量转换为浮点数，其余类型不同的条件在编译时报错
+    char rec[record_size] = {};
+    float b = 2.5f;
+    memcpy(rec + 4, &b, sizeof(float));
+    cond.lhs_col = {"t", "b"};
+    cond.is_rhs_val = true;
+    for (auto [val, op, expected] : std::vector<std::tuple<int, CompOp, bool>>{
+             {2, OP_GT, true}, {3, OP_GT, false}, {3, OP_LT, true}, {2, OP_EQ, false}, {-1, OP_GE, true}}) {
+        cond.op = op;
+        cond.rhs_val = Value();
+        cond.rhs_val.set_int(val);
+        cond.rhs_val.init_raw(sizeof(int));
+        pred.compile(cols, {cond});
+        ASSERT_EQ(pred.eval(rec), expected);
+    }
+    b = 3;
+    memcpy(rec + 4, &b, sizeof(float));
+    cond.op = OP_EQ;
+    cond.rhs_val = Value();
+    cond.rhs_val.set_int(3);
+    cond.rhs_val.init_raw(sizeof(int));
+    pred.compile(cols, {cond});
+    ASSERT_TRUE(pred.eval(rec));
+
+    cond.lhs_col = {"t", "a"};
+    cond.rhs_val = Value();
+    cond.rhs_val.set_float(1.5f);
+    cond.rhs_val.init_raw(sizeof(float));
+    EXPECT_THROW(pred.compile(cols, {cond}), IncompatibleTypeError);
+    cond.rhs_val = Value();
+    cond.rhs_val.set_str("ab");
+    cond.rhs_val.init_raw(sizeof(int));
+    EXPECT_THROW(pred.compile(cols, {cond}), IncompatibleTypeError);
+    cond.is_rhs_val = false;
+    cond.rhs_col = {"t", "b"};
+    EXPECT_THROW(pred.compile(cols, {cond}), IncompatibleTypeError);
+}
+
+TEST(PredicateTest, CharLengthTest) {
+    // 记录为(char(4) a, char(8) b)，长度不同的CHAR字段按补0后的值比较，与两侧的顺序无关
+    std::vector<ColMeta> cols = {{"t", "a", TYPE_STRING, 4, 0, false}, {"t", "b", TYPE_STRING, 8, 4, false}};
+    std::vector<std::string> vals = {"", "a", "ab", "abc", "abcd", "abzz", "abcdefgh", "b"};
+    for (auto &a : vals) {
+        for (auto &b : vals) {
+            if (a.size() > 4) {
+                continue;
+            }
+            char rec[12] = {};
+            memcpy(rec, a.data(), a.size());
+            memcpy(rec + 4, b.data(), b.size());
+            int cmp = a.compare(b);
+            for (int op = OP_EQ; op <= OP_GE; op++) {
+                Condition cond;
+                cond.lhs_col = {"t", "a"};
+                cond.op = (CompOp)op;
+                cond.is_rhs_val = false;
+                cond.rhs_col = {"t", "b"};
+                Predicate pred;
+                pred.compile(cols, {cond});
+                bool expected = op == OP_EQ   ? cmp == 0
+                                : op == OP_NE ? cmp != 0
+                                : op == OP_LT ? cmp < 0
+                                : op == OP_GT ? cmp > 0
+                                : op == OP_LE ? cmp <= 0
+                                              : cmp >= 0;
+                ASSERT_EQ(pred.eval(rec), expected) << "'" << a << "' " << op << " '" << b << "'";
+                // 交换两侧后比较结果反转
+                std::swap(cond.lhs_col, cond.rhs_col);
+                cond.op = op == OP_LT ? OP_GT : op == OP_GT ? OP_LT : op == OP_LE ? OP_GE : op == OP_GE ? OP_LE : cond.op;
+                pred.compile(cols, {cond});
+                ASSERT_EQ(pred.eval(rec), expected) << "'" << b << "' " << cond.op << " '" << a << "'";
+            }
+        }
+    }
+}
+
+TEST(FilterKernelTest, SimpleTest) {
+    // 记录为(int a, float b, char(4) s)，各指令集的结果与逐条比较的结果相同
+    constexpr int stride = 12;
+    constexpr int max_n = 300;
+    std::mt19937 rng(11);
+    std::vector<char> recs(max_n * stride);
+    for (int i = 0; i < max_n; i++) {
+        int a = rng() % 20 - 10;
+        float b = (float)(rng() % 20) / 4 - 2;
+        memcpy(&recs[i * stride], &a, sizeof(int));
+        memcpy(&recs[i * stride + 4], &b, sizeof(float));
+        recs[i * stride + 8] = 'a' + rng() % 3;
+    }
+    std::vector<FilterIsa> isas;
+    for (auto isa : {FilterIsa::SCALAR, FilterIsa::SSE4, FilterIsa::AVX2}) {
+        if (filter_isa_supported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    for (int n : {1, 7, 8, 63, 64, 65, 100, max_n}) {
+        std::vector<uint64_t> occupied(filter_mask_words(n));
+        for (int i = 0; i < n; i++) {
+            occupied[i / 64] |= (uint64_t)(rng() % 4 != 0) << (i % 64);
+        }
+        for (int op = OP_EQ; op <= OP_GE; op++) {
+            for (ColType type : {TYPE_INT, TYPE_FLOAT}) {
+                int offset = type == TYPE_INT ? 0 : 4;
+                const char *val = &recs[(rng() % max_n) * stride + offset];
+                auto cmp = Predicate::select(type, (CompOp)op);
+                std::vector<uint64_t> expected = occupied;
+                for (int i = 0; i < n; i++) {
+                    if (!cmp(&recs[i * stride + offset], val, 4, 4)) {
+                        expected[i / 64] &= ~(1ULL << (i % 64));
+                    }
+                }
+                for (auto isa : isas) {
+                    std::vector<uint64_t> mask = occupied;
+                    filter_column(recs.data(), n, stride, offset, type, (CompOp)op, val, mask.data(), isa);
+                    ASSERT_EQ(mask, expected) << "isa " << (int)isa << " op " << op << " type " << type << " n " << n;
+                }
+            }
+        }
+    }
+
+    // 整个谓词程序：数值条件由内核求值，字符串条件逐条求值
+    std::vector<ColMeta> cols = {{"t", "a", TYPE_INT, 4, 0, false},
+                                 {"t", "b", TYPE_FLOAT, 4, 4, false},
+                                 {"t", "s", TYPE_STRING, 4, 8, false}};
+    std::vector<Condition> conds(3);
+    conds[0].lhs_col = {"t", "a"};
+    conds[0].op = OP_GE;
+    conds[0].is_rhs_val = true;
+    conds[0].rhs_val.set_int(-3);
+    conds[1].lhs_col = {"t", "b"};
+    conds[1].op = OP_LT;
+    conds[1].is_rhs_val = true;
+    conds[1].rhs_val.set_float(1.5);
+    conds[2].lhs_col = {"t", "s"};
+    conds[2].op = OP_NE;
+    conds[2].is_rhs_val = true;
+    conds[2].rhs_val.set_str("b");
+    for (int i = 0; i < 3; i++) {
+        conds[i].rhs_val.init_raw(cols[i].len);
+    }
+    Predicate pred;
+    pred.compile(cols, conds);
+    for (auto isa : isas) {
+        std::vector<uint64_t> mask(filter_mask_words(max_n), ~0ULL);
+        filter_records(pred, recs.data(), max_n, stride, mask.data(), isa);
+        for (int i = 0; i < max_n; i++) {
+            ASSERT_EQ((mask[i / 64] >> (i % 64)) & 1, (uint64_t)pred.eval(&recs[i * stride]));
+        }
+    }
+}
+
+/* 依次输出内存中给定记录的算子，用作连接算子的子节点 */
+class MockExecutor : public AbstractExecutor {
+   private:
+    std::vector<ColMeta> cols_;
+    size_t len_;
+    std::vector<std::string> rows_;
+    size_t pos_ = 0;
+
+   public:
+    MockExecutor(std::vector<ColMeta> cols, std::vector<std::string> rows) : cols_(std::move(cols)), rows_(std::move(rows)) {
+        len_ = cols_.back().offset + cols_.back().len;
+    }
+
+    size_t tupleLen() const override { return len_; }
+
+    const std::vector<ColMeta> &cols() const override { return cols_; }
+
+    void beginTuple() override { pos_ = 0; }
+
+    void nextTuple() override { pos_++; }
+
+    bool is_end() const override { return pos_ == rows_.size(); }
+
+    std::unique_ptr<RmRecord> Next() override { return std::make_unique<RmRecord>(len_, const_cast<char *>(rows_[pos_].data())); }
+
+    Rid &rid() override { return _abstract_rid; }
+    size_t get_pos() const { return pos_; }
+};
+
+TEST(HashJoinTest, SpillTest) {
+    // l(k int, v int)与r(k int, s char(6), w int)按l.k = r.k and l.v < r.w连接，k有大量重复值
+    std::vector<ColMeta> left_cols = {{"l", "k", TYPE_INT, 4, 0, false}, {"l", "v", TYPE_INT, 4, 4, false}};
+    std::vector<ColMeta> right_cols = {
+        {"r", "k", TYPE_INT, 4, 0, false}, {"r", "s", TYPE_STRING, 6, 4, false}, {"r", "w", TYPE_INT, 4, 10, false}};
+    std::mt19937 rng(3);
+    auto make_row = [](std::vector<int> ints, size_t len) {
+        std::string row(len, '\0');
+        memcpy(&row[0], &ints[0], sizeof(int));
+        memcpy(&row[len - sizeof(int)], &ints[1], sizeof(int));
+        return row;
+    };
+    std::vector<std::string> left_rows, right_rows;
+    for (int i = 0; i < 3000; i++) {
+        int k = i % 10 == 0 ? 7 : rng() % 500;
+        left_rows.push_back(make_row({k, (int)(rng() % 100)}, 8));
+    }
+    for (int i = 0; i < 2000; i++) {
+        int k = i % 20 == 0 ? 7 : rng() % 600;
+        std::string row = make_row({k, (int)(rng() % 100)}, 14);
+        snprintf(&row[4], 6, "r%d", i % 1000);
+        right_rows.push_back(row);
+    }
+    std::multiset<std::string> expected;
+    for (auto &l : left_rows) {
+        for (auto &r : right_rows) {
+            if (memcmp(l.data(), r.data(), 4) == 0 && *(int *)&l[4] < *(int *)&r[10]) {
+                expected.insert(l + r);
+            }
+        }
+    }
+    ASSERT_GT(expected.size(), 1000u);
+
+    std::vector<Condition> conds(2);
+    conds[0].lhs_col = {"r", "k"};
+    conds[0].op = OP_EQ;
+    conds[0].is_rhs_val = false;
+    conds[0].rhs_col = {"l", "k"};
+    conds[1].lhs_col = {"l", "v"};
+    conds[1].op = OP_LT;
+    conds[1].is_rhs_val = false;
+    conds[1].rhs_col = {"r", "w"};
+    // 预算足够时不溢出；预算很小时多次划分分区，重复值过多的分区到最大层数后仍在内存中建表
+    for (size_t budget : {HASH_JOIN_MEM_BUDGET, (size_t)16384, (size_t)256}) {
+        for (bool build_left : {false, true}) {
+            HashJoinExecutor join(std::make_unique<MockExecutor>(left_cols, left_rows),
+                                  std::make_unique<MockExecutor>(right_cols, right_rows), conds, build_left, budget);
+            ASSERT_EQ(join.tupleLen(), 22u);
+            std::multiset<std::string> actual;
+            for (join.beginTuple(); !join.is_end(); join.nextTuple()) {
+                actual.insert(std::string(join.Next()->data, 22));
+            }
+            EXPECT_EQ(actual, expected) << "budget " << budget << " build_left " << build_left;
+            EXPECT_EQ(join.get_num_partitions() > 0, budget != HASH_JOIN_MEM_BUDGET);
+
+            // 批量读取的结果相同
+            actual.clear();
+            TupleBatch batch;
+            join.beginBatch();
+            while (join.NextBatch(batch)) {
+                for (int i = 0; i < batch.size(); i++) {
+                    actual.insert(std::string(batch.row(i), 22));
+                }
+            }
+            EXPECT_EQ(actual, expected);
+        }
+    }
+
+    // 建表一侧为空
+    HashJoinExecutor empty_join(std::make_unique<MockExecutor>(left_cols, left_rows),
+                                std::make_unique<MockExecutor>(right_cols, std::vector<std::string>()), conds);
+    empty_join.beginTuple();
+    EXPECT_TRUE(empty_join.is_end());
+}
+
+/* 第一个字段为int，may_contain按实际出现过的值回答，相当于该字段上没有误判的Bloom过滤器 */
+class FilteredMockExecutor : public MockExecutor {
+   private:
+    TabCol key_col_;
+    std::set<int> keys_;
+
+   public:
+    FilteredMockExecutor(std::vector<ColMeta> cols, std::vector<std::string> rows)
+        : MockExecutor(cols, rows), key_col_{cols[0].tab_name, cols[0].name} {
+        for (auto &row : rows) {
+            keys_.insert(*(int *)row.data());
+        }
+    }
+
+    bool may_contain(const TabCol &col, const char *val, int len) override {
+        if (col.tab_name != key_col_.tab_name || col.col_name != key_col_.col_name) {
+            return true;
+        }
+        return keys_.count(*(const int *)val) > 0;
+    }
+};
+
+TEST(HashJoinTest, BloomSkipTest) {
+    // l(k int, v int)与r(k int, w int)按l.k = r.k连接，在r上建表，l中只有k为偶数的记录在r中有匹配
+    std::vector<ColMeta> left_cols = {{"l", "k", TYPE_INT, 4, 0, false}, {"l", "v", TYPE_INT, 4, 4, false}};
+    std::vector<ColMeta> right_cols = {{"r", "k", TYPE_INT, 4, 0, false}, {"r", "w", TYPE_INT, 4, 4, false}};
+    auto make_row = [](int a, int b) {
+        std::string row(8, '\0');
+        memcpy(&row[0], &a, sizeof(int));
+        memcpy(&row[4], &b, sizeof(int));
+        return row;
+    };
+    std::vector<std::string> left_rows, right_rows;
+    for (int i = 0; i < 4000; i++) {
+        left_rows.push_back(make_row(i % 1000, i));
+    }
+    for (int i = 0; i < 500; i++) {
+        right_rows.push_back(make_row(i * 2, -i));
+    }
+    std::vector<Condition> conds(1);
+    conds[0].lhs_col = {"l", "k"};
+    conds[0].op = OP_EQ;
+    conds[0].is_rhs_val = false;
+    conds[0].rhs_col = {"r", "k"};
+
+    // 溢出时k为奇数的2000条左记录不写入分区；不溢出时不检查
+    for (size_t budget : {HASH_JOIN_MEM_BUDGET, (size_t)1024}) {
+        HashJoinExecutor join(std::make_unique<MockExecutor>(left_cols, left_rows),
+                              std::make_unique<FilteredMockExecutor>(right_cols, right_rows), conds, false, budget);
+        size_t num_rows = 0;
+        for (join.beginTuple(); !join.is_end(); join.nextTuple()) {
+            auto rec = join.Next();
+            ASSERT_EQ(*(int *)rec->data, *(int *)(rec->data + 8));
+            num_rows++;
+        }
+        EXPECT_EQ(num_rows, 2000u);
+        EXPECT_EQ(join.get_num_partitions() > 0, budget != HASH_JOIN_MEM_BUDGET);
+        EXPECT_EQ(join.get_num_bloom_skipped(), budget == HASH_JOIN_MEM_BUDGET ? 0u : 2000u);
+    }
+}
+
+TEST(MergeJoinTest, SimpleTest) {
+    // l(s char(4), v int)与r(k int, s char(8))按l.s = r.s and l.v != r.k连接，两侧都按s升序且有重复值
+    std::vector<ColMeta> left_cols = {{"l", "s", TYPE_STRING, 4, 0, false}, {"l", "v", TYPE_INT, 4, 4, false}};
+    std::vector<ColMeta> right_cols = {{"r", "k", TYPE_INT, 4, 0, false}, {"r", "s", TYPE_STRING, 8, 4, false}};
+    std::mt19937 rng(5);
+    std::vector<std::string> left_rows, right_rows;
+    for (int i = 0; i < 2000; i++) {
+        std::string row(8, '\0');
+        snprintf(&row[0], 5, "%03d", (int)(rng() % 300));
+        int v = rng() % 10;
+        memcpy(&row[4], &v, sizeof(int));
+        left_rows.push_back(row);
+    }
+    for (int i = 0; i < 1500; i++) {
+        std::string row(12, '\0');
+        int k = rng() % 10;
+        memcpy(&row[0], &k, sizeof(int));
+        // 长度超过4的值与左侧的任何值都不相等
+        snprintf(&row[4], 9, i % 7 == 0 ? "%03d0" : "%03d", (int)(rng() % 400));
+        right_rows.push_back(row);
+    }
+    auto by_left_key = [](const std::string &a, const std::string &b) { return memcmp(a.data(), b.data(), 4) < 0; };
+    auto by_right_key = [](const std::string &a, const std::string &b) { return memcmp(&a[4], &b[4], 8) < 0; };
+    std::stable_sort(left_rows.begin(), left_rows.end(), by_left_key);
+    std::stable_sort(right_rows.begin(), right_rows.end(), by_right_key);
+    std::multiset<std::string> expected;
+    for (auto &l : left_rows) {
+        for (auto &r : right_rows) {
+            if (std::string(l.data(), strnlen(l.data(), 4)) == std::string(&r[4], strnlen(&r[4], 8)) &&
+                memcmp(&l[4], &r[0], 4) != 0) {
+                expected.insert(l + r);
+            }
+        }
+    }
+    ASSERT_GT(expected.size(), 1000u);
+
+    std::vector<Condition> conds(2);
+    conds[0].lhs_col = {"l", "v"};
+    conds[0].op = OP_NE;
+    conds[0].is_rhs_val = false;
+    conds[0].rhs_col = {"r", "k"};
+    conds[1].lhs_col = {"r", "s"};
+    conds[1].op = OP_EQ;
+    conds[1].is_rhs_val = false;
+    conds[1].rhs_col = {"l", "s"};
+    MergeJoinExecutor join(std::make_unique<MockExecutor>(left_cols, left_rows),
+                           std::make_unique<MockExecutor>(right_cols, right_rows), conds);
+    std::vector<std::string> actual;
+    for (join.beginTuple(); !join.is_end(); join.nextTuple()) {
+        actual.push_back(std::string(join.Next()->data, 20));
+    }
+    EXPECT_TRUE(std::is_sorted(actual.begin(), actual.end(), by_left_key));
+    EXPECT_EQ(std::multiset<std::string>(actual.begin(), actual.end()), expected);
+
+    // 批量读取的结果相同，重新开始时从头输出
+    actual.clear();
+    TupleBatch batch;
+    join.beginBatch();
+    while (join.NextBatch(batch)) {
+        for (int i = 0; i < batch.size(); i++) {
+            actual.push_back(std::string(batch.row(i), 20));
+        }
+    }
+    EXPECT_EQ(std::multiset<std::string>(actual.begin(), actual.end()), expected);
+
+    // 没有等值条件时不能使用合并连接
+    EXPECT_THROW(MergeJoinExecutor(std::make_unique<MockExecutor>(left_cols, left_rows),
+                                   std::make_unique<MockExecutor>(right_cols, right_rows), {conds[0]}),
+                 InternalError);
+}
+
+TEST(BlockNestedLoopJoinTest, SimpleTest) {
+    // l(k int, v float)与r(k int, w float)按l.k < r.k and l.v != r.w连接，以及不带条件的笛卡尔积
+    std::vector<ColMeta> left_cols = {{"l", "k", TYPE_INT, 4, 0, false}, {"l", "v", TYPE_FLOAT, 4, 4, false}};
+    std::vector<ColMeta> right_cols = {{"r", "k", TYPE_INT, 4, 0, false}, {"r", "w", TYPE_FLOAT, 4, 4, false}};
+    std::mt19937 rng(7);
+    auto make_rows = [&](int n) {
+        std::vector<std::string> rows;
+        for (int i = 0; i < n; i++) {
+            std::string row(8, '\0');
+            int k = rng() % 1000;
+            float v = (float)(rng() % 10);
+            memcpy(&row[0], &k, sizeof(int));
+            memcpy(&row[4], &v, sizeof(float));
+            rows.push_back(row);
+        }
+        return rows;
+    };
+    auto left_rows = make_rows(300), right_rows = make_rows(250);
+
+    std::vector<Condition> conds(2);
+    conds[0].lhs_col = {"l", "k"};
+    conds[0].op = OP_LT;
+    conds[0].is_rhs_val = false;
+    conds[0].rhs_col = {"r", "k"};
+    conds[1].lhs_col = {"r", "w"};
+    conds[1].op = OP_NE;
+    conds[1].is_rhs_val = false;
+    conds[1].rhs_col = {"l", "v"};
+    for (bool with_conds : {true, false}) {
+        std::multiset<std::string> expected;
+        for (auto &l : left_rows) {
+            for (auto &r : right_rows) {
+                if (!with_conds || (*(int *)&l[0] < *(int *)&r[0] && *(float *)&l[4] != *(float *)&r[4])) {
+                    expected.insert(l + r);
+                }
+            }
+        }
+        // 预算足够时只读入一块；预算只够放200条左记录时分为两块，每块扫描一遍右侧
+        for (size_t budget : {BLOCK_NLJ_MEM_BUDGET, (size_t)1600}) {
+            BlockNestedLoopJoinExecutor join(std::make_unique<MockExecutor>(left_cols, left_rows),
+                                             std::make_unique<MockExecutor>(right_cols, right_rows),
+                                             with_conds ? conds : std::vector<Condition>(), budget);
+            std::multiset<std::string> actual;
+            TupleBatch batch;
+            join.beginBatch();
+            while (join.NextBatch(batch)) {
+                for (int i = 0; i < batch.size(); i++) {
+                    actual.insert(std::string(batch.row(i), 16));
+                }
+            }
+            EXPECT_EQ(actual, expected);
+            EXPECT_EQ(join.get_num_blocks(), budget == BLOCK_NLJ_MEM_BUDGET ? 1u : 2u);
+        }
+    }
+
+    // 逐条读取的结果相同；左侧为空时没有输出
+    BlockNestedLoopJoinExecutor join(std::make_unique<MockExecutor>(left_cols, left_rows),
+                                     std::make_unique<MockExecutor>(right_cols, right_rows), conds, 800);
+    size_t num_rows = 0;
+    for (join.beginTuple(); !join.is_end(); join.nextTuple()) {
+        auto rec = join.Next();
+        EXPECT_LT(*(int *)rec->data, *(int *)(rec->data + 8));
+        num_rows++;
+    }
+    EXPECT_GT(num_rows, 0u);
+    EXPECT_EQ(join.get_num_blocks(), 3u);
+    BlockNestedLoopJoinExecutor empty_join(std::make_unique<MockExecutor>(left_cols, std::vector<std::string>()),
+                                           std::make_unique<MockExecutor>(right_cols, right_rows), conds);
+    empty_join.beginTuple();
+    EXPECT_TRUE(empty_join.is_end());
+}
+
+TEST(BlockNestedLoopJoinTest, CharLengthTest) {
+    // l(k int, s char(4))与r(s char(8), k int)按r.s >= l.s连接，较短的连接字段是左记录的最后一个字段，
+    // 比较时不能读到块中下一条左记录
+    std::vector<ColMeta> left_cols = {{"l", "k", TYPE_INT, 4, 0, false}, {"l", "s", TYPE_STRING, 4, 4, false}};
+    std::vector<ColMeta> right_cols = {{"r", "s", TYPE_STRING, 8, 0, false}, {"r", "k", TYPE_INT, 4, 8, false}};
+    std::mt19937 rng(17);
+    auto rand_str = [&](int max_len) {
+        std::string str;
+        for (int i = 0, n = rng() % (max_len + 1); i < n; i++) {
+            str.push_back('a' + rng() % 2);
+        }
+        return str;
+    };
+    std::vector<std::string> left_strs, right_strs, left_rows, right_rows;
+    for (int i = 0; i < 200; i++) {
+        int k = -1;
+        left_strs.push_back(rand_str(4));
+        std::string row(8, '\0');
+        memcpy(&row[0], &k, sizeof(int));
+        memcpy(&row[4], left_strs.back().data(), left_strs.back().size());
+        left_rows.push_back(row);
+    }
+    for (int i = 0; i < 100; i++) {
+        int k = i;
+        right_strs.push_back(rand_str(8));
+        std::string row(12, '\0');
+        memcpy(&row[0], right_strs.back().data(), right_strs.back().size());
+        memcpy(&row[8], &k, sizeof(int));
+        right_rows.push_back(row);
+    }
+    std::multiset<std::string> expected;
+    for (size_t i = 0; i < left_rows.size(); i++) {
+        for (size_t j = 0; j < right_rows.size(); j++) {
+            if (right_strs[j] >= left_strs[i]) {
+                expected.insert(left_rows[i] + right_rows[j]);
+            }
+        }
+    }
+
+    std::vector<Condition> conds(1);
+    conds[0].lhs_col = {"r", "s"};
+    conds[0].op = OP_GE;
+    conds[0].is_rhs_val = false;
+    conds[0].rhs_col = {"l", "s"};
+    for (size_t budget : {BLOCK_NLJ_MEM_BUDGET, (size_t)800}) {
+        BlockNestedLoopJoinExecutor join(std::make_unique<MockExecutor>(left_cols, left_rows),
+                                         std::make_unique<MockExecutor>(right_cols, right_rows), conds, budget);
+        std::multiset<std::string> actual;
+        TupleBatch batch;
+        join.beginBatch();
+        while (join.NextBatch(batch)) {
+            for (int i = 0; i < batch.size(); i++) {
+                actual.insert(std::string(batch.row(i), 20));
+            }
+        }
+        EXPECT_EQ(actual, expected) << "budget " << budget;
+    }
+}
+
+TEST(IndexNestedLoopJoinTest, SimpleTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto sm_manager =
+        std::make_unique<SmManager>(disk_manager.get(), buffer_pool_manager.get(), rm_manager.get(), ix_manager.get());
+
+    // 内表r(k int, s char(8), w int)在k上有非唯一B+树索引，k有重复值，7的倍数和100以上的k不存在
+    std::string tab_name = "inlj_inner";
+    std::vector<ColMeta> index_cols = {{tab_name, "k", TYPE_INT, 4, 0, true}};
+    if (ix_manager->exists(tab_name, index_cols)) {
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+    if (disk_manager->is_file(tab_name)) {
+        rm_manager->destroy_file(tab_name);
+    }
+    sm_manager->create_table(tab_name, {{"k", TYPE_INT, 4}, {"s", TYPE_STRING, 8}, {"w", TYPE_INT, 4}}, nullptr);
+    auto fh = sm_manager->fhs_.at(tab_name).get();
+    std::mt19937 rng(5);
+    std::vector<std::string> inner_rows;
+    for (int i = 0; i < 600; i++) {
+        int k = rng() % 100, w = rng() % 50;
+        if (k % 7 == 0) {
+            continue;
+        }
+        std::string row(16, '\0');
+        memcpy(&row[0], &k, sizeof(int));
+        snprintf(&row[4], 8, "r%d", i);
+        memcpy(&row[12], &w, sizeof(int));
+        fh->insert_record(&row[0], nullptr);
+        inner_rows.push_back(row);
+    }
+    sm_manager->create_index(tab_name, {"k"}, INDEX_BTREE, false, nullptr);
+
+    // 外侧l(k int, v int)，k有一部分在内表中不存在
+    std::vector<ColMeta> outer_cols = {{"l", "k", TYPE_INT, 4, 0, false}, {"l", "v", TYPE_INT, 4, 4, false}};
+    std::vector<std::string> outer_rows;
+    for (int i = 0; i < 3000; i++) {
+        int k = rng() % 120, v = rng() % 50;
+        std::string row(8, '\0');
+        memcpy(&row[0], &k, sizeof(int));
+        memcpy(&row[4], &v, sizeof(int));
+        outer_rows.push_back(row);
+    }
+
+    // 按l.k = r.k and r.w > l.v连接，内表上另有条件r.w != 10
+    std::vector<Condition> conds(2);
+    conds[0].lhs_col = {"l", "k"};
+    conds[0].op = OP_EQ;
+    conds[0].is_rhs_val = false;
+    conds[0].rhs_col = {tab_name, "k"};
+    conds[1].lhs_col = {tab_name, "w"};
+    conds[1].op = OP_GT;
+    conds[1].is_rhs_val = false;
+    conds[1].rhs_col = {"l", "v"};
+    std::vector<Condition> inner_conds(1);
+    inner_conds[0].lhs_col = {tab_name, "w"};
+    inner_conds[0].op = OP_NE;
+    inner_conds[0].is_rhs_val = true;
+    inner_conds[0].rhs_val.set_int(10);
+    inner_conds[0].rhs_val.init_raw(sizeof(int));
+
+    // 嵌套循环得到的参考结果
+    std::multiset<std::string> expected;
+    for (auto &l : outer_rows) {
+        for (auto &r : inner_rows) {
+            int w = *(int *)&r[12];
+            if (memcmp(l.data(), r.data(), 4) == 0 && w > *(int *)&l[4] && w != 10) {
+                expected.insert(l + r);
+            }
+        }
+    }
+    ASSERT_GT(expected.size(), 1000u);
+
+    // 批量探测与逐条探测、批量读取与逐条读取的结果都与参考结果相同
+    for (bool batch_probes : {true, false}) {
+        IndexNestedLoopJoinExecutor join(sm_manager.get(), std::make_unique<MockExecutor>(outer_cols, outer_rows),
+                                         tab_name, inner_conds, conds, {"k"}, nullptr, batch_probes);
+        ASSERT_EQ(join.tupleLen(), 24u);
+        std::multiset<std::string> actual;
+        TupleBatch batch;
+        join.beginBatch();
+        while (join.NextBatch(batch)) {
+            for (int i = 0; i < batch.size(); i++) {
+                actual.insert(std::string(batch.row(i), 24));
+            }
+        }
+        EXPECT_EQ(actual, expected);
+
+        actual.clear();
+        for (join.beginTuple(); !join.is_end(); join.nextTuple()) {
+            auto rec = join.Next();
+            actual.insert(std::string(rec->data, 24));
+        }
+        EXPECT_EQ(actual, expected);
+    }
+
+    // 外侧为空或全部不匹配时没有输出
+    std::vector<std::string> missing_rows(100, std::string(8, '\0'));
+    for (auto rows : {std::vector<std::string>(), missing_rows}) {
+        IndexNestedLoopJoinExecutor join(sm_manager.get(), std::make_unique<MockExecutor>(outer_cols, rows), tab_name,
+                                         inner_conds, conds, {"k"}, nullptr);
+        join.beginTuple();
+        EXPECT_TRUE(join.is_end());
+    }
+
+    sm_manager->drop_table(tab_name, nullptr);
+    std::remove(DB_META_NAME.c_str());
+}
+
+TEST(SortTest, ExternalSortTest) {
+    // t(k int, s char(4), v float)按k升序、s降序排序，k和s都有大量重复值
+    std::vector<ColMeta> cols = {
+        {"t", "k", TYPE_INT, 4, 0, false}, {"t", "s", TYPE_STRING, 4, 4, false}, {"t", "v", TYPE_FLOAT, 4, 8, false}};
+    std::mt19937 rng(11);
+    std::vector<std::string> rows;
+    for (int i = 0; i < 5000; i++) {
+        std::string row(12, '\0');
+        int k = rng() % 50;
+        float v = (float)i;
+        row[4] = 'a' + rng() % 5;
+        memcpy(&row[0], &k, sizeof(int));
+        memcpy(&row[8], &v, sizeof(float));
+        rows.push_back(row);
+    }
+    std::vector<SortKey> keys = {{{"t", "k"}, false}, {{"t", "s"}, true}};
+    auto in_order = [](const std::string &a, const std::string &b) {
+        int ka = *(int *)&a[0], kb = *(int *)&b[0];
+        return ka < kb || (ka == kb && memcmp(&a[4], &b[4], 4) >= 0);
+    };
+
+    // 内存足够时不写出有序段；每段2457条时一趟归并3段；每段20条时归并路数为2，需要多趟归并
+    for (size_t work_mem : {SORT_WORK_MEM, (size_t)12 * TUPLE_BATCH_SIZE * 4, (size_t)400}) {
+        SortExecutor sort(std::make_unique<MockExecutor>(cols, rows), keys, work_mem);
+        std::vector<std::string> actual;
+        TupleBatch batch;
+        sort.beginBatch();
+        while (sort.NextBatch(batch)) {
+            for (int i = 0; i < batch.size(); i++) {
+                actual.emplace_back(batch.row(i), 12);
+            }
+        }
+        ASSERT_EQ(actual.size(), rows.size());
+        for (size_t i = 1; i < actual.size(); i++) {
+            EXPECT_TRUE(in_order(actual[i - 1], actual[i]));
+        }
+        EXPECT_EQ(std::multiset<std::string>(actual.begin(), actual.end()),
+                  std::multiset<std::string>(rows.begin(), rows.end()));
+        EXPECT_EQ(sort.get_num_runs(), work_mem == SORT_WORK_MEM ? 0u : work_mem == 400 ? 250u : 3u);
+    }
+
+    // 逐条读取的结果相同；输入为空时没有输出
+    SortExecutor sort(std::make_unique<MockExecutor>(cols, rows), keys, 400);
+    std::string prev;
+    size_t num_rows = 0;
+    for (sort.beginTuple(); !sort.is_end(); sort.nextTuple()) {
+        auto rec = sort.Next();
+        std::string row(rec->data, 12);
+        if (num_rows > 0) {
+            EXPECT_TRUE(in_order(prev, row));
+        }
+        prev = row;
+        num_rows++;
+    }
+    EXPECT_EQ(num_rows, rows.size());
+    SortExecutor empty_sort(std::make_unique<MockExecutor>(cols, std::vector<std::string>()), keys);
+    empty_sort.beginTuple();
+    EXPECT_TRUE(empty_sort.is_end());
+}
+
+TEST(SortTest, LimitTest) {
+    // t(k int, s char(4))按k降序、s升序取前n行，以及不排序时直接取第m行开始的n行
+    std::vector<ColMeta> cols = {{"t", "k", TYPE_INT, 4, 0, false}, {"t", "s", TYPE_STRING, 4, 4, false}};
+    std::mt19937 rng(13);
+    std::vector<std::string> rows;
+    for (int i = 0; i < 5000; i++) {
+        std::string row(8, '\0');
+        int k = rng() % 1000;
+        row[4] = 'a' + rng() % 26;
+        memcpy(&row[0], &k, sizeof(int));
+        rows.push_back(row);
+    }
+    std::vector<SortKey> keys = {{{"t", "k"}, true}, {{"t", "s"}, false}};
+    auto sorted = rows;
+    std::sort(sorted.begin(), sorted.end(), [](const std::string &a, const std::string &b) {
+        int ka = *(int *)&a[0], kb = *(int *)&b[0];
+        return ka > kb || (ka == kb && a.substr(4) < b.substr(4));
+    });
+    auto collect = [](AbstractExecutor &exec) {
+        std::vector<std::string> result;
+        TupleBatch batch;
+        exec.beginBatch();
+        while (exec.NextBatch(batch)) {
+            for (int i = 0; i < batch.size(); i++) {
+                result.emplace_back(batch.row(i), exec.tupleLen());
+            }
+        }
+        return result;
+    };
+
+    // 前30行放得进work_mem时用堆选出，放不下时外部排序后只输出前30行
+    for (size_t work_mem : {SORT_WORK_MEM, (size_t)400}) {
+        SortExecutor sort(std::make_unique<MockExecutor>(cols, rows), keys, work_mem, 30);
+        EXPECT_EQ(collect(sort), std::vector<std::string>(sorted.begin(), sorted.begin() + 30));
+        EXPECT_EQ(sort.get_num_runs(), work_mem == SORT_WORK_MEM ? 0u : 200u);
+        LimitExecutor limit(std::make_unique<SortExecutor>(std::make_unique<MockExecutor>(cols, rows), keys, work_mem, 30),
+                            20, 10);
+        EXPECT_EQ(collect(limit), std::vector<std::string>(sorted.begin() + 10, sorted.begin() + 30));
+    }
+
+    // 行数小于一批时逐条读取，读够后不再推进子节点；行数较多时按批读取
+    auto mock = std::make_unique<MockExecutor>(cols, rows);
+    auto mock_ptr = mock.get();
+    LimitExecutor small(std::move(mock), 5, 3);
+    EXPECT_EQ(collect(small), std::vector<std::string>(rows.begin() + 3, rows.begin() + 8));
+    EXPECT_EQ(mock_ptr->get_pos(), 7u);
+    LimitExecutor large(std::make_unique<MockExecutor>(cols, rows), 1500, 100);
+    EXPECT_EQ(collect(large), std::vector<std::string>(rows.begin() + 100, rows.begin() + 1600));
+    LimitExecutor past_end(std::make_unique<MockExecutor>(cols, rows), 100, 4950);
+    EXPECT_EQ(collect(past_end), std::vector<std::string>(rows.begin() + 4950, rows.end()));
+    LimitExecutor none(std::make_unique<MockExecutor>(cols, rows), 0, 0);
+    EXPECT_TRUE(collect(none).empty());
+    // LIMIT 0 OFFSET m不开始也不读取子节点，逐条和按批读取时都一样
+    for (size_t offset : {(size_t)3, (size_t)3000}) {
+        auto zero_mock = std::make_unique<MockExecutor>(cols, rows);
+        auto zero_mock_ptr = zero_mock.get();
+        LimitExecutor zero(std::move(zero_mock), 0, offset);
+        EXPECT_TRUE(collect(zero).empty());
+        zero.beginTuple();
+        EXPECT_TRUE(zero.is_end());
+        EXPECT_EQ(zero_mock_ptr->get_pos(), 0u);
+    }
+}
+
+TEST(AggregateTest, GroupByTest) {
+    // t(k int, s char(4), v int, f float)按k, s分组求COUNT(*), SUM(v), MIN(f), MAX(s), AVG(v), SUM(f)
+    std::vector<ColMeta> cols = {{"t", "k", TYPE_INT, 4, 0, false},
+                                 {"t", "s", TYPE_STRING, 4, 4, false},
+                                 {"t", "v", TYPE_INT, 4, 8, false},
+                                 {"t", "f", TYPE_FLOAT, 4, 12, false}};
+    std::vector<AggExpr> aggs = {{AGG_COUNT, {}, "COUNT(*)"},
+                                 {AGG_SUM, {"t", "v"}, "SUM(t.v)"},
+                                 {AGG_MIN, {"t", "f"}, "MIN(t.f)"},
+                                 {AGG_MAX, {"t", "s"}, "MAX(t.s)"},
+                                 {AGG_AVG, {"t", "v"}, "AVG(t.v)"},
+                                 {AGG_SUM, {"t", "f"}, "SUM(t.f)"}};
+    struct Group {
+        int count = 0;
+        int64_t sum_v = 0;
+        float min_f = 0;
+        double sum_f = 0;
+    };
+    std::mt19937 rng(17);
+    std::vector<std::string> rows;
+    std::map<std::pair<int, std::string>, Group> expect;
+    for (int i = 0; i < 20000; i++) {
+        std::string row(16, '\0');
+        int k = rng() % 500;
+        int v = (int)(rng() % 2000) - 1000;
+        float f = (int)(rng() % 100) / 2.0f - 10;
+        row[4] = 'a' + rng() % 3;
+        memcpy(&row[0], &k, sizeof(int));
+        memcpy(&row[8], &v, sizeof(int));
+        memcpy(&row[12], &f, sizeof(float));
+        rows.push_back(row);
+        auto &group = expect[{k, row.substr(4, 1)}];
+        group.min_f = group.count == 0 ? f : std::min(group.min_f, f);
+        group.count++;
+        group.sum_v += v;
+        group.sum_f += f;
+    }
+    auto collect = [](AbstractExecutor &exec) {
+        std::vector<std::string> result;
+        TupleBatch batch;
+        exec.beginBatch();
+        while (exec.NextBatch(batch)) {
+            for (int i = 0; i < batch.size(); i++) {
+                result.emplace_back(batch.row(i), exec.tupleLen());
+            }
+        }
+        return result;
+    };
+
+    // 默认预算下各线程的哈希表直接合并；预算很小时各线程写出分区，分区再逐层划分；单线程时不启动线程
+    for (auto [mem_budget, num_threads] : std::vector<std::pair<size_t, int>>{{AGG_MEM_BUDGET, 4}, {4096, 3}, {4096, 1}}) {
+        AggregateExecutor agg(std::make_unique<MockExecutor>(cols, rows), {{"t", "k"}, {"t", "s"}}, aggs, mem_budget,
+                              num_threads);
+        ASSERT_EQ(agg.tupleLen(), 32u);
+        EXPECT_EQ(agg.cols()[2].name, "COUNT(*)");
+        EXPECT_EQ(agg.cols()[7].type, TYPE_FLOAT);
+        auto result = collect(agg);
+        EXPECT_EQ(result.size(), expect.size());
+        std::set<std::pair<int, std::string>> seen;
+        for (auto &row : result) {
+            auto key = std::make_pair(*(int *)&row[0], std::string(row.c_str() + 4));
+            ASSERT_TRUE(expect.count(key));
+            EXPECT_TRUE(seen.insert(key).second);
+            auto &group = expect[key];
+            EXPECT_EQ(*(int *)&row[8], group.count);
+            EXPECT_EQ(*(int *)&row[12], group.sum_v);
+            EXPECT_EQ(*(float *)&row[16], group.min_f);
+            EXPECT_EQ(row.substr(20, 4), row.substr(4, 4));
+            EXPECT_EQ(*(float *)&row[24], (float)((double)group.sum_v / group.count));
+            EXPECT_EQ(*(float *)&row[28], (float)group.sum_f);
+        }
+        EXPECT_EQ(agg.get_num_partitions() > 0, mem_budget != AGG_MEM_BUDGET);
+    }
+
+    // 没有分组字段时输出一行，输入为空时COUNT为0
+    std::vector<AggExpr> totals = {{AGG_COUNT, {"t", "v"}, "COUNT(t.v)"}, {AGG_MAX, {"t", "k"}, "MAX(t.k)"}};
+    AggregateExecutor all(std::make_unique<MockExecutor>(cols, rows), {}, totals);
+    auto result = collect(all);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(*(int *)&result[0][0], 20000);
+    EXPECT_EQ(*(int *)&result[0][4], expect.rbegin()->first.first);
+    AggregateExecutor empty(std::make_unique<MockExecutor>(cols, std::vector<std::string>()), {}, totals);
+    empty.beginTuple();
+    ASSERT_FALSE(empty.is_end());
+    EXPECT_EQ(*(int *)empty.Next()->data, 0);
+    empty.nextTuple();
+    EXPECT_TRUE(empty.is_end());
+}
+
+TEST(AggregateTest, SumOverflowTest) {
+    // t(k int, v int)按k分组求SUM(v)和AVG(v)，每组的v都接近INT的上下界
+    std::vector<ColMeta> cols = {{"t", "k", TYPE_INT, 4, 0, false}, {"t", "v", TYPE_INT, 4, 4, false}};
+    std::vector<AggExpr> aggs = {{AGG_SUM, {"t", "v"}, "SUM(t.v)"}, {AGG_AVG, {"t", "v"}, "AVG(t.v)"}};
+    const int big = std::numeric_limits<int>::max();
+    auto make_rows = [](const std::vector<std::pair<int, int>> &kvs) {
+        std::vector<std::string> rows;
+        for (auto [k, v] : kvs) {
+            std::string row(8, '\0');
+            memcpy(&row[0], &k, sizeof(int));
+            memcpy(&row[4], &v, sizeof(int));
+            rows.push_back(row);
+        }
+        return rows;
+    };
+    auto run = [&](const std::vector<std::string> &rows, int num_threads) {
+        AggregateExecutor agg(std::make_unique<MockExecutor>(cols, rows), {{"t", "k"}}, aggs, AGG_MEM_BUDGET,
+                              num_threads);
+        std::map<int, std::pair<int, float>> result;
+        for (agg.beginTuple(); !agg.is_end(); agg.nextTuple()) {
+            auto rec = agg.Next();
+            result[*(int *)rec->data] = {*(int *)(rec->data + 4), *(float *)(rec->data + 8)};
+        }
+        return result;
+    };
+
+    for (int num_threads : {1, 4}) {
+        // 中间结果超出INT的范围但最终的和在范围内时结果正确
+        std::vector<std::pair<int, int>> kvs;
+        for (int i = 0; i < 1000; i++) {
+            kvs.push_back({0, big});
+            kvs.push_back({1, -big});
+        }
+        for (int i = 0; i < 1000; i++) {
+            kvs.push_back({0, -big});
+            kvs.push_back({1, big});
+        }
+        kvs.push_back({0, 5});
+        kvs.push_back({1, -5});
+        auto result = run(make_rows(kvs), num_threads);
+        ASSERT_EQ(result.size(), 2u);
+        EXPECT_EQ(result[0].first, 5);
+        EXPECT_EQ(result[1].first, -5);
+        EXPECT_FLOAT_EQ(result[0].second, 5.0f / 2001);
+
+        // 和超过INT_MAX或低于INT_MIN时报错，不回绕
+        EXPECT_THROW(run(make_rows({{0, 1}, {0, big}}), num_threads), AggregateOverflowError);
+        EXPECT_THROW(run(make_rows({{0, -big}, {0, -2}}), num_threads), AggregateOverflowError);
+        std::vector<std::pair<int, int>> many(3000, {7, big / 1000});
+        EXPECT_THROW(run(make_rows(many), num_threads), AggregateOverflowError);
+    }
+
+    // 只求AVG时按int64_t的和计算，和超出INT的范围也不报错
+    AggregateExecutor avg(std::make_unique<MockExecutor>(cols, make_rows({{0, big}, {0, big}, {0, big - 3}})),
+                          {{"t", "k"}}, {{AGG_AVG, {"t", "v"}, "AVG(t.v)"}});
+    avg.beginTuple();
+    ASSERT_FALSE(avg.is_end());
+    EXPECT_EQ(*(float *)(avg.Next()->data + 4), (float)(big - 1));
+}
+
+TEST(RidBitmapTest, SimpleTest) {
+    const int max_slots = 300;
+    std::mt19937 rng(2023);
+    // 每页的记录数有多有少，覆盖数组容器、位图容器以及两者之间的转换
+    auto make = [&](int num_pages, RidBitmap *bitmap, std::set<std::pair<int, int>> *expect) {
+        for (int page_no = 0; page_no < num_pages; page_no++) {
+            int num_slots = rng() % 3 == 0 ? rng() % max_slots : rng() % 10;
+            for (int i = 0; i < num_slots; i++) {
+                int slot_no = rng() % max_slots;
+                bitmap->add(Rid{page_no, slot_no});
+                expect->emplace(page_no, slot_no);
+            }
+        }
+    };
+    auto check = [&](const RidBitmap &bitmap, const std::set<std::pair<int, int>> &expect) {
+        assert(bitmap.cardinality() == expect.size());
+        auto iter = bitmap.iterator();
+        Rid rid;
+        for (auto &[page_no, slot_no] : expect) {
+            assert(iter.next(&rid) && rid.page_no == page_no && rid.slot_no == slot_no);
+            assert(bitmap.contains(rid));
+        }
+        assert(!iter.next(&rid));
+    };
+    for (int round = 0; round < 20; round++) {
+        RidBitmap a(max_slots), b(max_slots), c(max_slots);
+        std::set<std::pair<int, int>> sa, sb, sc;
+        make(50, &a, &sa);
+        make(60, &b, &sb);
+        make(40, &c, &sc);
+        check(a, sa);
+
+        std::set<std::pair<int, int>> expect;
+        std::set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(), std::inserter(expect, expect.end()));
+        a.intersect_with(b);
+        check(a, expect);
+
+        std::set<std::pair<int, int>> merged;
+        std::set_union(expect.begin(), expect.end(), sc.begin(), sc.end(), std::inserter(merged, merged.end()));
+        a.union_with(c);
+        check(a, merged);
+    }
+    RidBitmap empty(max_slots), d(max_slots);
+    d.add(Rid{1, 2});
+    d.intersect_with(empty);
+    assert(d.empty());
+}
+
+TEST(IxHashIndexHandleTest, SimpleTest) {
+    srand((unsigned)time(nullptr));
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    // 使用较长的key，使每个桶只能存放少量键值对，从而能够测试到目录跨页时的翻倍与减半
+    const int key_len = 500;
+    std::string tab_name = "hash_test";
+    std::vector<ColMeta> index_cols = {
+        {.tab_name = tab_name, .name = "k", .type = TYPE_STRING, .len = key_len, .offset = 0, .index = true}};
+    if (ix_manager->exists(tab_name, index_cols)) {
+        ix_manager->destroy_index(tab_name, index_cols);
+    }
+    ix_manager->create_hash_index(tab_name, index_cols);
+    auto ih = ix_manager->open_hash_index(tab_name, index_cols);
+
+    std::map<std::string, Rid> mock;
+    auto make_key = [&](int k) {
+        std::string key(key_len, '\0');
+        snprintf(&key[0], key_len, "%08d", k);
+        return key;
+    };
+    auto check_equal = [&]() {
+        for (auto &entry : mock) {
+            std::vector<Rid> result;
+            assert(ih->get_value(entry.first.c_str(), &result, nullptr));
+            assert(result.size() == 1 && result[0] == entry.second);
+        }
+    };
+
+    // 随机插入和删除
+    for (int round = 0; round < 30000; round++) {
+        double insert_prob = 1. - mock.size() / 20000.;
+        int k = rand() % 40000;
+        std::string key = make_key(k);
+        if (mock.empty() || rand() * 1. / RAND_MAX < insert_prob) {
+            Rid rid = {.page_no = k, .slot_no = round};
+            page_id_t page_no = ih->insert_entry(key.c_str(), rid, nullptr);
+            if (mock.count(key)) {
+                assert(page_no == IX_NO_PAGE);
+            } else {
+                assert(page_no != IX_NO_PAGE);
+                mock[key] = rid;
+            }
+        } else {
+            auto it = mock.lower_bound(key);
+            if (it == mock.end()) it = mock.begin();
+            assert(ih->delete_entry(it->first.c_str(), nullptr));
+            mock.erase(it);
+            assert(!ih->delete_entry(make_key(40000).c_str(), nullptr));
+        }
+        std::vector<Rid> result;
+        assert(ih->get_value(key.c_str(), &result, nullptr) == (mock.count(key) > 0));
+        // Randomly re-open file
+        if (round % 10000 == 0) {
+            ix_manager->close_hash_index(ih.get());
+            ih = ix_manager->open_hash_index(tab_name, index_cols);
+            check_equal();
+        }
+    }
+    check_equal();
+    // 目录已经跨越多个目录页
+    assert(ih->get_global_depth() > 10);
+
+    // 全部删除后桶逐级合并，目录缩回一项
+    while (!mock.empty()) {
+        assert(ih->delete_entry(mock.begin()->first.c_str(), nullptr));
+        mock.erase(mock.begin());
+    }
+    assert(ih->get_global_depth() == 0);
+
+    // clean up
+    ix_manager->close_hash_index(ih.get());
+    ix_manager->destroy_index(tab_name, index_cols);
+}